@@ -0,0 +1,158 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file affinity.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 00:40
+ * @brief 线程的 CPU 亲和性与 NUMA 内存放置
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_AFFINITY_HPP
+#define TINY_WEB_SERVER_AFFINITY_HPP
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tiny_web_server::async {
+
+    /**
+     * @brief 有序、无重复的 CPU 编号集合
+     */
+    struct CpuSet {
+    private:
+        std::vector<int> cpus_;
+
+    public:
+        CpuSet() = default;
+
+        explicit CpuSet(std::vector<int> cpus);
+
+        /**
+         * @brief 解析内核 cpulist 格式，如 @c 0-3,8,10-11
+         * @return 格式错误、区间倒置(如 @c 3-1)或 CPU 编号不小于 8192 时返回空
+         */
+        static std::optional<CpuSet> parse(std::string_view list);
+
+        /**
+         * @brief 当前进程允许运行的 CPU(受 taskset 与 cgroup cpuset 限制)
+         */
+        static CpuSet available();
+
+        void add(int cpu);
+
+        [[nodiscard]] bool contains(int cpu) const noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        [[nodiscard]] int operator[](std::size_t index) const noexcept;
+
+        [[nodiscard]] std::span<const int> cpus() const noexcept;
+
+        /**
+         * @brief 以 cpulist 格式输出
+         */
+        [[nodiscard]] std::string toString() const;
+    };
+
+    /**
+     * @brief NUMA 拓扑，读取自 /sys/devices/system/node
+     * @details 非 NUMA 机器或无法读取时视为单个节点，包含所有可用 CPU
+     */
+    struct NumaTopology {
+    private:
+        std::vector<CpuSet> nodes_;
+
+        /// 下标为 CPU 编号
+        std::vector<int> nodeOf_;
+
+    public:
+        explicit NumaTopology(std::vector<CpuSet> nodes);
+
+        static const NumaTopology& system();
+
+        [[nodiscard]] std::size_t nodes() const noexcept;
+
+        [[nodiscard]] const CpuSet& cpus(std::size_t node) const;
+
+        /**
+         * @brief CPU 所在的节点，未知的 CPU 归入节点0
+         */
+        [[nodiscard]] int nodeOf(int cpu) const noexcept;
+    };
+
+    /**
+     * @brief 把当前线程绑定到 @p cpus
+     * @return 不支持或被拒绝(如不在 cgroup cpuset 内)时返回 false
+     */
+    bool pinThread(const CpuSet& cpus);
+
+    /**
+     * @brief 当前线程此刻所在的 CPU
+     */
+    [[nodiscard]] std::optional<int> currentCpu();
+
+    /**
+     * @brief 令当前线程此后的内存分配优先从 @p node 获取(MPOL_PREFERRED)
+     * @details 内核默认的首次访问策略把页放在首次写入它的线程所在的节点; 绑定线程后再设置此策略，
+     * 可避免线程在调度迁移前后分配的内存散落在远端节点
+     */
+    bool preferNode(int node);
+
+    /**
+     * @brief 把已分配的内存迁移到 @p node ，此后缺页也优先从该节点分配(mbind)
+     * @details 用于在其他线程上分配、由 @p node 上的线程使用的缓冲区; 区间按页对齐扩展。
+     * 使用 MPOL_PREFERRED 而非 MPOL_BIND，本地节点内存耗尽时回退到其他节点而不是失败
+     */
+    bool bindMemory(std::span<std::byte> memory, int node);
+
+    /**
+     * @brief 线程放置计划: 第 i 个线程绑定到 @c cpus[i % cpus.size()] ，并优先使用其本地节点的内存
+     * @details 各线程应在创建自己的反应器、连接池与缓冲区之前调用 @c apply ，
+     * 使这些内存经首次访问落在本地节点上
+     */
+    struct ThreadPlacement {
+        CpuSet cpus = CpuSet::available();
+
+        /// 是否同时设置内存策略
+        bool localMemory = true;
+
+        /**
+         * @brief 从 cpulist 字符串构造，如环境变量 @c TWS_CPUS
+         * @return 格式错误或为空时返回空
+         */
+        static std::optional<ThreadPlacement> parse(std::string_view list);
+
+        [[nodiscard]] int cpu(std::size_t index) const noexcept;
+
+        [[nodiscard]] int node(std::size_t index) const noexcept;
+
+        /**
+         * @brief 在第 @p index 个线程内调用
+         * @return 绑定是否成功; 失败时线程照常运行
+         */
+        bool apply(std::size_t index) const;
+    };
+
+    /**
+     * @brief 记录一个被接受的连接的接收 CPU(SO_INCOMING_CPU)与处理它的线程
+     * @details 导出 @c tws_accepts_by_cpu_total{rx_cpu,thread} ，
+     * 以及按是否与线程所在 CPU 一致划分的 @c tws_accept_cpu_locality_total
+     */
+    void recordIncomingCpu(std::size_t thread, int threadCpu, std::optional<int> rxCpu);
+
+}  // namespace tiny_web_server::async
+
+#endif  // TINY_WEB_SERVER_AFFINITY_HPP
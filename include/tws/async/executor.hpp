@@ -0,0 +1,205 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file executor.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 17:40
+ * @brief 工作窃取线程池
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_EXECUTOR_HPP
+#define TINY_WEB_SERVER_EXECUTOR_HPP
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "affinity.hpp"
+#include "reactor.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace tiny_web_server::async {
+
+    /**
+     * @brief 工作窃取线程池，用于把模板渲染、JSON 编码、压缩等计算移出 I/O 线程
+     * @details 每个工作线程持有一个 Chase-Lev 队列; 工作线程内提交的任务进入自身队列，
+     * 其他线程提交的任务进入共享注入队列。空闲的工作线程先从注入队列与其他线程的队列窃取，
+     * 短暂自旋后在 futex 上休眠(@c std::atomic::wait)，有新任务时才被唤醒。
+     * 任务抛出的异常由工作线程捕获并计数(@c tws_executor_task_failures_total)，不会终止进程。
+     */
+    struct Executor {
+    public:
+        using Task = std::function<void()>;
+
+        /**
+         * @brief 任务节点
+         * @details 协程切换时节点嵌在等待体中，无需分配
+         */
+        struct Job {
+            void (*run)(Job* job);
+        };
+
+    private:
+        struct Worker {
+            WorkStealingDeque<Job*> deque;
+
+            /// 窃取时随机选择起点
+            std::uint64_t seed;
+
+            std::jthread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+        std::mutex injectMutex_;
+
+        std::deque<Job*> inject_;
+
+        /// 注入队列长度，空闲时无需加锁即可判断
+        std::atomic<std::size_t> injected_ = 0;
+
+        /// 每次提交递增，休眠的工作线程在其上等待
+        alignas(64) std::atomic<std::uint32_t> signal_ = 0;
+
+        alignas(64) std::atomic<std::uint32_t> sleeping_ = 0;
+
+        std::atomic<bool> stopping_ = false;
+
+        std::atomic<std::uint64_t> failures_ = 0;
+
+        std::optional<ThreadPlacement> placement_;
+
+    public:
+        explicit Executor(std::size_t threads = std::thread::hardware_concurrency());
+
+        /**
+         * @brief 第 i 个工作线程启动时按 @p placement 绑定 CPU 与内存节点
+         */
+        Executor(std::size_t threads, ThreadPlacement placement);
+
+        /**
+         * @brief 执行完已提交的任务后停止所有工作线程
+         */
+        ~Executor();
+
+        Executor(const Executor&)            = delete;
+        Executor& operator=(const Executor&) = delete;
+
+        void submit(Task task);
+
+        /**
+         * @brief 提交任务节点，节点在 @c run 返回前必须保持有效
+         */
+        void submit(Job* job);
+
+        /**
+         * @brief 切换到线程池的等待体
+         * @details 如 @c co_await executor.schedule() ; 与 @c Reactor::schedule 配合，
+         * 处理器可在计算前后在 I/O 线程与工作线程之间切换
+         */
+        auto schedule() noexcept {
+            struct Awaiter : Job {
+                Executor* executor;
+
+                std::coroutine_handle<> handle;
+
+                explicit Awaiter(Executor* executor) noexcept
+                    : Job{&resume}
+                    , executor(executor) {}
+
+                bool await_ready() const noexcept { return false; }
+
+                void await_suspend(std::coroutine_handle<> handle) {
+                    this->handle = handle;
+                    executor->submit(this);
+                }
+
+                void await_resume() const noexcept {}
+
+                static void resume(Job* job) { static_cast<Awaiter*>(job)->handle.resume(); }
+            };
+
+            return Awaiter{this};
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /**
+         * @brief 当前线程是否为本线程池的工作线程
+         */
+        [[nodiscard]] bool isWorkerThread() const noexcept;
+
+        /**
+         * @brief 以异常结束的任务数
+         */
+        [[nodiscard]] std::uint64_t failures() const noexcept;
+
+    private:
+        void start(std::size_t threads);
+
+        void run(std::size_t index);
+
+        void execute(Job* job) noexcept;
+
+        Job* findWork(std::size_t index);
+
+        void notify();
+    };
+
+    /**
+     * @brief 在线程池中执行 @p work ，再把结果交回 @p reactor 线程中的 @p done
+     * @details 适用于回调风格的处理器; 结果通过反应器的无锁队列返回。
+     * @p work 抛出异常时不调用 @p done ，异常只由线程池计数; 需要感知失败时使用带 @p fail 的重载
+     */
+    template<typename Work, typename Done>
+    void offload(Executor& executor, Reactor& reactor, Work work, Done done) {
+        auto task = [&reactor, work = std::move(work), done = std::move(done)]() mutable {
+            if constexpr (std::is_void_v<std::invoke_result_t<Work&>>) {
+                work();
+                reactor.post(std::move(done));
+            } else {
+                reactor.post([done = std::move(done), result = work()]() mutable {
+                    done(std::move(result));
+                });
+            }
+        };
+
+        executor.submit(std::move(task));
+    }
+
+    /**
+     * @brief 同上，@p work 抛出异常时改为在 @p reactor 线程中以 @c std::exception_ptr 调用 @p fail
+     */
+    template<typename Work, typename Done, typename Fail>
+    void offload(Executor& executor, Reactor& reactor, Work work, Done done, Fail fail) {
+        auto guarded = [&reactor, work = std::move(work), fail = std::move(fail)]() mutable {
+            try {
+                return work();
+            } catch (...) {
+                auto error = std::current_exception();
+
+                reactor.post([fail = std::move(fail), error]() mutable { fail(error); });
+                throw;
+            }
+        };
+
+        offload(executor, reactor, std::move(guarded), std::move(done));
+    }
+
+}  // namespace tiny_web_server::async
+
+#endif  // TINY_WEB_SERVER_EXECUTOR_HPP
@@ -0,0 +1,89 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file mpsc_queue.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 17:40
+ * @brief 无锁多生产者单消费者队列
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_MPSC_QUEUE_HPP
+#define TINY_WEB_SERVER_MPSC_QUEUE_HPP
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace tiny_web_server::async {
+
+    /**
+     * @brief 无锁多生产者单消费者队列(Vyukov)
+     * @details @c push 是无等待的，一次原子交换加一次存储; @c pop 只能由单一消费者调用。
+     * 生产者交换头指针后、链接前的短暂窗口内，@c pop 可能看不到该元素而返回空，
+     * 调用者应在生产者完成后另行唤醒消费者(如 eventfd)。
+     */
+    template<typename T>
+    struct MpscQueue {
+    private:
+        struct Node {
+            std::atomic<Node*> next = nullptr;
+
+            std::optional<T> value;
+        };
+
+        alignas(64) std::atomic<Node*> head_;
+
+        alignas(64) Node* tail_;
+
+    public:
+        MpscQueue()
+            : head_(new Node)
+            , tail_(head_.load(std::memory_order_relaxed)) {}
+
+        ~MpscQueue() {
+            while (pop()) {}
+
+            delete tail_;
+        }
+
+        MpscQueue(const MpscQueue&)            = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        /**
+         * @brief 任意线程调用
+         */
+        void push(T value) {
+            auto* node = new Node;
+            node->value.emplace(std::move(value));
+
+            auto* prev = head_.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        /**
+         * @brief 仅消费者线程调用
+         */
+        std::optional<T> pop() {
+            auto* next = tail_->next.load(std::memory_order_acquire);
+            if (!next) return std::nullopt;
+
+            // next 成为新的哨兵节点
+            auto value = std::move(next->value);
+            next->value.reset();
+
+            delete std::exchange(tail_, next);
+
+            return value;
+        }
+    };
+
+}  // namespace tiny_web_server::async
+
+#endif  // TINY_WEB_SERVER_MPSC_QUEUE_HPP
@@ -0,0 +1,210 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file reactor.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 13:02
+ * @brief 基于 epoll 的单线程反应器
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_REACTOR_HPP
+#define TINY_WEB_SERVER_REACTOR_HPP
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include "../platform.hpp"
+#include "mpsc_queue.hpp"
+
+namespace tiny_web_server::async {
+
+    /** @enum EventType
+     *
+     * @brief 事件类型枚举
+     * @details 可按位组合
+     */
+    enum class EventType : std::uint32_t {
+        NONE = 0,
+        /// 可读，对应EPOLLIN
+        READ = EPOLLIN,
+        /// 可写，对应EPOLLOUT
+        WRITE = EPOLLOUT,
+        /// 对端关闭写端，对应EPOLLRDHUP; 无需注册即上报的EPOLLHUP也映射到此
+        HANGUP = EPOLLRDHUP,
+        /// 错误，对应EPOLLERR
+        ERROR = EPOLLERR,
+        /// 边缘触发，对应EPOLLET
+        EDGE = EPOLLET
+    };
+
+    constexpr EventType operator|(EventType lhs, EventType rhs) noexcept {
+        return static_cast<EventType>(
+            static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs)
+        );
+    }
+
+    constexpr bool operator&(EventType lhs, EventType rhs) noexcept {
+        return (static_cast<std::uint32_t>(lhs) & static_cast<std::uint32_t>(rhs)) != 0;
+    }
+
+    /**
+     * @brief 混合忙轮询选项
+     * @details 开启后 @c runOnce 先以零超时反复轮询 epoll 至多 @c spin ，仍无事件才阻塞等待，
+     * 省去线程睡眠后被唤醒的调度延迟。自适应时自旋时长按近期事件间隔在 [0, spin] 内调整:
+     * 自旋落空时减半，阻塞后很快又有事件时增长到该间隔的两倍，空闲时不会持续占满 CPU。
+     */
+    struct BusyPollOptions {
+        /// 阻塞前自旋的最长时间，0 表示关闭
+        std::chrono::microseconds spin{0};
+
+        bool adaptive = true;
+
+        /// 内核在 epoll_wait 中轮询网卡队列的时间(EPIOCSPARAMS，Linux 6.9+)，0 表示不设置
+        std::uint32_t kernelPollUs = 0;
+
+        /// 每次内核轮询处理的数据包上限，0 表示内核默认值
+        std::uint16_t kernelPollBudget = 0;
+
+        /// 内核优先以忙轮询而非中断处理网卡队列
+        bool preferBusyPoll = false;
+    };
+
+    /**
+     * @brief 反应器
+     * @details 每个I/O线程持有一个反应器; 除 @c post 与 @c stop 外的方法只能在其运行线程中调用
+     */
+    struct Reactor {
+    public:
+        using Handler = std::function<void(EventType events)>;
+
+        using Task = std::function<void()>;
+
+    private:
+        int epoll_ = -1;
+
+        int wakeup_ = -1;
+
+        std::atomic<bool> running_ = false;
+
+        /// 最近一次处理事件的线程，事件循环开始前为空
+        std::atomic<std::thread::id> owner_;
+
+        std::unordered_map<socket_t, std::shared_ptr<Handler>> handlers_;
+
+        /// 跨线程投递的任务，无锁入队
+        MpscQueue<Task> tasks_;
+
+        /// 已有未处理的唤醒时为 true，合并多次投递的 eventfd 写入
+        std::atomic<bool> notified_ = false;
+
+        BusyPollOptions busyPoll_;
+
+        /// 当前的自旋时长，自适应时在 [0, busyPoll_.spin] 内变化
+        std::chrono::microseconds spin_{0};
+
+        /// 最近一次 epoll_wait 带着就绪事件返回的时刻
+        std::chrono::steady_clock::time_point polled_{};
+
+    public:
+        Reactor();
+
+        ~Reactor();
+
+        Reactor(const Reactor&)            = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        void add(socket_t handle, EventType events, Handler handler);
+
+        void modify(socket_t handle, EventType events) const;
+
+        void remove(socket_t handle);
+
+        /**
+         * @brief 投递任务到反应器线程执行(线程安全，无锁)
+         */
+        void post(Task task);
+
+        /**
+         * @brief 切换回反应器线程的等待体
+         * @details 如 @c co_await reactor.schedule() ，在工作线程完成计算后回到 I/O 线程;
+         * 已在反应器线程中时不挂起
+         */
+        auto schedule() noexcept {
+            struct Awaiter {
+                Reactor* reactor;
+
+                bool await_ready() const noexcept { return reactor->isInLoopThread(); }
+
+                void await_suspend(std::coroutine_handle<> handle) const {
+                    reactor->post([handle] { handle.resume(); });
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            return Awaiter{this};
+        }
+
+        /**
+         * @brief 运行事件循环直到 @c stop 被调用
+         */
+        void run();
+
+        /**
+         * @brief 处理一轮事件
+         * @param timeoutMs 等待超时，-1 表示一直等待
+         * @return 本轮处理的事件数(不含投递的任务)
+         */
+        std::size_t runOnce(int timeoutMs = -1);
+
+        /**
+         * @brief 设置混合忙轮询，只能在反应器线程中调用
+         * @return 内核是否接受了 epoll 忙轮询参数; 未要求内核轮询时返回 true
+         */
+        bool setBusyPoll(const BusyPollOptions& options);
+
+        /**
+         * @brief 停止事件循环(线程安全)
+         */
+        void stop();
+
+        /**
+         * @brief 当前线程是否为运行事件循环的线程
+         * @details 由 @c run / @c runOnce 记录; 事件循环开始前对任何线程(包括构造线程)都返回 false
+         */
+        [[nodiscard]] bool isInLoopThread() const noexcept;
+
+        /**
+         * @brief 本轮事件的到达时刻: epoll_wait 返回时取一次，同批事件共用
+         * @details 就绪数据最晚在此时已到达; 以它(而非处理器被调用的时刻)为排队起点，
+         * 同批中排在后面的连接等待前面处理器的时间也计入排队延迟。只能在反应器线程中调用
+         */
+        [[nodiscard]] std::chrono::steady_clock::time_point pollTime() const noexcept;
+
+    private:
+        /**
+         * @brief 等待并分发一轮事件
+         * @return 处理的事件数与执行的任务数
+         */
+        std::pair<std::size_t, std::size_t> poll(int timeoutMs);
+
+        void wakeup() const;
+
+        std::size_t runTasks();
+    };
+
+}  // namespace tiny_web_server::async
+
+#endif  // TINY_WEB_SERVER_REACTOR_HPP
@@ -0,0 +1,326 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file single_flight.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 04:20
+ * @brief 并发相同请求的合并执行
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_SINGLE_FLIGHT_HPP
+#define TINY_WEB_SERVER_SINGLE_FLIGHT_HPP
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "../metrics/metrics.hpp"
+#include "reactor.hpp"
+
+namespace tiny_web_server::async {
+
+    struct SingleFlightOptions {
+        /// 跟随者等待结果的最长时间，超时后收到 timed_out，可自行处理请求
+        std::chrono::milliseconds waitTimeout = std::chrono::seconds(5);
+
+        /// 一次执行的最长时间，超过后视为失效: 新的请求另起一次执行，旧的结果被丢弃
+        std::chrono::milliseconds flightTimeout = std::chrono::seconds(30);
+
+        /// 每次执行的跟随者上限，超出的请求收到 resource_unavailable_try_again
+        std::size_t maxWaiters = 4096;
+    };
+
+    /**
+     * @brief 合并并发的相同请求(single-flight)
+     * @details 同一键上第一个 @c join 的调用者成为领导者，执行实际工作(调用处理器或上游)
+     * 后以 @c complete 提交结果，或在工作抛出异常时以 @c fail 提交异常(@c execute 兼做两者);
+     * 执行期间到达的调用者成为跟随者，其回调连同共享的结果或异常被投递回各自的反应器线程执行，
+     * 结果只生成一次、不被拷贝。提交后键立即释放，之后的调用者另起一次执行。热点键缓存过期时，
+     * 后端只收到一次请求而不是一拥而上。
+     * 超时由 @c expire 驱动，应由任一线程周期性调用。回调可能在请求方连接关闭后到达，
+     * 应只捕获弱引用。所有方法都是线程安全的。
+     */
+    template<typename Key, typename Value, typename Hash = std::hash<Key>>
+    struct SingleFlight {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        using Result = std::shared_ptr<const Value>;
+
+        /**
+         * @brief 跟随者的回调，成功时 @p error 为空
+         * @details 领导者的工作抛出异常时 @p exception 为该异常，@p error 为 operation_canceled
+         */
+        using Callback = std::function<
+            void(std::error_code error, Result value, std::exception_ptr exception)>;
+
+        /**
+         * @brief 领导者提交结果的凭据
+         */
+        struct Ticket {
+            Key key;
+
+            std::uint64_t id;
+        };
+
+    private:
+        struct Waiter {
+            Reactor* reactor;
+
+            Callback callback;
+
+            Clock::time_point deadline;
+        };
+
+        struct Flight {
+            std::uint64_t id;
+
+            Clock::time_point deadline;
+
+            std::vector<Waiter> waiters;
+        };
+
+        SingleFlightOptions options_;
+
+        mutable std::mutex mutex_;
+
+        std::unordered_map<Key, Flight, Hash> flights_;
+
+        std::uint64_t nextId_ = 1;
+
+        metrics::Counter& leaders_;
+
+        metrics::Counter& followers_;
+
+        metrics::Counter& timeouts_;
+
+        metrics::Counter& rejected_;
+
+    public:
+        explicit SingleFlight(const SingleFlightOptions& options = {})
+            : options_(options)
+            , leaders_(counter("role=\"leader\""))
+            , followers_(counter("role=\"follower\""))
+            , timeouts_(counter("role=\"timeout\""))
+            , rejected_(counter("role=\"rejected\"")) {}
+
+        SingleFlight(const SingleFlight&)            = delete;
+        SingleFlight& operator=(const SingleFlight&) = delete;
+
+        /**
+         * @brief 加入键 @p key 上的执行
+         * @param reactor 调用者所在的反应器，跟随者的回调投递到这里
+         * @param callback 成为跟随者时在结果、超时或拒绝时被调用一次; 成为领导者时不会被调用
+         * @return 成为领导者时返回凭据，调用者须执行工作并 @c complete
+         */
+        std::optional<Ticket> join(
+            const Key& key, Reactor& reactor, Callback callback,
+            const Clock::time_point now = Clock::now()
+        ) {
+            std::unique_lock lock(mutex_);
+
+            auto it = flights_.find(key);
+
+            // 失效的执行不再接纳跟随者，由新的领导者取代
+            if (it != flights_.end() && now >= it->second.deadline) {
+                auto waiters = std::move(it->second.waiters);
+                flights_.erase(it);
+
+                lock.unlock();
+                notify(
+                    waiters, std::make_error_code(std::errc::timed_out), nullptr, nullptr
+                );
+                timeouts_.add(waiters.size());
+                lock.lock();
+
+                it = flights_.find(key);
+            }
+
+            if (it == flights_.end()) {
+                auto id = nextId_++;
+                flights_.emplace(key, Flight{id, now + options_.flightTimeout, {}});
+
+                leaders_.add();
+                return Ticket{key, id};
+            }
+
+            auto& flight = it->second;
+
+            if (flight.waiters.size() >= options_.maxWaiters) {
+                lock.unlock();
+
+                rejected_.add();
+                reactor.post([callback = std::move(callback)] {
+                    using enum std::errc;
+                    auto error = std::make_error_code(resource_unavailable_try_again);
+
+                    callback(error, nullptr, nullptr);
+                });
+
+                return std::nullopt;
+            }
+
+            auto deadline = std::min(now + options_.waitTimeout, flight.deadline);
+            flight.waiters.push_back({&reactor, std::move(callback), deadline});
+
+            followers_.add();
+            return std::nullopt;
+        }
+
+        /**
+         * @brief 提交结果并唤醒全部跟随者
+         * @param error 非空时跟随者收到该错误而不是结果
+         * @return 执行已失效(超时后被取代)时返回 false，结果被丢弃
+         */
+        bool complete(const Ticket& ticket, Result value, const std::error_code error = {}) {
+            return finish(ticket, error, std::move(value), nullptr);
+        }
+
+        bool complete(const Ticket& ticket, Value value) {
+            return complete(ticket, std::make_shared<const Value>(std::move(value)));
+        }
+
+        /**
+         * @brief 以领导者工作抛出的异常结束执行，每个跟随者都收到同一个异常
+         * @return 执行已失效时返回 false
+         */
+        bool fail(const Ticket& ticket, std::exception_ptr exception) {
+            auto error = std::make_error_code(std::errc::operation_canceled);
+
+            return finish(ticket, error, nullptr, std::move(exception));
+        }
+
+        /**
+         * @brief 执行领导者的工作并提交: 返回值以 @c complete 提交，异常以 @c fail 提交后重新抛出
+         * @details 保证工作抛出异常时键也被释放，跟随者不必等到超时
+         */
+        template<typename Work>
+        Result execute(const Ticket& ticket, Work&& work) {
+            Result value;
+
+            try {
+                value = std::make_shared<const Value>(std::forward<Work>(work)());
+            } catch (...) {
+                fail(ticket, std::current_exception());
+                throw;
+            }
+
+            complete(ticket, value);
+            return value;
+        }
+
+        /**
+         * @brief 使等待超时的跟随者与失效的执行超时，返回下一次需要调用的时刻
+         * @return 没有进行中的执行时返回空
+         */
+        std::optional<Clock::time_point> expire(const Clock::time_point now = Clock::now()) {
+            std::vector<Waiter> expired;
+            std::optional<Clock::time_point> next;
+
+            {
+                std::lock_guard lock(mutex_);
+
+                for (auto it = flights_.begin(); it != flights_.end();) {
+                    auto& flight = it->second;
+
+                    if (now >= flight.deadline) {
+                        std::ranges::move(flight.waiters, std::back_inserter(expired));
+                        it = flights_.erase(it);
+                        continue;
+                    }
+
+                    std::erase_if(flight.waiters, [&](Waiter& waiter) {
+                        if (now < waiter.deadline) return false;
+
+                        expired.push_back(std::move(waiter));
+                        return true;
+                    });
+
+                    next = std::min(next.value_or(flight.deadline), flight.deadline);
+
+                    for (const auto& waiter : flight.waiters)
+                        next = std::min(*next, waiter.deadline);
+
+                    ++it;
+                }
+            }
+
+            notify(expired, std::make_error_code(std::errc::timed_out), nullptr, nullptr);
+            timeouts_.add(expired.size());
+
+            return next;
+        }
+
+        /**
+         * @brief 进行中的执行数
+         */
+        [[nodiscard]] std::size_t size() const {
+            std::lock_guard lock(mutex_);
+            return flights_.size();
+        }
+
+    private:
+        static metrics::Counter& counter(const std::string_view labels) {
+            return metrics::Registry::global().counter(
+                "tws_single_flight_requests_total", "Coalesced requests by outcome", labels
+            );
+        }
+
+        /**
+         * @brief 移除执行并通知其跟随者
+         */
+        bool finish(
+            const Ticket& ticket, const std::error_code error, Result value,
+            std::exception_ptr exception
+        ) {
+            std::vector<Waiter> waiters;
+
+            {
+                std::lock_guard lock(mutex_);
+
+                auto it = flights_.find(ticket.key);
+                if (it == flights_.end() || it->second.id != ticket.id) return false;
+
+                waiters = std::move(it->second.waiters);
+                flights_.erase(it);
+            }
+
+            notify(waiters, error, value, exception);
+            return true;
+        }
+
+        /**
+         * @brief 把回调投递回各跟随者的反应器
+         */
+        static void notify(
+            std::vector<Waiter>& waiters, std::error_code error, const Result& value,
+            const std::exception_ptr& exception
+        ) {
+            for (auto& waiter : waiters) {
+                waiter.reactor->post(
+                    [callback = std::move(waiter.callback), error, value, exception] {
+                        callback(error, value, exception);
+                    }
+                );
+            }
+        }
+    };
+
+}  // namespace tiny_web_server::async
+
+#endif  // TINY_WEB_SERVER_SINGLE_FLIGHT_HPP
@@ -0,0 +1,113 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file spsc_ring.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:10
+ * @brief 单生产者单消费者环形缓冲区
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_SPSC_RING_HPP
+#define TINY_WEB_SERVER_SPSC_RING_HPP
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace tiny_web_server::async {
+
+    /**
+     * @brief 有界无锁单生产者单消费者环形缓冲区
+     * @details 容量为2的幂，元素按值存放在连续数组中，不做任何分配。
+     * 生产者与消费者的位置各占一条缓存行，并各自缓存对方的位置，
+     * 只在看似已满/已空时才读取对方的原子变量，减少缓存行往返。
+     */
+    template<typename T, std::size_t Capacity>
+    struct SpscRing {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0);
+        static_assert(std::is_trivially_copyable_v<T>);
+
+    private:
+        static constexpr std::size_t MASK = Capacity - 1;
+
+        /// 生产者写入
+        alignas(64) std::atomic<std::size_t> tail_ = 0;
+
+        std::size_t cachedHead_ = 0;
+
+        /// 消费者写入
+        alignas(64) std::atomic<std::size_t> head_ = 0;
+
+        std::size_t cachedTail_ = 0;
+
+        alignas(64) std::array<T, Capacity> slots_;
+
+    public:
+        /**
+         * @brief 仅生产者线程调用
+         * @return 已满时返回 false，不等待
+         */
+        bool tryPush(const T& value) noexcept {
+            auto tail = tail_.load(std::memory_order_relaxed);
+
+            if (tail - cachedHead_ == Capacity) {
+                cachedHead_ = head_.load(std::memory_order_acquire);
+
+                if (tail - cachedHead_ == Capacity) return false;
+            }
+
+            slots_[tail & MASK] = value;
+            tail_.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief 仅消费者线程调用，批量取出
+         * @param consume 以每个元素的常引用调用
+         * @return 取出的元素数
+         */
+        template<typename F>
+        std::size_t drain(F&& consume, std::size_t max = Capacity) {
+            auto head = head_.load(std::memory_order_relaxed);
+
+            if (cachedTail_ == head) {
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+
+                if (cachedTail_ == head) return 0;
+            }
+
+            auto count = cachedTail_ - head;
+            if (count > max) count = max;
+
+            for (std::size_t i = 0; i < count; ++i) consume(slots_[(head + i) & MASK]);
+
+            head_.store(head + count, std::memory_order_release);
+
+            return count;
+        }
+
+        /**
+         * @brief 近似的当前元素数，任意线程调用
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            // 先读消费者位置，保证结果不会为负
+            auto head = head_.load(std::memory_order_acquire);
+
+            return tail_.load(std::memory_order_acquire) - head;
+        }
+
+        [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Capacity; }
+    };
+
+}  // namespace tiny_web_server::async
+
+#endif  // TINY_WEB_SERVER_SPSC_RING_HPP
@@ -19,6 +19,7 @@
 
 #include "tws/utils/fstr.h"
 #include <format>
+#include <stdexcept>
 #include <system_error>
 
 namespace tiny_web_server {
@@ -58,6 +59,35 @@ namespace tiny_web_server {
               ) {}
     };
 
+    template<auto...>
+    struct HttpError;
+
+    template<>
+    struct HttpError<> : std::runtime_error {
+        explicit HttpError(std::string_view message)
+            : std::runtime_error(std::format("HttpError: {}", message)) {}
+    };
+
+    template<FStrChar M>
+    struct HttpError<M> : std::runtime_error {
+        HttpError()
+            : std::runtime_error(
+                  std::format("HttpError: {}", std::string{M.data.data(), M.size})
+              ) {}
+    };
+
+    template<auto...>
+    struct LogError;
+
+    template<>
+    struct LogError<> : std::system_error {
+        LogError(int errc, std::string_view operation)
+            : std::system_error(
+                  errc, std::system_category(),
+                  std::format("LogError: Log operation '{}' failed", operation)
+              ) {}
+    };
+
 }  // namespace tiny_web_server
 
 #endif  // TINY_WEB_SERVER_EXCEPTION_HPP
@@ -0,0 +1,95 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file admission.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 20:20
+ * @brief 过载保护
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_ADMISSION_HPP
+#define TINY_WEB_SERVER_ADMISSION_HPP
+#pragma once
+
+#include <span>
+
+#include "connection_pool.hpp"
+
+namespace tiny_web_server::http {
+
+    struct AdmissionOptions {
+        /// 可接受的排队延迟; 一个窗口内的最小排队延迟超过它即视为过载
+        Clock::duration target = std::chrono::milliseconds(5);
+
+        /// 观察窗口，也是非过载时请求允许排队的上限
+        Clock::duration interval = std::chrono::milliseconds(100);
+    };
+
+    /**
+     * @brief CoDel 风格的准入控制，每个 I/O 线程一个，非线程安全
+     * @details 以请求从数据到达到开始处理之间的排队延迟为信号。若一个窗口内的最小延迟
+     * 仍高于 @c target ，说明队列不是偶发突发而是持续积压，进入过载状态:
+     * 排队超过 @c target 的请求直接以 503 拒绝，并暂停在监听套接字上 accept，
+     * 让新连接留在内核的积压队列(满后由内核拒绝)，而不是在用户态越积越多。
+     * 非过载时只拒绝排队超过 @c interval 的请求。没有样本的窗口视为已恢复。
+     */
+    struct AdmissionController {
+    private:
+        AdmissionOptions options_;
+
+        Clock::time_point windowEnd_{};
+
+        Clock::duration minDelay_ = Clock::duration::max();
+
+        bool overloaded_ = false;
+
+        std::uint64_t shed_ = 0;
+
+    public:
+        explicit AdmissionController(const AdmissionOptions& options = {});
+
+        ~AdmissionController();
+
+        AdmissionController(const AdmissionController&)            = delete;
+        AdmissionController& operator=(const AdmissionController&) = delete;
+
+        /**
+         * @brief 记录一个排队延迟样本并决定是否受理
+         * @param queued 请求数据到达(或入队)的时刻
+         * @return false 时应以 @c overloadResponse 拒绝并关闭连接
+         */
+        bool admit(Clock::time_point queued, Clock::time_point now = Clock::now()) noexcept;
+
+        /**
+         * @brief 以连接最近一次收到数据的时刻为排队起点
+         * @details 该时刻应取自事件到达时(如 @c Reactor::pollTime )，而不是读取数据时，
+         * 否则排队延迟只剩解析耗时，永远不会进入过载
+         */
+        bool
+        admit(const Connection& connection, Clock::time_point now = Clock::now()) noexcept;
+
+        /**
+         * @brief 是否应暂停 accept; 同时推进观察窗口，使空闲后能退出过载
+         */
+        [[nodiscard]] bool overloaded(Clock::time_point now = Clock::now()) noexcept;
+
+        [[nodiscard]] std::uint64_t shed() const noexcept;
+
+        /**
+         * @brief 预先构造的 503 响应，带 Retry-After 与 Connection: close
+         */
+        [[nodiscard]] static std::span<const std::byte> overloadResponse() noexcept;
+
+    private:
+        void advance(Clock::time_point now) noexcept;
+    };
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_ADMISSION_HPP
@@ -0,0 +1,265 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file body.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 02:10
+ * @brief 流式接收请求体
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_BODY_HPP
+#define TINY_WEB_SERVER_BODY_HPP
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include "../net/socket.hpp"
+#include "request.hpp"
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 请求体的分帧方式，由 Transfer-Encoding 与 Content-Length 决定(RFC 9112 6.3)
+     */
+    struct BodyFraming {
+        enum class Type {
+            /// 没有请求体
+            NONE,
+            /// 由 Content-Length 给出长度
+            LENGTH,
+            /// 分块传输编码
+            CHUNKED,
+            /// 无法确定边界，应以 400 响应并关闭连接
+            INVALID
+        };
+
+        Type type = Type::NONE;
+
+        std::uint64_t length = 0;
+
+        /**
+         * @details 同时出现 Transfer-Encoding 与 Content-Length、传输编码不是单独的 chunked、
+         * HTTP/1.0 使用 Transfer-Encoding，或多个 Content-Length 不一致时都视为无效，
+         * 以免与前置代理对请求边界的理解不同(请求走私)
+         */
+        static BodyFraming of(const Request& request) noexcept;
+    };
+
+    /**
+     * @brief 增量分块传输编码解码器
+     * @details 逐字节处理分块头、扩展与尾部字段，数据部分按段整体返回而不复制;
+     * 输入可以在任意位置被截断。行尾必须为 CRLF，单行与尾部字段的长度有上限。
+     */
+    struct ChunkedDecoder {
+    public:
+        enum class Status { INCOMPLETE, COMPLETE, ERROR };
+
+        struct Result {
+            /// 消耗的输入字节数，包含分块帧
+            std::size_t consumed = 0;
+
+            /// 本次解出的数据，指向输入
+            std::span<const std::byte> data;
+
+            Status status = Status::INCOMPLETE;
+        };
+
+        /// 分块扩展所在行与单个尾部字段的长度上限
+        static constexpr std::size_t MAX_LINE_SIZE = 4096;
+
+        /// 尾部字段的总长度上限
+        static constexpr std::size_t MAX_TRAILER_SIZE = 8192;
+
+    private:
+        enum class State {
+            SIZE,
+            EXTENSION,
+            SIZE_LF,
+            DATA,
+            DATA_CR,
+            DATA_LF,
+            TRAILER,
+            TRAILER_LF,
+            DONE,
+            ERROR
+        };
+
+        State state_ = State::SIZE;
+
+        /// 当前分块剩余的数据字节数; 在 SIZE 状态下为正在解析的分块大小
+        std::uint64_t remaining_ = 0;
+
+        int digits_ = 0;
+
+        std::size_t lineSize_ = 0;
+
+        std::size_t trailerSize_ = 0;
+
+    public:
+        /**
+         * @brief 解码到下一段数据或输入结束为止
+         * @details 每次最多返回一段数据，调用者处理后以剩余输入继续调用
+         */
+        Result decode(std::span<const std::byte> input) noexcept;
+
+        /**
+         * @brief 当前分块中尚未到达的数据字节数，不在数据部分时为0
+         * @details 这部分数据可以绕过接收缓冲区直接搬运，之后以 @c skip 告知解码器
+         */
+        [[nodiscard]] std::uint64_t pendingData() const noexcept;
+
+        /**
+         * @param count 不超过 @c pendingData
+         */
+        void skip(std::uint64_t count) noexcept;
+
+        /**
+         * @brief 是否已读到结尾的空分块与尾部字段
+         */
+        [[nodiscard]] bool done() const noexcept;
+
+        void reset() noexcept;
+    };
+
+    /**
+     * @brief 单个请求体的流式读取状态
+     * @details 不持有任何缓冲区: 调用者把接收缓冲区中的数据交给 @c read 并消费返回的数据段;
+     * 缓冲区为空时可按 @c directBytes 直接从套接字搬运数据(如 @c UploadFile::splice)，
+     * 再以 @c advance 记账。因此每个连接的内存占用只是其固定大小的接收缓冲区。
+     */
+    struct BodyReader {
+    public:
+        enum class Status {
+            INCOMPLETE,
+            COMPLETE,
+            /// 分帧错误，应以 400 响应
+            ERROR,
+            /// 超过上限，应以 413 响应
+            TOO_LARGE
+        };
+
+        struct Result {
+            std::size_t consumed = 0;
+
+            std::span<const std::byte> data;
+
+            Status status = Status::INCOMPLETE;
+        };
+
+    private:
+        BodyFraming framing_;
+
+        std::uint64_t maxSize_;
+
+        /// LENGTH 模式下剩余的字节数
+        std::uint64_t remaining_ = 0;
+
+        std::uint64_t received_ = 0;
+
+        ChunkedDecoder chunked_;
+
+        Status status_ = Status::INCOMPLETE;
+
+    public:
+        explicit BodyReader(
+            BodyFraming framing,
+            std::uint64_t maxSize = std::numeric_limits<std::uint64_t>::max()
+        ) noexcept;
+
+        Result read(std::span<const std::byte> input) noexcept;
+
+        /**
+         * @brief 接收缓冲区为空时可以直接读取的请求体字节数
+         */
+        [[nodiscard]] std::uint64_t directBytes() const noexcept;
+
+        /**
+         * @brief 记录绕过 @c read 直接读取的字节数
+         * @param count 不超过 @c directBytes
+         */
+        void advance(std::uint64_t count) noexcept;
+
+        [[nodiscard]] Status status() const noexcept;
+
+        [[nodiscard]] bool complete() const noexcept;
+
+        /**
+         * @brief 已读取的请求体字节数(不含分块帧)
+         */
+        [[nodiscard]] std::uint64_t received() const noexcept;
+    };
+
+    /**
+     * @brief 保存上传数据的文件
+     * @details 在指定目录中以随机名称独占创建; 未调用 @c keep 时析构会删除文件。
+     * Linux 上 @c splice 经由一个管道把套接字中的数据搬进文件，数据不进入用户态。
+     */
+    struct UploadFile {
+    private:
+        int fd_ = -1;
+
+        std::filesystem::path path_;
+
+        std::uint64_t size_ = 0;
+
+        bool keep_ = false;
+
+        /// splice 的中转管道，首次使用时创建
+        int pipe_[2]{-1, -1};
+
+        UploadFile() = default;
+
+    public:
+        /**
+         * @throw HttpError 无法创建文件时
+         */
+        static UploadFile create(const std::filesystem::path& directory);
+
+        ~UploadFile();
+
+        UploadFile(UploadFile&& other) noexcept;
+        UploadFile(const UploadFile&) = delete;
+
+        UploadFile& operator=(UploadFile&& other) noexcept;
+        UploadFile& operator=(const UploadFile&) = delete;
+
+        /**
+         * @throw HttpError 写入失败(如磁盘已满)时
+         */
+        void write(std::span<const std::byte> data);
+
+        /**
+         * @brief 从非阻塞套接字直接搬运最多 @p count 字节到文件
+         * @details 单次最多搬运一个管道容量，返回前管道总是被排空;
+         * 不支持 splice 的平台经由栈上的临时缓冲区复制
+         * @return 套接字暂无数据时返回空，对端关闭时返回0
+         * @throw HttpError 写入失败时
+         */
+        std::optional<std::size_t> splice(const net::Socket& socket, std::uint64_t count);
+
+        [[nodiscard]] const std::filesystem::path& path() const noexcept;
+
+        [[nodiscard]] std::uint64_t size() const noexcept;
+
+        /**
+         * @brief 保留文件，析构时只关闭不删除
+         */
+        void keep() noexcept;
+
+    private:
+        void close() noexcept;
+    };
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_BODY_HPP
@@ -0,0 +1,145 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file compression_cache.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 10:48
+ * @brief 动态响应压缩缓存
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_COMPRESSION_CACHE_HPP
+#define TINY_WEB_SERVER_COMPRESSION_CACHE_HPP
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "content_encoding.hpp"
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 以内容哈希为键的压缩结果缓存
+     * @details 未命中时不阻塞调用者: 原文被拷贝到后台线程压缩，本次请求按原文返回，
+     * 之后相同内容的请求直接命中缓存。缓存按字节数做LRU淘汰。
+     * 哈希带每个缓存随机生成的种子，且命中时逐字节比较保存的原文，
+     * 哈希碰撞(包括刻意构造的)不会把一份内容的压缩结果发给另一份内容。
+     */
+    struct CompressionCache {
+    public:
+        using Buffer = std::shared_ptr<const std::vector<std::byte>>;
+
+    private:
+        struct Key {
+            std::uint64_t hash;
+            std::size_t size;
+            ContentEncoding encoding;
+
+            bool operator==(const Key&) const = default;
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const Key& key) const noexcept {
+                return key.hash ^ (key.size << 3) ^ static_cast<std::size_t>(key.encoding);
+            }
+        };
+
+        struct Job {
+            Key key;
+            Buffer content;
+        };
+
+        struct Entry {
+            Key key;
+
+            /// 原文，命中时用于确认内容确实相同
+            Buffer original;
+
+            /// 为空表示不值得压缩
+            Buffer compressed;
+        };
+
+        using LruList = std::list<Entry>;
+
+        mutable std::mutex mutex_;
+
+        std::condition_variable cv_;
+
+        LruList lru_;
+
+        std::unordered_map<Key, LruList::iterator, KeyHash> entries_;
+
+        std::unordered_set<Key, KeyHash> pending_;
+
+        std::deque<Job> jobs_;
+
+        std::size_t capacity_;
+
+        std::size_t used_ = 0;
+
+        std::size_t maxPending_;
+
+        std::uint64_t seed_;
+
+        int level_;
+
+        bool stopping_ = false;
+
+        std::vector<std::jthread> workers_;
+
+    public:
+        /**
+         * @param capacity 缓存压缩结果的总字节上限
+         * @param workers 后台压缩线程数
+         * @param maxPending 等待压缩的任务上限，超出时直接放弃压缩
+         * @param level 压缩等级，-1 表示默认
+         */
+        explicit CompressionCache(
+            std::size_t capacity = 64 << 20, std::size_t workers = 1,
+            std::size_t maxPending = 256, int level = -1
+        );
+
+        ~CompressionCache();
+
+        CompressionCache(const CompressionCache&)            = delete;
+        CompressionCache& operator=(const CompressionCache&) = delete;
+
+        /**
+         * @brief 查找压缩结果，未命中时安排后台压缩
+         * @return 命中时返回压缩数据，否则返回 @c nullptr (调用者应发送原文)
+         */
+        [[nodiscard]] Buffer
+        find(std::span<const std::byte> content, ContentEncoding encoding);
+
+        /**
+         * @brief 协商并查找: 从客户端可接受且本构建支持的编码中选择最优者
+         * @return 编码与数据; 未命中或无可用编码时编码为 @c IDENTITY
+         */
+        [[nodiscard]] std::pair<ContentEncoding, Buffer>
+        find(std::span<const std::byte> content, const AcceptEncoding& accept);
+
+        [[nodiscard]] std::size_t size() const;
+
+        void clear();
+
+    private:
+        void work(const std::stop_token& token);
+
+        void insert(const Key& key, Buffer original, Buffer compressed);
+    };
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_COMPRESSION_CACHE_HPP
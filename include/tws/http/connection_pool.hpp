@@ -0,0 +1,258 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file connection_pool.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:10
+ * @brief HTTP 连接状态池
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_CONNECTION_POOL_HPP
+#define TINY_WEB_SERVER_CONNECTION_POOL_HPP
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include "../metrics/trace.hpp"
+#include "../net/socket.hpp"
+#include "../utils/intrusive_list.hpp"
+#include "../utils/slab.hpp"
+#include "context.hpp"
+
+namespace tiny_web_server::http {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Connection;
+
+    /**
+     * @brief 防御慢速客户端(slowloris)与空闲连接的限制
+     * @details 所有时限都由 @c ConnectionPool::sweep 的粗粒度扫描检查，不为每个连接设定时器;
+     * 实际生效时间比设定值最多晚一个扫描周期。
+     */
+    struct ConnectionLimits {
+        /// keep-alive 空闲超时
+        Clock::duration idleTimeout = std::chrono::seconds(60);
+
+        /// 从开始接收请求到头部接收完整的最长时间
+        Clock::duration headerTimeout = std::chrono::seconds(10);
+
+        /// 接收头部或请求体期间的最低平均速率(字节/秒)，0 表示不限制
+        std::uint64_t minReceiveRate = 256;
+
+        /// 开始接收后经过此时间才检查速率，给握手与慢启动留出余地
+        Clock::duration rateGracePeriod = std::chrono::seconds(2);
+
+        std::size_t maxHeaderSize = 8192;
+
+        std::size_t maxHeaderCount = 100;
+
+        /**
+         * @brief 正在接收的连接是否已超过头部时限或低于速率下限
+         */
+        [[nodiscard]] bool
+        violated(const Connection& connection, Clock::time_point now) const;
+    };
+
+    /**
+     * @brief 单个 HTTP 连接的全部状态
+     * @details 套接字、解析器、请求作用域、接收缓冲区与计时节点放在同一个槽位中，
+     * 避免分散分配与指针跳转; 频繁访问的字段在前，缓冲区在后。
+     */
+    struct Connection : ListHook<> {
+        static constexpr std::size_t BUFFER_SIZE = 8192;
+
+        net::Socket socket;
+
+        /// 所在链表中按此时间排序，兼作超时计时节点
+        Clock::time_point lastActivity;
+
+        /// 空闲(等待下一个 keep-alive 请求)或活跃(正在接收或处理请求)
+        bool idle = false;
+
+        std::size_t received = 0;
+
+        /// 当前请求开始接收的时刻，不在接收阶段(处理、发送或空闲)时为默认值
+        Clock::time_point readStart;
+
+        /// 自 @c readStart 起收到的字节数
+        std::uint64_t readBytes = 0;
+
+        /// 追踪开启时记录当前请求的各阶段时间点，请求结束时提交
+        metrics::RequestTrace trace;
+
+        RequestParser parser;
+
+        RequestContext context;
+
+        std::array<std::byte, BUFFER_SIZE> buffer;
+
+        Connection(
+            net::Socket socket, Clock::time_point now, const ConnectionLimits& limits
+        );
+
+        /**
+         * @brief 开始接收一个请求，速率与头部时限从 @p now 起算
+         * @details 已在缓冲区中的流水线数据计入已接收字节
+         */
+        void beginRead(Clock::time_point now) noexcept;
+
+        /**
+         * @brief 请求已接收完整，进入处理阶段，不再受速率限制
+         */
+        void endRead() noexcept;
+
+        [[nodiscard]] bool reading() const noexcept;
+
+        /**
+         * @brief 已接收但尚未消费的数据
+         */
+        [[nodiscard]] std::string_view data() const noexcept;
+    };
+
+    /**
+     * @brief 连接池
+     * @details 连接按所属反应器各建一个池，槽位来自缓存行对齐的 @c Slab ;
+     * 空闲与活跃连接各在一条侵入式链表中，并按最近活动时间排序，超时扫描只需从表头开始。
+     * 外部保存的是带代数的句柄，连接关闭后再使用旧句柄会得到空指针而非悬垂指针。
+     */
+    struct ConnectionPool {
+    public:
+        using Handle = Slab<Connection>::Handle;
+
+    private:
+        Slab<Connection> slab_;
+
+        ConnectionLimits limits_;
+
+        IntrusiveList<Connection> idle_;
+
+        IntrusiveList<Connection> active_;
+
+    public:
+        /**
+         * @param maxConnections 最大连接数，0 表示不限制
+         */
+        explicit ConnectionPool(
+            std::size_t maxConnections = 0, const ConnectionLimits& limits = {}
+        );
+
+        ~ConnectionPool();
+
+        ConnectionPool(const ConnectionPool&)            = delete;
+        ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+        /**
+         * @brief 接管新连接，初始为活跃状态
+         * @return 连接数已满时返回无效句柄，@p socket 随之关闭
+         */
+        Handle open(net::Socket socket, Clock::time_point now = Clock::now());
+
+        /**
+         * @brief 接管新连接; 已满时先淘汰最久未活动的空闲连接
+         * @param onEvict 淘汰前以被淘汰的连接调用，如从反应器中移除
+         * @return 已满且没有空闲连接可淘汰时返回无效句柄
+         */
+        template<typename F>
+        Handle open(net::Socket socket, Clock::time_point now, F&& onEvict) {
+            if (slab_.size() >= slab_.maxSize()) {
+                auto* oldest = idle_.front();
+                if (!oldest) return {};
+
+                onEvict(*oldest);
+                close(handle(*oldest));
+                countEvictions("capacity", 1);
+            }
+
+            return open(std::move(socket), now);
+        }
+
+        [[nodiscard]] Connection* get(Handle handle) noexcept;
+
+        [[nodiscard]] Handle handle(const Connection& connection) const noexcept;
+
+        /**
+         * @brief 记录活动，并按 @p idle 移入对应链表的末尾
+         * @details 由空闲转为活跃时开始接收新请求(@c beginRead)，转为空闲时结束接收
+         */
+        void touch(Connection& connection, bool idle, Clock::time_point now = Clock::now());
+
+        void close(Handle handle);
+
+        [[nodiscard]] Connection* oldestIdle() const noexcept;
+
+        /**
+         * @brief 关闭空闲超过 @p timeout 的连接
+         * @param onExpire 关闭前以连接调用，如从反应器中移除
+         * @return 关闭的连接数
+         */
+        template<typename F>
+        std::size_t
+        expireIdle(Clock::time_point now, Clock::duration timeout, F&& onExpire) {
+            std::size_t expired = 0;
+
+            while (auto* connection = idle_.front()) {
+                if (now - connection->lastActivity < timeout) break;
+
+                onExpire(*connection);
+                close(handle(*connection));
+
+                ++expired;
+            }
+
+            return expired;
+        }
+
+        /**
+         * @brief 粗粒度扫描: 关闭空闲超时的连接，以及超过头部时限或低于速率下限的接收中连接
+         * @details 空闲链表按活动时间有序，只扫描到第一个未超时的连接; 活跃链表需完整遍历，
+         * 建议每秒左右调用一次
+         * @param onExpire 关闭前以连接调用，如从反应器中移除
+         * @return 关闭的连接数
+         */
+        template<typename F>
+        std::size_t sweep(Clock::time_point now, F&& onExpire) {
+            auto idle = expireIdle(now, limits_.idleTimeout, onExpire);
+
+            std::size_t slow = 0;
+
+            for (auto it = active_.begin(); it != active_.end();) {
+                auto& connection = *it;
+                ++it;
+
+                if (!limits_.violated(connection, now)) continue;
+
+                onExpire(connection);
+                close(handle(connection));
+
+                ++slow;
+            }
+
+            countEvictions("idle", idle);
+            countEvictions("slow", slow);
+
+            return idle + slow;
+        }
+
+        [[nodiscard]] const ConnectionLimits& limits() const noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] std::size_t idleCount() const noexcept;
+
+        [[nodiscard]] std::size_t activeCount() const noexcept;
+
+    private:
+        static void countEvictions(std::string_view reason, std::size_t count);
+    };
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_CONNECTION_POOL_HPP
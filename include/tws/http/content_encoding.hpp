@@ -0,0 +1,90 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file content_encoding.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 10:20
+ * @brief 内容编码协商与压缩
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_CONTENT_ENCODING_HPP
+#define TINY_WEB_SERVER_CONTENT_ENCODING_HPP
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace tiny_web_server::http {
+
+    /** @enum ContentEncoding
+     *
+     * @brief 内容编码枚举
+     * @details 枚举值的顺序即服务端的偏好顺序(越靠后压缩率越高)
+     */
+    enum class ContentEncoding : std::uint8_t {
+        /// 不压缩
+        IDENTITY,
+        /// gzip，对应 .gz
+        GZIP,
+        /// zstd，对应 .zst
+        ZSTD,
+        /// brotli，对应 .br
+        BROTLI
+    };
+
+    [[nodiscard]] std::string_view toString(ContentEncoding encoding) noexcept;
+
+    /**
+     * @brief 预压缩文件的后缀名
+     * @details 对于 @c IDENTITY 返回空串
+     */
+    [[nodiscard]] std::string_view extension(ContentEncoding encoding) noexcept;
+
+    /**
+     * @brief 当前构建是否支持在线压缩该编码
+     */
+    [[nodiscard]] bool isSupported(ContentEncoding encoding) noexcept;
+
+    /**
+     * @brief Accept-Encoding 请求头
+     * @details 解析q值，未出现的编码视为不可接受，@c identity 默认可接受(除非显式 q=0)
+     */
+    struct AcceptEncoding {
+    private:
+        std::array<std::uint16_t, 4> quality_{1000, 0, 0, 0};
+
+    public:
+        AcceptEncoding() = default;
+
+        AcceptEncoding(std::string_view header);
+
+        [[nodiscard]] bool accepts(ContentEncoding encoding) const noexcept;
+
+        /**
+         * @brief 从可用编码中选出客户端最偏好的一个
+         * @details q值相同时取服务端偏好靠前者; 均不可接受时返回 @c IDENTITY
+         */
+        [[nodiscard]] ContentEncoding
+        select(std::span<const ContentEncoding> available) const noexcept;
+    };
+
+    /**
+     * @brief 压缩数据
+     * @param level 压缩等级，-1 表示使用各算法的默认值
+     * @throw HttpError 当编码不被支持或压缩失败时
+     */
+    [[nodiscard]] std::vector<std::byte>
+    compress(std::span<const std::byte> data, ContentEncoding encoding, int level = -1);
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_CONTENT_ENCODING_HPP
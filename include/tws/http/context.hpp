@@ -0,0 +1,64 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file context.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:40
+ * @brief 请求作用域
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_CONTEXT_HPP
+#define TINY_WEB_SERVER_CONTEXT_HPP
+#pragma once
+
+#include <array>
+
+#include "../utils/arena.hpp"
+#include "request.hpp"
+#include "response.hpp"
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 单个请求的作用域
+     * @details 解析出的请求、处理器的临时数据与响应头都从同一个 @c Arena 分配，
+     * 常见请求完全落在内联缓冲区中; 请求结束时 @c reset 一次性回收。
+     * 处理器可通过 @c resource 构造自己的 pmr 容器。
+     */
+    struct RequestContext {
+    public:
+        static constexpr std::size_t INLINE_SIZE = 2048;
+
+    private:
+        /// 必须先于 arena 构造
+        alignas(std::max_align_t) std::array<std::byte, INLINE_SIZE> inline_;
+
+    public:
+        Arena arena;
+
+        Request request;
+
+        ResponseBuilder response;
+
+        RequestContext() noexcept;
+
+        RequestContext(const RequestContext&)            = delete;
+        RequestContext& operator=(const RequestContext&) = delete;
+
+        [[nodiscard]] std::pmr::memory_resource* resource() noexcept;
+
+        /**
+         * @brief 结束当前请求，为同一连接上的下一个请求复位
+         */
+        void reset() noexcept;
+    };
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_CONTEXT_HPP
@@ -0,0 +1,86 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file range.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 11:52
+ * @brief Range 请求头解析
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_RANGE_HPP
+#define TINY_WEB_SERVER_RANGE_HPP
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 字节区间
+     * @details 已根据文件大小解析为绝对偏移，长度不为0
+     */
+    struct ByteRange {
+        std::uint64_t offset;
+
+        std::uint64_t length;
+
+        [[nodiscard]] std::uint64_t last() const noexcept { return offset + length - 1; }
+
+        bool operator==(const ByteRange&) const = default;
+    };
+
+    struct RangeSet {
+        /** @enum Status
+         *
+         * @brief 解析结果
+         */
+        enum class Status {
+            /// 无 Range 头或格式无法识别，按完整内容(200)响应
+            IGNORED,
+            /// 至少一个区间可满足，按 206 响应
+            SATISFIABLE,
+            /// 所有区间都超出文件大小，按 416 响应
+            UNSATISFIABLE
+        };
+
+        Status status = Status::IGNORED;
+
+        /// 按偏移排序且已合并重叠/相邻区间
+        std::vector<ByteRange> ranges;
+    };
+
+    /**
+     * @brief 解析 Range 请求头
+     * @param size 完整内容的字节数
+     * @param maxRanges 合并后允许的最大区间数，超出时忽略 Range (防止大量碎片区间的放大攻击)
+     */
+    [[nodiscard]] RangeSet
+    parseRange(std::string_view header, std::uint64_t size, std::size_t maxRanges = 16);
+
+    /**
+     * @brief 生成 Content-Range 的值，如 @c bytes 0-99/1000
+     */
+    [[nodiscard]] std::string contentRange(const ByteRange& range, std::uint64_t size);
+
+    /**
+     * @brief 评估 If-Range (RFC 9110 13.1.5): 为真时 Range 生效，否则应发送完整内容
+     * @details 实体标签按强比较，弱标签永不匹配; 日期须与当前 Last-Modified 逐字节相同
+     * @param etag 当前表示的强 ETag (含引号)，没有时为空
+     * @param lastModified 当前表示的 Last-Modified，没有时为空
+     */
+    [[nodiscard]] bool ifRangeMatches(
+        std::string_view ifRange, std::string_view etag, std::string_view lastModified
+    ) noexcept;
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_RANGE_HPP
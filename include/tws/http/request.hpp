@@ -0,0 +1,126 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file request.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 13:40
+ * @brief HTTP/1.x 请求头解析
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_REQUEST_HPP
+#define TINY_WEB_SERVER_REQUEST_HPP
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace tiny_web_server::http {
+
+    struct Header {
+        std::string_view name;
+
+        std::string_view value;
+    };
+
+    /**
+     * @brief 请求头
+     * @details 所有视图都指向接收缓冲区，缓冲区被移动或覆盖前有效;
+     * 头部列表从构造时给定的内存资源(通常为请求级 @c Arena )分配
+     */
+    struct Request {
+        std::string_view method;
+
+        std::string_view target;
+
+        /// HTTP/1.x 中的 x
+        int versionMinor = 1;
+
+        std::pmr::vector<Header> headers;
+
+        Request() = default;
+
+        explicit Request(std::pmr::memory_resource* resource);
+
+        /**
+         * @brief 按名称查找请求头(不区分大小写)
+         * @return 不存在时返回空视图
+         */
+        [[nodiscard]] std::string_view header(std::string_view name) const noexcept;
+
+        /**
+         * @brief 逗号分隔的请求头值中是否包含某个记号(不区分大小写)
+         * @details 如 @c Connection: keep-alive, Upgrade 中的 @c upgrade
+         */
+        [[nodiscard]] bool
+        hasToken(std::string_view name, std::string_view token) const noexcept;
+
+        [[nodiscard]] bool keepAlive() const noexcept;
+
+        void clear() noexcept;
+    };
+
+    /**
+     * @brief 增量请求头解析器
+     * @details 每次传入从请求起始处开始的全部已接收数据; 解析器记住已扫描的位置，
+     * 数据分多次到达时不会重复查找头部结束标记
+     */
+    struct RequestParser {
+    public:
+        /** @enum Status
+         *
+         * @brief 解析结果
+         */
+        enum class Status {
+            /// 头部尚未接收完整
+            INCOMPLETE,
+            /// 解析完成，@c headerLength 为头部(含结尾空行)的字节数
+            COMPLETE,
+            /// 格式错误、头部过大或字段过多，应以 400/431 响应并关闭连接
+            ERROR
+        };
+
+    private:
+        std::size_t scanned_ = 0;
+
+        std::size_t headerLength_ = 0;
+
+        std::size_t maxHeaderSize_;
+
+        std::size_t maxHeaderCount_;
+
+        /// 同一请求多次 parse 调用的累计耗时
+        std::chrono::steady_clock::duration elapsed_{};
+
+    public:
+        explicit RequestParser(
+            std::size_t maxHeaderSize = 8192, std::size_t maxHeaderCount = 100
+        );
+
+        /**
+         * @brief 解析完成时把累计耗时记入 @c tws_parse_duration_seconds
+         */
+        Status parse(std::string_view data, Request& request);
+
+        [[nodiscard]] std::size_t headerLength() const noexcept;
+
+        /**
+         * @brief 为同一连接上的下一个请求复位
+         */
+        void reset() noexcept;
+
+    private:
+        Status parseHeader(std::string_view data, Request& request);
+    };
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_REQUEST_HPP
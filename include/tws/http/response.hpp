@@ -0,0 +1,152 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file response.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:40
+ * @brief HTTP/1.1 响应头构建
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_RESPONSE_HPP
+#define TINY_WEB_SERVER_RESPONSE_HPP
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <initializer_list>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 响应头构建器
+     * @details 直接拼接到一个 pmr 字符串中，通常从请求的 @c Arena 分配;
+     * 整数用 @c std::to_chars 格式化，不经过 @c std::format 与临时字符串
+     */
+    struct ResponseBuilder {
+    private:
+        std::pmr::string buffer_;
+
+    public:
+        explicit ResponseBuilder(
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        );
+
+        /**
+         * @brief 状态行
+         * @param reason 为空时使用标准原因短语
+         */
+        ResponseBuilder& status(int code, std::string_view reason = {});
+
+        ResponseBuilder& header(std::string_view name, std::string_view value);
+
+        ResponseBuilder& header(std::string_view name, std::uint64_t value);
+
+        /**
+         * @brief 追加原始文本，调用者负责 CRLF
+         */
+        ResponseBuilder& append(std::string_view text);
+
+        ResponseBuilder& append(std::uint64_t value);
+
+        /**
+         * @brief 当前时间的 Date 头，取自 @c HttpDate::now
+         */
+        ResponseBuilder& date();
+
+        /**
+         * @brief 结束头部(追加空行)
+         */
+        ResponseBuilder& end();
+
+        [[nodiscard]] std::string_view view() const noexcept;
+
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        void clear() noexcept;
+
+        /**
+         * @return 未知状态码返回空视图
+         */
+        [[nodiscard]] static std::string_view reasonPhrase(int code) noexcept;
+    };
+
+    /**
+     * @brief HTTP 日期(IMF-fixdate)，如 @c Sun, 06 Nov 1994 08:49:37 GMT
+     */
+    struct HttpDate {
+        static constexpr std::size_t SIZE = 29;
+
+        /**
+         * @brief 当前时间，每个线程每秒只格式化一次
+         * @details 返回的视图指向线程本地缓冲区，在同一线程下一次跨秒调用前有效
+         */
+        [[nodiscard]] static std::string_view now();
+
+        static void format(std::time_t time, std::span<char, SIZE> out) noexcept;
+    };
+
+    /**
+     * @brief 预先序列化的响应头模板
+     * @details 状态行与静态头部在构造时拼接一次; 每次响应只复制整块模板，就地覆写 Date，
+     * 再追加 Content-Length 与 Connection。结果是一段连续的缓冲区，可直接交给 @c Socket::send 。
+     * 模板构造后只读，可在线程间共享
+     */
+    struct ResponseTemplate {
+    private:
+        /// 状态行、静态头部与 "Date: <占位>\r\n"
+        std::string head_;
+
+        std::size_t dateOffset_ = 0;
+
+    public:
+        /// Content-Length 的十进制位数上限
+        static constexpr std::size_t MAX_DIGITS = 20;
+
+        ResponseTemplate(
+            int status,
+            std::initializer_list<std::pair<std::string_view, std::string_view>> headers,
+            std::string_view reason = {}
+        );
+
+        /**
+         * @brief @c render 最多写入的字节数
+         */
+        [[nodiscard]] std::size_t maxSize() const noexcept;
+
+        /**
+         * @param out 至少 @c maxSize 字节
+         * @param contentLength 为空时不输出 Content-Length (如分块编码或 304)
+         * @return 写入的字节数
+         */
+        std::size_t render(
+            std::span<char> out, std::optional<std::uint64_t> contentLength,
+            bool keepAlive = true
+        ) const noexcept;
+
+        /**
+         * @brief 以完整的响应头替换 @p out 的内容
+         */
+        void render(
+            std::string& out, std::optional<std::uint64_t> contentLength,
+            bool keepAlive = true
+        ) const;
+    };
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_RESPONSE_HPP
@@ -0,0 +1,194 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file static_bundle.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 04:50
+ * @brief 静态资源包
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_STATIC_BUNDLE_HPP
+#define TINY_WEB_SERVER_STATIC_BUNDLE_HPP
+#pragma once
+
+#include <filesystem>
+#include <optional>
+
+#include "../net/socket.hpp"
+#include "content_encoding.hpp"
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 打包参数
+     */
+    struct BundleOptions {
+        /// 小于该字节数的文件不做压缩
+        std::size_t minCompressSize = 256;
+
+        /// 压缩结果至少比原文件小这一比例才保留
+        double minSavings = 0.1;
+
+        /// 压缩等级，-1 表示使用各算法的默认值
+        int level = -1;
+    };
+
+    /**
+     * @brief 把文档根目录打包为单个静态资源包文件
+     * @details 每个普通文件以 "/" 开头的相对路径为键。已存在且不旧于原文件的 .gz/.br/.zst
+     * 兄弟文件直接作为对应编码的变体，否则对可压缩的类型按本构建支持的编码在线压缩。
+     * 每个变体的响应头(含 ETag 与 Date 占位)在打包时序列化; 路径索引为 CHD 风格的完美哈希，
+     * 查找至多一次哈希和一次比较。先写入临时文件再原子替换 @p output
+     * @return 打包的文件数
+     * @throw HttpError 当读取或写入失败时
+     */
+    std::size_t packBundle(
+        const std::filesystem::path& root, const std::filesystem::path& output,
+        const BundleOptions& options = {}
+    );
+
+    /**
+     * @brief 资源包中某个文件的一种编码
+     * @details 所有视图都指向资源包的只读映射，在资源包关闭前有效
+     */
+    struct BundleVariant {
+        ContentEncoding encoding = ContentEncoding::IDENTITY;
+
+        /// 状态行与全部静态头部，以 "Date: <占位>\r\n" 结尾，不含结尾空行
+        std::string_view head;
+
+        /// 含引号的强 ETag
+        std::string_view etag;
+
+        std::span<const std::byte> body;
+
+        /// @c body 在资源包文件中的偏移，供 sendfile 使用
+        std::uint64_t offset = 0;
+
+        /// 同一文件是否还有其它编码(响应需带 Vary)
+        bool varies = false;
+
+        /**
+         * @brief @c render 最多写入的字节数
+         */
+        [[nodiscard]] std::size_t maxSize() const noexcept;
+
+        /**
+         * @brief 复制 @c head，就地写入 Date，再追加 Connection 并结束头部
+         * @param out 至少 @c maxSize 字节
+         * @return 写入的字节数
+         */
+        std::size_t render(std::span<char> out, bool keepAlive = true) const noexcept;
+
+        /**
+         * @brief 以完整的响应头替换 @p out 的内容
+         */
+        void render(std::string& out, bool keepAlive = true) const;
+    };
+
+    /**
+     * @brief 以只读内存映射打开的静态资源包
+     * @details 打开时校验全部索引项的边界，之后的查找不再做检查。
+     * 只读且无内部状态，可在线程间共享。目前只支持 POSIX 平台
+     */
+    struct StaticBundle {
+    private:
+        struct Header;
+        struct Entry;
+
+        int fd_ = -1;
+
+        const std::byte* data_ = nullptr;
+
+        std::size_t size_ = 0;
+
+        const Header* header_ = nullptr;
+
+        const std::uint32_t* seeds_ = nullptr;
+
+        const Entry* entries_ = nullptr;
+
+        friend std::size_t packBundle(
+            const std::filesystem::path& root, const std::filesystem::path& output,
+            const BundleOptions& options
+        );
+
+    public:
+        /**
+         * @throw HttpError 当文件无法打开、映射或格式不正确时
+         */
+        [[nodiscard]] static StaticBundle open(const std::filesystem::path& path);
+
+        StaticBundle() = default;
+
+        StaticBundle(StaticBundle&& other) noexcept;
+
+        StaticBundle& operator=(StaticBundle&& other) noexcept;
+
+        StaticBundle(const StaticBundle&) = delete;
+
+        StaticBundle& operator=(const StaticBundle&) = delete;
+
+        ~StaticBundle();
+
+        /**
+         * @param path 已解码、不含查询串的请求路径，如 @c /css/site.css
+         * @return 文件的索引; 不存在时返回空
+         */
+        [[nodiscard]] std::optional<std::size_t> find(std::string_view path) const noexcept;
+
+        /**
+         * @brief 从文件已有的变体中选出客户端最偏好的编码
+         */
+        [[nodiscard]] BundleVariant
+        select(std::size_t entry, const AcceptEncoding& accept) const noexcept;
+
+        [[nodiscard]] std::string_view path(std::size_t entry) const noexcept;
+
+        /**
+         * @brief 包内的文件数
+         */
+        [[nodiscard]] std::size_t files() const noexcept;
+
+        /**
+         * @brief 用于 sendfile 的文件描述符
+         */
+        [[nodiscard]] int fd() const noexcept;
+
+        [[nodiscard]] bool isOpen() const noexcept;
+
+    private:
+        void close() noexcept;
+
+        [[nodiscard]] BundleVariant
+        variant(const Entry& entry, ContentEncoding encoding) const noexcept;
+    };
+
+    /**
+     * @brief If-None-Match 是否命中 @p etag
+     * @details 按弱比较处理逗号分隔的列表与 "*"
+     */
+    [[nodiscard]] bool
+    matchesETag(std::string_view ifNoneMatch, std::string_view etag) noexcept;
+
+    /**
+     * @brief 发送资源包中的文件，按阻塞套接字的语义发送完整响应
+     * @details 小文件直接从映射写出(响应头以 MSG_MORE 合并进同一报文)，
+     * 大文件以 @c Socket::sendFile 按偏移从资源包发送。不支持 Range
+     * @return 响应状态码: 200 或 304
+     */
+    int sendBundleAsset(
+        const net::Socket& socket, const StaticBundle& bundle, std::size_t entry,
+        const AcceptEncoding& accept, std::string_view ifNoneMatch = {},
+        bool keepAlive = true
+    );
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_STATIC_BUNDLE_HPP
@@ -0,0 +1,67 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file static_file.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 11:15
+ * @brief 静态文件解析
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_STATIC_FILE_HPP
+#define TINY_WEB_SERVER_STATIC_FILE_HPP
+#pragma once
+
+#include <filesystem>
+#include <optional>
+
+#include "../net/socket.hpp"
+#include "content_encoding.hpp"
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 解析后的静态文件
+     * @details @c path 为实际要发送的文件(可能是 .gz/.br/.zst 兄弟文件)，
+     * @c encoding 为其 Content-Encoding，@c size 为其字节数
+     */
+    struct StaticFile {
+        std::filesystem::path path;
+
+        ContentEncoding encoding = ContentEncoding::IDENTITY;
+
+        std::uintmax_t size = 0;
+
+        std::filesystem::file_time_type lastWrite;
+    };
+
+    /**
+     * @brief 查找静态文件，并在客户端允许时选择预压缩的兄弟文件
+     * @details 仅当兄弟文件不旧于原文件时才会被选中；响应需带上 @c Vary: Accept-Encoding
+     * @return 原文件不存在或不是普通文件时返回空
+     */
+    [[nodiscard]] std::optional<StaticFile>
+    resolveStaticFile(const std::filesystem::path& path, const AcceptEncoding& accept);
+
+    /**
+     * @brief 发送静态文件响应，支持单区间与多区间(multipart/byteranges)的 Range 请求
+     * @details 文件内容(含每个区间)通过 @c Socket::sendFile 按偏移直接发送而不读入内存;
+     * 按阻塞套接字的语义发送完整响应
+     * 响应带 Last-Modified，@p ifRange 与之不符时忽略 Range 发送完整文件
+     * @param range Range 请求头的值，为空时发送完整文件
+     * @param ifRange If-Range 请求头的值
+     * @return 响应状态码: 200、206 或 416
+     */
+    int sendStaticFile(
+        const net::Socket& socket, const StaticFile& file, std::string_view contentType,
+        std::string_view range = {}, std::string_view ifRange = {}
+    );
+
+}  // namespace tiny_web_server::http
+
+#endif  // TINY_WEB_SERVER_STATIC_FILE_HPP
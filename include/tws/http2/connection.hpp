@@ -0,0 +1,344 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file connection.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 23:00
+ * @brief HTTP/2 明文(h2c)连接
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_HTTP2_CONNECTION_HPP
+#define TINY_WEB_SERVER_HTTP2_CONNECTION_HPP
+#pragma once
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include "../async/reactor.hpp"
+#include "../http/request.hpp"
+#include "../net/socket.hpp"
+#include "frame.hpp"
+#include "hpack.hpp"
+
+namespace tiny_web_server::http2 {
+
+    struct ConnectionOptions {
+        /// 本端允许对端同时打开的流数，超出的新流以 REFUSED_STREAM 拒绝
+        std::uint32_t maxConcurrentStreams = 100;
+
+        /// 每个流的接收窗口
+        std::uint32_t initialWindowSize = 1 << 20;
+
+        /// 连接级接收窗口，建立连接时即通过 WINDOW_UPDATE 从默认的 65535 扩大
+        std::uint32_t connectionWindowSize = 16 << 20;
+
+        /// 本端接受的最大帧负载
+        std::uint32_t maxFrameSize = DEFAULT_MAX_FRAME_SIZE;
+
+        /// 解码后头部列表的上限(按名称、值与每项32字节计算)，超出时以 431 响应
+        std::uint32_t maxHeaderListSize = 16 << 10;
+
+        /// 单个请求体的上限，超出时以 413 响应并重置流
+        std::size_t maxRequestBodySize = 16 << 20;
+
+        /// 各流尚未交给回调的请求体合计上限，超出时新到数据的流以 503 响应并重置
+        std::size_t maxBufferedBodySize = 32 << 20;
+
+        /// 接收缓冲区的初始大小，放不下完整帧时按需增长
+        std::size_t receiveBufferSize = 64 << 10;
+
+        /// 一次向量化发送合并的最大字节数
+        std::size_t maxBatchBytes = 256 << 10;
+    };
+
+    struct Request {
+        std::string method;
+
+        std::string scheme;
+
+        std::string authority;
+
+        std::string path;
+
+        /// 伪头部以外的字段，名称均为小写
+        std::vector<HeaderField> headers;
+
+        std::vector<std::byte> body;
+
+        /**
+         * @brief 按名称查找头部字段
+         * @param name 必须是小写
+         * @return 不存在时返回空视图
+         */
+        [[nodiscard]] std::string_view header(std::string_view name) const noexcept;
+    };
+
+    struct Response {
+        int status = 200;
+
+        /// 名称在编码时转为小写; 连接相关的字段(Connection、Keep-Alive 等)会被丢弃
+        std::vector<HeaderField> headers;
+
+        /// 响应体以共享指针持有，发送时直接引用而不再拷贝
+        std::shared_ptr<const std::vector<std::byte>> body;
+    };
+
+    /**
+     * @brief HTTP/2 明文连接(h2c)，支持先验知识与 HTTP/1.1 Upgrade 两种建立方式
+     * @details 帧直接在接收缓冲区中解析，请求在收到 END_STREAM 后交给回调。
+     * 响应头进入控制帧缓冲区，响应体按流控窗口切分为 DATA 帧，由写调度器在就绪的流之间
+     * 轮转，每轮每个流一帧; 控制帧与多个流的 DATA 帧合并为一次向量化发送，
+     * DATA 帧的负载直接引用响应体。除 @c reactor 外的所有方法只能在所属反应器的线程中调用。
+     * 不支持服务端推送，PRIORITY 被忽略。
+     */
+    struct Connection : std::enable_shared_from_this<Connection> {
+    public:
+        /**
+         * @brief 请求回调
+         * @details @p request 只在回调期间有效，异步响应需自行移走所需的字段;
+         * 之后在反应器线程中以 @p streamId 调用 @c respond
+         */
+        using RequestHandler =
+            std::function<void(Connection&, std::uint32_t streamId, Request& request)>;
+
+        using CloseHandler = std::function<void(Connection&)>;
+
+    private:
+        struct Private {};
+
+        struct Stream {
+            Request request;
+
+            /// 可用的发送窗口，对端减小 SETTINGS_INITIAL_WINDOW_SIZE 后可能为负
+            std::int64_t sendWindow = DEFAULT_WINDOW_SIZE;
+
+            /// 尚未通过 WINDOW_UPDATE 补充的剩余接收窗口
+            std::uint32_t receiveWindow = DEFAULT_WINDOW_SIZE;
+
+            /// 已计入 bufferedBody_ 的请求体字节数
+            std::size_t buffered = 0;
+
+            /// 待发送的响应体
+            std::shared_ptr<const std::vector<std::byte>> body;
+
+            std::size_t bodyOffset = 0;
+
+            /// 对端已发送 END_STREAM
+            bool remoteClosed = false;
+
+            /// 本端已发送 END_STREAM 或 RST_STREAM
+            bool localClosed = false;
+
+            /// 已调用过 respond
+            bool responded = false;
+
+            /// 已在就绪队列中
+            bool scheduled = false;
+        };
+
+        /// 每批次最多的 DATA 帧数: 每帧占两个缓冲区，另留一个给控制帧，不超过单次发送的64个
+        static constexpr std::size_t MAX_BATCH_FRAMES = 31;
+
+        net::Socket socket_;
+
+        async::Reactor& reactor_;
+
+        ConnectionOptions options_;
+
+        RequestHandler onRequest_;
+
+        CloseHandler onClose_;
+
+        std::vector<std::byte> input_;
+
+        std::size_t inputBegin_ = 0;
+
+        std::size_t inputEnd_ = 0;
+
+        bool prefaceReceived_ = false;
+
+        HpackDecoder decoder_;
+
+        HpackEncoder encoder_;
+
+        std::unordered_map<std::uint32_t, Stream> streams_;
+
+        /// 两端都已关闭、等到下一批次开始时才移除的流，避免回调中持有的请求失效
+        std::vector<std::uint32_t> finished_;
+
+        std::uint32_t lastStreamId_ = 0;
+
+        /// 正在等待 CONTINUATION 的流，0 表示没有
+        std::uint32_t continuationStream_ = 0;
+
+        /// 首个 HEADERS 帧的标志
+        std::uint8_t continuationFlags_ = 0;
+
+        /// 当前头部块已收到的 CONTINUATION 帧数
+        std::uint32_t continuationFrames_ = 0;
+
+        std::vector<std::byte> headerBlock_;
+
+        std::uint32_t peerInitialWindow_ = DEFAULT_WINDOW_SIZE;
+
+        std::uint32_t peerMaxFrameSize_ = DEFAULT_MAX_FRAME_SIZE;
+
+        /// 连接级发送窗口
+        std::int64_t sendWindow_ = DEFAULT_WINDOW_SIZE;
+
+        /// 连接级剩余接收窗口
+        std::uint32_t receiveWindow_ = DEFAULT_WINDOW_SIZE;
+
+        /// 各流已缓冲、尚未交给回调的请求体字节数; 连接级窗口随数据到达即补充，
+        /// 由它限制整个连接占用的内存
+        std::size_t bufferedBody_ = 0;
+
+        /// 有响应体待发送且窗口未耗尽的流，按轮转顺序排列
+        std::deque<std::uint32_t> ready_;
+
+        /// 待发送的控制帧与头部帧，在下一批次中排在所有 DATA 帧之前
+        std::vector<std::byte> control_;
+
+        /// 当前批次: 控制帧、DATA 帧头与引用响应体的片段
+        std::vector<std::span<const std::byte>> batch_;
+
+        /// 首个尚未发完的片段
+        std::size_t batchIndex_ = 0;
+
+        std::vector<std::byte> batchControl_;
+
+        std::vector<std::array<std::byte, FRAME_HEADER_SIZE>> batchHeaders_;
+
+        /// 批次发送完之前保持被引用的响应体存活
+        std::vector<std::shared_ptr<const std::vector<std::byte>>> batchOwners_;
+
+        bool writing_ = false;
+
+        /// 正在处理接收到的帧或回调，期间产生的输出在结束后一次发出
+        bool processing_ = false;
+
+        /// 本端已发送 GOAWAY，输出发完后关闭
+        bool goingAway_ = false;
+
+        bool peerGoingAway_ = false;
+
+        /// 套接字已关闭并已从反应器移除
+        bool closed_ = false;
+
+    public:
+        Connection(
+            Private, net::Socket socket, async::Reactor& reactor, RequestHandler onRequest,
+            const ConnectionOptions& options
+        );
+
+        /**
+         * @brief 以先验知识建立连接并把套接字交给反应器
+         * @param received 已读走的字节，应以连接序言开头
+         */
+        static std::shared_ptr<Connection> start(
+            net::Socket socket, std::span<const std::byte> received, async::Reactor& reactor,
+            RequestHandler onRequest, const ConnectionOptions& options = {}
+        );
+
+        /**
+         * @brief 响应 101 后把 HTTP/1.1 请求作为流1交给回调
+         * @param rest 接收缓冲区中紧跟请求头之后、已被读走的字节
+         * @throw HttpError 当请求不是合法的 h2c 升级请求时
+         */
+        static std::shared_ptr<Connection> upgrade(
+            net::Socket socket, const http::Request& request,
+            std::span<const std::byte> rest, async::Reactor& reactor,
+            RequestHandler onRequest, const ConnectionOptions& options = {}
+        );
+
+        /**
+         * @brief 发送响应，流已被重置或已响应过时忽略
+         */
+        void respond(std::uint32_t streamId, Response response);
+
+        void reset(std::uint32_t streamId, ErrorCode code = ErrorCode::CANCEL);
+
+        /**
+         * @brief 发送 GOAWAY，已排队的响应发送完毕后关闭连接
+         */
+        void close(ErrorCode code = ErrorCode::NONE);
+
+        void onClose(CloseHandler handler);
+
+        [[nodiscard]] bool isOpen() const noexcept;
+
+        [[nodiscard]] std::size_t activeStreams() const noexcept;
+
+        [[nodiscard]] async::Reactor& reactor() const noexcept;
+
+        [[nodiscard]] const net::Socket& socket() const noexcept;
+
+    private:
+        void attach(std::span<const std::byte> received);
+
+        void handleEvents(async::EventType events);
+
+        void readable();
+
+        void writable();
+
+        void fillBatch();
+
+        void flush();
+
+        void processFrames();
+
+        void dispatch(const FrameHeader& header, std::span<const std::byte> payload);
+
+        void onHeaders(const FrameHeader& header, std::span<const std::byte> payload);
+
+        void onHeaderBlock(
+            std::uint32_t streamId, std::uint8_t flags, std::span<const std::byte> block
+        );
+
+        void onData(const FrameHeader& header, std::span<const std::byte> payload);
+
+        void onSettings(const FrameHeader& header, std::span<const std::byte> payload);
+
+        void onWindowUpdate(const FrameHeader& header, std::span<const std::byte> payload);
+
+        [[nodiscard]] ErrorCode applySettings(std::span<const Setting> settings);
+
+        void deliver(std::uint32_t streamId);
+
+        [[nodiscard]] Stream* find(std::uint32_t streamId) noexcept;
+
+        void schedule(std::uint32_t streamId, Stream& stream);
+
+        void finish(std::uint32_t streamId, Stream& stream);
+
+        /// 请求体已交给回调或被丢弃，不再计入连接的缓冲预算
+        void release(Stream& stream) noexcept;
+
+        void sendWindowUpdate(std::uint32_t streamId, std::uint32_t increment);
+
+        void sendReset(std::uint32_t streamId, ErrorCode code);
+
+        void fail(ErrorCode code);
+
+        void shutdown();
+    };
+
+    /**
+     * @brief 是否为可接受的 h2c 升级请求
+     * @details 要求 @c Upgrade: h2c 、@c Connection 中含 HTTP2-Settings 且没有请求体
+     */
+    [[nodiscard]] bool isUpgradeRequest(const http::Request& request) noexcept;
+
+}  // namespace tiny_web_server::http2
+
+#endif  // TINY_WEB_SERVER_HTTP2_CONNECTION_HPP
@@ -0,0 +1,171 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file frame.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 22:10
+ * @brief HTTP/2 帧编解码
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_HTTP2_FRAME_HPP
+#define TINY_WEB_SERVER_HTTP2_FRAME_HPP
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace tiny_web_server::http2 {
+
+    /// 客户端连接序言
+    constexpr std::string_view PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+    constexpr std::size_t FRAME_HEADER_SIZE = 9;
+
+    constexpr std::uint32_t DEFAULT_WINDOW_SIZE = 65535;
+
+    constexpr std::uint32_t DEFAULT_MAX_FRAME_SIZE = 16384;
+
+    constexpr std::uint32_t MAX_WINDOW_SIZE = 0x7FFFFFFF;
+
+    /** @enum FrameType
+     *
+     * @brief 帧类型
+     */
+    enum class FrameType : std::uint8_t {
+        DATA          = 0x0,
+        HEADERS       = 0x1,
+        PRIORITY      = 0x2,
+        RST_STREAM    = 0x3,
+        SETTINGS      = 0x4,
+        PUSH_PROMISE  = 0x5,
+        PING          = 0x6,
+        GOAWAY        = 0x7,
+        WINDOW_UPDATE = 0x8,
+        CONTINUATION  = 0x9
+    };
+
+    /// 帧标志位，含义随帧类型而定
+    namespace flags {
+
+        constexpr std::uint8_t END_STREAM = 0x1;
+
+        constexpr std::uint8_t ACK = 0x1;
+
+        constexpr std::uint8_t END_HEADERS = 0x4;
+
+        constexpr std::uint8_t PADDED = 0x8;
+
+        constexpr std::uint8_t PRIORITY = 0x20;
+
+    }  // namespace flags
+
+    /** @enum ErrorCode
+     *
+     * @brief RST_STREAM 与 GOAWAY 携带的错误码
+     */
+    enum class ErrorCode : std::uint32_t {
+        /// 即 NO_ERROR，避免与 Windows 的同名宏冲突
+        NONE                = 0x0,
+        PROTOCOL_ERROR      = 0x1,
+        INTERNAL_ERROR      = 0x2,
+        FLOW_CONTROL_ERROR  = 0x3,
+        SETTINGS_TIMEOUT    = 0x4,
+        STREAM_CLOSED       = 0x5,
+        FRAME_SIZE_ERROR    = 0x6,
+        REFUSED_STREAM      = 0x7,
+        CANCEL              = 0x8,
+        COMPRESSION_ERROR   = 0x9,
+        CONNECT_ERROR       = 0xA,
+        ENHANCE_YOUR_CALM   = 0xB,
+        INADEQUATE_SECURITY = 0xC,
+        HTTP_1_1_REQUIRED   = 0xD
+    };
+
+    /** @enum SettingsId
+     *
+     * @brief SETTINGS 参数标识
+     */
+    enum class SettingsId : std::uint16_t {
+        HEADER_TABLE_SIZE      = 0x1,
+        ENABLE_PUSH            = 0x2,
+        MAX_CONCURRENT_STREAMS = 0x3,
+        INITIAL_WINDOW_SIZE    = 0x4,
+        MAX_FRAME_SIZE         = 0x5,
+        MAX_HEADER_LIST_SIZE   = 0x6
+    };
+
+    struct Setting {
+        SettingsId id;
+
+        std::uint32_t value;
+    };
+
+    struct FrameHeader {
+        /// 负载长度(24位)
+        std::uint32_t length = 0;
+
+        FrameType type = FrameType::DATA;
+
+        std::uint8_t flags = 0;
+
+        /// 流标识(31位)，0 表示连接本身
+        std::uint32_t streamId = 0;
+
+        [[nodiscard]] bool has(std::uint8_t flag) const noexcept;
+    };
+
+    /**
+     * @brief 判断接收到的数据是否以连接序言开头
+     * @return 数据只是序言的前缀、还无法判断时返回空
+     */
+    [[nodiscard]] std::optional<bool>
+    detectPreface(std::span<const std::byte> data) noexcept;
+
+    /**
+     * @brief 直接从接收缓冲区解析帧头，不拷贝数据
+     * @return 数据不足9字节时返回 false
+     */
+    [[nodiscard]] bool
+    parseHeader(std::span<const std::byte> data, FrameHeader& header) noexcept;
+
+    void encodeHeader(
+        std::span<std::byte, FRAME_HEADER_SIZE> out, const FrameHeader& header
+    ) noexcept;
+
+    /**
+     * @brief 把帧头与负载追加到 @p out 的末尾
+     */
+    void appendFrame(
+        std::vector<std::byte>& out, FrameType type, std::uint8_t flags,
+        std::uint32_t streamId, std::span<const std::byte> payload = {}
+    );
+
+    void appendSettings(std::vector<std::byte>& out, std::span<const Setting> settings);
+
+    /**
+     * @brief 解析 SETTINGS 负载，未知参数被忽略
+     * @return 负载长度不是6的倍数时返回 false
+     */
+    [[nodiscard]] bool
+    parseSettings(std::span<const std::byte> payload, std::vector<Setting>& settings);
+
+    /**
+     * @brief 按网络字节序读取 @p size (1~4)字节的整数
+     */
+    [[nodiscard]] std::uint32_t
+    readInteger(const std::byte* data, std::size_t size) noexcept;
+
+    void writeInteger(std::byte* data, std::uint32_t value, std::size_t size) noexcept;
+
+}  // namespace tiny_web_server::http2
+
+#endif  // TINY_WEB_SERVER_HTTP2_FRAME_HPP
@@ -0,0 +1,159 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file hpack.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 22:30
+ * @brief HPACK 头部压缩
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_HTTP2_HPACK_HPP
+#define TINY_WEB_SERVER_HTTP2_HPACK_HPP
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tiny_web_server::http2 {
+
+    struct HeaderField {
+        std::string name;
+
+        std::string value;
+    };
+
+    /// 计算表大小时每个表项额外计入的字节数
+    constexpr std::size_t ENTRY_OVERHEAD = 32;
+
+    constexpr std::size_t DEFAULT_HEADER_TABLE_SIZE = 4096;
+
+    [[nodiscard]] std::size_t huffmanEncodedSize(std::string_view text) noexcept;
+
+    void huffmanEncode(std::string_view text, std::vector<std::byte>& out);
+
+    /**
+     * @brief Huffman 解码，结果追加到 @p out
+     * @details 以半字节为单位查预先生成的状态转移表，每次查表最多输出一个符号
+     * @return 含 EOS、填充超过7位或填充不全为1时返回 false
+     */
+    [[nodiscard]] bool huffmanDecode(std::span<const std::byte> data, std::string& out);
+
+    /**
+     * @brief 动态表
+     * @details 新表项在前; 大小按名称、值与每项32字节的开销计算，超出上限时从最旧的一端逐出
+     */
+    struct DynamicTable {
+    private:
+        std::deque<HeaderField> entries_;
+
+        std::size_t size_ = 0;
+
+        std::size_t maxSize_;
+
+    public:
+        explicit DynamicTable(std::size_t maxSize = DEFAULT_HEADER_TABLE_SIZE);
+
+        /**
+         * @brief 插入表项，比整个表还大的表项会清空表且不被插入
+         */
+        void insert(std::string_view name, std::string_view value);
+
+        void setMaxSize(std::size_t maxSize);
+
+        /**
+         * @param index 从0开始，0 为最新插入的表项
+         * @return 越界时返回空指针
+         */
+        [[nodiscard]] const HeaderField* get(std::size_t index) const noexcept;
+
+        [[nodiscard]] std::size_t count() const noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] std::size_t maxSize() const noexcept;
+
+    private:
+        void evict(std::size_t limit);
+    };
+
+    /**
+     * @brief 头部块解码器，每个连接一个
+     */
+    struct HpackDecoder {
+    public:
+        enum class Status {
+            OK,
+            /// 格式错误，此后解码器状态不可用，连接应以 COMPRESSION_ERROR 关闭
+            ERROR,
+            /// 解码后的字段列表超出预算; 动态表仍已同步，可只拒绝该流
+            TOO_LARGE
+        };
+
+    private:
+        DynamicTable table_;
+
+        /// 本端 SETTINGS_HEADER_TABLE_SIZE，对端的动态表大小更新不得超过
+        std::size_t maxTableSize_;
+
+    public:
+        explicit HpackDecoder(std::size_t maxTableSize = DEFAULT_HEADER_TABLE_SIZE);
+
+        /**
+         * @brief 解码一个完整的头部块，字段按顺序追加到 @p fields
+         * @details 字段大小按名称、值与每字段32字节累计，超出 @p maxListSize 后不再展开字段
+         * (@p fields 恢复为调用前的内容)，只继续解析以维护动态表。
+         * 1字节的索引表示可引用数KB的表项，不设预算时一个头部块可展开成上百MB
+         */
+        [[nodiscard]] Status decode(
+            std::span<const std::byte> block, std::vector<HeaderField>& fields,
+            std::size_t maxListSize = SIZE_MAX
+        );
+    };
+
+    /**
+     * @brief 头部块编码器，每个连接一个
+     * @details 优先引用静态表与动态表中的表项; 字符串只在 Huffman 编码更短时才使用它
+     */
+    struct HpackEncoder {
+    private:
+        DynamicTable table_;
+
+        /// 尚未告知对端的动态表大小更新，在下一个头部块的开头发出
+        std::optional<std::size_t> pendingSize_;
+
+        /// 自上次告知以来出现过的最小表大小
+        std::size_t pendingMinimum_ = 0;
+
+    public:
+        explicit HpackEncoder(std::size_t maxTableSize = DEFAULT_HEADER_TABLE_SIZE);
+
+        /**
+         * @brief 对端的 SETTINGS_HEADER_TABLE_SIZE 变化时调用，本端最多使用默认的4096字节
+         */
+        void setMaxTableSize(std::size_t size);
+
+        /**
+         * @brief 编码一个字段，追加到 @p out
+         * @param name 必须已是小写
+         * @param index 是否加入动态表; 取值每次都不同的字段(如 date、content-length)应传 false
+         */
+        void encode(
+            std::string_view name, std::string_view value, std::vector<std::byte>& out,
+            bool index = true
+        );
+    };
+
+}  // namespace tiny_web_server::http2
+
+#endif  // TINY_WEB_SERVER_HTTP2_HPACK_HPP
@@ -0,0 +1,186 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file access_log.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:20
+ * @brief 异步访问日志
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_ACCESS_LOG_HPP
+#define TINY_WEB_SERVER_ACCESS_LOG_HPP
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../async/spsc_ring.hpp"
+#include "../http/request.hpp"
+#include "../net/endpoint.hpp"
+
+namespace tiny_web_server::logging {
+
+    /**
+     * @brief 一条访问记录的紧凑二进制形式
+     * @details 定长128字节，可直接按值拷入环形缓冲区; 格式化推迟到后台线程。
+     * 请求目标超过 @c TARGET_SIZE 时截断。
+     */
+    struct AccessRecord {
+        static constexpr std::size_t TARGET_SIZE = 64;
+
+        /// 请求完成时刻，自 Unix 纪元起的纳秒
+        std::int64_t timestamp = 0;
+
+        /// 处理耗时，纳秒
+        std::uint64_t duration = 0;
+
+        std::uint64_t bytesIn = 0;
+
+        std::uint64_t bytesOut = 0;
+
+        /// 网络字节序，IPv4 只使用前4字节
+        std::array<std::byte, 16> address{};
+
+        std::uint16_t port = 0;
+
+        std::uint16_t status = 0;
+
+        bool ipv6 = false;
+
+        std::uint8_t methodLength = 0;
+
+        std::uint8_t targetLength = 0;
+
+        std::array<char, 8> method{};
+
+        std::array<char, TARGET_SIZE> target{};
+
+        static AccessRecord make(
+            const net::Endpoint& peer, const http::Request& request, int status,
+            std::uint64_t bytesIn, std::uint64_t bytesOut, std::chrono::nanoseconds duration
+        ) noexcept;
+    };
+
+    static_assert(sizeof(AccessRecord) == 128);
+
+    struct AccessLogOptions {
+        std::filesystem::path path;
+
+        /// 超过此大小时轮转，0 表示不按大小轮转
+        std::uint64_t maxFileSize = 64 << 20;
+
+        /// 保留的轮转文件数: path.1 ... path.N
+        int maxFiles = 5;
+
+        /// 后台线程无记录可取时的休眠间隔
+        std::chrono::milliseconds flushInterval{100};
+    };
+
+    /**
+     * @brief 异步访问日志
+     * @details 每个 I/O 线程首次调用 @c log 时获得自己的 SPSC 环形缓冲区，之后记录只是一次
+     * 定长拷贝加一次 release 存储，不加锁、不分配、不做系统调用。后台线程轮询所有环，
+     * 格式化为文本并批量以 O_APPEND 写入文件，按大小或 @c rotate 请求轮转。
+     * 环满时丢弃记录并计数，绝不阻塞调用者。
+     */
+    struct AccessLog {
+    public:
+        static constexpr std::size_t RING_CAPACITY = 4096;
+
+    private:
+        struct Producer {
+            async::SpscRing<AccessRecord, RING_CAPACITY> ring;
+
+            /// 只由所属生产者线程写入
+            std::atomic<std::uint64_t> dropped = 0;
+        };
+
+        AccessLogOptions options_;
+
+        /// 区分线程局部缓存中属于不同实例的环
+        std::uint64_t id_;
+
+        mutable std::mutex mutex_;
+
+        std::vector<std::unique_ptr<Producer>> producers_;
+
+        int file_ = -1;
+
+        std::uint64_t fileSize_ = 0;
+
+        std::atomic<bool> rotateRequested_ = false;
+
+        std::atomic<std::uint64_t> written_ = 0;
+
+        /// 以下只在后台线程中访问
+        std::string buffer_;
+
+        std::int64_t cachedSecond_ = -1;
+
+        std::array<char, 20> cachedTime_{};
+
+        /// 必须最后构造、最先析构
+        std::jthread writer_;
+
+    public:
+        /**
+         * @throw LogError 无法打开日志文件
+         */
+        explicit AccessLog(AccessLogOptions options);
+
+        /**
+         * @brief 写出所有已提交的记录后返回
+         */
+        ~AccessLog();
+
+        AccessLog(const AccessLog&)            = delete;
+        AccessLog& operator=(const AccessLog&) = delete;
+
+        /**
+         * @brief 任意线程调用，从不阻塞
+         * @return 环已满而丢弃时返回 false
+         */
+        bool log(const AccessRecord& record) noexcept;
+
+        /**
+         * @brief 请求后台线程在下一轮轮转文件(如收到 SIGHUP 时)
+         */
+        void rotate() noexcept;
+
+        [[nodiscard]] std::uint64_t written() const noexcept;
+
+        [[nodiscard]] std::uint64_t dropped() const noexcept;
+
+    private:
+        Producer* producer() noexcept;
+
+        void run(const std::stop_token& token);
+
+        /**
+         * @brief 从所有环中取出记录并格式化到 @c buffer_
+         */
+        std::size_t collect();
+
+        void format(const AccessRecord& record);
+
+        void flush();
+
+        void open();
+
+        void rotateFiles();
+    };
+
+}  // namespace tiny_web_server::logging
+
+#endif  // TINY_WEB_SERVER_ACCESS_LOG_HPP
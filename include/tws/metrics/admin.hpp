@@ -0,0 +1,38 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file admin.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:10
+ * @brief Prometheus 抓取端点
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_ADMIN_HPP
+#define TINY_WEB_SERVER_ADMIN_HPP
+#pragma once
+
+#include "../http/request.hpp"
+#include "../http/response.hpp"
+#include "metrics.hpp"
+
+namespace tiny_web_server::metrics {
+
+    /**
+     * @brief 处理 @c GET/HEAD /metrics 请求
+     * @details 所有分片在此时才被汇总，热路径上不做任何聚合
+     * @return 不是抓取请求时返回 false，且不修改 @p response
+     */
+    bool serveMetrics(
+        const http::Request& request, http::ResponseBuilder& response,
+        const Registry& registry = Registry::global()
+    );
+
+}  // namespace tiny_web_server::metrics
+
+#endif  // TINY_WEB_SERVER_ADMIN_HPP
@@ -0,0 +1,255 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file metrics.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:10
+ * @brief 分片计数器、仪表与延迟直方图
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_METRICS_HPP
+#define TINY_WEB_SERVER_METRICS_HPP
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace tiny_web_server::metrics {
+
+    /// 分片数; 线程按首次记录的顺序轮流分到各分片
+    constexpr std::size_t SHARD_COUNT = 16;
+
+    /**
+     * @brief 当前线程的分片下标
+     */
+    std::size_t shardIndex() noexcept;
+
+    /**
+     * @brief 单调递增计数器
+     * @details 每个分片独占一条缓存行，热路径上只对本线程分片做 relaxed 加法，
+     * 线程间不争用同一缓存行; 读取时汇总所有分片
+     */
+    struct Counter {
+    private:
+        struct alignas(64) Shard {
+            std::atomic<std::uint64_t> value = 0;
+        };
+
+        std::array<Shard, SHARD_COUNT> shards_;
+
+    public:
+        void add(std::uint64_t value = 1) noexcept {
+            shards_[shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] std::uint64_t value() const noexcept;
+    };
+
+    /**
+     * @brief 可增可减的仪表，如活跃连接数
+     */
+    struct Gauge {
+    private:
+        struct alignas(64) Shard {
+            std::atomic<std::int64_t> value = 0;
+        };
+
+        std::array<Shard, SHARD_COUNT> shards_;
+
+    public:
+        void add(std::int64_t value = 1) noexcept {
+            shards_[shardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void sub(const std::int64_t value = 1) noexcept { add(-value); }
+
+        [[nodiscard]] std::int64_t value() const noexcept;
+    };
+
+    /**
+     * @brief HDR 风格的对数-线性直方图
+     * @details 每个2的幂区间再等分为16个子桶，相对误差不超过 1/16;
+     * 覆盖整个 64 位范围而无需预设上限。记录只是一次对本线程分片的 relaxed 加法，
+     * 抓取时才合并各分片。延迟以纳秒记录。
+     */
+    struct Histogram {
+    public:
+        static constexpr int SUB_BUCKET_BITS = 4;
+
+        static constexpr std::size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+        static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        struct Snapshot {
+            std::array<std::uint64_t, BUCKET_COUNT> counts{};
+
+            std::uint64_t count = 0;
+
+            std::uint64_t sum = 0;
+
+            /**
+             * @param quantile 0 到 1 之间，如 0.99
+             * @return 对应桶的上界
+             */
+            [[nodiscard]] std::uint64_t quantile(double quantile) const noexcept;
+        };
+
+    private:
+        struct alignas(64) Shard {
+            std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> counts{};
+
+            std::atomic<std::uint64_t> sum = 0;
+        };
+
+        std::unique_ptr<Shard[]> shards_;
+
+    public:
+        Histogram();
+
+        void record(std::uint64_t value) noexcept {
+            auto& shard = shards_[shardIndex()];
+
+            shard.counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+            shard.sum.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        void record(const std::chrono::nanoseconds duration) noexcept {
+            record(static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0)));
+        }
+
+        [[nodiscard]] Snapshot snapshot() const;
+
+        static constexpr std::size_t bucketIndex(const std::uint64_t value) noexcept {
+            if (value < SUB_BUCKETS) return value;
+
+            auto exponent = std::bit_width(value) - 1;
+            auto sub      = (value >> (exponent - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+
+            return SUB_BUCKETS * (exponent - SUB_BUCKET_BITS + 1) + sub;
+        }
+
+        /**
+         * @brief 桶中可能出现的最大值
+         */
+        static constexpr std::uint64_t bucketUpperBound(const std::size_t index) noexcept {
+            if (index < SUB_BUCKETS) return index;
+
+            auto shift = index / SUB_BUCKETS - 1;
+            auto lower = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+
+            return lower + ((std::uint64_t{1} << shift) - 1);
+        }
+    };
+
+    /**
+     * @brief 记录作用域耗时的计时器
+     */
+    struct ScopedTimer {
+    private:
+        Histogram& histogram_;
+
+        std::chrono::steady_clock::time_point start_;
+
+    public:
+        explicit ScopedTimer(Histogram& histogram) noexcept
+            : histogram_(histogram)
+            , start_(std::chrono::steady_clock::now()) {}
+
+        ~ScopedTimer() { histogram_.record(std::chrono::steady_clock::now() - start_); }
+
+        ScopedTimer(const ScopedTimer&)            = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+    /**
+     * @brief 指标注册表
+     * @details 注册在启动时完成，返回的引用在注册表生命周期内有效;
+     * 同名同标签重复注册时返回已有的指标
+     */
+    struct Registry {
+    private:
+        struct Entry {
+            std::string name;
+
+            /// 如 @c direction="in" ，不含花括号
+            std::string labels;
+
+            std::string help;
+
+            std::variant<
+                std::unique_ptr<Counter>, std::unique_ptr<Gauge>, std::unique_ptr<Histogram>>
+                metric;
+        };
+
+        mutable std::mutex mutex_;
+
+        std::vector<Entry> entries_;
+
+    public:
+        Counter& counter(
+            std::string_view name, std::string_view help, std::string_view labels = {}
+        );
+
+        Gauge& gauge(
+            std::string_view name, std::string_view help, std::string_view labels = {}
+        );
+
+        /**
+         * @brief 延迟直方图，记录纳秒，以秒为单位导出
+         */
+        Histogram& histogram(
+            std::string_view name, std::string_view help, std::string_view labels = {}
+        );
+
+        /**
+         * @brief 以 Prometheus 文本格式(0.0.4)输出所有指标
+         */
+        void render(std::string& out) const;
+
+        static Registry& global();
+
+    private:
+        template<typename T>
+        T& find(std::string_view name, std::string_view help, std::string_view labels);
+    };
+
+    /**
+     * @brief 服务器内置指标，首次使用时注册到全局注册表
+     */
+    struct ServerMetrics {
+        Counter& accepts;
+
+        Gauge& activeConnections;
+
+        Counter& bytesIn;
+
+        Counter& bytesOut;
+
+        Histogram& parseTime;
+
+        Histogram& handlerTime;
+
+        Histogram& writeTime;
+    };
+
+    ServerMetrics& server();
+
+}  // namespace tiny_web_server::metrics
+
+#endif  // TINY_WEB_SERVER_METRICS_HPP
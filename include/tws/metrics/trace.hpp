@@ -0,0 +1,177 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file trace.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:50
+ * @brief 请求分阶段追踪
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_TRACE_HPP
+#define TINY_WEB_SERVER_TRACE_HPP
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+    #include <intrin.h>
+#endif
+
+#include "../async/spsc_ring.hpp"
+#include "metrics.hpp"
+
+namespace tiny_web_server::metrics {
+
+    /** @enum Stage
+     *
+     * @brief 请求生命周期中的时间点，按发生顺序排列
+     */
+    enum class Stage : std::uint8_t {
+        ACCEPT,
+        FIRST_READ,
+        HEADERS_PARSED,
+        HANDLER_START,
+        HANDLER_END,
+        FIRST_WRITE,
+        LAST_WRITE,
+        COUNT
+    };
+
+    constexpr std::size_t STAGE_COUNT = static_cast<std::size_t>(Stage::COUNT);
+
+    /**
+     * @brief 追踪用的时间戳
+     * @details x86 上直接读 TSC(假定为恒定速率的 invariant TSC)，只在导出时换算为纳秒;
+     * 其他平台退化为 CLOCK_MONOTONIC 的纳秒数。
+     */
+    inline std::uint64_t traceTicks() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count()
+        );
+#endif
+    }
+
+    /**
+     * @brief 每个时钟刻度对应的纳秒数，首次调用时对照 steady_clock 校准约10毫秒
+     */
+    double nanosPerTick() noexcept;
+
+    /**
+     * @brief 追踪的全局开关与各线程的追踪记录
+     * @details 关闭时 @c RequestTrace::mark 只是一次 relaxed 读取。
+     * 每个线程首次提交时获得自己的 SPSC 环，满时丢弃并计数;
+     * 导出(Chrome 追踪 JSON 或直方图)是唯一的消费者，取出后即从环中移除。
+     */
+    struct Tracer {
+    public:
+        static constexpr std::size_t RING_CAPACITY = 1024;
+
+    private:
+        struct Producer;
+
+        static inline std::atomic<bool> enabled_ = false;
+
+        /// 导出之间互斥，保证每个环只有一个消费者
+        mutable std::mutex mutex_;
+
+        std::vector<std::unique_ptr<Producer>> producers_;
+
+        Counter dropped_;
+
+    public:
+        Tracer();
+
+        ~Tracer();
+
+        Tracer(const Tracer&)            = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        /**
+         * @brief 开启时顺带完成时钟校准(约10毫秒)，之后的时间戳都晚于导出的零点
+         */
+        static void enable(bool enabled = true) noexcept;
+
+        [[nodiscard]] static bool enabled() noexcept {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 取出所有已提交的追踪，追加为 Chrome 追踪格式(chrome://tracing、Perfetto)
+         * @details 每个请求输出一个总跨度与各阶段的嵌套跨度，tid 为提交线程的序号
+         * @return 导出的请求数
+         */
+        std::size_t exportChromeTrace(std::string& out);
+
+        /**
+         * @brief 取出所有已提交的追踪，把各阶段耗时记入
+         * @c tws_stage_duration_seconds{stage="..."}
+         * @return 记录的请求数
+         */
+        std::size_t recordHistograms(Registry& registry = Registry::global());
+
+        [[nodiscard]] std::uint64_t dropped() const noexcept;
+
+        static Tracer& global();
+
+    private:
+        friend struct RequestTrace;
+
+        Producer* producer() noexcept;
+
+        template<typename F>
+        std::size_t drain(F&& consume);
+    };
+
+    /**
+     * @brief 单个请求各阶段的时间戳，0 表示未记录
+     * @details 嵌在连接状态中随请求复用，请求结束时 @c commit 提交到本线程的环
+     */
+    struct RequestTrace {
+        std::array<std::uint64_t, STAGE_COUNT> ticks{};
+
+        /**
+         * @brief 记录(覆盖)某一阶段
+         */
+        void mark(const Stage stage) noexcept {
+            if (Tracer::enabled()) ticks[static_cast<std::size_t>(stage)] = traceTicks();
+        }
+
+        /**
+         * @brief 只记录首次发生，用于 FIRST_READ、FIRST_WRITE
+         */
+        void markOnce(const Stage stage) noexcept {
+            auto& slot = ticks[static_cast<std::size_t>(stage)];
+
+            if (slot == 0 && Tracer::enabled()) slot = traceTicks();
+        }
+
+        /**
+         * @brief 提交到本线程的环并清空，为下一个请求复用
+         */
+        void commit() noexcept;
+
+        void reset() noexcept { ticks = {}; }
+
+        [[nodiscard]] bool empty() const noexcept;
+    };
+
+}  // namespace tiny_web_server::metrics
+
+#endif  // TINY_WEB_SERVER_TRACE_HPP
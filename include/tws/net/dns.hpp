@@ -0,0 +1,194 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file dns.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 23:40
+ * @brief DNS 报文、hosts 与 resolv.conf 解析及解析结果缓存
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_DNS_HPP
+#define TINY_WEB_SERVER_DNS_HPP
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <unordered_map>
+
+#include "endpoint.hpp"
+
+namespace tiny_web_server::net {
+
+    /** @enum DnsType
+     *
+     * @brief 资源记录类型
+     */
+    enum class DnsType : std::uint16_t { A = 1, CNAME = 5, SOA = 6, AAAA = 28 };
+
+    /** @enum DnsError
+     *
+     * @brief 名称解析失败的原因
+     */
+    enum class DnsError {
+        /// 名称不存在(NXDOMAIN)或没有任何地址记录
+        NOT_FOUND = 1,
+        /// 所有名称服务器在重试次数内都没有应答
+        TIMEOUT,
+        /// 名称服务器返回 SERVFAIL/REFUSED 或截断的应答
+        SERVER_FAILURE,
+        /// 名称不是合法的域名
+        INVALID_NAME
+    };
+
+    [[nodiscard]] const std::error_category& dnsCategory() noexcept;
+
+    [[nodiscard]] std::error_code make_error_code(DnsError error) noexcept;
+
+    struct DnsAnswer {
+        /** @enum Status
+         *
+         * @brief 应答码
+         */
+        enum class Status {
+            /// 成功，地址列表可能为空(名称存在但没有该类型的记录)
+            OK,
+            /// NXDOMAIN
+            NOT_FOUND,
+            /// TC 位被置位，UDP 应答不完整
+            TRUNCATED,
+            /// 其他非零应答码
+            SERVER_FAILURE
+        };
+
+        Status status = Status::OK;
+
+        std::vector<IpAddress> addresses;
+
+        /// 所用记录(含 CNAME 链)的最小 TTL; 否定应答取 SOA 的 TTL 与 MINIMUM 中较小者
+        std::optional<std::uint32_t> ttl;
+    };
+
+    /**
+     * @brief 构造设置了 RD 位的单问题查询报文
+     * @return 名称不合法(空标签、标签超过63字节或总长超过255字节)时返回空
+     */
+    [[nodiscard]] std::optional<std::vector<std::byte>>
+    buildDnsQuery(std::uint16_t id, std::string_view name, DnsType type);
+
+    /**
+     * @brief 解析应答报文，只收集与问题类型相同的地址记录
+     * @return 报文格式错误，或 ID、问题与查询不匹配时返回空
+     */
+    [[nodiscard]] std::optional<DnsAnswer> parseDnsResponse(
+        std::span<const std::byte> message, std::uint16_t id, std::string_view name,
+        DnsType type
+    );
+
+    /**
+     * @brief 静态主机表(/etc/hosts)
+     * @details 名称不区分大小写; 同一名称的多个地址按出现顺序保留
+     */
+    struct HostsFile {
+    private:
+        std::unordered_map<std::string, std::vector<IpAddress>> entries_;
+
+    public:
+        /**
+         * @brief 解析主机表文本，无法解析的行被跳过
+         */
+        static HostsFile parse(std::string_view text);
+
+        /**
+         * @brief 读取主机表文件，文件不存在时返回空表
+         */
+        static HostsFile load(const std::filesystem::path& path = "/etc/hosts");
+
+        /**
+         * @return 未收录时返回空指针
+         */
+        [[nodiscard]] const std::vector<IpAddress>* find(std::string_view name) const;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+    };
+
+    /**
+     * @brief 解析器配置(/etc/resolv.conf)中用到的部分
+     * @details 只识别 nameserver 与 options 中的 timeout、attempts，search 与 ndots 被忽略
+     */
+    struct ResolvConf {
+        std::vector<Endpoint> nameservers;
+
+        std::chrono::milliseconds timeout = std::chrono::seconds(5);
+
+        int attempts = 2;
+
+        /**
+         * @brief 解析配置文本; 没有可用的名称服务器时使用 127.0.0.1:53
+         */
+        static ResolvConf parse(std::string_view text);
+
+        static ResolvConf load(const std::filesystem::path& path = "/etc/resolv.conf");
+    };
+
+    /**
+     * @brief 按 RFC 8305 排列地址: 两个地址族交替，IPv6 在前，同族内保持原有顺序
+     */
+    void happyEyeballsOrder(std::vector<IpAddress>& addresses);
+
+    /**
+     * @brief 线程安全的解析结果缓存，所有 I/O 线程的解析器共享
+     * @details 结果在 TTL 到期后失效; 空的地址列表表示否定缓存(名称不存在)
+     */
+    struct DnsCache {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        struct Entry {
+            std::vector<IpAddress> addresses;
+
+            Clock::time_point expires;
+        };
+
+        mutable std::mutex mutex_;
+
+        std::unordered_map<std::string, Entry> entries_;
+
+        std::size_t maxEntries_;
+
+    public:
+        explicit DnsCache(std::size_t maxEntries = 10000);
+
+        static DnsCache& global();
+
+        /**
+         * @return 未命中或已过期时返回空; 命中否定缓存时返回空列表
+         */
+        [[nodiscard]] std::optional<std::vector<IpAddress>>
+        find(std::string_view name, Clock::time_point now = Clock::now());
+
+        void store(
+            std::string_view name, std::vector<IpAddress> addresses,
+            std::chrono::seconds ttl, Clock::time_point now = Clock::now()
+        );
+
+        void clear();
+
+        [[nodiscard]] std::size_t size() const;
+    };
+
+}  // namespace tiny_web_server::net
+
+template<>
+struct std::is_error_code_enum<tiny_web_server::net::DnsError> : std::true_type {};
+
+#endif  // TINY_WEB_SERVER_DNS_HPP
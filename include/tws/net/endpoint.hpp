@@ -16,6 +16,10 @@
 #ifndef TINY_WEB_SERVER_ENDPOINT_HPP
 #define TINY_WEB_SERVER_ENDPOINT_HPP
 #pragma once
+
+#include <utility>
+
+#include "enums.hpp"
 #include "ip_address.hpp"
 
 namespace tiny_web_server::net {
@@ -24,20 +28,68 @@ namespace tiny_web_server::net {
     private:
         IpAddress address_;
 
-        std::uint16_t port_;
+        std::uint16_t port_ = 0;
+
+        /// Unix域套接字路径，非空时忽略地址与端口; 抽象命名空间以 '\0' 开头
+        std::string path_;
 
     public:
         Endpoint(const IpAddress& address, std::uint16_t port);
 
+        /**
+         * @brief 解析 @c ip:port 与 @c [ipv6]:port ，或 @c unix:/path (文件系统) 与
+         * @c unix:@name (抽象命名空间)
+         * @details 主机名需经 @c Resolver 异步解析，这里不做阻塞的名称查询
+         */
         Endpoint(std::string_view str);
 
+        /**
+         * @brief 文件系统中的 Unix 域套接字
+         */
+        static Endpoint unixSocket(std::string_view path);
+
+        /**
+         * @brief Linux 抽象命名空间中的 Unix 域套接字，不在文件系统中留下文件
+         */
+        static Endpoint abstractSocket(std::string_view name);
+
+        /**
+         * @brief 从系统地址结构构造
+         */
+        static Endpoint fromNative(const sockaddr_storage& storage, socklen_t length);
+
         [[nodiscard]] const IpAddress& address() const noexcept;
 
         [[nodiscard]] std::uint16_t port() const noexcept;
 
+        [[nodiscard]] const std::string& path() const noexcept;
+
+        [[nodiscard]] bool isUnix() const noexcept;
+
+        [[nodiscard]] bool isAbstract() const noexcept;
+
+        [[nodiscard]] AddressFamily family() const noexcept;
+
+        /**
+         * @brief 填充系统地址结构
+         * @return 地址结构的有效长度
+         */
+        socklen_t toNative(sockaddr_storage& storage) const;
+
         [[nodiscard]] std::string toString() const;
+
+    private:
+        Endpoint() = default;
     };
 
+    /**
+     * @brief 拆分 @c host:port 或 @c [ipv6]:port
+     * @return 主机部分(不含方括号)与端口
+     * @throw SocketError 缺少端口、方括号不配对或端口越界时
+     */
+    [[nodiscard]] std::pair<std::string_view, std::uint16_t>
+    splitHostPort(std::string_view str);
+
 }  // namespace tiny_web_server::net
 
 #endif  // TINY_WEB_SERVER_ENDPOINT_HPP
@@ -32,10 +32,14 @@ namespace tiny_web_server::net {
         IPv4 = AF_INET,
         /// IPv6地址族，对应AF_INET6
         IPv6 = AF_INET6,
+        /// Unix域地址族，对应AF_UNIX(Windows 10 1803 起支持流式套接字)
+        UNIX = AF_UNIX,
+#if WEB_SERVER_WINDOWS
         /// 红外地址族，对应AF_IRDA
         RDA = AF_IRDA,
         /// 蓝牙地址族，对应AF_BTH
         BTH = AF_BTH
+#endif
     };
 
     /** @enum SocketType
@@ -98,11 +102,13 @@ namespace tiny_web_server::net {
          * @details Internet组管理协议（IGMP）。 当af参数为AF_UNSPEC，AF_INET或AF_INET6且类型参数为SOCK_RAW或未指定时，这是一个可能的值。
          */
         IGMP = IPPROTO_IGMP,
+#if WEB_SERVER_WINDOWS
         /**
          * @brief PGM协议，对应IPPROTO_PGM
          * @details 用于可靠多播的PGM协议。 当af参数为AF_INET且类型参数为SOCK_RDM时，这是一个可能的值。 在针对Windows Vista及更高版本发布的Windows SDK上，此协议也称为IPPROTO_PGM。仅在安装了可靠多播协议时才支持此协议值。
          */
         PGM = IPPROTO_PGM,
+#endif
         /**
          * @brief 不指定协议
          * @details 调用者不希望指定协议，服务提供商将选择要使用的协议。
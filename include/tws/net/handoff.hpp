@@ -0,0 +1,204 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file handoff.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 17:10
+ * @brief 监听套接字交接与热重启
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_HANDOFF_HPP
+#define TINY_WEB_SERVER_HANDOFF_HPP
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../async/reactor.hpp"
+#include "socket.hpp"
+
+namespace tiny_web_server::net {
+
+    /**
+     * @brief 带名称的监听套接字
+     * @details 名称默认为本地端点的 @c Endpoint::toString ，新实例据此认领对应的监听套接字
+     */
+    struct ListenSocket {
+        std::string name;
+
+        Socket socket;
+    };
+
+    using ListenSockets = std::vector<ListenSocket>;
+
+    /**
+     * @brief 通过 Unix 域套接字以 SCM_RIGHTS 发送监听套接字
+     * @details 名称与句柄在同一条消息中发送，@p channel 应为 @c SEQPACKET 类型
+     */
+    void sendListeners(const Socket& channel, std::span<const ListenSocket> listeners);
+
+    /**
+     * @brief 接收 @c sendListeners 发送的监听套接字，句柄均设置了 close-on-exec
+     */
+    ListenSockets receiveListeners(const Socket& channel);
+
+    /**
+     * @brief 接收 systemd 风格的套接字激活传入的句柄
+     * @details 读取 @c LISTEN_PID 、@c LISTEN_FDS 与 @c LISTEN_FDNAMES ，句柄从3开始;
+     * 读取后清除这些环境变量，避免再传给子进程
+     */
+    ListenSockets inheritedListeners();
+
+    /**
+     * @brief 从继承的套接字中认领 @p endpoint 对应的监听套接字，没有时新建并监听
+     */
+    Socket takeListener(ListenSockets& inherited, const Endpoint& endpoint);
+
+    /**
+     * @brief 连接计数与排空
+     * @details 旧实例交出监听套接字后调用 @c start ，已有连接在完成当前请求后应关闭
+     * (不再 keep-alive)，@c wait 等待所有连接结束或超时。所有方法都是线程安全的。
+     */
+    struct Drainer {
+    private:
+        mutable std::mutex mutex_;
+
+        std::condition_variable idle_;
+
+        std::size_t active_ = 0;
+
+        bool draining_ = false;
+
+    public:
+        /**
+         * @brief 连接存活期间持有的守卫
+         */
+        struct Guard {
+        private:
+            Drainer* drainer_;
+
+        public:
+            explicit Guard(Drainer& drainer);
+
+            ~Guard();
+
+            Guard(Guard&& other) noexcept;
+            Guard(const Guard&) = delete;
+
+            Guard& operator=(Guard&&)      = delete;
+            Guard& operator=(const Guard&) = delete;
+        };
+
+        [[nodiscard]] Guard track();
+
+        void start();
+
+        [[nodiscard]] bool draining() const;
+
+        [[nodiscard]] std::size_t active() const;
+
+        /**
+         * @return 所有连接已结束时返回 true，超时返回 false
+         */
+        bool wait(std::chrono::milliseconds timeout);
+    };
+
+    /**
+     * @brief 零停机热重启
+     * @details 流程:
+     * 1. 旧实例调用 @c serve 在控制端点上等待;
+     * 2. 旧实例用 @c spawn 启动新的二进制，新实例调用 @c acquire 取得监听套接字，
+     *    此时两个实例共享同一个监听队列，积压的连接不会丢失;
+     * 3. 新实例开始接受连接后调用 @c ready ，旧实例随即收到 @c onHandoff 回调，
+     *    停止接受连接并排空已有连接后退出;
+     * 4. 新实例再调用 @c serve ，为下一次升级做准备。
+     * 若新实例在 @c ready 之前退出，旧实例重新监听控制端点并继续服务。
+     * 控制端点只接受与本进程有效用户相同的对端，其他用户的连接被直接关闭。
+     */
+    struct HotRestart {
+    public:
+        using HandoffCallback = std::function<void()>;
+
+    private:
+        Endpoint control_;
+
+        /// 新实例到旧实例的连接，@c ready 之后关闭
+        Socket channel_;
+
+        /// 旧实例的控制监听套接字
+        Socket listener_;
+
+        /// 旧实例上等待新实例确认的连接
+        Socket peer_;
+
+        async::Reactor* reactor_ = nullptr;
+
+        std::span<const ListenSocket> listeners_;
+
+        HandoffCallback onHandoff_;
+
+    public:
+        /**
+         * @param control 控制端点，通常为抽象命名空间中的 Unix 域套接字
+         */
+        explicit HotRestart(Endpoint control);
+
+        ~HotRestart();
+
+        HotRestart(const HotRestart&)            = delete;
+        HotRestart& operator=(const HotRestart&) = delete;
+
+        /**
+         * @brief 新实例启动时取得监听套接字
+         * @details 依次尝试 systemd 套接字激活与控制端点上的旧实例，都没有时返回空，
+         * 由调用者自行绑定
+         */
+        ListenSockets acquire();
+
+        /**
+         * @brief 通知旧实例新实例已开始接受连接
+         */
+        void ready();
+
+        /**
+         * @brief 在 @p reactor 上监听控制端点，等待下一个实例
+         * @param listeners 要交出的监听套接字，必须在本对象生命周期内有效
+         * @param onHandoff 新实例确认后在 @p reactor 线程中调用
+         */
+        void serve(
+            async::Reactor& reactor, std::span<const ListenSocket> listeners,
+            HandoffCallback onHandoff
+        );
+
+        /**
+         * @brief 启动新的二进制
+         * @details 按 @p argv[0] 重新查找可执行文件，而非 @c /proc/self/exe ，
+         * 后者在二进制被替换后仍指向旧文件。@c Socket 创建与接受的句柄都带 close-on-exec，
+         * 新实例不会继承客户端连接
+         * @return 子进程ID
+         */
+        static pid_t spawn(char* const argv[]);
+
+    private:
+        void listen();
+
+        void onAccept();
+
+        void onPeer(async::EventType events);
+
+        void closePeer();
+    };
+
+}  // namespace tiny_web_server::net
+
+#endif  // TINY_WEB_SERVER_HANDOFF_HPP
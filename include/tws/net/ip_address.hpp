@@ -17,6 +17,7 @@
 #define TINY_WEB_SERVER_IP_ADDRESS_HPP
 #pragma once
 
+#include <optional>
 #include <span>
 #include <string>
 #include <variant>
@@ -38,10 +39,27 @@ namespace tiny_web_server::net {
 
         IpAddress(std::span<const std::byte> bytes, bool ipv6 = false);
 
+        /**
+         * @brief 解析 IPv4 或 IPv6 字面量(允许 [::1] 形式)，不抛出异常
+         * @return 不是合法的地址字面量(如主机名)时返回空
+         */
+        static std::optional<IpAddress> tryParse(std::string_view str);
+
         [[nodiscard]] std::string toString() const;
 
         [[nodiscard]] std::vector<std::byte> toBytes() const;
 
+        /**
+         * @brief 网络字节序的原始地址(4或16字节)，不分配内存
+         */
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept;
+
+        /**
+         * @brief 只保留前 @p prefixLength 位的网络地址，如 203.0.113.7 取 /24 得 203.0.113.0
+         * @details IPv4 映射的 IPv6 地址(::ffff:a.b.c.d)按其 IPv4 地址处理
+         */
+        [[nodiscard]] IpAddress masked(int prefixLength) const;
+
         [[nodiscard]] bool isIPv4() const noexcept;
 
         [[nodiscard]] bool isIPv6() const noexcept;
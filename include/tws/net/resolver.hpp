@@ -0,0 +1,175 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file resolver.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 23:55
+ * @brief 非阻塞主机名解析
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_RESOLVER_HPP
+#define TINY_WEB_SERVER_RESOLVER_HPP
+#pragma once
+
+#include <functional>
+#include <random>
+
+#include "../async/reactor.hpp"
+#include "dns.hpp"
+#include "socket.hpp"
+
+namespace tiny_web_server::net {
+
+    struct ResolverOptions {
+        /// 名称服务器，按顺序轮换重试
+        std::vector<Endpoint> nameservers;
+
+        /// 单次查询的超时
+        std::chrono::milliseconds timeout = std::chrono::seconds(5);
+
+        /// 每个名称服务器的尝试次数
+        int attempts = 2;
+
+        HostsFile hosts;
+
+        /// 是否同时查询 AAAA 记录
+        bool ipv6 = true;
+
+        /// 收到 A 应答后等待 AAAA 应答的最长时间(RFC 8305 的 Resolution Delay)
+        std::chrono::milliseconds resolutionDelay{50};
+
+        /// 否定应答不带 SOA 时的缓存时长
+        std::chrono::seconds negativeTtl{30};
+
+        /// 缓存时长的上限，超过的 TTL 被截短
+        std::chrono::seconds maxTtl{3600};
+
+        /**
+         * @brief 读取 /etc/resolv.conf 与 /etc/hosts
+         */
+        static ResolverOptions system();
+    };
+
+    /**
+     * @brief 运行在反应器线程中的非阻塞主机名解析器
+     * @details 依次查找地址字面量、hosts 表与共享缓存，都未命中时通过 UDP 同时发出 A 与 AAAA
+     * 查询。同一名称的并发解析合并为一次查询。结果按 Happy Eyeballs 排列(IPv6 在前、交替)，
+     * 并按 TTL 写入缓存; 名称不存在也会被缓存。截断的应答按服务器失败处理，不回退到 TCP。
+     * 每次发出查询(含重传)都使用新的 UDP 套接字、随机源端口与随机 ID(RFC 5452)，
+     * 只接受来自该名称服务器、ID 与问题都匹配的应答。
+     * 超时与重传由 @c expire 驱动，应由所属线程周期性调用。所有方法只能在反应器线程中调用。
+     */
+    struct Resolver {
+    public:
+        using Clock = DnsCache::Clock;
+
+        /**
+         * @brief 解析完成回调，成功时 @p endpoints 非空
+         */
+        using Callback =
+            std::function<void(std::error_code error, std::vector<Endpoint> endpoints)>;
+
+    private:
+        /// 下标 0 为 A 查询，1 为 AAAA 查询
+        struct Lookup {
+            std::string name;
+
+            std::vector<std::pair<std::uint16_t, Callback>> waiters;
+
+            std::uint16_t ids[2]{};
+
+            /// 各地址族当前查询的套接字，已连接到本次尝试的名称服务器
+            Socket sockets[2];
+
+            bool done[2]{};
+
+            std::vector<IpAddress> addresses[2];
+
+            std::optional<std::uint32_t> ttl;
+
+            bool notFound = false;
+
+            bool failed = false;
+
+            std::size_t server = 0;
+
+            int attempt = 0;
+
+            /// 本次尝试的超时时刻
+            Clock::time_point deadline;
+
+            /// 只剩 AAAA 未应答时的最晚完成时刻
+            std::optional<Clock::time_point> delayUntil;
+        };
+
+        async::Reactor& reactor_;
+
+        ResolverOptions options_;
+
+        DnsCache& cache_;
+
+        std::unordered_map<std::string, Lookup> lookups_;
+
+        std::mt19937 random_;
+
+    public:
+        explicit Resolver(
+            async::Reactor& reactor, ResolverOptions options = ResolverOptions::system(),
+            DnsCache& cache = DnsCache::global()
+        );
+
+        ~Resolver();
+
+        Resolver(const Resolver&)            = delete;
+        Resolver& operator=(const Resolver&) = delete;
+
+        /**
+         * @brief 解析主机名
+         * @details 命中字面量、hosts 表或缓存时在调用返回前同步执行回调
+         */
+        void resolve(std::string_view host, std::uint16_t port, Callback callback);
+
+        /**
+         * @brief 解析 @c host:port 或 @c [ipv6]:port
+         * @throw SocketError 格式错误时
+         */
+        void resolve(std::string_view hostPort, Callback callback);
+
+        /**
+         * @brief 处理超时、重传与 AAAA 等待，返回下一次需要调用的时刻
+         * @return 没有进行中的查询时返回空
+         */
+        std::optional<Clock::time_point> expire(Clock::time_point now = Clock::now());
+
+        [[nodiscard]] std::size_t pending() const noexcept;
+
+    private:
+        /**
+         * @brief 以新的 ID 与套接字向当前名称服务器发送尚未应答的查询
+         */
+        void send(Lookup& lookup, Clock::time_point now);
+
+        /**
+         * @brief 创建绑定随机源端口、连接到 @p server 的套接字并加入反应器
+         */
+        Socket open(const std::string& name, int family, std::size_t server);
+
+        /**
+         * @brief 从反应器移除并关闭一个地址族的套接字
+         */
+        void close(Lookup& lookup, int family);
+
+        void readable(const std::string& name, int family);
+
+        void finish(const std::string& name);
+    };
+
+}  // namespace tiny_web_server::net
+
+#endif  // TINY_WEB_SERVER_RESOLVER_HPP
@@ -17,12 +17,50 @@
 #define TINY_WEB_SERVER_SOCKET_HPP
 #pragma once
 
+#include <chrono>
+#include <optional>
+#include <system_error>
+#include <utility>
+
 #include "../platform.hpp"
 #include "endpoint.hpp"
 #include "enums.hpp"
 
 namespace tiny_web_server::net {
 
+    /**
+     * @brief Unix域套接字对端进程的身份(SO_PEERCRED)，取自对端 connect 时的凭据
+     */
+    struct PeerCredentials {
+        std::int32_t pid;
+
+        std::uint32_t uid;
+
+        std::uint32_t gid;
+    };
+
+    /**
+     * @brief TCP 连接的网络状况(TCP_INFO)
+     */
+    struct TcpInfo {
+        /// 平滑往返时间
+        std::chrono::microseconds rtt;
+
+        std::chrono::microseconds rttVariance;
+
+        /// 连接建立以来的重传报文段总数
+        std::uint32_t retransmits;
+
+        /// 拥塞窗口，以报文段计
+        std::uint32_t congestionWindow;
+
+        /// 最近的交付速率(字节/秒)，内核不支持时为 0
+        std::uint64_t deliveryRate;
+
+        /// 已发送未确认的字节数(按 MSS 估算)
+        std::uint64_t unackedBytes;
+    };
+
     struct Socket {
     private:
         socket_t handle_ = NET_INVALID_SOCKET;
@@ -31,12 +69,19 @@ namespace tiny_web_server::net {
 
         struct Options {
             bool reuse_address      = false;
+            bool reuse_port         = false;
             bool no_delay           = false;
             bool keep_alive         = false;
             int receive_timeout_ms  = 0;
             int send_timeout_ms     = 0;
             int receive_buffer_size = 0;
             int send_buffer_size    = 0;
+            /// 阻塞接收与 poll 时忙轮询网卡队列的微秒数(SO_BUSY_POLL)
+            int busy_poll_us        = 0;
+            /// 每次忙轮询处理的数据包上限(SO_BUSY_POLL_BUDGET)，超过默认值需要 CAP_NET_ADMIN
+            int busy_poll_budget    = 0;
+            /// 优先以忙轮询处理网卡队列，减少中断(SO_PREFER_BUSY_POLL)
+            bool prefer_busy_poll   = false;
         };
 
     public:
@@ -60,12 +105,91 @@ namespace tiny_web_server::net {
 
         void connect(const Endpoint &endpoint) const;
 
+        /**
+         * @brief 非阻塞连接
+         * @return 立即连上时返回 true; 连接进行中(EINPROGRESS)时返回 false，
+         * 待套接字可写后以 @c error 检查结果
+         */
+        [[nodiscard]] bool tryConnect(const Endpoint &endpoint) const;
+
+        /**
+         * @brief 取出并清除套接字上挂起的错误(SO_ERROR)
+         */
+        [[nodiscard]] std::error_code error() const;
+
+        [[nodiscard]] Endpoint localEndpoint() const;
+
+        [[nodiscard]] Endpoint peerEndpoint() const;
+
+        /**
+         * @brief 仅适用于 Linux 上的 Unix 域套接字
+         */
+        [[nodiscard]] PeerCredentials peerCredentials() const;
+
+        /**
+         * @brief 读取 TCP_INFO，一次 getsockopt 调用
+         * @return 不是 TCP 套接字或平台不支持时返回空
+         */
+        [[nodiscard]] std::optional<TcpInfo> tcpInfo() const;
+
+        /**
+         * @brief 创建一对互相连接的 Unix 域套接字
+         * @param type @c STREAM 或 @c SEQPACKET
+         */
+        static std::pair<Socket, Socket> pair(SocketType type = SocketType::STREAM);
+
         [[nodiscard]] std::size_t recv(std::span<std::byte> buffer, int flags = 0) const;
 
         [[nodiscard]] std::size_t send(std::span<const std::byte> data, int flags = 0) const;
 
+        /**
+         * @brief 非阻塞接收
+         * @return 套接字暂无数据(EAGAIN/EWOULDBLOCK)时返回空，对端关闭时返回0
+         */
+        [[nodiscard]] std::optional<std::size_t>
+        tryRecv(std::span<std::byte> buffer, int flags = 0) const;
+
+        /**
+         * @brief 非阻塞发送
+         * @return 发送缓冲区已满(EAGAIN/EWOULDBLOCK)时返回空
+         */
+        [[nodiscard]] std::optional<std::size_t>
+        trySend(std::span<const std::byte> data, int flags = 0) const;
+
+        /**
+         * @brief 非阻塞的向量化发送，多个缓冲区合并为一次系统调用
+         * @details 单次最多提交前 64 个缓冲区
+         * @return 发送缓冲区已满(EAGAIN/EWOULDBLOCK)时返回空
+         */
+        [[nodiscard]] std::optional<std::size_t>
+        trySend(std::span<const std::span<const std::byte>> buffers) const;
+
+        /**
+         * @brief 零拷贝发送文件的一段
+         * @param file 文件描述符
+         * @param offset 文件内偏移，不影响文件描述符自身的读写位置
+         * @return 实际发送的字节数，可能小于 @p count
+         */
+        [[nodiscard]] std::size_t
+        sendFile(int file, std::uint64_t offset, std::size_t count) const;
+
         void setOptions(const Options &opts) const;
 
+        /**
+         * @brief 最后处理该连接入站数据包的 CPU(SO_INCOMING_CPU)，通常即网卡接收队列中断所在的 CPU
+         * @return 不支持或尚无数据包时返回空
+         */
+        [[nodiscard]] std::optional<int> incomingCpu() const;
+
+        /**
+         * @brief 令 SO_REUSEPORT 组按接收 CPU 分发新连接: CPU @c cpus[i] 上到达的连接交给组内
+         * 第 i 个套接字(按绑定顺序)，其他 CPU 上到达的连接仍由内核按哈希分发
+         * @details 组内任一监听套接字上设置即可，附加 cBPF 程序(SO_ATTACH_REUSEPORT_CBPF)。
+         * @p cpus 应为各监听线程所绑定的 CPU，连接就在其数据包到达的 CPU 上处理。仅适用于 Linux
+         * @throw SocketError @p cpus 为空、含负数或重复的 CPU 时
+         */
+        void steerByIncomingCpu(std::span<const int> cpus) const;
+
         void setNonBlocking(bool nonBlocking = true) const;
 
         void close();
@@ -74,6 +198,16 @@ namespace tiny_web_server::net {
 
         [[nodiscard]] socket_t nativeHandle() const noexcept;
 
+        /**
+         * @brief 接管一个已存在的套接字句柄，如继承自父进程或通过 SCM_RIGHTS 接收的句柄
+         */
+        static Socket adopt(socket_t handle) noexcept;
+
+        /**
+         * @brief 放弃句柄的所有权，析构时不再关闭
+         */
+        [[nodiscard]] socket_t release() noexcept;
+
     private:
         Socket(socket_t&& handle);
 
@@ -0,0 +1,119 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file tcp_telemetry.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 03:05
+ * @brief 按客户端网段统计的 TCP 网络状况
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_TCP_TELEMETRY_HPP
+#define TINY_WEB_SERVER_TCP_TELEMETRY_HPP
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "../metrics/metrics.hpp"
+#include "socket.hpp"
+
+namespace tiny_web_server::net {
+
+    struct TcpTelemetryOptions {
+        /// 每多少个连接采样一个，1 表示全部采样，0 表示关闭
+        std::uint32_t sampleEvery = 16;
+
+        int ipv4PrefixLength = 24;
+
+        int ipv6PrefixLength = 48;
+
+        /// 分别统计的网段数上限，之后出现的网段计入 prefix="other"
+        std::size_t maxPrefixes = 64;
+    };
+
+    /**
+     * @brief 按客户端网段汇总被采样连接的 TCP_INFO
+     * @details 延迟升高时用于区分服务端变慢与客户端网络变差: 同一网段的往返时间与重传同时上升
+     * 说明问题在网络侧。连接建立时以 @c probe 决定是否采样并确定所属网段(一次加锁查表)，
+     * 之后每次 @c Probe::sample 只有一次 getsockopt 与几次分片计数，不加锁。
+     * 导出 tws_client_rtt_seconds、tws_client_rtt_variance_seconds 直方图
+     * 与 tws_client_retransmits_total、tws_client_tcp_samples_total 计数器，均带 prefix 标签。
+     * 所有方法都是线程安全的。
+     */
+    struct TcpTelemetry {
+    private:
+        struct Series {
+            metrics::Histogram& rtt;
+
+            metrics::Histogram& rttVariance;
+
+            metrics::Counter& retransmits;
+
+            metrics::Counter& samples;
+        };
+
+        TcpTelemetryOptions options_;
+
+        metrics::Registry& registry_;
+
+        std::atomic<std::uint64_t> connections_ = 0;
+
+        mutable std::mutex mutex_;
+
+        /// 网段 -> 指标; 元素地址在生命周期内不变
+        std::unordered_map<std::string, std::unique_ptr<Series>> series_;
+
+    public:
+        /**
+         * @brief 一个被采样连接的句柄，随连接保存
+         */
+        struct Probe {
+        private:
+            const Series* series_;
+
+            /// 上次采样时的重传总数，计数器只累加增量
+            std::uint32_t retransmits_ = 0;
+
+        public:
+            explicit Probe(const Series& series) noexcept;
+
+            /**
+             * @brief 读取一次 TCP_INFO 并记入所属网段
+             * @return 读取失败(如连接已关闭)时返回空
+             */
+            std::optional<TcpInfo> sample(const Socket& socket);
+        };
+
+        explicit TcpTelemetry(
+            const TcpTelemetryOptions& options = {},
+            metrics::Registry& registry        = metrics::Registry::global()
+        );
+
+        /**
+         * @brief 为新连接决定是否采样
+         * @param client 对端地址
+         * @return 不采样时返回空
+         */
+        std::optional<Probe> probe(const IpAddress& client);
+
+        /**
+         * @brief 客户端所属网段的标签值，如 "203.0.113.0/24"
+         */
+        [[nodiscard]] std::string prefix(const IpAddress& client) const;
+
+    private:
+        const Series& series(const std::string& prefix);
+    };
+
+}  // namespace tiny_web_server::net
+
+#endif  // TINY_WEB_SERVER_TCP_TELEMETRY_HPP
@@ -0,0 +1,240 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file upstream.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 03:40
+ * @brief 后端负载均衡与异常摘除
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_UPSTREAM_HPP
+#define TINY_WEB_SERVER_UPSTREAM_HPP
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "endpoint.hpp"
+
+namespace tiny_web_server::net {
+
+    enum class BalancePolicy {
+        ROUND_ROBIN,
+        /// 进行中请求最少
+        LEAST_OUTSTANDING,
+        /// 随机取两个，选进行中请求较少的一个
+        POWER_OF_TWO,
+        /// 有界负载的一致性哈希
+        CONSISTENT_HASH
+    };
+
+    struct UpstreamOptions {
+        BalancePolicy policy = BalancePolicy::POWER_OF_TWO;
+
+        /// 一致性哈希环上每个后端的虚拟节点数
+        std::size_t virtualNodes = 100;
+
+        /// 有界负载: 后端的进行中请求不超过平均值的此倍数，超出时沿哈希环顺延
+        double loadFactor = 1.25;
+
+        /// 连续失败达到此次数时立即摘除，0 表示不检测
+        std::uint32_t consecutiveErrors = 5;
+
+        /// 一个统计周期内请求数达到此值的后端才参与错误率与延迟检测
+        std::uint64_t minRequests = 20;
+
+        /// 周期内错误率超过此值时摘除
+        double maxErrorRate = 0.5;
+
+        /// 周期内平均延迟超过各后端平均延迟中位数的此倍数时摘除，0 表示不检测
+        double latencyFactor = 3.0;
+
+        /// 首次摘除的时长，之后每次再被摘除按次数倍增
+        std::chrono::milliseconds baseEjection = std::chrono::seconds(30);
+
+        std::chrono::milliseconds maxEjection = std::chrono::minutes(5);
+
+        /// 同时被摘除的后端比例上限
+        double maxEjectedRatio = 0.5;
+    };
+
+    struct UpstreamSelector;
+
+    /**
+     * @brief 一组后端及其共享的健康状态
+     * @details 选择在各线程自己的 @c UpstreamSelector 中进行，只读取这里的原子摘除标记，
+     * 不加锁。各线程的请求结果写入自己的统计窗口，由 @c aggregate 周期性汇总(建议每秒一次，
+     * 任一线程调用): 周期内错误率过高，或平均延迟远高于各后端中位数的后端被摘除一段时间，
+     * 再次被摘除时时长倍增，健康的周期逐步抵消倍数。连续失败则由选择器当场摘除。
+     * 被摘除的后端比例不超过上限; 全部不可用时忽略摘除状态。
+     */
+    struct Upstream {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        friend struct UpstreamSelector;
+
+        /// 后端的健康状态，各占一条缓存行
+        struct alignas(64) Backend {
+            std::atomic<bool> ejected = false;
+
+            /// 以下只在 @c aggregate 中访问; 选择器摘除的后端在下次汇总时才确定恢复时间
+            Clock::time_point ejectedUntil{};
+
+            std::uint32_t ejections = 0;
+        };
+
+        /// 各后端的累计结果，只由所属线程写入
+        struct alignas(64) Stats {
+            std::atomic<std::uint64_t> requests = 0;
+
+            std::atomic<std::uint64_t> errors = 0;
+
+            std::atomic<std::uint64_t> latency = 0;
+        };
+
+        /// 一个线程的统计窗口
+        struct Window {
+            std::unique_ptr<Stats[]> stats;
+
+            /// 上次汇总时的累计值，只在 @c aggregate 中访问
+            std::vector<std::array<std::uint64_t, 3>> previous;
+
+            /// 选择器已销毁，最后一次汇总后即可移除
+            std::atomic<bool> retired = false;
+        };
+
+        UpstreamOptions options_;
+
+        std::vector<Endpoint> endpoints_;
+
+        std::size_t size_;
+
+        std::unique_ptr<Backend[]> backends_;
+
+        /// 一致性哈希环: (哈希值, 后端下标)，按哈希值排序
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> ring_;
+
+        std::atomic<std::size_t> ejectedCount_ = 0;
+
+        mutable std::mutex mutex_;
+
+        /// 选择器销毁后其窗口在下次汇总时移除
+        std::vector<std::shared_ptr<Window>> windows_;
+
+    public:
+        explicit Upstream(
+            const std::vector<Endpoint>& backends, const UpstreamOptions& options = {}
+        );
+
+        Upstream(const Upstream&)            = delete;
+        Upstream& operator=(const Upstream&) = delete;
+
+        /**
+         * @brief 汇总各线程的统计，执行异常检测并恢复摘除到期的后端
+         */
+        void aggregate(Clock::time_point now = Clock::now());
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] const Endpoint& endpoint(std::size_t index) const noexcept;
+
+        [[nodiscard]] bool isEjected(std::size_t index) const noexcept;
+
+        [[nodiscard]] const UpstreamOptions& options() const noexcept;
+
+    private:
+        /**
+         * @brief 在比例上限内摘除后端
+         * @return 本次调用摘除了该后端时返回 true
+         */
+        bool eject(std::size_t index) noexcept;
+
+        std::shared_ptr<Window> registerWindow();
+    };
+
+    /**
+     * @brief 单个线程的后端选择器
+     * @details 进行中请求数与轮询位置都是线程本地的，选择路径不加锁、不做原子读改写;
+     * 最少请求与有界负载据此按本线程的负载决策。只能在创建它的线程中使用。
+     */
+    struct UpstreamSelector {
+    private:
+        Upstream& upstream_;
+
+        std::shared_ptr<Upstream::Window> window_;
+
+        std::vector<std::uint32_t> outstanding_;
+
+        std::uint32_t totalOutstanding_ = 0;
+
+        std::vector<std::uint32_t> consecutiveErrors_;
+
+        std::size_t next_ = 0;
+
+        std::mt19937 random_;
+
+    public:
+        explicit UpstreamSelector(Upstream& upstream);
+
+        ~UpstreamSelector();
+
+        UpstreamSelector(const UpstreamSelector&)            = delete;
+        UpstreamSelector& operator=(const UpstreamSelector&) = delete;
+
+        /**
+         * @brief 按策略选择后端并计入进行中请求，之后必须以 @c complete 结束
+         * @param key 一致性哈希的键，其他策略忽略
+         * @return 后端下标; 没有后端时返回空
+         */
+        std::optional<std::size_t> select(std::uint64_t key = 0);
+
+        /**
+         * @brief 以客户端地址(@c IpAddress::hash)为键选择，同一客户端落在同一后端
+         */
+        std::optional<std::size_t> select(const IpAddress& client);
+
+        /**
+         * @brief 以请求中的键(如会话标识或路径)选择
+         */
+        std::optional<std::size_t> select(std::string_view key);
+
+        /**
+         * @brief 请求结束: 释放进行中计数并记录结果
+         * @param success 连接失败、超时或 5xx 视为失败
+         */
+        void complete(std::size_t backend, bool success, std::chrono::nanoseconds latency);
+
+        [[nodiscard]] std::uint32_t outstanding(std::size_t backend) const noexcept;
+
+    private:
+        /**
+         * @param all 为 true 时忽略摘除状态
+         */
+        [[nodiscard]] bool usable(std::size_t backend, bool all) const noexcept;
+
+        std::optional<std::size_t> leastOutstanding(bool all);
+
+        std::optional<std::size_t> powerOfTwo(bool all);
+
+        std::optional<std::size_t> consistentHash(std::uint64_t key, bool all);
+
+        std::size_t acquire(std::size_t backend) noexcept;
+    };
+
+}  // namespace tiny_web_server::net
+
+#endif  // TINY_WEB_SERVER_UPSTREAM_HPP
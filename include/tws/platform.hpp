@@ -56,6 +56,7 @@
     #include <winsock2.h>
     #include <ws2tcpip.h>
     #include <mswsock.h>
+    #include <afunix.h>
 
     #ifdef __MINGW32__
         #ifdef ULONG
@@ -82,8 +83,12 @@
     #include <arpa/inet.h>
     #include <fcntl.h>
     #include <netinet/in.h>
+    #include <netinet/tcp.h>
     #include <sys/epoll.h>
+    #include <sys/sendfile.h>
     #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
     #include <unistd.h>
     #include <liburing.h>
 
@@ -175,6 +180,20 @@
  */
     #define ssize_t SSIZE_T
 
+    /** @def NET_NOSIGNAL
+     *
+     * @if zh
+     * @brief 发送时不产生 SIGPIPE
+     * @details Windows 没有 SIGPIPE，定义为 @c 0
+     *
+     * @else
+     * @brief Do not raise SIGPIPE on send
+     * @details Windows has no SIGPIPE, define as @c 0
+     *
+     * @endif
+     */
+    #define NET_NOSIGNAL 0
+
 #else
 
     /** @def NET_ERROR
@@ -233,6 +252,40 @@
      */
     using socket_t = int;
 
+    /** @def NET_NOSIGNAL
+     *
+     * @if zh
+     * @brief 发送时不产生 SIGPIPE
+     * @details 定义为 @c MSG_NOSIGNAL
+     *
+     * @else
+     * @brief Do not raise SIGPIPE on send
+     * @details Define as @c MSG_NOSIGNAL
+     *
+     * @endif
+     */
+    #define NET_NOSIGNAL MSG_NOSIGNAL
+
+#endif
+
+/**
+ * @if zh
+ * @brief 可选依赖检测
+ * @details 由构建系统在找到对应库时定义为 1
+ *
+ * @else
+ * @brief Optional dependency detection
+ * @details Defined as 1 by the build system when the library is found
+ *
+ * @endif
+ */
+
+#ifndef WEB_SERVER_HAS_BROTLI
+    #define WEB_SERVER_HAS_BROTLI 0
+#endif
+
+#ifndef WEB_SERVER_HAS_ZSTD
+    #define WEB_SERVER_HAS_ZSTD 0
 #endif
 
 /// @}
@@ -0,0 +1,100 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file arena.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:40
+ * @brief 请求级单调内存池
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_ARENA_HPP
+#define TINY_WEB_SERVER_ARENA_HPP
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+
+namespace tiny_web_server {
+
+    /**
+     * @brief 单调(bump)内存池
+     * @details 作为 @c std::pmr::memory_resource 供解析器与响应构建器的 pmr 容器使用;
+     * 分配只移动指针，释放为空操作，请求结束时 @c reset 一次性回收。
+     * 先使用构造时给定的内联缓冲区，用尽后从线程局部的块池取定长块，
+     * 超过块大小四分之一的分配单独向全局分配器申请。非线程安全。
+     */
+    struct Arena : std::pmr::memory_resource {
+    public:
+        static constexpr std::size_t BLOCK_SIZE = 16 * 1024;
+
+    private:
+        struct Block {
+            Block* next;
+
+            std::size_t size;
+        };
+
+        std::span<std::byte> initial_;
+
+        std::byte* cursor_;
+
+        std::byte* end_;
+
+        /// 从块池取得的定长块，最新的在前
+        Block* blocks_ = nullptr;
+
+        Block* lastBlock_ = nullptr;
+
+        std::size_t blockCount_ = 0;
+
+        /// 单独申请的大块
+        Block* large_ = nullptr;
+
+        std::size_t allocated_ = 0;
+
+    public:
+        Arena() noexcept;
+
+        /**
+         * @param initial 内联缓冲区，通常位于连接对象或栈上，必须比本对象存活更久
+         */
+        explicit Arena(std::span<std::byte> initial) noexcept;
+
+        ~Arena() override;
+
+        Arena(const Arena&)            = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * @brief 回收全部内存; 在此之前分配的对象必须已不再使用
+         * @details 定长块整串交还块池，耗时与分配次数无关
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief 上次 @c reset 以来分配的字节数
+         */
+        [[nodiscard]] std::size_t allocated() const noexcept;
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void do_deallocate(void*, std::size_t, std::size_t) noexcept override {}
+
+        [[nodiscard]] bool
+        do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        void* allocateLarge(std::size_t bytes, std::size_t alignment);
+    };
+
+}  // namespace tiny_web_server
+
+#endif  // TINY_WEB_SERVER_ARENA_HPP
@@ -0,0 +1,37 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file base64.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 14:10
+ * @brief Base64 编解码
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_BASE64_HPP
+#define TINY_WEB_SERVER_BASE64_HPP
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace tiny_web_server {
+
+    [[nodiscard]] std::string base64Encode(std::span<const std::byte> data);
+
+    /**
+     * @brief 解码 Base64，同时接受标准与 URL 安全字母表，结尾的填充可以省略
+     * @return 含非法字符或长度不合法时返回空
+     */
+    [[nodiscard]] std::optional<std::vector<std::byte>> base64Decode(std::string_view text);
+
+}  // namespace tiny_web_server
+
+#endif  // TINY_WEB_SERVER_BASE64_HPP
@@ -0,0 +1,66 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file hash.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 10:12
+ * @brief 内容哈希
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_HASH_HPP
+#define TINY_WEB_SERVER_HASH_HPP
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace tiny_web_server {
+
+    /**
+     * @brief 64位内容哈希
+     * @details 每次处理8字节的乘法-旋转哈希(xxh64风格)，用于缓存键而非安全用途。
+     */
+    inline std::uint64_t
+    contentHash(const std::span<const std::byte> data, const std::uint64_t seed = 0) {
+        constexpr std::uint64_t P1 = 0x9E3779B185EBCA87ULL;
+        constexpr std::uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr std::uint64_t P3 = 0x165667B19E3779F9ULL;
+
+        std::uint64_t hash = seed + P3 + data.size();
+
+        const auto* ptr = data.data();
+        auto remain     = data.size();
+
+        for (; remain >= 8; ptr += 8, remain -= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, ptr, 8);
+
+            hash ^= std::rotl(word * P2, 31) * P1;
+            hash = std::rotl(hash, 27) * P1 + P3;
+        }
+
+        for (; remain > 0; ++ptr, --remain) {
+            hash ^= static_cast<std::uint64_t>(*ptr) * P3;
+            hash = std::rotl(hash, 11) * P1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= P2;
+        hash ^= hash >> 29;
+        hash *= P3;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+
+}  // namespace tiny_web_server
+
+#endif  // TINY_WEB_SERVER_HASH_HPP
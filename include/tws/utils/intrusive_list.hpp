@@ -0,0 +1,155 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file intrusive_list.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:10
+ * @brief 侵入式双向链表
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_INTRUSIVE_LIST_HPP
+#define TINY_WEB_SERVER_INTRUSIVE_LIST_HPP
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+namespace tiny_web_server {
+
+    /**
+     * @brief 链表节点，由元素类型继承
+     * @tparam Tag 区分同一元素所在的多个链表
+     */
+    template<typename Tag = void>
+    struct ListHook {
+    private:
+        template<typename, typename>
+        friend struct IntrusiveList;
+
+        ListHook* prev_ = nullptr;
+
+        ListHook* next_ = nullptr;
+
+    public:
+        ListHook() = default;
+
+        ListHook(const ListHook&)            = delete;
+        ListHook& operator=(const ListHook&) = delete;
+
+        [[nodiscard]] bool isLinked() const noexcept { return next_ != nullptr; }
+    };
+
+    /**
+     * @brief 侵入式双向循环链表
+     * @details 不分配内存，也不拥有元素; 插入、删除均为 O(1)。元素析构前必须从链表中移除。
+     */
+    template<typename T, typename Tag = void>
+    struct IntrusiveList {
+    private:
+        using Hook = ListHook<Tag>;
+
+        /// 哨兵节点
+        Hook head_;
+
+        std::size_t size_ = 0;
+
+    public:
+        struct Iterator {
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = T*;
+            using reference         = T&;
+
+            Hook* node;
+
+            T& operator*() const noexcept { return owner(node); }
+
+            T* operator->() const noexcept { return &owner(node); }
+
+            Iterator& operator++() noexcept {
+                node = node->next_;
+                return *this;
+            }
+
+            Iterator& operator--() noexcept {
+                node = node->prev_;
+                return *this;
+            }
+
+            bool operator==(const Iterator&) const noexcept = default;
+        };
+
+        IntrusiveList() noexcept { head_.prev_ = head_.next_ = &head_; }
+
+        ~IntrusiveList() { clear(); }
+
+        IntrusiveList(const IntrusiveList&)            = delete;
+        IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+        void pushBack(T& value) noexcept { insert(head_.prev_, value); }
+
+        void pushFront(T& value) noexcept { insert(&head_, value); }
+
+        void remove(T& value) noexcept {
+            Hook& hook = value;
+
+            hook.prev_->next_ = hook.next_;
+            hook.next_->prev_ = hook.prev_;
+            hook.prev_ = hook.next_ = nullptr;
+
+            --size_;
+        }
+
+        /**
+         * @brief 移到末尾，如按最近活动时间排序时刷新位置
+         */
+        void moveToBack(T& value) noexcept {
+            remove(value);
+            pushBack(value);
+        }
+
+        [[nodiscard]] T* front() const noexcept {
+            return empty() ? nullptr : &owner(head_.next_);
+        }
+
+        [[nodiscard]] T* back() const noexcept {
+            return empty() ? nullptr : &owner(head_.prev_);
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+        void clear() noexcept {
+            while (auto* value = front()) remove(*value);
+        }
+
+        Iterator begin() const noexcept { return {head_.next_}; }
+
+        Iterator end() const noexcept { return {const_cast<Hook*>(&head_)}; }
+
+    private:
+        void insert(Hook* after, T& value) noexcept {
+            Hook& hook = value;
+
+            hook.prev_          = after;
+            hook.next_          = after->next_;
+            after->next_->prev_ = &hook;
+            after->next_        = &hook;
+
+            ++size_;
+        }
+
+        static T& owner(Hook* hook) noexcept { return static_cast<T&>(*hook); }
+    };
+
+}  // namespace tiny_web_server
+
+#endif  // TINY_WEB_SERVER_INTRUSIVE_LIST_HPP
@@ -0,0 +1,34 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file sha1.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 14:10
+ * @brief SHA-1 摘要
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_SHA1_HPP
+#define TINY_WEB_SERVER_SHA1_HPP
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace tiny_web_server {
+
+    /**
+     * @brief 计算 SHA-1 摘要
+     * @details 仅用于 WebSocket 握手等协议要求的场合，不应用于安全用途
+     */
+    [[nodiscard]] std::array<std::byte, 20> sha1(std::span<const std::byte> data);
+
+}  // namespace tiny_web_server
+
+#endif  // TINY_WEB_SERVER_SHA1_HPP
@@ -0,0 +1,185 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file slab.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:10
+ * @brief 定长对象池
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_SLAB_HPP
+#define TINY_WEB_SERVER_SLAB_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace tiny_web_server {
+
+    /**
+     * @brief 定长对象池
+     * @details 对象按块(slab)成批分配，块内每个槽位按缓存行对齐，地址在对象存活期间保持不变;
+     * 空闲槽位组成链表，分配与释放均为 O(1) 且不调用全局分配器(除扩容外)。
+     * 每个槽位带有代数计数，释放后递增，过期的句柄因此能被检测出来。
+     * 非线程安全，应每个线程(反应器)各持有一个。
+     * @tparam SlabSize 每块的槽位数
+     */
+    template<typename T, std::size_t SlabSize = 64>
+    struct Slab {
+    public:
+        struct Handle {
+            static constexpr auto INVALID = std::numeric_limits<std::uint32_t>::max();
+
+            std::uint32_t index = INVALID;
+
+            std::uint32_t generation = 0;
+
+            explicit operator bool() const noexcept { return index != INVALID; }
+
+            bool operator==(const Handle&) const noexcept = default;
+        };
+
+    private:
+        static constexpr std::size_t CACHE_LINE = 64;
+
+        struct alignas(std::max(alignof(T), CACHE_LINE)) Slot {
+            /// 必须为第一个成员，对象指针才能换算回槽位
+            alignas(T) std::byte storage[sizeof(T)];
+
+            std::uint32_t index;
+
+            std::uint32_t generation = 0;
+
+            /// 空闲时指向下一个空闲槽位
+            std::uint32_t nextFree = Handle::INVALID;
+
+            bool live = false;
+
+            T* object() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        std::vector<std::unique_ptr<Slot[]>> slabs_;
+
+        std::uint32_t freeHead_ = Handle::INVALID;
+
+        std::size_t size_ = 0;
+
+        std::size_t maxSize_;
+
+    public:
+        /**
+         * @param maxSize 最大对象数，0 表示不限制
+         */
+        explicit Slab(const std::size_t maxSize = 0)
+            : maxSize_(maxSize ? maxSize : Handle::INVALID - SlabSize) {}
+
+        ~Slab() {
+            for (auto& slab : slabs_)
+                for (std::size_t i = 0; i < SlabSize; ++i)
+                    if (slab[i].live) slab[i].object()->~T();
+        }
+
+        Slab(const Slab&)            = delete;
+        Slab& operator=(const Slab&) = delete;
+
+        /**
+         * @return 已达到容量上限时返回无效句柄
+         */
+        template<typename... Args>
+        Handle create(Args&&... args) {
+            if (size_ >= maxSize_) return {};
+
+            if (freeHead_ == Handle::INVALID) grow();
+
+            auto& slot = this->slot(freeHead_);
+
+            ::new (slot.storage) T(std::forward<Args>(args)...);
+
+            freeHead_ = slot.nextFree;
+            slot.live = true;
+            ++size_;
+
+            return {slot.index, slot.generation};
+        }
+
+        void destroy(const Handle handle) {
+            auto* slot = find(handle);
+            if (!slot) return;
+
+            slot->object()->~T();
+            slot->live = false;
+            ++slot->generation;
+
+            slot->nextFree = freeHead_;
+            freeHead_      = slot->index;
+            --size_;
+        }
+
+        /**
+         * @return 句柄已过期时返回空指针
+         */
+        [[nodiscard]] T* get(const Handle handle) noexcept {
+            auto* slot = find(handle);
+
+            return slot ? slot->object() : nullptr;
+        }
+
+        /**
+         * @brief 由池中对象的地址取得其句柄
+         */
+        [[nodiscard]] Handle handle(const T& object) const noexcept {
+            const auto& slot = reinterpret_cast<const Slot&>(object);
+
+            return {slot.index, slot.generation};
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+        [[nodiscard]] std::size_t maxSize() const noexcept { return maxSize_; }
+
+        [[nodiscard]] std::size_t capacity() const noexcept {
+            return slabs_.size() * SlabSize;
+        }
+
+    private:
+        Slot& slot(const std::uint32_t index) noexcept {
+            return slabs_[index / SlabSize][index % SlabSize];
+        }
+
+        Slot* find(const Handle handle) noexcept {
+            if (handle.index >= capacity()) return nullptr;
+
+            auto& slot = this->slot(handle.index);
+
+            return slot.live && slot.generation == handle.generation ? &slot : nullptr;
+        }
+
+        void grow() {
+            auto base = static_cast<std::uint32_t>(capacity());
+            auto slab = std::make_unique<Slot[]>(SlabSize);
+
+            // 逆序链入，使低地址的槽位先被使用
+            for (auto i = SlabSize; i-- > 0;) {
+                slab[i].index    = base + static_cast<std::uint32_t>(i);
+                slab[i].nextFree = freeHead_;
+                freeHead_        = slab[i].index;
+            }
+
+            slabs_.push_back(std::move(slab));
+        }
+    };
+
+}  // namespace tiny_web_server
+
+#endif  // TINY_WEB_SERVER_SLAB_HPP
@@ -0,0 +1,71 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file string.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 13:45
+ * @brief 协议文本处理的小工具
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_STRING_HPP
+#define TINY_WEB_SERVER_STRING_HPP
+#pragma once
+
+#include <string_view>
+
+namespace tiny_web_server {
+
+    /**
+     * @brief 去除首尾的空格与制表符(HTTP 中的 OWS)
+     */
+    constexpr std::string_view trim(std::string_view str) noexcept {
+        while (!str.empty() && (str.front() == ' ' || str.front() == '\t'))
+            str.remove_prefix(1);
+
+        while (!str.empty() && (str.back() == ' ' || str.back() == '\t'))
+            str.remove_suffix(1);
+
+        return str;
+    }
+
+    /**
+     * @brief ASCII 不区分大小写比较
+     */
+    constexpr bool iequals(std::string_view lhs, std::string_view rhs) noexcept {
+        if (lhs.size() != rhs.size()) return false;
+
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            auto l = lhs[i] >= 'A' && lhs[i] <= 'Z' ? lhs[i] | 0x20 : lhs[i];
+            auto r = rhs[i] >= 'A' && rhs[i] <= 'Z' ? rhs[i] | 0x20 : rhs[i];
+
+            if (l != r) return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 逐项遍历逗号分隔的列表，跳过空项
+     * @details 返回 @c false 时停止遍历
+     */
+    template<typename F>
+    constexpr void forEachListItem(std::string_view list, F&& func) {
+        while (!list.empty()) {
+            auto comma = list.find(',');
+            auto item  = trim(list.substr(0, comma));
+
+            list.remove_prefix(comma == std::string_view::npos ? list.size() : comma + 1);
+
+            if (!item.empty() && !func(item)) return;
+        }
+    }
+
+}  // namespace tiny_web_server
+
+#endif  // TINY_WEB_SERVER_STRING_HPP
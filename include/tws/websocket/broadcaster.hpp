@@ -0,0 +1,65 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file broadcaster.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 16:00
+ * @brief WebSocket 广播
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_WEBSOCKET_BROADCASTER_HPP
+#define TINY_WEB_SERVER_WEBSOCKET_BROADCASTER_HPP
+#pragma once
+
+#include <mutex>
+
+#include "connection.hpp"
+
+namespace tiny_web_server::websocket {
+
+    /**
+     * @brief 一次序列化、多连接扇出的广播器
+     * @details 订阅者按所属反应器分组; 每次广播只序列化一帧，并向每个反应器各投递一个任务，
+     * 在其线程内把同一帧的共享指针追加到该组所有连接的发送队列中。
+     * 已关闭的连接在下一次广播时被惰性移除。所有方法都是线程安全的。
+     */
+    struct Broadcaster {
+    private:
+        struct Group {
+            async::Reactor* reactor;
+
+            /// 只在 @c reactor 线程中访问
+            std::vector<std::weak_ptr<Connection>> members;
+
+            /// 正在进行的扇出层数; 非零时退订只置空成员，由最外层扇出结束后统一移除
+            std::size_t sending = 0;
+        };
+
+        mutable std::mutex mutex_;
+
+        std::vector<std::shared_ptr<Group>> groups_;
+
+    public:
+        void subscribe(const std::shared_ptr<Connection>& connection);
+
+        void unsubscribe(const std::shared_ptr<Connection>& connection);
+
+        void broadcast(Opcode opcode, std::span<const std::byte> payload);
+
+        void broadcast(Frame frame);
+
+    private:
+        std::shared_ptr<Group> group(async::Reactor& reactor);
+
+        static void run(async::Reactor& reactor, std::function<void()> task);
+    };
+
+}  // namespace tiny_web_server::websocket
+
+#endif  // TINY_WEB_SERVER_WEBSOCKET_BROADCASTER_HPP
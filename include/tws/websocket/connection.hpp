@@ -0,0 +1,153 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file connection.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 15:20
+ * @brief 反应器驱动的 WebSocket 连接
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_WEBSOCKET_CONNECTION_HPP
+#define TINY_WEB_SERVER_WEBSOCKET_CONNECTION_HPP
+#pragma once
+
+#include <deque>
+#include <functional>
+
+#include "../async/reactor.hpp"
+#include "../http/request.hpp"
+#include "../net/socket.hpp"
+#include "frame.hpp"
+
+namespace tiny_web_server::websocket {
+
+    struct ConnectionOptions {
+        /// 单条消息(含所有分片)的最大字节数，超出时以 1009 关闭
+        std::size_t maxMessageSize = 16 << 20;
+
+        /// 接收缓冲区的初始大小，放不下完整帧时按需增长
+        std::size_t receiveBufferSize = 64 << 10;
+
+        /// 待发送数据的上限，慢消费者超出后连接被直接关闭
+        std::size_t maxPendingBytes = 8 << 20;
+    };
+
+    /**
+     * @brief WebSocket 连接
+     * @details 帧在接收缓冲区内原地解析与去掩码; 未分片的消息以指向接收缓冲区的视图交给回调，
+     * 分片消息才会被拼接。Ping/Pong 与关闭握手由连接自身在反应器线程中处理，不经过回调。
+     * 除 @c reactor 外的所有方法只能在所属反应器的线程中调用。文本消息不做 UTF-8 校验。
+     */
+    struct Connection : std::enable_shared_from_this<Connection> {
+    public:
+        using MessageHandler =
+            std::function<void(Connection&, Opcode, std::span<const std::byte>)>;
+
+        using CloseHandler = std::function<void(Connection&, std::uint16_t code)>;
+
+    private:
+        struct Private {};
+
+        net::Socket socket_;
+
+        async::Reactor& reactor_;
+
+        ConnectionOptions options_;
+
+        MessageHandler onMessage_;
+
+        CloseHandler onClose_;
+
+        std::vector<std::byte> input_;
+
+        std::size_t inputBegin_ = 0;
+
+        std::size_t inputEnd_ = 0;
+
+        std::vector<std::byte> message_;
+
+        Opcode messageOpcode_ = Opcode::BINARY;
+
+        bool fragmented_ = false;
+
+        std::deque<Frame> output_;
+
+        std::size_t outputOffset_ = 0;
+
+        std::size_t pendingBytes_ = 0;
+
+        bool writing_ = false;
+
+        bool closeSent_ = false;
+
+        bool closeReceived_ = false;
+
+        std::uint16_t closeCode_ = 1005;
+
+        /// 套接字已关闭并已从反应器移除
+        bool closed_ = false;
+
+    public:
+        Connection(
+            Private, net::Socket socket, async::Reactor& reactor, MessageHandler onMessage,
+            const ConnectionOptions& options
+        );
+
+        /**
+         * @brief 完成升级握手并把套接字交给反应器
+         * @param rest 接收缓冲区中紧跟请求头之后、已被读走的字节
+         * @throw HttpError 当请求不是合法的升级请求时
+         */
+        static std::shared_ptr<Connection> upgrade(
+            net::Socket socket, const http::Request& request,
+            std::span<const std::byte> rest, async::Reactor& reactor,
+            MessageHandler onMessage, const ConnectionOptions& options = {}
+        );
+
+        void send(Opcode opcode, std::span<const std::byte> payload);
+
+        /**
+         * @brief 发送已序列化的帧，不再拷贝
+         */
+        void send(Frame frame);
+
+        /**
+         * @brief 发起关闭握手
+         */
+        void close(std::uint16_t code = 1000, std::string_view reason = {});
+
+        void onClose(CloseHandler handler);
+
+        [[nodiscard]] bool isOpen() const noexcept;
+
+        [[nodiscard]] async::Reactor& reactor() const noexcept;
+
+        [[nodiscard]] const net::Socket& socket() const noexcept;
+
+    private:
+        void handleEvents(async::EventType events);
+
+        void readable();
+
+        void writable();
+
+        void processFrames();
+
+        void dispatch(const FrameHeader& header, std::span<std::byte> payload);
+
+        void deliver(Opcode opcode, std::span<const std::byte> payload);
+
+        void fail(std::uint16_t code);
+
+        void shutdown(std::uint16_t code);
+    };
+
+}  // namespace tiny_web_server::websocket
+
+#endif  // TINY_WEB_SERVER_WEBSOCKET_CONNECTION_HPP
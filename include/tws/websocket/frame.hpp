@@ -0,0 +1,113 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file frame.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 14:30
+ * @brief WebSocket 帧编解码(RFC 6455)
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_WEBSOCKET_FRAME_HPP
+#define TINY_WEB_SERVER_WEBSOCKET_FRAME_HPP
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace tiny_web_server::websocket {
+
+    /** @enum Opcode
+     *
+     * @brief 帧操作码
+     */
+    enum class Opcode : std::uint8_t {
+        CONTINUATION = 0x0,
+        TEXT         = 0x1,
+        BINARY       = 0x2,
+        CLOSE        = 0x8,
+        PING         = 0x9,
+        PONG         = 0xA
+    };
+
+    [[nodiscard]] constexpr bool isControl(Opcode opcode) noexcept {
+        return (static_cast<std::uint8_t>(opcode) & 0x8) != 0;
+    }
+
+    struct FrameHeader {
+        bool fin = true;
+
+        Opcode opcode = Opcode::BINARY;
+
+        bool masked = false;
+
+        std::uint32_t maskKey = 0;
+
+        std::uint64_t payloadLength = 0;
+
+        /// 帧头字节数(2~14)
+        std::size_t headerLength = 0;
+    };
+
+    /** @enum ParseStatus
+     *
+     * @brief 帧头解析结果
+     */
+    enum class ParseStatus {
+        /// 数据不足以解析帧头
+        INCOMPLETE,
+        /// 帧头解析完成
+        COMPLETE,
+        /// 协议错误: 保留位非零、未知操作码、控制帧分片或过长、长度最高位非零
+        ERROR
+    };
+
+    /**
+     * @brief 直接从接收缓冲区解析帧头，不拷贝数据
+     */
+    [[nodiscard]] ParseStatus
+    parseHeader(std::span<const std::byte> data, FrameHeader& header);
+
+    /**
+     * @brief 原地对负载做掩码异或
+     * @details x86-64 上使用 SSE2，运行时检测到 AVX2 时使用 AVX2
+     * @param offset 该段数据在整个负载中的偏移，用于负载分段处理时对齐掩码相位
+     */
+    void unmask(
+        std::span<std::byte> payload, std::uint32_t maskKey, std::size_t offset = 0
+    ) noexcept;
+
+    /**
+     * @brief 编码服务端帧头(服务端发出的帧不加掩码)
+     * @return 写入 @p out 的字节数，@p out 至少需要10字节
+     */
+    std::size_t encodeHeader(
+        std::span<std::byte> out, Opcode opcode, std::uint64_t payloadLength, bool fin = true
+    ) noexcept;
+
+    /**
+     * @brief 已序列化的完整帧
+     * @details 以共享指针持有，广播时一次序列化后被多个连接共享
+     */
+    using Frame = std::shared_ptr<const std::vector<std::byte>>;
+
+    [[nodiscard]] Frame
+    makeFrame(Opcode opcode, std::span<const std::byte> payload, bool fin = true);
+
+    /**
+     * @brief 生成关闭帧的负载: 2字节状态码 + 原因
+     */
+    [[nodiscard]] std::vector<std::byte>
+    closePayload(std::uint16_t code, std::string_view reason = {});
+
+}  // namespace tiny_web_server::websocket
+
+#endif  // TINY_WEB_SERVER_WEBSOCKET_FRAME_HPP
@@ -0,0 +1,44 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file handshake.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 15:05
+ * @brief WebSocket 升级握手
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_WEBSOCKET_HANDSHAKE_HPP
+#define TINY_WEB_SERVER_WEBSOCKET_HANDSHAKE_HPP
+#pragma once
+
+#include <string>
+
+#include "../http/request.hpp"
+
+namespace tiny_web_server::websocket {
+
+    /**
+     * @brief 请求是否为合法的 WebSocket 升级请求(RFC 6455 4.2.1)
+     */
+    [[nodiscard]] bool isUpgradeRequest(const http::Request& request) noexcept;
+
+    /**
+     * @brief 由 Sec-WebSocket-Key 计算 Sec-WebSocket-Accept
+     */
+    [[nodiscard]] std::string acceptKey(std::string_view key);
+
+    /**
+     * @brief 生成 101 Switching Protocols 响应
+     * @throw HttpError 当请求不是合法的升级请求时
+     */
+    [[nodiscard]] std::string handshakeResponse(const http::Request& request);
+
+}  // namespace tiny_web_server::websocket
+
+#endif  // TINY_WEB_SERVER_WEBSOCKET_HANDSHAKE_HPP
@@ -0,0 +1,349 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file affinity.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 00:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/async/affinity.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/platform.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#if WEB_SERVER_LINUX
+    #include <linux/mempolicy.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/syscall.h>
+#endif
+
+namespace tiny_web_server::async {
+
+    namespace {
+
+        /// 可识别的 CPU 编号上限(内核 NR_CPUS 的最大配置)，拒绝误写的巨大区间
+        constexpr int MAX_CPUS = 8192;
+
+        std::optional<int> parseCpu(std::string_view str) {
+            int value = 0;
+
+            auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+            if (ec != std::errc{} || end != str.data() + str.size() || value < 0
+                || value >= MAX_CPUS)
+                return std::nullopt;
+
+            return value;
+        }
+
+        std::string_view trim(std::string_view str) {
+            while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front())))
+                str.remove_prefix(1);
+
+            while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back())))
+                str.remove_suffix(1);
+
+            return str;
+        }
+
+#if WEB_SERVER_LINUX
+        constexpr std::size_t BITS = sizeof(unsigned long) * 8;
+
+        /// 内核接口使用的节点位图
+        std::vector<unsigned long> nodeMask(const int node) {
+            std::vector<unsigned long> mask(node / BITS + 1);
+            mask[node / BITS] |= 1UL << (node % BITS);
+
+            return mask;
+        }
+#endif
+
+    }  // namespace
+
+    CpuSet::CpuSet(std::vector<int> cpus)
+        : cpus_(std::move(cpus)) {
+        std::ranges::sort(cpus_);
+        cpus_.erase(std::ranges::unique(cpus_).begin(), cpus_.end());
+    }
+
+    std::optional<CpuSet> CpuSet::parse(const std::string_view list) {
+        // 以位图去重，重复的区间不会让结果无限增长
+        std::vector<bool> present(MAX_CPUS);
+
+        for (auto rest = trim(list); !rest.empty();) {
+            auto comma = rest.find(',');
+            auto item  = trim(rest.substr(0, comma));
+
+            rest = comma == std::string_view::npos ? std::string_view{}
+                                                  : rest.substr(comma + 1);
+
+            auto dash  = item.find('-');
+            auto first = parseCpu(item.substr(0, dash));
+            auto last  = dash == std::string_view::npos ? first
+                                                        : parseCpu(item.substr(dash + 1));
+
+            if (!first || !last || *last < *first) return std::nullopt;
+
+            for (auto cpu = *first; cpu <= *last; ++cpu) present[cpu] = true;
+        }
+
+        std::vector<int> cpus;
+
+        for (auto cpu = 0; cpu < MAX_CPUS; ++cpu)
+            if (present[cpu]) cpus.push_back(cpu);
+
+        return CpuSet{std::move(cpus)};
+    }
+
+    CpuSet CpuSet::available() {
+        std::vector<int> cpus;
+
+#if WEB_SERVER_LINUX
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+
+            return CpuSet{std::move(cpus)};
+        }
+#endif
+
+        auto count = std::max(1U, std::thread::hardware_concurrency());
+        for (auto cpu = 0U; cpu < count; ++cpu) cpus.push_back(static_cast<int>(cpu));
+
+        return CpuSet{std::move(cpus)};
+    }
+
+    void CpuSet::add(const int cpu) {
+        auto it = std::ranges::lower_bound(cpus_, cpu);
+        if (it == cpus_.end() || *it != cpu) cpus_.insert(it, cpu);
+    }
+
+    bool CpuSet::contains(const int cpu) const noexcept {
+        return std::ranges::binary_search(cpus_, cpu);
+    }
+
+    std::size_t CpuSet::size() const noexcept { return cpus_.size(); }
+
+    bool CpuSet::empty() const noexcept { return cpus_.empty(); }
+
+    int CpuSet::operator[](const std::size_t index) const noexcept { return cpus_[index]; }
+
+    std::span<const int> CpuSet::cpus() const noexcept { return cpus_; }
+
+    std::string CpuSet::toString() const {
+        std::string out;
+
+        for (std::size_t i = 0; i < cpus_.size();) {
+            auto j = i;
+            while (j + 1 < cpus_.size() && cpus_[j + 1] == cpus_[j] + 1) ++j;
+
+            if (!out.empty()) out += ',';
+            out += std::to_string(cpus_[i]);
+
+            if (j > i) out += '-' + std::to_string(cpus_[j]);
+
+            i = j + 1;
+        }
+
+        return out;
+    }
+
+    NumaTopology::NumaTopology(std::vector<CpuSet> nodes)
+        : nodes_(std::move(nodes)) {
+        if (nodes_.empty()) nodes_.push_back(CpuSet::available());
+
+        for (std::size_t node = 0; node < nodes_.size(); ++node) {
+            for (auto cpu : nodes_[node].cpus()) {
+                if (static_cast<std::size_t>(cpu) >= nodeOf_.size()) nodeOf_.resize(cpu + 1);
+
+                nodeOf_[cpu] = static_cast<int>(node);
+            }
+        }
+    }
+
+    const NumaTopology& NumaTopology::system() {
+        static const NumaTopology topology = [] {
+            namespace fs = std::filesystem;
+
+            std::vector<CpuSet> nodes;
+            std::error_code ec;
+
+            fs::directory_iterator entries("/sys/devices/system/node", ec);
+
+            for (const auto& entry : entries) {
+                auto name = entry.path().filename().string();
+                if (!name.starts_with("node")) continue;
+
+                auto node = parseCpu(std::string_view{name}.substr(4));
+                if (!node) continue;
+
+                std::ifstream file(entry.path() / "cpulist");
+                std::string list;
+                std::getline(file, list);
+
+                if (static_cast<std::size_t>(*node) >= nodes.size()) nodes.resize(*node + 1);
+
+                if (auto cpus = CpuSet::parse(list)) nodes[*node] = std::move(*cpus);
+            }
+
+            return NumaTopology{std::move(nodes)};
+        }();
+
+        return topology;
+    }
+
+    std::size_t NumaTopology::nodes() const noexcept { return nodes_.size(); }
+
+    const CpuSet& NumaTopology::cpus(const std::size_t node) const {
+        return nodes_.at(node);
+    }
+
+    int NumaTopology::nodeOf(const int cpu) const noexcept {
+        if (cpu < 0 || static_cast<std::size_t>(cpu) >= nodeOf_.size()) return 0;
+
+        return nodeOf_[cpu];
+    }
+
+    bool pinThread(const CpuSet& cpus) {
+#if WEB_SERVER_LINUX
+        if (cpus.empty()) return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (auto cpu : cpus.cpus())
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    std::optional<int> currentCpu() {
+#if WEB_SERVER_LINUX
+        if (auto cpu = sched_getcpu(); cpu >= 0) return cpu;
+#endif
+
+        return std::nullopt;
+    }
+
+    bool preferNode(const int node) {
+#if WEB_SERVER_LINUX
+        if (node < 0) return false;
+
+        auto mask = nodeMask(node);
+
+        auto bits = mask.size() * BITS + 1;
+
+        return syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), bits) == 0;
+#else
+        return false;
+#endif
+    }
+
+    bool bindMemory(const std::span<std::byte> memory, const int node) {
+#if WEB_SERVER_LINUX
+        if (node < 0 || memory.empty()) return false;
+
+        static const auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+
+        auto begin = reinterpret_cast<std::uintptr_t>(memory.data()) & ~(pageSize - 1);
+        auto end   = reinterpret_cast<std::uintptr_t>(memory.data() + memory.size());
+        end        = (end + pageSize - 1) & ~(pageSize - 1);
+
+        auto mask = nodeMask(node);
+
+        auto bits = mask.size() * BITS + 1;
+
+        return syscall(
+                   SYS_mbind, begin, end - begin, MPOL_PREFERRED, mask.data(), bits,
+                   MPOL_MF_MOVE
+               )
+            == 0;
+#else
+        return false;
+#endif
+    }
+
+    std::optional<ThreadPlacement> ThreadPlacement::parse(const std::string_view list) {
+        auto cpus = CpuSet::parse(list);
+        if (!cpus || cpus->empty()) return std::nullopt;
+
+        return ThreadPlacement{std::move(*cpus)};
+    }
+
+    int ThreadPlacement::cpu(const std::size_t index) const noexcept {
+        return cpus[index % cpus.size()];
+    }
+
+    int ThreadPlacement::node(const std::size_t index) const noexcept {
+        return NumaTopology::system().nodeOf(cpu(index));
+    }
+
+    bool ThreadPlacement::apply(const std::size_t index) const {
+        if (cpus.empty()) return false;
+
+        CpuSet single;
+        single.add(cpu(index));
+
+        if (!pinThread(single)) return false;
+
+        // 单节点机器上内存策略没有意义
+        if (localMemory && NumaTopology::system().nodes() > 1) preferNode(node(index));
+
+        return true;
+    }
+
+    void recordIncomingCpu(
+        const std::size_t thread, const int threadCpu, const std::optional<int> rxCpu
+    ) {
+        static const char* const HELP = "Accepted connections by receiving CPU and thread";
+
+        static auto& local = metrics::Registry::global().counter(
+            "tws_accept_cpu_locality_total", "Accepted connections by CPU locality",
+            "locality=\"local\""
+        );
+        static auto& remote = metrics::Registry::global().counter(
+            "tws_accept_cpu_locality_total", "Accepted connections by CPU locality",
+            "locality=\"remote\""
+        );
+
+        if (!rxCpu) return;
+
+        (*rxCpu == threadCpu ? local : remote).add();
+
+        // 注册表查找需要加锁，按接收 CPU 缓存在线程内; 同一线程的 thread 参数不变
+        thread_local std::vector<metrics::Counter*> counters;
+
+        auto cpu = static_cast<std::size_t>(*rxCpu);
+        if (cpu >= counters.size()) counters.resize(cpu + 1);
+
+        if (!counters[cpu]) {
+            auto labels = "rx_cpu=\"" + std::to_string(cpu) + "\",thread=\""
+                        + std::to_string(thread) + '"';
+
+            counters[cpu] = &metrics::Registry::global().counter(
+                "tws_accepts_by_cpu_total", HELP, labels
+            );
+        }
+
+        counters[cpu]->add();
+    }
+
+}  // namespace tiny_web_server::async
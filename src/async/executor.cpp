@@ -0,0 +1,210 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file executor.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 17:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/async/executor.hpp"
+#include "tws/metrics/metrics.hpp"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace tiny_web_server::async {
+
+    namespace {
+
+        /// 休眠前的自旋次数
+        constexpr int SPIN_COUNT = 64;
+
+        struct FunctionJob : Executor::Job {
+            Executor::Task task;
+
+            explicit FunctionJob(Executor::Task task)
+                : Job{&run}
+                , task(std::move(task)) {}
+
+            static void run(Job* job) {
+                std::unique_ptr<FunctionJob> self{static_cast<FunctionJob*>(job)};
+                self->task();
+            }
+        };
+
+        metrics::Counter& failureCounter() {
+            static auto& counter = metrics::Registry::global().counter(
+                "tws_executor_task_failures_total", "Executor tasks that threw an exception"
+            );
+            return counter;
+        }
+
+        thread_local const Executor* currentExecutor = nullptr;
+
+        thread_local std::size_t currentIndex = 0;
+
+        void cpuRelax() noexcept {
+#if defined(_MSC_VER)
+            _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+
+        std::uint64_t xorshift(std::uint64_t& state) noexcept {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            return state;
+        }
+
+    }  // namespace
+
+    Executor::Executor(const std::size_t threads) { start(threads); }
+
+    Executor::Executor(const std::size_t threads, ThreadPlacement placement)
+        : placement_(std::move(placement)) {
+        start(threads);
+    }
+
+    Executor::~Executor() {
+        stopping_.store(true);
+
+        signal_.fetch_add(1);
+        signal_.notify_all();
+
+        for (const auto& worker : workers_) worker->thread.join();
+    }
+
+    void Executor::start(std::size_t threads) {
+        threads = std::max<std::size_t>(threads, 1);
+
+        workers_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->seed = 0x9E3779B97F4A7C15ull * (i + 1);
+        }
+
+        // 所有队列就绪后再启动线程，窃取时才能安全遍历 workers_
+        for (std::size_t i = 0; i < threads; ++i)
+            workers_[i]->thread = std::jthread([this, i] { run(i); });
+    }
+
+    void Executor::submit(Task task) { submit(new FunctionJob(std::move(task))); }
+
+    void Executor::submit(Job* job) {
+        if (isWorkerThread())
+            workers_[currentIndex]->deque.push(job);
+        else {
+            std::lock_guard lock(injectMutex_);
+            inject_.push_back(job);
+            injected_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        notify();
+    }
+
+    std::size_t Executor::size() const noexcept { return workers_.size(); }
+
+    bool Executor::isWorkerThread() const noexcept { return currentExecutor == this; }
+
+    void Executor::run(const std::size_t index) {
+        currentExecutor = this;
+        currentIndex    = index;
+
+        if (placement_) placement_->apply(index);
+
+        while (true) {
+            auto* job = findWork(index);
+
+            for (auto i = 0; !job && i < SPIN_COUNT; ++i) {
+                cpuRelax();
+                job = findWork(index);
+            }
+
+            if (job) {
+                execute(job);
+                continue;
+            }
+
+            // 先记下信号再检查一次，避免在检查与休眠之间错过提交
+            auto seen = signal_.load();
+
+            if ((job = findWork(index))) {
+                execute(job);
+                continue;
+            }
+
+            if (stopping_.load()) break;
+
+            sleeping_.fetch_add(1);
+            signal_.wait(seen);
+            sleeping_.fetch_sub(1);
+        }
+
+        currentExecutor = nullptr;
+    }
+
+    std::uint64_t Executor::failures() const noexcept {
+        return failures_.load(std::memory_order_relaxed);
+    }
+
+    void Executor::execute(Job* job) noexcept {
+        // 异常若逃出 jthread 会调用 std::terminate ，一个任务的错误不应结束整个服务
+        try {
+            job->run(job);
+        } catch (...) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            failureCounter().add();
+        }
+    }
+
+    Executor::Job* Executor::findWork(const std::size_t index) {
+        auto& self = *workers_[index];
+
+        if (auto job = self.deque.pop()) return *job;
+
+        if (injected_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard lock(injectMutex_);
+
+            if (!inject_.empty()) {
+                auto* job = inject_.front();
+                inject_.pop_front();
+                injected_.fetch_sub(1, std::memory_order_relaxed);
+
+                return job;
+            }
+        }
+
+        const auto count = workers_.size();
+        const auto start = xorshift(self.seed) % count;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto victim = (start + i) % count;
+            if (victim == index) continue;
+
+            if (auto job = workers_[victim]->deque.steal()) return *job;
+        }
+
+        return nullptr;
+    }
+
+    void Executor::notify() {
+        signal_.fetch_add(1);
+
+        if (sleeping_.load() > 0) signal_.notify_one();
+    }
+
+}  // namespace tiny_web_server::async
@@ -0,0 +1,251 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file reactor.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 13:02
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/async/reactor.hpp"
+#include "tws/exception.hpp"
+#include "tws/metrics/metrics.hpp"
+#include <algorithm>
+#include <array>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+
+// 较旧的内核头文件中没有 epoll 忙轮询参数
+#ifndef EPIOCSPARAMS
+struct epoll_params {
+    std::uint32_t busy_poll_usecs;
+    std::uint16_t busy_poll_budget;
+    std::uint8_t prefer_busy_poll;
+    std::uint8_t __pad;
+};
+
+#define EPIOCSPARAMS _IOW(0x8A, 0x01, struct epoll_params)
+#endif
+
+namespace tiny_web_server::async {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+
+        void recordSpin(const bool hit) {
+            constexpr std::string_view NAME = "tws_reactor_busy_poll_total";
+            constexpr std::string_view HELP = "Busy-poll spins by outcome";
+
+            auto& registry = metrics::Registry::global();
+
+            static auto& hits   = registry.counter(NAME, HELP, "result=\"hit\"");
+            static auto& misses = registry.counter(NAME, HELP, "result=\"miss\"");
+
+            (hit ? hits : misses).add();
+        }
+
+    }  // namespace
+
+    Reactor::Reactor()
+        : epoll_(epoll_create1(EPOLL_CLOEXEC))
+        , wakeup_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (epoll_ < 0 || wakeup_ < 0)
+            throw SocketError<>(NET_ERROR, "Failed to create reactor");
+
+        epoll_event event{};
+        event.events  = EPOLLIN;
+        event.data.fd = wakeup_;
+
+        if (epoll_ctl(epoll_, EPOLL_CTL_ADD, wakeup_, &event) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to register reactor wakeup");
+    }
+
+    Reactor::~Reactor() {
+        ::close(wakeup_);
+        ::close(epoll_);
+    }
+
+    void Reactor::add(const socket_t handle, const EventType events, Handler handler) {
+        epoll_event event{};
+        event.events  = static_cast<std::uint32_t>(events);
+        event.data.fd = handle;
+
+        if (epoll_ctl(epoll_, EPOLL_CTL_ADD, handle, &event) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to add socket to reactor");
+
+        handlers_[handle] = std::make_shared<Handler>(std::move(handler));
+    }
+
+    void Reactor::modify(const socket_t handle, const EventType events) const {
+        epoll_event event{};
+        event.events  = static_cast<std::uint32_t>(events);
+        event.data.fd = handle;
+
+        if (epoll_ctl(epoll_, EPOLL_CTL_MOD, handle, &event) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to modify socket in reactor");
+    }
+
+    void Reactor::remove(const socket_t handle) {
+        epoll_ctl(epoll_, EPOLL_CTL_DEL, handle, nullptr);
+
+        handlers_.erase(handle);
+    }
+
+    void Reactor::post(Task task) {
+        tasks_.push(std::move(task));
+
+        // 反应器尚未处理上一次唤醒时无需再写 eventfd
+        if (!notified_.exchange(true, std::memory_order_acq_rel)) wakeup();
+    }
+
+    void Reactor::run() {
+        running_ = true;
+
+        while (running_) runOnce();
+    }
+
+    std::size_t Reactor::runOnce(const int timeoutMs) {
+        owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        if (timeoutMs == 0 || busyPoll_.spin.count() == 0) return poll(timeoutMs).first;
+
+        auto start = Clock::now();
+
+        // 先自旋: 零超时轮询，直到有事件或自旋时间用完
+        if (spin_.count() > 0) {
+            auto deadline = start + spin_;
+
+            do {
+                if (auto [events, tasks] = poll(0); events + tasks > 0) {
+                    recordSpin(true);
+                    return events;
+                }
+            } while (Clock::now() < deadline);
+
+            recordSpin(false);
+
+            if (busyPoll_.adaptive) spin_ /= 2;
+        }
+
+        auto blocked = Clock::now();
+        auto timeout = timeoutMs;
+
+        if (timeout > 0) {
+            auto elapsed = blocked - start;
+            auto spent   = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+
+            timeout = std::max(0, timeout - static_cast<int>(spent.count()));
+        }
+
+        auto [events, tasks] = poll(timeout);
+
+        // 阻塞后很快就有事件: 下次自旋足够长以覆盖这样的间隔
+        if (busyPoll_.adaptive && events + tasks > 0) {
+            auto gap = std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - blocked
+            );
+
+            if (gap < busyPoll_.spin) spin_ = std::clamp(2 * gap, spin_, busyPoll_.spin);
+        }
+
+        return events;
+    }
+
+    std::pair<std::size_t, std::size_t> Reactor::poll(const int timeoutMs) {
+        std::array<epoll_event, 256> events;
+
+        auto count = epoll_wait(epoll_, events.data(), events.size(), timeoutMs);
+
+        if (count < 0) {
+            if (errno == EINTR) return {0, 0};
+
+            throw SocketError<>(NET_ERROR, "Failed to wait for reactor events");
+        }
+
+        if (count > 0) polled_ = Clock::now();
+
+        std::size_t handled = 0;
+
+        for (auto i = 0; i < count; ++i) {
+            auto handle = events[i].data.fd;
+
+            if (handle == wakeup_) {
+                std::uint64_t value;
+                while (::read(wakeup_, &value, sizeof(value)) > 0) {}
+
+                continue;
+            }
+
+            auto it = handlers_.find(handle);
+            if (it == handlers_.end()) continue;
+
+            // EPOLLHUP 总会上报: 映射为 HANGUP，否则只关心 EPOLLRDHUP 的处理器
+            // 在水平触发下会一直收到无法处理的事件
+            auto ready = events[i].events;
+            if (ready & EPOLLHUP) ready |= EPOLLRDHUP;
+
+            // 持有一份引用，处理器在回调中移除自身时不会被提前析构
+            auto handler = it->second;
+            (*handler)(static_cast<EventType>(ready));
+
+            ++handled;
+        }
+
+        return {handled, runTasks()};
+    }
+
+    bool Reactor::setBusyPoll(const BusyPollOptions& options) {
+        busyPoll_ = options;
+        spin_     = options.spin;
+
+        if (options.kernelPollUs == 0) return true;
+
+        epoll_params params{};
+        params.busy_poll_usecs  = options.kernelPollUs;
+        params.busy_poll_budget = options.kernelPollBudget;
+        params.prefer_busy_poll = options.preferBusyPoll;
+
+        // 旧内核不支持时 epoll_wait 照常工作，只是没有内核侧的轮询
+        return ioctl(epoll_, EPIOCSPARAMS, &params) == 0;
+    }
+
+    void Reactor::stop() {
+        running_ = false;
+
+        wakeup();
+    }
+
+    bool Reactor::isInLoopThread() const noexcept {
+        return owner_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    Clock::time_point Reactor::pollTime() const noexcept { return polled_; }
+
+    void Reactor::wakeup() const {
+        std::uint64_t one = 1;
+
+        [[maybe_unused]] auto result = ::write(wakeup_, &one, sizeof(one));
+    }
+
+    std::size_t Reactor::runTasks() {
+        // 先清除标记再取任务: 之后投递的任务会重新唤醒反应器，不会被遗漏
+        if (!notified_.exchange(false, std::memory_order_acq_rel)) return 0;
+
+        std::size_t count = 0;
+
+        while (auto task = tasks_.pop()) {
+            (*task)();
+            ++count;
+        }
+
+        return count;
+    }
+
+}  // namespace tiny_web_server::async
@@ -0,0 +1,99 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file admission.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 20:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/admission.hpp"
+#include "tws/metrics/metrics.hpp"
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        constexpr std::string_view OVERLOAD_RESPONSE = "HTTP/1.1 503 Service Unavailable\r\n"
+                                                       "Content-Length: 0\r\n"
+                                                       "Retry-After: 1\r\n"
+                                                       "Connection: close\r\n"
+                                                       "\r\n";
+
+        metrics::Counter& shedCounter() {
+            static auto& counter = metrics::Registry::global().counter(
+                "tws_requests_shed_total", "Requests rejected by admission control"
+            );
+            return counter;
+        }
+
+        metrics::Gauge& overloadedGauge() {
+            static auto& gauge = metrics::Registry::global().gauge(
+                "tws_overloaded_threads", "I/O threads currently in the overloaded state"
+            );
+            return gauge;
+        }
+
+    }  // namespace
+
+    AdmissionController::AdmissionController(const AdmissionOptions& options)
+        : options_(options) {}
+
+    AdmissionController::~AdmissionController() {
+        if (overloaded_) overloadedGauge().sub();
+    }
+
+    bool AdmissionController::admit(
+        const Clock::time_point queued, const Clock::time_point now
+    ) noexcept {
+        auto delay = now - queued;
+
+        advance(now);
+        minDelay_ = std::min(minDelay_, delay);
+
+        if (delay <= (overloaded_ ? options_.target : options_.interval)) return true;
+
+        ++shed_;
+        shedCounter().add();
+
+        return false;
+    }
+
+    bool AdmissionController::admit(
+        const Connection& connection, const Clock::time_point now
+    ) noexcept {
+        return admit(connection.lastActivity, now);
+    }
+
+    bool AdmissionController::overloaded(const Clock::time_point now) noexcept {
+        advance(now);
+
+        return overloaded_;
+    }
+
+    std::uint64_t AdmissionController::shed() const noexcept { return shed_; }
+
+    std::span<const std::byte> AdmissionController::overloadResponse() noexcept {
+        return std::as_bytes(std::span{OVERLOAD_RESPONSE});
+    }
+
+    void AdmissionController::advance(const Clock::time_point now) noexcept {
+        if (now < windowEnd_) return;
+
+        // 窗口结束: 最小延迟仍超过目标才算过载，没有样本则视为空闲
+        auto overloaded = minDelay_ != Clock::duration::max() && minDelay_ > options_.target;
+
+        if (overloaded != overloaded_) overloadedGauge().add(overloaded ? 1 : -1);
+
+        overloaded_ = overloaded;
+        minDelay_   = Clock::duration::max();
+        windowEnd_  = now + options_.interval;
+    }
+
+}  // namespace tiny_web_server::http
@@ -0,0 +1,460 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file body.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 02:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/body.hpp"
+#include "tws/exception.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/utils/string.hpp"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <random>
+#include <utility>
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        /// 单次 splice 搬运的上限，等于 Linux 管道的默认容量
+        constexpr std::size_t SPLICE_CHUNK = 64 * 1024;
+
+        /// 不支持 splice 时经由的栈上缓冲区大小
+        constexpr std::size_t COPY_CHUNK = 16 * 1024;
+
+        int hexValue(const char c) noexcept {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+
+            return -1;
+        }
+
+        metrics::Counter& uploadBytes(const bool spliced) {
+            static constexpr auto HELP = "Request body bytes written to upload files";
+
+            static auto& splice = metrics::Registry::global().counter(
+                "tws_upload_bytes_total", HELP, "method=\"splice\""
+            );
+            static auto& copy = metrics::Registry::global().counter(
+                "tws_upload_bytes_total", HELP, "method=\"copy\""
+            );
+
+            return spliced ? splice : copy;
+        }
+
+    }  // namespace
+
+    BodyFraming BodyFraming::of(const Request& request) noexcept {
+        bool hasEncoding = false, chunked = false;
+        std::optional<std::uint64_t> length;
+
+        for (const auto& [name, value] : request.headers) {
+            if (iequals(name, "Transfer-Encoding")) {
+                // 只支持单独的 chunked; 多个同名头部视为一个列表
+                forEachListItem(value, [&](const std::string_view coding) {
+                    chunked     = !hasEncoding && iequals(coding, "chunked");
+                    hasEncoding = true;
+                    return chunked;
+                });
+
+                if (!chunked) return {Type::INVALID};
+
+                continue;
+            }
+
+            if (!iequals(name, "Content-Length")) continue;
+
+            // 重复的 Content-Length 只有值完全相同时才接受，包括逗号分隔的形式
+            bool valid = true;
+
+            forEachListItem(value, [&](const std::string_view item) {
+                std::uint64_t parsed = 0;
+
+                auto* last     = item.data() + item.size();
+                auto [end, ec] = std::from_chars(item.data(), last, parsed);
+
+                valid = ec == std::errc{} && end == last && (!length || *length == parsed);
+
+                if (valid) length = parsed;
+                return valid;
+            });
+
+            if (!valid || trim(value).empty()) return {Type::INVALID};
+        }
+
+        if (hasEncoding) {
+            if (length || request.versionMinor == 0) return {Type::INVALID};
+
+            return {Type::CHUNKED};
+        }
+
+        if (length) return {Type::LENGTH, *length};
+
+        return {};
+    }
+
+    ChunkedDecoder::Result ChunkedDecoder::decode(const std::span<const std::byte> input
+    ) noexcept {
+        std::size_t i = 0;
+
+        auto fail = [&] {
+            state_ = State::ERROR;
+            return Result{i, {}, Status::ERROR};
+        };
+
+        while (i < input.size()) {
+            auto c = static_cast<char>(input[i]);
+
+            switch (state_) {
+                case State::SIZE: {
+                    if (auto value = hexValue(c); value >= 0) {
+                        // 16 位十六进制已占满 64 位
+                        if (digits_ == 16) return fail();
+
+                        remaining_ = remaining_ << 4 | static_cast<std::uint64_t>(value);
+                        ++digits_;
+                        break;
+                    }
+
+                    if (digits_ == 0) return fail();
+
+                    if (c == '\r')
+                        state_ = State::SIZE_LF;
+                    else if (c == ';' || c == ' ' || c == '\t') {
+                        state_    = State::EXTENSION;
+                        lineSize_ = 0;
+                    } else
+                        return fail();
+
+                    break;
+                }
+
+                // 分块扩展没有已定义的语义，只检查长度后丢弃
+                case State::EXTENSION: {
+                    if (c == '\r')
+                        state_ = State::SIZE_LF;
+                    else if (c == '\n' || ++lineSize_ > MAX_LINE_SIZE)
+                        return fail();
+
+                    break;
+                }
+
+                case State::SIZE_LF: {
+                    if (c != '\n') return fail();
+
+                    digits_   = 0;
+                    lineSize_ = 0;
+                    state_    = remaining_ == 0 ? State::TRAILER : State::DATA;
+                    break;
+                }
+
+                case State::DATA: {
+                    auto size = std::min<std::uint64_t>(remaining_, input.size() - i);
+                    auto data = input.subspan(i, size);
+
+                    skip(size);
+
+                    return {i + size, data, Status::INCOMPLETE};
+                }
+
+                case State::DATA_CR: {
+                    if (c != '\r') return fail();
+
+                    state_ = State::DATA_LF;
+                    break;
+                }
+
+                case State::DATA_LF: {
+                    if (c != '\n') return fail();
+
+                    state_ = State::SIZE;
+                    break;
+                }
+
+                // 尾部字段不转交给调用者
+                case State::TRAILER: {
+                    if (c == '\r')
+                        state_ = State::TRAILER_LF;
+                    else if (
+                        c == '\n' || ++lineSize_ > MAX_LINE_SIZE
+                        || ++trailerSize_ > MAX_TRAILER_SIZE
+                    )
+                        return fail();
+
+                    break;
+                }
+
+                case State::TRAILER_LF: {
+                    if (c != '\n') return fail();
+
+                    // 空行结束整个请求体
+                    if (lineSize_ == 0) {
+                        state_ = State::DONE;
+                        return {i + 1, {}, Status::COMPLETE};
+                    }
+
+                    lineSize_ = 0;
+                    state_    = State::TRAILER;
+                    break;
+                }
+
+                case State::DONE: return {i, {}, Status::COMPLETE};
+
+                case State::ERROR: return fail();
+            }
+
+            ++i;
+        }
+
+        if (state_ == State::DONE) return {i, {}, Status::COMPLETE};
+
+        return {i, {}, Status::INCOMPLETE};
+    }
+
+    std::uint64_t ChunkedDecoder::pendingData() const noexcept {
+        return state_ == State::DATA ? remaining_ : 0;
+    }
+
+    void ChunkedDecoder::skip(const std::uint64_t count) noexcept {
+        remaining_ -= count;
+
+        if (remaining_ == 0) state_ = State::DATA_CR;
+    }
+
+    bool ChunkedDecoder::done() const noexcept { return state_ == State::DONE; }
+
+    void ChunkedDecoder::reset() noexcept { *this = {}; }
+
+    BodyReader::BodyReader(const BodyFraming framing, const std::uint64_t maxSize) noexcept
+        : framing_(framing)
+        , maxSize_(maxSize) {
+        switch (framing.type) {
+            case BodyFraming::Type::NONE: status_ = Status::COMPLETE; break;
+
+            case BodyFraming::Type::LENGTH: {
+                remaining_ = framing.length;
+
+                if (framing.length > maxSize)
+                    status_ = Status::TOO_LARGE;
+                else if (framing.length == 0)
+                    status_ = Status::COMPLETE;
+
+                break;
+            }
+
+            case BodyFraming::Type::CHUNKED: break;
+
+            case BodyFraming::Type::INVALID: status_ = Status::ERROR; break;
+        }
+    }
+
+    BodyReader::Result BodyReader::read(const std::span<const std::byte> input) noexcept {
+        if (status_ != Status::INCOMPLETE) return {0, {}, status_};
+
+        if (framing_.type == BodyFraming::Type::LENGTH) {
+            auto size = std::min<std::uint64_t>(remaining_, input.size());
+
+            advance(size);
+
+            return {size, input.first(size), status_};
+        }
+
+        auto result = chunked_.decode(input);
+        received_ += result.data.size();
+
+        // 分块头中声明的大小一经解析就检查上限，不必等数据到达; 声明的大小可达 2^64-1，
+        // 与已收到的字节数相加会回绕，因此与剩余额度比较
+        if (result.status == ChunkedDecoder::Status::COMPLETE)
+            status_ = Status::COMPLETE;
+        else if (result.status == ChunkedDecoder::Status::ERROR)
+            status_ = Status::ERROR;
+        else if (received_ > maxSize_ || chunked_.pendingData() > maxSize_ - received_)
+            status_ = Status::TOO_LARGE;
+
+        return {result.consumed, result.data, status_};
+    }
+
+    std::uint64_t BodyReader::directBytes() const noexcept {
+        if (status_ != Status::INCOMPLETE) return 0;
+
+        if (framing_.type == BodyFraming::Type::LENGTH) return remaining_;
+
+        return chunked_.pendingData();
+    }
+
+    void BodyReader::advance(const std::uint64_t count) noexcept {
+        received_ += count;
+
+        if (framing_.type == BodyFraming::Type::CHUNKED) return chunked_.skip(count);
+
+        remaining_ -= count;
+        if (remaining_ == 0) status_ = Status::COMPLETE;
+    }
+
+    BodyReader::Status BodyReader::status() const noexcept { return status_; }
+
+    bool BodyReader::complete() const noexcept { return status_ == Status::COMPLETE; }
+
+    std::uint64_t BodyReader::received() const noexcept { return received_; }
+
+    UploadFile UploadFile::create(const std::filesystem::path& directory) {
+        static thread_local std::mt19937_64 random{std::random_device{}()};
+
+        UploadFile file;
+
+        // 名称冲突时换一个随机名称重试
+        for (auto attempt = 0; attempt < 8 && file.fd_ < 0; ++attempt) {
+            char name[7 + 16]{'u', 'p', 'l', 'o', 'a', 'd', '-'};
+            auto* end = std::to_chars(name + 7, name + sizeof(name), random(), 16).ptr;
+
+            file.path_ = directory / std::string_view{name, end};
+
+#if WEB_SERVER_WINDOWS
+            file.fd_ = _wopen(
+                file.path_.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY,
+                _S_IREAD | _S_IWRITE
+            );
+#else
+            file.fd_ =
+                ::open(file.path_.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0600);
+#endif
+
+            if (file.fd_ < 0 && errno != EEXIST) break;
+        }
+
+        if (file.fd_ < 0) {
+            file.path_.clear();
+
+            throw HttpError<>(
+                std::format("Failed to create upload file in '{}'", directory.string())
+            );
+        }
+
+        return file;
+    }
+
+    UploadFile::~UploadFile() {
+        close();
+
+        if (keep_ || path_.empty()) return;
+
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+    UploadFile::UploadFile(UploadFile&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , path_(std::move(other.path_))
+        , size_(other.size_)
+        , keep_(other.keep_)
+        , pipe_{std::exchange(other.pipe_[0], -1), std::exchange(other.pipe_[1], -1)} {
+        other.path_.clear();
+    }
+
+    UploadFile& UploadFile::operator=(UploadFile&& other) noexcept {
+        // 原有的文件随 other 析构
+        if (this != &other) {
+            std::swap(fd_, other.fd_);
+            std::swap(path_, other.path_);
+            std::swap(size_, other.size_);
+            std::swap(keep_, other.keep_);
+            std::swap(pipe_, other.pipe_);
+        }
+
+        return *this;
+    }
+
+    void UploadFile::write(std::span<const std::byte> data) {
+        uploadBytes(false).add(data.size());
+
+        while (!data.empty()) {
+#if WEB_SERVER_WINDOWS
+            auto written = _write(fd_, data.data(), static_cast<unsigned>(data.size()));
+#else
+            auto written = ::write(fd_, data.data(), data.size());
+            if (written < 0 && errno == EINTR) continue;
+#endif
+
+            if (written <= 0) throw HttpError<"Failed to write upload file"_s>();
+
+            data    = data.subspan(static_cast<std::size_t>(written));
+            size_  += static_cast<std::size_t>(written);
+        }
+    }
+
+    std::optional<std::size_t>
+    UploadFile::splice(const net::Socket& socket, const std::uint64_t count) {
+#if WEB_SERVER_LINUX
+        if (pipe_[0] < 0 && ::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC) < 0)
+            throw HttpError<"Failed to create pipe for splice"_s>();
+
+        auto want  = static_cast<std::size_t>(std::min<std::uint64_t>(count, SPLICE_CHUNK));
+        auto moved = ::splice(
+            socket.nativeHandle(), nullptr, pipe_[1], nullptr, want,
+            SPLICE_F_MOVE | SPLICE_F_NONBLOCK
+        );
+
+        if (moved < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return std::nullopt;
+
+            throw SocketError<>(errno, "splice");
+        }
+
+        // 排空管道，数据不在调用之间滞留
+        for (auto left = moved; left > 0;) {
+            auto written = ::splice(pipe_[0], nullptr, fd_, nullptr, left, SPLICE_F_MOVE);
+
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) throw HttpError<"Failed to write upload file"_s>();
+
+            left -= written;
+        }
+
+        size_ += static_cast<std::size_t>(moved);
+        uploadBytes(true).add(static_cast<std::size_t>(moved));
+
+        return static_cast<std::size_t>(moved);
+#else
+        std::byte buffer[COPY_CHUNK];
+
+        auto want     = static_cast<std::size_t>(std::min<std::uint64_t>(count, COPY_CHUNK));
+        auto received = socket.tryRecv(std::span{buffer}.first(want));
+
+        if (received && *received > 0) write(std::span{buffer}.first(*received));
+
+        return received;
+#endif
+    }
+
+    const std::filesystem::path& UploadFile::path() const noexcept { return path_; }
+
+    std::uint64_t UploadFile::size() const noexcept { return size_; }
+
+    void UploadFile::keep() noexcept { keep_ = true; }
+
+    void UploadFile::close() noexcept {
+        for (auto* fd : {&fd_, &pipe_[0], &pipe_[1]}) {
+            if (*fd < 0) continue;
+
+#if WEB_SERVER_WINDOWS
+            _close(*fd);
+#else
+            ::close(*fd);
+#endif
+            *fd = -1;
+        }
+    }
+
+}  // namespace tiny_web_server::http
@@ -0,0 +1,199 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file compression_cache.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 10:48
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/compression_cache.hpp"
+#include "tws/utils/hash.hpp"
+#include <cstring>
+#include <random>
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        // 小于该长度的内容压缩收益低于头部开销
+        constexpr std::size_t MIN_COMPRESS_SIZE = 256;
+
+        using Buffer = CompressionCache::Buffer;
+
+        // 原文与压缩结果都计入容量; 不可压缩内容以空缓冲记录(负缓存)，按固定开销计入
+        std::size_t cost(const Buffer& original, const Buffer& compressed) noexcept {
+            return original->size() + (compressed ? compressed->size() : 64);
+        }
+
+        std::uint64_t randomSeed() {
+            std::random_device device;
+            return (std::uint64_t{device()} << 32) | device();
+        }
+
+    }  // namespace
+
+    CompressionCache::CompressionCache(
+        const std::size_t capacity, const std::size_t workers, const std::size_t maxPending,
+        const int level
+    )
+        : capacity_(capacity)
+        , maxPending_(maxPending)
+        , seed_(randomSeed())
+        , level_(level) {
+        workers_.reserve(workers);
+
+        for (std::size_t i = 0; i < workers; ++i)
+            workers_.emplace_back([this](const std::stop_token& token) { work(token); });
+    }
+
+    CompressionCache::~CompressionCache() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+
+        cv_.notify_all();
+        workers_.clear();
+    }
+
+    CompressionCache::Buffer
+    CompressionCache::find(std::span<const std::byte> content, ContentEncoding encoding) {
+        if (encoding == ContentEncoding::IDENTITY || content.size() < MIN_COMPRESS_SIZE)
+            return nullptr;
+
+        Key key{contentHash(content, seed_), content.size(), encoding};
+
+        Buffer original, compressed;
+
+        {
+            std::lock_guard lock(mutex_);
+
+            if (auto it = entries_.find(key); it != entries_.end()) {
+                original   = it->second->original;
+                compressed = it->second->compressed;
+            } else {
+                if (stopping_ || pending_.contains(key) || jobs_.size() >= maxPending_)
+                    return nullptr;
+
+                pending_.insert(key);
+                jobs_.push_back({
+                    key,
+                    std::make_shared<Buffer::element_type>(content.begin(), content.end())
+                });
+            }
+        }
+
+        if (original) {
+            // 逐字节比较在锁外进行，大资源命中不会串行化其他线程;
+            // 哈希碰撞: 按未命中处理，且不覆盖已有条目
+            if (std::memcmp(original->data(), content.data(), content.size()) != 0)
+                return nullptr;
+
+            std::lock_guard lock(mutex_);
+
+            // 比较期间条目可能已被淘汰或替换，只在仍是同一条目时更新LRU位置
+            if (auto it = entries_.find(key);
+                it != entries_.end() && it->second->original == original)
+                lru_.splice(lru_.begin(), lru_, it->second);
+
+            return compressed;
+        }
+
+        cv_.notify_one();
+
+        return nullptr;
+    }
+
+    std::pair<ContentEncoding, CompressionCache::Buffer>
+    CompressionCache::find(
+        const std::span<const std::byte> content, const AcceptEncoding& accept
+    ) {
+        static constexpr ContentEncoding candidates[]{
+            ContentEncoding::GZIP, ContentEncoding::ZSTD, ContentEncoding::BROTLI
+        };
+
+        ContentEncoding available[std::size(candidates)];
+        std::size_t count = 0;
+
+        for (auto encoding : candidates)
+            if (isSupported(encoding)) available[count++] = encoding;
+
+        auto encoding = accept.select({available, count});
+
+        if (auto buffer = find(content, encoding)) return {encoding, std::move(buffer)};
+
+        return {ContentEncoding::IDENTITY, nullptr};
+    }
+
+    std::size_t CompressionCache::size() const {
+        std::lock_guard lock(mutex_);
+
+        return used_;
+    }
+
+    void CompressionCache::clear() {
+        std::lock_guard lock(mutex_);
+
+        entries_.clear();
+        lru_.clear();
+        used_ = 0;
+    }
+
+    void CompressionCache::work(const std::stop_token& token) {
+        while (true) {
+            Job job;
+
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [&] { return stopping_ || !jobs_.empty(); });
+
+                if (stopping_ || token.stop_requested()) return;
+
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+
+            Buffer buffer;
+
+            try {
+                auto compressed = compress(*job.content, job.key.encoding, level_);
+
+                // 压缩后反而更大则记为空缓冲，之后的请求直接发送原文而不再排队
+                if (compressed.size() < job.content->size())
+                    buffer = std::make_shared<Buffer::element_type>(std::move(compressed));
+            } catch (...) {}
+
+            std::lock_guard lock(mutex_);
+
+            pending_.erase(job.key);
+
+            insert(job.key, std::move(job.content), std::move(buffer));
+        }
+    }
+
+    void CompressionCache::insert(const Key& key, Buffer original, Buffer compressed) {
+        auto bytes = cost(original, compressed);
+
+        if (bytes > capacity_ || entries_.contains(key)) return;
+
+        while (used_ + bytes > capacity_ && !lru_.empty()) {
+            const auto& last = lru_.back();
+
+            used_ -= cost(last.original, last.compressed);
+            entries_.erase(last.key);
+            lru_.pop_back();
+        }
+
+        lru_.push_front({key, std::move(original), std::move(compressed)});
+        entries_.emplace(key, lru_.begin());
+        used_ += bytes;
+    }
+
+}  // namespace tiny_web_server::http
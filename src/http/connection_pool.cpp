@@ -0,0 +1,144 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file connection_pool.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/connection_pool.hpp"
+#include "tws/metrics/metrics.hpp"
+
+namespace tiny_web_server::http {
+
+    bool ConnectionLimits::violated(
+        const Connection& connection, const Clock::time_point now
+    ) const {
+        if (!connection.reading()) return false;
+
+        auto elapsed = now - connection.readStart;
+
+        // 头部尚未完整
+        if (connection.parser.headerLength() == 0 && elapsed >= headerTimeout) return true;
+
+        if (minReceiveRate == 0 || elapsed < rateGracePeriod) return false;
+
+        auto seconds = std::chrono::duration<double>(elapsed).count();
+
+        return static_cast<double>(connection.readBytes) < minReceiveRate * seconds;
+    }
+
+    Connection::Connection(
+        net::Socket socket, const Clock::time_point now, const ConnectionLimits& limits
+    )
+        : socket(std::move(socket))
+        , lastActivity(now)
+        , readStart(now)
+        , parser(limits.maxHeaderSize, limits.maxHeaderCount) {
+        trace.mark(metrics::Stage::ACCEPT);
+    }
+
+    void Connection::beginRead(const Clock::time_point now) noexcept {
+        readStart = now;
+        readBytes = received;
+    }
+
+    void Connection::endRead() noexcept { readStart = {}; }
+
+    bool Connection::reading() const noexcept { return readStart != Clock::time_point{}; }
+
+    std::string_view Connection::data() const noexcept {
+        return {reinterpret_cast<const char*>(buffer.data()), received};
+    }
+
+    ConnectionPool::ConnectionPool(
+        const std::size_t maxConnections, const ConnectionLimits& limits
+    )
+        : slab_(maxConnections)
+        , limits_(limits) {}
+
+    ConnectionPool::~ConnectionPool() {
+        metrics::server().activeConnections.sub(static_cast<std::int64_t>(slab_.size()));
+
+        // 链表必须先于槽位中的对象清空
+        idle_.clear();
+        active_.clear();
+    }
+
+    ConnectionPool::Handle
+    ConnectionPool::open(net::Socket socket, const Clock::time_point now) {
+        auto handle = slab_.create(std::move(socket), now, limits_);
+
+        if (!handle) return handle;
+
+        active_.pushBack(*slab_.get(handle));
+        metrics::server().activeConnections.add();
+
+        return handle;
+    }
+
+    Connection* ConnectionPool::get(const Handle handle) noexcept {
+        return slab_.get(handle);
+    }
+
+    ConnectionPool::Handle
+    ConnectionPool::handle(const Connection& connection) const noexcept {
+        return slab_.handle(connection);
+    }
+
+    void ConnectionPool::touch(
+        Connection& connection, const bool idle, const Clock::time_point now
+    ) {
+        (connection.idle ? idle_ : active_).remove(connection);
+        (idle ? idle_ : active_).pushBack(connection);
+
+        if (idle)
+            connection.endRead();
+        else if (connection.idle)
+            connection.beginRead(now);
+
+        connection.idle         = idle;
+        connection.lastActivity = now;
+    }
+
+    void ConnectionPool::close(const Handle handle) {
+        auto* connection = slab_.get(handle);
+        if (!connection) return;
+
+        (connection->idle ? idle_ : active_).remove(*connection);
+
+        slab_.destroy(handle);
+        metrics::server().activeConnections.sub();
+    }
+
+    Connection* ConnectionPool::oldestIdle() const noexcept { return idle_.front(); }
+
+    const ConnectionLimits& ConnectionPool::limits() const noexcept { return limits_; }
+
+    std::size_t ConnectionPool::size() const noexcept { return slab_.size(); }
+
+    std::size_t ConnectionPool::idleCount() const noexcept { return idle_.size(); }
+
+    std::size_t ConnectionPool::activeCount() const noexcept { return active_.size(); }
+
+    void
+    ConnectionPool::countEvictions(const std::string_view reason, const std::size_t count) {
+        if (count == 0) return;
+
+        // 原因只有固定几种，各自的计数器在首次使用时注册
+        auto& counter = metrics::Registry::global().counter(
+            "tws_connections_evicted_total", "Connections closed by the pool",
+            std::string(R"(reason=")").append(reason).append("\"")
+        );
+
+        counter.add(count);
+    }
+
+}  // namespace tiny_web_server::http
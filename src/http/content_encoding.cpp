@@ -0,0 +1,221 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file content_encoding.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 10:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/content_encoding.hpp"
+#include "tws/exception.hpp"
+#include "tws/platform.hpp"
+#include "tws/utils/string.hpp"
+#include <zlib.h>
+
+#if WEB_SERVER_HAS_BROTLI
+    #include <brotli/encode.h>
+#endif
+
+#if WEB_SERVER_HAS_ZSTD
+    #include <zstd.h>
+#endif
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        // "0.5" -> 500, "1" -> 1000
+        std::uint16_t parseQuality(std::string_view str) noexcept {
+            if (str.empty() || str[0] == '1') return 1000;
+            if (str[0] != '0') return 0;
+
+            std::uint16_t value = 0, scale = 100;
+
+            for (std::size_t i = 2; i < str.size() && i < 5; ++i, scale /= 10) {
+                if (str[i] < '0' || str[i] > '9') break;
+
+                value += static_cast<std::uint16_t>((str[i] - '0') * scale);
+            }
+
+            return value;
+        }
+
+        std::vector<std::byte> gzip(std::span<const std::byte> data, int level) {
+            z_stream stream{};
+
+            // windowBits 15 + 16 表示输出 gzip 头与尾
+            if (deflateInit2(
+                    &stream, level < 0 ? Z_DEFAULT_COMPRESSION : level, Z_DEFLATED, 15 + 16,
+                    8, Z_DEFAULT_STRATEGY
+                )
+                != Z_OK)
+                throw HttpError<"Failed to initialize gzip stream"_s>();
+
+            std::vector<std::byte> out(deflateBound(&stream, data.size()) + 18);
+
+            stream.next_in   = reinterpret_cast<Bytef*>(const_cast<std::byte*>(data.data()));
+            stream.avail_in  = static_cast<uInt>(data.size());
+            stream.next_out  = reinterpret_cast<Bytef*>(out.data());
+            stream.avail_out = static_cast<uInt>(out.size());
+
+            auto result = deflate(&stream, Z_FINISH);
+            out.resize(stream.total_out);
+            deflateEnd(&stream);
+
+            if (result != Z_STREAM_END) throw HttpError<"Failed to gzip content"_s>();
+
+            return out;
+        }
+
+    }  // namespace
+
+    std::string_view toString(const ContentEncoding encoding) noexcept {
+        switch (encoding) {
+            case ContentEncoding::GZIP: return "gzip";
+            case ContentEncoding::ZSTD: return "zstd";
+            case ContentEncoding::BROTLI: return "br";
+            default: return "identity";
+        }
+    }
+
+    std::string_view extension(const ContentEncoding encoding) noexcept {
+        switch (encoding) {
+            case ContentEncoding::GZIP: return ".gz";
+            case ContentEncoding::ZSTD: return ".zst";
+            case ContentEncoding::BROTLI: return ".br";
+            default: return "";
+        }
+    }
+
+    bool isSupported(const ContentEncoding encoding) noexcept {
+        switch (encoding) {
+            case ContentEncoding::IDENTITY:
+            case ContentEncoding::GZIP: return true;
+            case ContentEncoding::ZSTD: return WEB_SERVER_HAS_ZSTD;
+            case ContentEncoding::BROTLI: return WEB_SERVER_HAS_BROTLI;
+        }
+
+        return false;
+    }
+
+    AcceptEncoding::AcceptEncoding(std::string_view header) {
+        constexpr auto none = static_cast<std::uint16_t>(-1);
+
+        std::array<std::uint16_t, 4> explicitQuality{none, none, none, none};
+        auto wildcard = none;
+
+        forEachListItem(header, [&](std::string_view item) {
+            std::uint16_t quality = 1000;
+
+            if (auto semicolon = item.find(';'); semicolon != std::string_view::npos) {
+                auto params = trim(item.substr(semicolon + 1));
+                item        = trim(item.substr(0, semicolon));
+
+                if (params.size() >= 2 && (params[0] | 0x20) == 'q' && params[1] == '=')
+                    quality = parseQuality(params.substr(2));
+            }
+
+            auto set = [&](ContentEncoding encoding) {
+                explicitQuality[static_cast<std::size_t>(encoding)] = quality;
+            };
+
+            if (item == "*")
+                wildcard = quality;
+            else if (iequals(item, "gzip") || iequals(item, "x-gzip"))
+                set(ContentEncoding::GZIP);
+            else if (iequals(item, "br"))
+                set(ContentEncoding::BROTLI);
+            else if (iequals(item, "zstd"))
+                set(ContentEncoding::ZSTD);
+            else if (iequals(item, "identity"))
+                set(ContentEncoding::IDENTITY);
+
+            return true;
+        });
+
+        for (std::size_t i = 0; i < quality_.size(); ++i) {
+            if (explicitQuality[i] != none)
+                quality_[i] = explicitQuality[i];
+            else if (wildcard != none)
+                quality_[i] = wildcard;
+        }
+    }
+
+    bool AcceptEncoding::accepts(const ContentEncoding encoding) const noexcept {
+        return quality_[static_cast<std::size_t>(encoding)] > 0;
+    }
+
+    ContentEncoding
+    AcceptEncoding::select(const std::span<const ContentEncoding> available) const noexcept {
+        auto best        = ContentEncoding::IDENTITY;
+        std::uint16_t bq = 0;
+
+        for (auto encoding : available) {
+            auto q = quality_[static_cast<std::size_t>(encoding)];
+
+            if (q > bq || (q == bq && q > 0 && encoding > best)) {
+                best = encoding;
+                bq   = q;
+            }
+        }
+
+        return best;
+    }
+
+    std::vector<std::byte> compress(
+        std::span<const std::byte> data, const ContentEncoding encoding, const int level
+    ) {
+        switch (encoding) {
+            case ContentEncoding::IDENTITY: return {data.begin(), data.end()};
+
+            case ContentEncoding::GZIP: return gzip(data, level);
+
+#if WEB_SERVER_HAS_BROTLI
+            case ContentEncoding::BROTLI: {
+                // 在线压缩使用中等质量，最高质量(11)留给离线预压缩
+                std::vector<std::byte> out(BrotliEncoderMaxCompressedSize(data.size()));
+                auto size = out.size();
+
+                if (!BrotliEncoderCompress(
+                        level < 0 ? 5 : level, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC,
+                        data.size(), reinterpret_cast<const std::uint8_t*>(data.data()),
+                        &size, reinterpret_cast<std::uint8_t*>(out.data())
+                    ))
+                    throw HttpError<"Failed to brotli compress content"_s>();
+
+                out.resize(size);
+                return out;
+            }
+#endif
+
+#if WEB_SERVER_HAS_ZSTD
+            case ContentEncoding::ZSTD: {
+                std::vector<std::byte> out(ZSTD_compressBound(data.size()));
+
+                auto size = ZSTD_compress(
+                    out.data(), out.size(), data.data(), data.size(), level < 0 ? 3 : level
+                );
+
+                if (ZSTD_isError(size))
+                    throw HttpError<"Failed to zstd compress content"_s>();
+
+                out.resize(size);
+                return out;
+            }
+#endif
+
+            default:
+                throw HttpError<>(
+                    std::format("Unsupported content encoding '{}'", toString(encoding))
+                );
+        }
+    }
+
+}  // namespace tiny_web_server::http
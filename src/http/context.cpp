@@ -0,0 +1,35 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file context.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/context.hpp"
+
+namespace tiny_web_server::http {
+
+    RequestContext::RequestContext() noexcept
+        : arena({inline_.data(), inline_.size()})
+        , request(&arena)
+        , response(&arena) {}
+
+    std::pmr::memory_resource* RequestContext::resource() noexcept { return &arena; }
+
+    void RequestContext::reset() noexcept {
+        // 先丢弃指向内存池的容器，再回收内存池
+        request  = Request{&arena};
+        response = ResponseBuilder{&arena};
+
+        arena.reset();
+    }
+
+}  // namespace tiny_web_server::http
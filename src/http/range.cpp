@@ -0,0 +1,148 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file range.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 11:52
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/range.hpp"
+#include "tws/utils/string.hpp"
+#include <algorithm>
+#include <charconv>
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        bool parseNumber(std::string_view str, std::uint64_t& value) noexcept {
+            if (str.empty()) return false;
+
+            auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+
+            return ec == std::errc{} && ptr == str.data() + str.size();
+        }
+
+    }  // namespace
+
+    RangeSet parseRange(
+        std::string_view header, const std::uint64_t size, const std::size_t maxRanges
+    ) {
+        RangeSet result;
+
+        header = trim(header);
+        if (!header.starts_with("bytes=")) return result;
+
+        header.remove_prefix(6);
+
+        bool anySpec = false, invalid = false;
+
+        forEachListItem(header, [&](std::string_view spec) {
+            auto dash = spec.find('-');
+            if (dash == std::string_view::npos) return !(invalid = true);
+
+            auto firstStr = trim(spec.substr(0, dash));
+            auto lastStr  = trim(spec.substr(dash + 1));
+
+            std::uint64_t first = 0, last = 0;
+            anySpec = true;
+
+            // 后缀区间: bytes=-500
+            if (firstStr.empty()) {
+                if (!parseNumber(lastStr, last)) return !(invalid = true);
+                if (last == 0 || size == 0) return true;
+
+                auto length = std::min(last, size);
+                result.ranges.push_back({size - length, length});
+                return true;
+            }
+
+            if (!parseNumber(firstStr, first)) return !(invalid = true);
+
+            // 开放区间: bytes=500-
+            if (lastStr.empty())
+                last = size == 0 ? 0 : size - 1;
+            else if (!parseNumber(lastStr, last) || last < first)
+                return !(invalid = true);
+
+            if (first >= size) return true;
+
+            last = std::min(last, size - 1);
+            result.ranges.push_back({first, last - first + 1});
+            return true;
+        });
+
+        if (invalid || !anySpec) return {};
+
+        if (result.ranges.empty()) {
+            result.status = RangeSet::Status::UNSATISFIABLE;
+            return result;
+        }
+
+        std::ranges::sort(result.ranges, {}, &ByteRange::offset);
+
+        std::size_t merged = 0;
+
+        for (std::size_t i = 1; i < result.ranges.size(); ++i) {
+            auto& current = result.ranges[merged];
+            auto& next    = result.ranges[i];
+
+            if (next.offset <= current.offset + current.length) {
+                auto end =
+                    std::max(current.offset + current.length, next.offset + next.length);
+                current.length = end - current.offset;
+            }
+            else
+                result.ranges[++merged] = next;
+        }
+
+        result.ranges.resize(merged + 1);
+
+        if (result.ranges.size() > maxRanges) return {};
+
+        result.status = RangeSet::Status::SATISFIABLE;
+        return result;
+    }
+
+    std::string contentRange(const ByteRange& range, const std::uint64_t size) {
+        // 每个区间响应都会调用，直接用 to_chars 拼接
+        std::string out{"bytes "};
+        out.reserve(6 + 3 * 20 + 2);
+
+        auto append = [&out](const std::uint64_t value) {
+            char digits[20];
+            out.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+        };
+
+        append(range.offset);
+        out.push_back('-');
+        append(range.last());
+        out.push_back('/');
+        append(size);
+
+        return out;
+    }
+
+    bool ifRangeMatches(
+        std::string_view ifRange, const std::string_view etag,
+        const std::string_view lastModified
+    ) noexcept {
+        ifRange = trim(ifRange);
+        if (ifRange.empty()) return true;
+
+        if (ifRange.starts_with("W/")) return false;
+
+        if (ifRange.starts_with('"'))
+            return !etag.empty() && !etag.starts_with("W/") && ifRange == etag;
+
+        return !lastModified.empty() && ifRange == lastModified;
+    }
+
+}  // namespace tiny_web_server::http
@@ -0,0 +1,166 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file request.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 13:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/request.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/utils/string.hpp"
+#include <algorithm>
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        // RFC 9110 tchar
+        constexpr bool isTokenChar(const char c) noexcept {
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+                return true;
+
+            return std::string_view{"!#$%&'*+-.^_`|~"}.contains(c);
+        }
+
+        constexpr bool isToken(std::string_view str) noexcept {
+            return !str.empty() && std::ranges::all_of(str, isTokenChar);
+        }
+
+    }  // namespace
+
+    Request::Request(std::pmr::memory_resource* resource)
+        : headers(resource) {}
+
+    std::string_view Request::header(const std::string_view name) const noexcept {
+        for (const auto& [key, value] : headers)
+            if (iequals(key, name)) return value;
+
+        return {};
+    }
+
+    bool Request::hasToken(std::string_view name, std::string_view token) const noexcept {
+        bool found = false;
+
+        for (const auto& [key, value] : headers) {
+            if (!iequals(key, name)) continue;
+
+            forEachListItem(value, [&](std::string_view item) {
+                return !(found = iequals(item, token));
+            });
+
+            if (found) return true;
+        }
+
+        return false;
+    }
+
+    bool Request::keepAlive() const noexcept {
+        if (versionMinor == 0) return hasToken("Connection", "keep-alive");
+
+        return !hasToken("Connection", "close");
+    }
+
+    void Request::clear() noexcept {
+        method       = {};
+        target       = {};
+        versionMinor = 1;
+        headers.clear();
+    }
+
+    RequestParser::RequestParser(
+        const std::size_t maxHeaderSize, const std::size_t maxHeaderCount
+    )
+        : maxHeaderSize_(maxHeaderSize)
+        , maxHeaderCount_(maxHeaderCount) {}
+
+    RequestParser::Status RequestParser::parse(std::string_view data, Request& request) {
+        auto start  = std::chrono::steady_clock::now();
+        auto status = parseHeader(data, request);
+
+        elapsed_ += std::chrono::steady_clock::now() - start;
+
+        if (status == Status::COMPLETE) {
+            metrics::server().parseTime.record(elapsed_);
+            elapsed_ = {};
+        }
+
+        return status;
+    }
+
+    RequestParser::Status
+    RequestParser::parseHeader(std::string_view data, Request& request) {
+        // 从上次扫描处回退3字节，以免错过跨两次接收的 \r\n\r\n
+        auto start = scanned_ > 3 ? scanned_ - 3 : 0;
+        auto end   = data.find("\r\n\r\n", start);
+
+        if (end == std::string_view::npos) {
+            scanned_ = data.size();
+
+            return data.size() > maxHeaderSize_ ? Status::ERROR : Status::INCOMPLETE;
+        }
+
+        headerLength_ = end + 4;
+        if (headerLength_ > maxHeaderSize_) return Status::ERROR;
+
+        request.clear();
+
+        // 请求行: METHOD SP TARGET SP HTTP/1.x
+        auto lineEnd = data.find("\r\n");
+        auto line    = data.substr(0, lineEnd);
+
+        auto sp1 = line.find(' ');
+        auto sp2 = line.find(' ', sp1 + 1);
+        if (sp1 == std::string_view::npos || sp2 == std::string_view::npos)
+            return Status::ERROR;
+
+        request.method = line.substr(0, sp1);
+        request.target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+
+        auto version = line.substr(sp2 + 1);
+        if (!isToken(request.method) || request.target.empty() || version.size() != 8
+            || !version.starts_with("HTTP/1.") || version[7] < '0' || version[7] > '9')
+            return Status::ERROR;
+
+        request.versionMinor = version[7] - '0';
+
+        // 头部字段: NAME ":" OWS VALUE OWS
+        auto rest = data.substr(lineEnd + 2, end - lineEnd);
+
+        while (!rest.empty()) {
+            auto eol   = rest.find("\r\n");
+            auto field = rest.substr(0, eol);
+            rest.remove_prefix(eol + 2);
+
+            if (field.empty()) break;
+
+            // 不支持已废弃的多行折叠(obs-fold)
+            auto colon = field.find(':');
+            if (colon == std::string_view::npos) return Status::ERROR;
+
+            auto name = field.substr(0, colon);
+            if (!isToken(name) || request.headers.size() == maxHeaderCount_)
+                return Status::ERROR;
+
+            request.headers.push_back({name, trim(field.substr(colon + 1))});
+        }
+
+        return Status::COMPLETE;
+    }
+
+    std::size_t RequestParser::headerLength() const noexcept { return headerLength_; }
+
+    void RequestParser::reset() noexcept {
+        scanned_      = 0;
+        headerLength_ = 0;
+        elapsed_      = {};
+    }
+
+}  // namespace tiny_web_server::http
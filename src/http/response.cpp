@@ -0,0 +1,235 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file response.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/response.hpp"
+#include "tws/platform.hpp"
+#include <charconv>
+#include <cstring>
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        constexpr std::string_view CONTENT_LENGTH = "Content-Length: ";
+
+        constexpr std::string_view KEEP_ALIVE = "Connection: keep-alive\r\n\r\n";
+
+        constexpr std::string_view CLOSE = "Connection: close\r\n\r\n";
+
+        /// 两位数字，写入小于100的字段
+        char* twoDigits(char* out, const int value) noexcept {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+
+            return out + 2;
+        }
+
+        char* copy(char* out, const std::string_view text) noexcept {
+            std::memcpy(out, text.data(), text.size());
+
+            return out + text.size();
+        }
+
+    }  // namespace
+
+    ResponseBuilder::ResponseBuilder(std::pmr::memory_resource* resource)
+        : buffer_(resource) {}
+
+    ResponseBuilder& ResponseBuilder::status(const int code, std::string_view reason) {
+        if (reason.empty()) reason = reasonPhrase(code);
+
+        buffer_.append("HTTP/1.1 ");
+        append(static_cast<std::uint64_t>(code));
+        buffer_.push_back(' ');
+        buffer_.append(reason).append("\r\n");
+
+        return *this;
+    }
+
+    ResponseBuilder&
+    ResponseBuilder::header(const std::string_view name, const std::string_view value) {
+        buffer_.append(name).append(": ").append(value).append("\r\n");
+
+        return *this;
+    }
+
+    ResponseBuilder&
+    ResponseBuilder::header(const std::string_view name, const std::uint64_t value) {
+        buffer_.append(name).append(": ");
+        append(value);
+        buffer_.append("\r\n");
+
+        return *this;
+    }
+
+    ResponseBuilder& ResponseBuilder::append(const std::string_view text) {
+        buffer_.append(text);
+
+        return *this;
+    }
+
+    ResponseBuilder& ResponseBuilder::append(const std::uint64_t value) {
+        char digits[20];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+
+        buffer_.append(digits, end);
+
+        return *this;
+    }
+
+    ResponseBuilder& ResponseBuilder::date() { return header("Date", HttpDate::now()); }
+
+    ResponseBuilder& ResponseBuilder::end() {
+        buffer_.append("\r\n");
+
+        return *this;
+    }
+
+    std::string_view ResponseBuilder::view() const noexcept { return buffer_; }
+
+    std::span<const std::byte> ResponseBuilder::bytes() const noexcept {
+        return std::as_bytes(std::span{buffer_});
+    }
+
+    std::size_t ResponseBuilder::size() const noexcept { return buffer_.size(); }
+
+    void ResponseBuilder::clear() noexcept { buffer_.clear(); }
+
+    std::string_view ResponseBuilder::reasonPhrase(const int code) noexcept {
+        switch (code) {
+            case 100: return "Continue";
+            case 101: return "Switching Protocols";
+            case 200: return "OK";
+            case 201: return "Created";
+            case 204: return "No Content";
+            case 206: return "Partial Content";
+            case 301: return "Moved Permanently";
+            case 302: return "Found";
+            case 304: return "Not Modified";
+            case 400: return "Bad Request";
+            case 401: return "Unauthorized";
+            case 403: return "Forbidden";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 408: return "Request Timeout";
+            case 413: return "Content Too Large";
+            case 416: return "Range Not Satisfiable";
+            case 429: return "Too Many Requests";
+            case 431: return "Request Header Fields Too Large";
+            case 500: return "Internal Server Error";
+            case 501: return "Not Implemented";
+            case 502: return "Bad Gateway";
+            case 503: return "Service Unavailable";
+            case 504: return "Gateway Timeout";
+            default: return {};
+        }
+    }
+
+    std::string_view HttpDate::now() {
+        thread_local std::time_t cachedSecond = -1;
+        thread_local std::array<char, SIZE> cached;
+
+        if (auto second = std::time(nullptr); second != cachedSecond) {
+            format(second, cached);
+            cachedSecond = second;
+        }
+
+        return {cached.data(), cached.size()};
+    }
+
+    void HttpDate::format(const std::time_t time, const std::span<char, SIZE> out) noexcept {
+        // 不使用 strftime: %a 与 %b 受区域设置影响
+        static constexpr std::string_view DAYS   = "SunMonTueWedThuFriSat";
+        static constexpr std::string_view MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+        std::tm tm{};
+#if WEB_SERVER_WINDOWS
+        gmtime_s(&tm, &time);
+#else
+        gmtime_r(&time, &tm);
+#endif
+
+        auto* p = out.data();
+
+        p    = copy(p, DAYS.substr(tm.tm_wday * 3, 3));
+        p    = copy(p, ", ");
+        p    = twoDigits(p, tm.tm_mday);
+        *p++ = ' ';
+        p    = copy(p, MONTHS.substr(tm.tm_mon * 3, 3));
+        *p++ = ' ';
+        p    = twoDigits(p, (tm.tm_year + 1900) / 100);
+        p    = twoDigits(p, (tm.tm_year + 1900) % 100);
+        *p++ = ' ';
+        p    = twoDigits(p, tm.tm_hour);
+        *p++ = ':';
+        p    = twoDigits(p, tm.tm_min);
+        *p++ = ':';
+        p    = twoDigits(p, tm.tm_sec);
+        copy(p, " GMT");
+    }
+
+    ResponseTemplate::ResponseTemplate(
+        const int status,
+        const std::initializer_list<std::pair<std::string_view, std::string_view>> headers,
+        const std::string_view reason
+    ) {
+        ResponseBuilder builder;
+        builder.status(status, reason);
+
+        for (const auto& [name, value] : headers) builder.header(name, value);
+
+        builder.append("Date: ");
+
+        head_       = builder.view();
+        dateOffset_ = head_.size();
+
+        head_.append(HttpDate::SIZE, ' ').append("\r\n");
+    }
+
+    std::size_t ResponseTemplate::maxSize() const noexcept {
+        return head_.size() + CONTENT_LENGTH.size() + MAX_DIGITS + 2 + KEEP_ALIVE.size();
+    }
+
+    std::size_t ResponseTemplate::render(
+        const std::span<char> out, const std::optional<std::uint64_t> contentLength,
+        const bool keepAlive
+    ) const noexcept {
+        auto* p = copy(out.data(), head_);
+
+        auto date = HttpDate::now();
+        std::memcpy(out.data() + dateOffset_, date.data(), date.size());
+
+        if (contentLength) {
+            p = copy(p, CONTENT_LENGTH);
+            p = std::to_chars(p, p + MAX_DIGITS, *contentLength).ptr;
+            p = copy(p, "\r\n");
+        }
+
+        p = copy(p, keepAlive ? KEEP_ALIVE : CLOSE);
+
+        return static_cast<std::size_t>(p - out.data());
+    }
+
+    void ResponseTemplate::render(
+        std::string& out, const std::optional<std::uint64_t> contentLength,
+        const bool keepAlive
+    ) const {
+        // 先按上限扩容，写完后截到实际长度; 容量足够时不分配
+        out.resize_and_overwrite(maxSize(), [&](char* data, const std::size_t size) {
+            return render(std::span{data, size}, contentLength, keepAlive);
+        });
+    }
+
+}  // namespace tiny_web_server::http
@@ -0,0 +1,828 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file static_bundle.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 04:50
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/static_bundle.hpp"
+#include "tws/exception.hpp"
+#include "tws/http/response.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/utils/arena.hpp"
+#include "tws/utils/hash.hpp"
+#include "tws/utils/string.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <unordered_set>
+
+#if !WEB_SERVER_WINDOWS
+    #include <sys/mman.h>
+#endif
+
+namespace tiny_web_server::http {
+
+    /**
+     * @brief 资源包文件头
+     * @details 文件布局: 文件头、每个桶一个 u32 种子、按槽位排列的索引项(8字节对齐)，
+     * 其后依次是每个文件的路径、各变体的响应头与内容。整数均为本机字节序
+     */
+    struct StaticBundle::Header {
+        std::array<char, 8> magic;
+
+        std::uint32_t version;
+
+        std::uint32_t files;
+
+        std::uint32_t slots;
+
+        std::uint32_t buckets;
+
+        std::uint64_t seedsOffset;
+
+        std::uint64_t entriesOffset;
+
+        /// 整个资源包的字节数
+        std::uint64_t size;
+    };
+
+    /**
+     * @brief 一个槽位的索引项
+     * @details @c variants 是按 @c ContentEncoding 取位的掩码，为0表示空槽位
+     */
+    struct StaticBundle::Entry {
+        struct Variant {
+            std::uint64_t headOffset;
+
+            std::uint64_t bodyOffset;
+
+            std::uint64_t bodyLength;
+
+            std::uint32_t headLength;
+
+            /// ETag 值在响应头内的偏移与长度
+            std::uint16_t etagOffset;
+
+            std::uint16_t etagLength;
+        };
+
+        std::uint64_t pathOffset;
+
+        std::uint32_t pathLength;
+
+        std::uint32_t variants;
+
+        std::array<Variant, 4> variant;
+    };
+
+    namespace {
+
+        constexpr std::array<char, 8> MAGIC{'T', 'W', 'S', 'B', 'N', 'D', 'L', '1'};
+
+        constexpr std::uint32_t VERSION = 1;
+
+        // 不大于该字节数的内容直接从映射写出，更大的走 sendfile
+        constexpr std::size_t DIRECT_WRITE_LIMIT = 16 * 1024;
+
+        // 单个桶的种子搜索上限，超出后加倍桶数重建
+        constexpr std::uint32_t MAX_SEED = 1U << 20;
+
+        constexpr std::string_view DATE_PREFIX = "Date: ";
+
+        // 响应头末尾的 Date 占位与 CRLF
+        constexpr std::size_t DATE_TAIL = HttpDate::SIZE + 2;
+
+        constexpr std::string_view KEEP_ALIVE = "Connection: keep-alive\r\n\r\n";
+
+        constexpr std::string_view CLOSE = "Connection: close\r\n\r\n";
+
+        constexpr std::array ENCODINGS{
+            ContentEncoding::IDENTITY, ContentEncoding::GZIP, ContentEncoding::ZSTD,
+            ContentEncoding::BROTLI
+        };
+
+        struct MimeType {
+            std::string_view extension;
+
+            std::string_view type;
+
+            bool compressible;
+        };
+
+        constexpr MimeType MIME_TYPES[]{
+            {".html", "text/html; charset=utf-8", true},
+            {".htm", "text/html; charset=utf-8", true},
+            {".css", "text/css; charset=utf-8", true},
+            {".js", "text/javascript; charset=utf-8", true},
+            {".mjs", "text/javascript; charset=utf-8", true},
+            {".json", "application/json", true},
+            {".map", "application/json", true},
+            {".xml", "application/xml", true},
+            {".txt", "text/plain; charset=utf-8", true},
+            {".csv", "text/csv; charset=utf-8", true},
+            {".md", "text/markdown; charset=utf-8", true},
+            {".svg", "image/svg+xml", true},
+            {".ico", "image/x-icon", true},
+            {".wasm", "application/wasm", true},
+            {".ttf", "font/ttf", true},
+            {".otf", "font/otf", true},
+            {".woff", "font/woff", false},
+            {".woff2", "font/woff2", false},
+            {".png", "image/png", false},
+            {".jpg", "image/jpeg", false},
+            {".jpeg", "image/jpeg", false},
+            {".gif", "image/gif", false},
+            {".webp", "image/webp", false},
+            {".avif", "image/avif", false},
+            {".pdf", "application/pdf", false},
+            {".mp3", "audio/mpeg", false},
+            {".mp4", "video/mp4", false},
+            {".webm", "video/webm", false},
+        };
+
+        constexpr MimeType OCTET_STREAM{{}, "application/octet-stream", false};
+
+        const MimeType& mimeType(const std::string_view extension) noexcept {
+            for (const auto& mime : MIME_TYPES)
+                if (iequals(mime.extension, extension)) return mime;
+
+            return OCTET_STREAM;
+        }
+
+        std::uint64_t pathHash(const std::string_view path) noexcept {
+            return contentHash(std::as_bytes(std::span{path}));
+        }
+
+        std::size_t
+        bucketOf(const std::uint64_t hash, const std::uint32_t buckets) noexcept {
+            return static_cast<std::size_t>((hash >> 32) % buckets);
+        }
+
+        /**
+         * @brief 以桶的种子重新混合路径哈希，得到槽位
+         */
+        std::size_t slotOf(
+            std::uint64_t hash, const std::uint32_t seed, const std::uint32_t slots
+        ) noexcept {
+            hash ^= (std::uint64_t{seed} + 1) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ULL;
+            hash ^= hash >> 33;
+
+            return static_cast<std::size_t>(hash % slots);
+        }
+
+        struct PerfectHash {
+            std::uint32_t slots;
+
+            std::vector<std::uint32_t> seeds;
+
+            /// 与输入哈希一一对应的槽位
+            std::vector<std::uint32_t> placement;
+        };
+
+        /**
+         * @brief 为给定的哈希构建 CHD 风格的完美哈希
+         * @details 键先按哈希高位分桶，再按桶从大到小依次为每个桶搜索一个种子，
+         * 使桶内所有键落在互不相同的空槽位上。留约 6% 的空槽位让最后的小桶也能很快放下
+         */
+        std::optional<PerfectHash>
+        tryBuild(const std::vector<std::uint64_t>& hashes, const std::uint32_t buckets) {
+            auto count = static_cast<std::uint32_t>(hashes.size());
+
+            PerfectHash result{
+                count + count / 16 + 1, std::vector<std::uint32_t>(buckets), {}
+            };
+            result.placement.resize(count);
+
+            std::vector<std::vector<std::uint32_t>> members(buckets);
+            for (std::uint32_t i = 0; i < count; ++i)
+                members[bucketOf(hashes[i], buckets)].push_back(i);
+
+            std::vector<std::uint32_t> order(buckets);
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::stable_sort(order, [&](auto lhs, auto rhs) {
+                return members[lhs].size() > members[rhs].size();
+            });
+
+            std::vector<bool> taken(result.slots);
+            std::vector<std::uint32_t> slots;
+
+            for (auto bucket : order) {
+                const auto& keys = members[bucket];
+                if (keys.empty()) break;
+
+                auto placed = false;
+
+                for (std::uint32_t seed = 0; seed < MAX_SEED && !placed; ++seed) {
+                    slots.clear();
+
+                    for (auto key : keys) {
+                        auto slot = static_cast<std::uint32_t>(
+                            slotOf(hashes[key], seed, result.slots)
+                        );
+
+                        if (taken[slot] || std::ranges::find(slots, slot) != slots.end())
+                            break;
+
+                        slots.push_back(slot);
+                    }
+
+                    if (slots.size() != keys.size()) continue;
+
+                    for (std::size_t i = 0; i < keys.size(); ++i) {
+                        taken[slots[i]]            = true;
+                        result.placement[keys[i]] = slots[i];
+                    }
+
+                    result.seeds[bucket] = seed;
+                    placed               = true;
+                }
+
+                if (!placed) return std::nullopt;
+            }
+
+            return result;
+        }
+
+        PerfectHash buildPerfectHash(const std::vector<std::uint64_t>& hashes) {
+            // 同一哈希的两个键在任何种子下都会冲突
+            auto sorted = hashes;
+            std::ranges::sort(sorted);
+
+            if (std::ranges::adjacent_find(sorted) != sorted.end())
+                throw HttpError<"Path hash collision while building static bundle"_s>();
+
+            auto buckets = static_cast<std::uint32_t>(hashes.size() / 4 + 1);
+
+            while (true) {
+                if (auto result = tryBuild(hashes, buckets)) return std::move(*result);
+
+                buckets *= 2;
+            }
+        }
+
+        std::vector<std::byte> readFile(const std::filesystem::path& path) {
+            std::ifstream file(path, std::ios::binary);
+
+            std::error_code ec;
+            auto size = std::filesystem::file_size(path, ec);
+
+            if (!file || ec)
+                throw HttpError<>(std::format("Failed to open '{}'", path.string()));
+
+            std::vector<std::byte> data(size);
+
+            auto* buffer = reinterpret_cast<char*>(data.data());
+
+            if (!file.read(buffer, static_cast<std::streamsize>(size)))
+                throw HttpError<>(std::format("Failed to read '{}'", path.string()));
+
+            return data;
+        }
+
+        /**
+         * @brief 强 ETag: 内容哈希的16位十六进制，压缩变体追加编码名
+         */
+        std::string makeETag(const std::uint64_t hash, const ContentEncoding encoding) {
+            std::array<char, 16> digits;
+            digits.fill('0');
+
+            char buffer[16];
+            auto end = std::to_chars(buffer, buffer + 16, hash, 16).ptr;
+            auto length = static_cast<std::size_t>(end - buffer);
+
+            std::memcpy(digits.data() + 16 - length, buffer, length);
+
+            std::string etag;
+            etag.append(1, '"').append(digits.data(), digits.size());
+
+            if (encoding != ContentEncoding::IDENTITY)
+                etag.append(1, '-').append(toString(encoding));
+
+            return etag.append(1, '"');
+        }
+
+        struct BundleWriter {
+            std::ofstream stream;
+
+            std::uint64_t offset = 0;
+
+            std::uint64_t write(const std::span<const std::byte> data) {
+                auto start = offset;
+
+                stream.write(
+                    reinterpret_cast<const char*>(data.data()),
+                    static_cast<std::streamsize>(data.size())
+                );
+                offset += data.size();
+
+                return start;
+            }
+
+            std::uint64_t write(const std::string_view text) {
+                return write(std::as_bytes(std::span{text}));
+            }
+        };
+
+        void sendAll(const net::Socket& socket, std::string_view data, const int flags = 0) {
+            while (!data.empty())
+                data.remove_prefix(socket.send(std::as_bytes(std::span{data}), flags));
+        }
+
+        void sendAll(const net::Socket& socket, std::span<const std::byte> data) {
+            while (!data.empty()) data = data.subspan(socket.send(data));
+        }
+
+        void sendFileAll(
+            const net::Socket& socket, int fd, std::uint64_t offset, std::uint64_t length
+        ) {
+            while (length > 0) {
+                auto sent = socket.sendFile(fd, offset, length);
+                if (sent == 0) throw HttpError<"Static bundle truncated while sending"_s>();
+
+                offset += sent;
+                length -= sent;
+            }
+        }
+
+        // 响应头之后紧跟内容时提示内核合并为同一报文
+#if WEB_SERVER_LINUX
+        constexpr int SEND_MORE = MSG_MORE;
+#else
+        constexpr int SEND_MORE = 0;
+#endif
+
+    }  // namespace
+
+    std::size_t packBundle(
+        const std::filesystem::path& root, const std::filesystem::path& output,
+        const BundleOptions& options
+    ) {
+        namespace fs = std::filesystem;
+
+        using Entry = StaticBundle::Entry;
+
+        std::error_code ec;
+
+        std::vector<std::string> paths;
+
+        for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end;
+             it.increment(ec)) {
+            if (!it->is_regular_file(ec)) continue;
+
+            paths.push_back("/" + it->path().lexically_relative(root).generic_string());
+        }
+
+        if (ec) throw HttpError<>(std::format("Failed to scan '{}'", root.string()));
+
+        std::ranges::sort(paths);
+
+        // 与原文件并存的预压缩兄弟文件只作为变体，不单独成为条目
+        std::unordered_set<std::string_view> present(paths.begin(), paths.end());
+
+        std::erase_if(paths, [&](const std::string& path) {
+            for (auto encoding : ENCODINGS) {
+                auto suffix = extension(encoding);
+                if (suffix.empty() || !path.ends_with(suffix)) continue;
+
+                auto original = std::string_view{path};
+                original.remove_suffix(suffix.size());
+
+                if (present.contains(original)) return true;
+            }
+
+            return false;
+        });
+
+        std::vector<std::uint64_t> hashes;
+        hashes.reserve(paths.size());
+
+        for (const auto& path : paths) hashes.push_back(pathHash(path));
+
+        auto table = buildPerfectHash(hashes);
+
+        StaticBundle::Header header{
+            MAGIC,
+            VERSION,
+            static_cast<std::uint32_t>(paths.size()),
+            table.slots,
+            static_cast<std::uint32_t>(table.seeds.size()),
+            sizeof(StaticBundle::Header),
+            0,
+            0
+        };
+
+        constexpr auto ALIGN = alignof(Entry);
+
+        auto seedsEnd        = header.seedsOffset + table.seeds.size() * 4;
+        header.entriesOffset = (seedsEnd + ALIGN - 1) / ALIGN * ALIGN;
+
+        std::vector<Entry> entries(table.slots);
+
+        auto temporary = output;
+        temporary += ".tmp";
+
+        BundleWriter writer{std::ofstream(temporary, std::ios::binary | std::ios::trunc)};
+
+        if (!writer.stream)
+            throw HttpError<>(std::format("Failed to create '{}'", temporary.string()));
+
+        // 索引区先占位，内容写完后回填
+        auto indexEnd = header.entriesOffset + entries.size() * sizeof(Entry);
+        writer.write(std::string(indexEnd, '\0'));
+
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            const auto& path = paths[i];
+            auto& entry      = entries[table.placement[i]];
+
+            auto source = root / fs::path(path.substr(1));
+            auto mime   = mimeType(source.extension().string());
+
+            std::array<std::vector<std::byte>, 4> bodies;
+            bodies[0] = readFile(source);
+
+            const auto& identity = bodies[0];
+            auto lastWrite       = fs::last_write_time(source, ec);
+
+            for (auto encoding : ENCODINGS) {
+                if (encoding == ContentEncoding::IDENTITY) continue;
+
+                auto& body = bodies[static_cast<std::size_t>(encoding)];
+
+                auto sibling = source;
+                sibling += extension(encoding);
+
+                if (fs::is_regular_file(sibling, ec)
+                    && fs::last_write_time(sibling, ec) >= lastWrite && !ec) {
+                    body = readFile(sibling);
+                    continue;
+                }
+
+                if (!mime.compressible || identity.size() < options.minCompressSize
+                    || !isSupported(encoding))
+                    continue;
+
+                body = compress(identity, encoding, options.level);
+
+                auto size  = static_cast<double>(identity.size());
+                auto limit = (1.0 - options.minSavings) * size;
+
+                if (static_cast<double>(body.size()) > limit) body.clear();
+            }
+
+            entry.variants = 1;
+
+            for (auto encoding : ENCODINGS)
+                if (!bodies[static_cast<std::size_t>(encoding)].empty())
+                    entry.variants |= 1U << static_cast<unsigned>(encoding);
+
+            entry.pathOffset = writer.write(path);
+            entry.pathLength = static_cast<std::uint32_t>(path.size());
+
+            auto digest = contentHash(identity);
+
+            for (auto encoding : ENCODINGS) {
+                auto index = static_cast<std::size_t>(encoding);
+                if (!(entry.variants & (1U << index))) continue;
+
+                auto etag = makeETag(digest, encoding);
+
+                ResponseBuilder head;
+                head.status(200)
+                    .header("Content-Type", mime.type)
+                    .header("Content-Length", bodies[index].size());
+
+                if (encoding != ContentEncoding::IDENTITY)
+                    head.header("Content-Encoding", toString(encoding));
+
+                if (std::popcount(entry.variants) > 1)
+                    head.header("Vary", "Accept-Encoding");
+
+                auto etagOffset = head.size() + std::string_view{"ETag: "}.size();
+
+                head.header("ETag", etag).append(DATE_PREFIX);
+                head.append(std::string(HttpDate::SIZE, ' ')).append("\r\n");
+
+                auto& variant = entry.variant[index];
+
+                variant.headOffset = writer.write(head.view());
+                variant.headLength = static_cast<std::uint32_t>(head.size());
+                variant.etagOffset = static_cast<std::uint16_t>(etagOffset);
+                variant.etagLength = static_cast<std::uint16_t>(etag.size());
+                variant.bodyOffset = writer.write(bodies[index]);
+                variant.bodyLength = bodies[index].size();
+            }
+        }
+
+        header.size = writer.offset;
+
+        writer.stream.seekp(0);
+        writer.write(std::as_bytes(std::span{&header, 1}));
+
+        writer.stream.seekp(static_cast<std::streamoff>(header.seedsOffset));
+        writer.write(std::as_bytes(std::span{table.seeds}));
+
+        writer.stream.seekp(static_cast<std::streamoff>(header.entriesOffset));
+        writer.write(std::as_bytes(std::span{entries}));
+
+        writer.stream.close();
+
+        if (!writer.stream)
+            throw HttpError<>(std::format("Failed to write '{}'", temporary.string()));
+
+        fs::rename(temporary, output, ec);
+
+        if (ec) throw HttpError<>(std::format("Failed to replace '{}'", output.string()));
+
+        return paths.size();
+    }
+
+    std::size_t BundleVariant::maxSize() const noexcept {
+        return head.size() + std::max(KEEP_ALIVE.size(), CLOSE.size());
+    }
+
+    std::size_t
+    BundleVariant::render(const std::span<char> out, const bool keepAlive) const noexcept {
+        std::memcpy(out.data(), head.data(), head.size());
+
+        auto date = HttpDate::now();
+        std::memcpy(out.data() + head.size() - DATE_TAIL, date.data(), date.size());
+
+        auto tail = keepAlive ? KEEP_ALIVE : CLOSE;
+        std::memcpy(out.data() + head.size(), tail.data(), tail.size());
+
+        return head.size() + tail.size();
+    }
+
+    void BundleVariant::render(std::string& out, const bool keepAlive) const {
+        out.resize_and_overwrite(maxSize(), [&](char* data, const std::size_t size) {
+            return render(std::span{data, size}, keepAlive);
+        });
+    }
+
+    StaticBundle StaticBundle::open(const std::filesystem::path& path) {
+#if WEB_SERVER_WINDOWS
+        throw HttpError<"Static bundles are not supported on this platform"_s>();
+#else
+        StaticBundle bundle;
+
+        bundle.fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (bundle.fd_ < 0)
+            throw HttpError<>(std::format("Failed to open '{}'", path.string()));
+
+        struct stat status{};
+
+        if (::fstat(bundle.fd_, &status) != 0
+            || static_cast<std::size_t>(status.st_size) < sizeof(Header))
+            throw HttpError<>(std::format("Invalid static bundle '{}'", path.string()));
+
+        bundle.size_ = static_cast<std::size_t>(status.st_size);
+
+        auto* data = ::mmap(nullptr, bundle.size_, PROT_READ, MAP_SHARED, bundle.fd_, 0);
+
+        if (data == MAP_FAILED)
+            throw HttpError<>(std::format("Failed to map '{}'", path.string()));
+
+        bundle.data_   = static_cast<const std::byte*>(data);
+        bundle.header_ = reinterpret_cast<const Header*>(bundle.data_);
+
+        const auto& header = *bundle.header_;
+
+        auto within = [&](const std::uint64_t offset, const std::uint64_t length) {
+            return offset <= bundle.size_ && length <= bundle.size_ - offset;
+        };
+
+        auto valid = header.magic == MAGIC && header.version == VERSION
+                  && header.size == bundle.size_ && header.slots > 0 && header.buckets > 0
+                  && header.seedsOffset % alignof(std::uint32_t) == 0
+                  && header.entriesOffset % alignof(Entry) == 0
+                  && within(header.seedsOffset, std::uint64_t{header.buckets} * 4)
+                  && within(header.entriesOffset, header.slots * sizeof(Entry));
+
+        if (valid) {
+            bundle.seeds_ = reinterpret_cast<const std::uint32_t*>(
+                bundle.data_ + header.seedsOffset
+            );
+            bundle.entries_ =
+                reinterpret_cast<const Entry*>(bundle.data_ + header.entriesOffset);
+        }
+
+        std::uint32_t files = 0;
+
+        for (std::uint32_t i = 0; valid && i < header.slots; ++i) {
+            const auto& entry = bundle.entries_[i];
+            if (entry.variants == 0) continue;
+
+            ++files;
+
+            valid = (entry.variants & 1) && entry.variants < 16
+                 && within(entry.pathOffset, entry.pathLength);
+
+            for (std::size_t j = 0; valid && j < entry.variant.size(); ++j) {
+                if (!(entry.variants & (1U << j))) continue;
+
+                const auto& variant = entry.variant[j];
+
+                valid = within(variant.headOffset, variant.headLength)
+                     && within(variant.bodyOffset, variant.bodyLength)
+                     && variant.headLength >= DATE_TAIL
+                     && variant.etagOffset + variant.etagLength <= variant.headLength;
+            }
+        }
+
+        if (!valid || files != header.files)
+            throw HttpError<>(std::format("Corrupt static bundle '{}'", path.string()));
+
+        // 索引区在查找时随机访问，提前读入
+        ::madvise(
+            const_cast<std::byte*>(bundle.data_),
+            header.entriesOffset + std::size_t{header.slots} * sizeof(Entry), MADV_WILLNEED
+        );
+
+        return bundle;
+#endif
+    }
+
+    StaticBundle::StaticBundle(StaticBundle&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , header_(std::exchange(other.header_, nullptr))
+        , seeds_(std::exchange(other.seeds_, nullptr))
+        , entries_(std::exchange(other.entries_, nullptr)) {}
+
+    StaticBundle& StaticBundle::operator=(StaticBundle&& other) noexcept {
+        if (this != &other) {
+            close();
+
+            fd_      = std::exchange(other.fd_, -1);
+            data_    = std::exchange(other.data_, nullptr);
+            size_    = std::exchange(other.size_, 0);
+            header_  = std::exchange(other.header_, nullptr);
+            seeds_   = std::exchange(other.seeds_, nullptr);
+            entries_ = std::exchange(other.entries_, nullptr);
+        }
+
+        return *this;
+    }
+
+    StaticBundle::~StaticBundle() { close(); }
+
+    void StaticBundle::close() noexcept {
+#if !WEB_SERVER_WINDOWS
+        if (data_) ::munmap(const_cast<std::byte*>(data_), size_);
+
+        if (fd_ >= 0) ::close(fd_);
+#endif
+
+        fd_      = -1;
+        data_    = nullptr;
+        header_  = nullptr;
+        seeds_   = nullptr;
+        entries_ = nullptr;
+    }
+
+    std::optional<std::size_t>
+    StaticBundle::find(const std::string_view path) const noexcept {
+        if (!entries_) return std::nullopt;
+
+        auto hash = pathHash(path);
+        auto seed = seeds_[bucketOf(hash, header_->buckets)];
+        auto slot = slotOf(hash, seed, header_->slots);
+
+        const auto& entry = entries_[slot];
+
+        if (entry.variants == 0 || entry.pathLength != path.size()
+            || std::memcmp(data_ + entry.pathOffset, path.data(), path.size()) != 0)
+            return std::nullopt;
+
+        return slot;
+    }
+
+    BundleVariant StaticBundle::select(
+        const std::size_t entry, const AcceptEncoding& accept
+    ) const noexcept {
+        const auto& item = entries_[entry];
+
+        ContentEncoding available[4];
+        std::size_t count = 0;
+
+        for (auto encoding : ENCODINGS)
+            if (item.variants & (1U << static_cast<unsigned>(encoding)))
+                available[count++] = encoding;
+
+        return variant(item, accept.select({available, count}));
+    }
+
+    std::string_view StaticBundle::path(const std::size_t entry) const noexcept {
+        const auto& item = entries_[entry];
+
+        return {reinterpret_cast<const char*>(data_ + item.pathOffset), item.pathLength};
+    }
+
+    std::size_t StaticBundle::files() const noexcept { return header_ ? header_->files : 0; }
+
+    int StaticBundle::fd() const noexcept { return fd_; }
+
+    bool StaticBundle::isOpen() const noexcept { return entries_ != nullptr; }
+
+    BundleVariant StaticBundle::variant(
+        const Entry& entry, const ContentEncoding encoding
+    ) const noexcept {
+        const auto& stored = entry.variant[static_cast<std::size_t>(encoding)];
+
+        std::string_view head{
+            reinterpret_cast<const char*>(data_ + stored.headOffset), stored.headLength
+        };
+
+        return {
+            encoding,
+            head,
+            head.substr(stored.etagOffset, stored.etagLength),
+            {data_ + stored.bodyOffset, static_cast<std::size_t>(stored.bodyLength)},
+            stored.bodyOffset,
+            std::popcount(entry.variants) > 1
+        };
+    }
+
+    bool
+    matchesETag(const std::string_view ifNoneMatch, const std::string_view etag) noexcept {
+        auto matched = false;
+
+        forEachListItem(ifNoneMatch, [&](std::string_view item) {
+            if (item.starts_with("W/")) item.remove_prefix(2);
+
+            matched = item == "*" || item == etag;
+            return !matched;
+        });
+
+        return matched;
+    }
+
+    int sendBundleAsset(
+        const net::Socket& socket, const StaticBundle& bundle, const std::size_t entry,
+        const AcceptEncoding& accept, const std::string_view ifNoneMatch,
+        const bool keepAlive
+    ) {
+        metrics::ScopedTimer timer(metrics::server().writeTime);
+
+        auto variant = bundle.select(entry, accept);
+
+        if (matchesETag(ifNoneMatch, variant.etag)) {
+            std::array<std::byte, 512> storage;
+            Arena arena{storage};
+
+            ResponseBuilder response{&arena};
+            response.status(304).header("ETag", variant.etag);
+
+            if (variant.varies) response.header("Vary", "Accept-Encoding");
+
+            response.date().append(keepAlive ? KEEP_ALIVE : CLOSE);
+            sendAll(socket, response.view());
+
+            return 304;
+        }
+
+        std::array<char, 1024> storage;
+        std::string fallback;
+
+        std::string_view head;
+
+        // 打包时生成的响应头都远小于栈上缓冲区，这里只是兜底
+        if (variant.maxSize() <= storage.size()) {
+            head = {storage.data(), variant.render(storage, keepAlive)};
+        } else {
+            variant.render(fallback, keepAlive);
+            head = fallback;
+        }
+
+        if (variant.body.size() <= DIRECT_WRITE_LIMIT) {
+            sendAll(socket, head, variant.body.empty() ? 0 : SEND_MORE);
+            sendAll(socket, variant.body);
+        } else {
+            sendAll(socket, head);
+            sendFileAll(socket, bundle.fd(), variant.offset, variant.body.size());
+        }
+
+        return 200;
+    }
+
+}  // namespace tiny_web_server::http
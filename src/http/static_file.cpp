@@ -0,0 +1,249 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file static_file.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 11:15
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/static_file.hpp"
+#include "tws/exception.hpp"
+#include "tws/http/range.hpp"
+#include "tws/http/response.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/utils/arena.hpp"
+#include <array>
+#include <chrono>
+#include <format>
+#include <random>
+
+namespace tiny_web_server::http {
+
+    namespace {
+
+        struct FileHandle {
+            int fd;
+
+            explicit FileHandle(const std::filesystem::path& path)
+#if WEB_SERVER_WINDOWS
+                : fd(_wopen(path.c_str(), _O_RDONLY | _O_BINARY)) {
+#else
+                : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+#endif
+                if (fd < 0)
+                    throw HttpError<>(std::format("Failed to open '{}'", path.string()));
+            }
+
+            ~FileHandle() {
+#if WEB_SERVER_WINDOWS
+                _close(fd);
+#else
+                ::close(fd);
+#endif
+            }
+
+            FileHandle(const FileHandle&)            = delete;
+            FileHandle& operator=(const FileHandle&) = delete;
+        };
+
+        const std::string& boundary() {
+            static const std::string value = [] {
+                std::random_device device;
+                return std::format("tws{:016x}", (std::uint64_t{device()} << 32) | device());
+            }();
+
+            return value;
+        }
+
+        void sendAll(const net::Socket& socket, std::string_view data) {
+            while (!data.empty())
+                data.remove_prefix(socket.send(std::as_bytes(std::span{data})));
+        }
+
+        void sendFileAll(
+            const net::Socket& socket, int fd, std::uint64_t offset, std::uint64_t length
+        ) {
+            while (length > 0) {
+                auto sent = socket.sendFile(fd, offset, length);
+                if (sent == 0) throw HttpError<"File truncated while sending"_s>();
+
+                offset += sent;
+                length -= sent;
+            }
+        }
+
+    }  // namespace
+
+    std::optional<StaticFile>
+    resolveStaticFile(const std::filesystem::path& path, const AcceptEncoding& accept) {
+        namespace fs = std::filesystem;
+
+        std::error_code ec;
+
+        auto status = fs::status(path, ec);
+        if (ec || !fs::is_regular_file(status)) return std::nullopt;
+
+        StaticFile file{path, ContentEncoding::IDENTITY, fs::file_size(path, ec), {}};
+        if (ec) return std::nullopt;
+
+        file.lastWrite = fs::last_write_time(path, ec);
+
+        // 兄弟文件按服务端偏好逆序探测，找到的都交给 select 按q值决定
+        ContentEncoding available[4]{ContentEncoding::IDENTITY};
+        std::size_t count = 1;
+
+        for (auto encoding :
+             {ContentEncoding::BROTLI, ContentEncoding::ZSTD, ContentEncoding::GZIP}) {
+            if (!accept.accepts(encoding)) continue;
+
+            auto sibling = path;
+            sibling += extension(encoding);
+
+            if (!fs::is_regular_file(sibling, ec)) continue;
+            if (fs::last_write_time(sibling, ec) < file.lastWrite || ec) continue;
+
+            available[count++] = encoding;
+        }
+
+        if (count == 1) return file;
+
+        auto encoding = accept.select({available, count});
+        if (encoding == ContentEncoding::IDENTITY) return file;
+
+        auto sibling = path;
+        sibling += extension(encoding);
+
+        auto size = fs::file_size(sibling, ec);
+        if (ec) return file;
+
+        return StaticFile{std::move(sibling), encoding, size, file.lastWrite};
+    }
+
+    int sendStaticFile(
+        const net::Socket& socket, const StaticFile& file, std::string_view contentType,
+        std::string_view range, std::string_view ifRange
+    ) {
+        metrics::ScopedTimer timer(metrics::server().writeTime);
+
+        // 响应头与分段头在栈上的内存池中构建，常见情况下不触发堆分配
+        std::array<std::byte, 1024> storage;
+        Arena arena{storage};
+
+        ResponseBuilder response{&arena};
+
+        std::array<char, HttpDate::SIZE> lastModified;
+        HttpDate::format(
+            std::chrono::system_clock::to_time_t(
+                std::chrono::file_clock::to_sys(file.lastWrite)
+            ),
+            lastModified
+        );
+
+        const std::string_view lastModifiedView{lastModified.data(), lastModified.size()};
+
+        if (!ifRangeMatches(ifRange, {}, lastModifiedView)) range = {};
+
+        auto ranges = parseRange(range, file.size);
+
+        if (ranges.status == RangeSet::Status::UNSATISFIABLE) {
+            response.status(416)
+                .append("Content-Range: bytes */")
+                .append(file.size)
+                .append("\r\n")
+                .header("Content-Length", "0")
+                .date()
+                .end();
+            sendAll(socket, response.view());
+
+            return 416;
+        }
+
+        FileHandle handle(file.path);
+
+        auto commonHeaders = [&] {
+            if (file.encoding != ContentEncoding::IDENTITY)
+                response.header("Content-Encoding", toString(file.encoding));
+
+            response.header("Vary", "Accept-Encoding")
+                .header("Accept-Ranges", "bytes")
+                .header("Last-Modified", lastModifiedView)
+                .date()
+                .end();
+        };
+
+        if (ranges.status == RangeSet::Status::IGNORED) {
+            response.status(200)
+                .header("Content-Type", contentType)
+                .header("Content-Length", file.size);
+            commonHeaders();
+
+            sendAll(socket, response.view());
+            sendFileAll(socket, handle.fd, 0, file.size);
+
+            return 200;
+        }
+
+        // 单区间
+        if (ranges.ranges.size() == 1) {
+            const auto& part = ranges.ranges.front();
+
+            response.status(206)
+                .header("Content-Type", contentType)
+                .header("Content-Range", contentRange(part, file.size))
+                .header("Content-Length", part.length);
+            commonHeaders();
+
+            sendAll(socket, response.view());
+            sendFileAll(socket, handle.fd, part.offset, part.length);
+
+            return 206;
+        }
+
+        // 多区间: 先生成全部分段头以计算 Content-Length，再交替发送分段头与文件区间
+        std::pmr::vector<ResponseBuilder> parts{&arena};
+        parts.reserve(ranges.ranges.size());
+
+        ResponseBuilder closing{&arena};
+        closing.append("\r\n--").append(boundary()).append("--\r\n");
+
+        auto length = static_cast<std::uint64_t>(closing.size());
+
+        for (const auto& part : ranges.ranges) {
+            parts.emplace_back(&arena)
+                .append("\r\n--")
+                .append(boundary())
+                .append("\r\n")
+                .header("Content-Type", contentType)
+                .header("Content-Range", contentRange(part, file.size))
+                .end();
+
+            length += parts.back().size() + part.length;
+        }
+
+        response.status(206)
+            .append("Content-Type: multipart/byteranges; boundary=")
+            .append(boundary())
+            .append("\r\n")
+            .header("Content-Length", length);
+        commonHeaders();
+
+        sendAll(socket, response.view());
+
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            sendAll(socket, parts[i].view());
+            sendFileAll(socket, handle.fd, ranges.ranges[i].offset, ranges.ranges[i].length);
+        }
+
+        sendAll(socket, closing.view());
+
+        return 206;
+    }
+
+}  // namespace tiny_web_server::http
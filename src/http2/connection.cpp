@@ -0,0 +1,956 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file connection.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 23:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http2/connection.hpp"
+#include "tws/exception.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/utils/base64.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace tiny_web_server::http2 {
+
+    namespace {
+
+        // 每次可读事件最多连续读取的次数，避免单个连接长期占用反应器
+        constexpr int MAX_READS_PER_EVENT = 4;
+
+        // 一个头部块最多的 CONTINUATION 帧数; 空帧不增加头部块大小，只靠字节上限挡不住
+        constexpr std::uint32_t MAX_CONTINUATION_FRAMES = 32;
+
+        metrics::Counter& streamCounter() {
+            static auto& counter = metrics::Registry::global().counter(
+                "tws_http2_streams_total", "HTTP/2 streams opened by clients"
+            );
+            return counter;
+        }
+
+        /**
+         * @brief HTTP/2 中禁止出现的连接相关字段
+         */
+        bool isConnectionSpecific(const std::string_view name) noexcept {
+            return name == "connection" || name == "keep-alive" || name == "proxy-connection"
+                || name == "transfer-encoding" || name == "upgrade";
+        }
+
+        std::string lowercase(const std::string_view text) {
+            std::string out{text};
+
+            for (auto& c : out)
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+
+            return out;
+        }
+
+        /**
+         * @brief 去掉 PADDED 标志对应的填充
+         * @return 填充长度不合法时返回 false
+         */
+        bool removePadding(
+            const FrameHeader& header, std::span<const std::byte>& payload
+        ) noexcept {
+            if (!header.has(flags::PADDED)) return true;
+
+            if (payload.empty()) return false;
+
+            auto padding = std::to_integer<std::size_t>(payload[0]);
+            if (padding >= payload.size()) return false;
+
+            payload = payload.subspan(1, payload.size() - 1 - padding);
+
+            return true;
+        }
+
+        Response statusOnly(const int status) {
+            Response response;
+            response.status = status;
+
+            return response;
+        }
+
+    }  // namespace
+
+    std::string_view Request::header(const std::string_view name) const noexcept {
+        for (const auto& field : headers)
+            if (field.name == name) return field.value;
+
+        return {};
+    }
+
+    Connection::Connection(
+        Private, net::Socket socket, async::Reactor& reactor, RequestHandler onRequest,
+        const ConnectionOptions& options
+    )
+        : socket_(std::move(socket))
+        , reactor_(reactor)
+        , options_(options)
+        , onRequest_(std::move(onRequest))
+        , input_(options.receiveBufferSize)
+        , receiveWindow_(options.connectionWindowSize) {
+        batchHeaders_.reserve(MAX_BATCH_FRAMES);
+    }
+
+    std::shared_ptr<Connection> Connection::start(
+        net::Socket socket, std::span<const std::byte> received, async::Reactor& reactor,
+        RequestHandler onRequest, const ConnectionOptions& options
+    ) {
+        socket.setNonBlocking();
+
+        auto connection = std::make_shared<Connection>(
+            Private{}, std::move(socket), reactor, std::move(onRequest), options
+        );
+
+        connection->attach(received);
+        connection->flush();
+
+        return connection;
+    }
+
+    std::shared_ptr<Connection> Connection::upgrade(
+        net::Socket socket, const http::Request& request, std::span<const std::byte> rest,
+        async::Reactor& reactor, RequestHandler onRequest, const ConnectionOptions& options
+    ) {
+        if (!isUpgradeRequest(request))
+            throw HttpError<"Invalid h2c upgrade request"_s>();
+
+        auto payload = base64Decode(request.header("HTTP2-Settings"));
+
+        std::vector<Setting> settings;
+        if (!payload || !parseSettings(*payload, settings))
+            throw HttpError<"Invalid HTTP2-Settings header"_s>();
+
+        socket.setNonBlocking();
+
+        auto connection = std::make_shared<Connection>(
+            Private{}, std::move(socket), reactor, std::move(onRequest), options
+        );
+
+        if (connection->applySettings(settings) != ErrorCode::NONE)
+            throw HttpError<"Invalid HTTP2-Settings header"_s>();
+
+        constexpr std::string_view switching =
+            "HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\n"
+            "Upgrade: h2c\r\n\r\n";
+
+        auto bytes = std::as_bytes(std::span{switching});
+        connection->control_.assign(bytes.begin(), bytes.end());
+
+        // 升级请求成为半关闭(远端)的流1
+        auto& stream         = connection->streams_[1];
+        stream.sendWindow    = connection->peerInitialWindow_;
+        stream.receiveWindow = options.initialWindowSize;
+        stream.remoteClosed  = true;
+
+        auto& converted     = stream.request;
+        converted.method    = request.method;
+        converted.scheme    = "http";
+        converted.authority = request.header("Host");
+        converted.path      = request.target;
+
+        for (const auto& [name, value] : request.headers) {
+            auto lowered = lowercase(name);
+
+            if (isConnectionSpecific(lowered) || lowered == "host") continue;
+            if (lowered == "http2-settings") continue;
+
+            converted.headers.push_back({std::move(lowered), std::string{value}});
+        }
+
+        connection->lastStreamId_ = 1;
+        streamCounter().add();
+
+        connection->attach(rest);
+        connection->deliver(1);
+        connection->flush();
+
+        return connection;
+    }
+
+    void Connection::respond(const std::uint32_t streamId, Response response) {
+        auto* stream = find(streamId);
+        if (closed_ || !stream || stream->responded || stream->localClosed) return;
+
+        stream->responded = true;
+
+        std::vector<std::byte> block;
+
+        char status[4]{};
+        std::to_chars(status, status + 3, response.status);
+        encoder_.encode(":status", {status, 3}, block);
+
+        for (const auto& [name, value] : response.headers) {
+            auto lowered = lowercase(name);
+            if (isConnectionSpecific(lowered)) continue;
+
+            // 每次都不同的取值不进入动态表，以免挤掉可复用的表项
+            auto index = lowered != "content-length" && lowered != "date"
+                      && lowered != "set-cookie" && value.size() < 256;
+
+            encoder_.encode(lowered, value, block, index);
+        }
+
+        auto hasBody = response.body && !response.body->empty();
+
+        // 超过对端帧大小上限的头部块拆分为 HEADERS + CONTINUATION
+        std::span<const std::byte> remaining{block};
+        auto type = FrameType::HEADERS;
+
+        do {
+            auto size      = std::min<std::size_t>(remaining.size(), peerMaxFrameSize_);
+            std::uint8_t f = size == remaining.size() ? flags::END_HEADERS : 0;
+
+            if (type == FrameType::HEADERS && !hasBody) f |= flags::END_STREAM;
+
+            appendFrame(control_, type, f, streamId, remaining.first(size));
+
+            remaining = remaining.subspan(size);
+            type      = FrameType::CONTINUATION;
+        } while (!remaining.empty());
+
+        if (!hasBody) {
+            finish(streamId, *stream);
+        } else {
+            stream->body       = std::move(response.body);
+            stream->bodyOffset = 0;
+            schedule(streamId, *stream);
+        }
+
+        flush();
+    }
+
+    void Connection::reset(const std::uint32_t streamId, const ErrorCode code) {
+        auto* stream = find(streamId);
+        if (closed_ || !stream) return;
+
+        sendReset(streamId, code);
+
+        stream->remoteClosed = true;
+        finish(streamId, *stream);
+
+        flush();
+    }
+
+    void Connection::close(const ErrorCode code) {
+        if (closed_ || goingAway_) return;
+
+        std::byte payload[8];
+        writeInteger(payload, lastStreamId_, 4);
+        writeInteger(payload + 4, static_cast<std::uint32_t>(code), 4);
+
+        appendFrame(control_, FrameType::GOAWAY, 0, 0, payload);
+        goingAway_ = true;
+
+        flush();
+    }
+
+    void Connection::onClose(CloseHandler handler) { onClose_ = std::move(handler); }
+
+    bool Connection::isOpen() const noexcept { return !closed_ && !goingAway_; }
+
+    std::size_t Connection::activeStreams() const noexcept {
+        return streams_.size() - finished_.size();
+    }
+
+    async::Reactor& Connection::reactor() const noexcept { return reactor_; }
+
+    const net::Socket& Connection::socket() const noexcept { return socket_; }
+
+    void Connection::attach(const std::span<const std::byte> received) {
+        // 服务端序言: SETTINGS 与扩大连接级接收窗口的 WINDOW_UPDATE
+        std::vector<Setting> settings{
+            {SettingsId::MAX_CONCURRENT_STREAMS, options_.maxConcurrentStreams},
+            {SettingsId::INITIAL_WINDOW_SIZE, options_.initialWindowSize},
+            {SettingsId::MAX_FRAME_SIZE, options_.maxFrameSize},
+            {SettingsId::MAX_HEADER_LIST_SIZE, options_.maxHeaderListSize},
+            {SettingsId::ENABLE_PUSH, 0}
+        };
+        appendSettings(control_, settings);
+
+        if (options_.connectionWindowSize > DEFAULT_WINDOW_SIZE)
+            sendWindowUpdate(0, options_.connectionWindowSize - DEFAULT_WINDOW_SIZE);
+
+        if (received.size() > input_.size()) input_.resize(received.size());
+
+        std::ranges::copy(received, input_.begin());
+        inputEnd_ = received.size();
+
+        reactor_.add(
+            socket_.nativeHandle(), async::EventType::READ | async::EventType::HANGUP,
+            [self = shared_from_this()](async::EventType events) {
+                self->handleEvents(events);
+            }
+        );
+
+        if (inputEnd_ > 0) processFrames();
+    }
+
+    void Connection::handleEvents(const async::EventType events) {
+        auto self = shared_from_this();
+
+        try {
+            if (events & async::EventType::ERROR) return shutdown();
+
+            if (events & async::EventType::WRITE) writable();
+
+            if (!closed_ && !goingAway_
+                && (events & (async::EventType::READ | async::EventType::HANGUP)))
+                readable();
+        } catch (const std::exception&) { shutdown(); }
+    }
+
+    void Connection::readable() {
+        for (auto i = 0; i < MAX_READS_PER_EVENT && !closed_ && !goingAway_; ++i) {
+            // 缓冲区尾部已满: 先把未处理的数据移到头部
+            if (inputEnd_ == input_.size() && inputBegin_ > 0) {
+                auto size = inputEnd_ - inputBegin_;
+
+                std::memmove(input_.data(), input_.data() + inputBegin_, size);
+                inputBegin_ = 0;
+                inputEnd_   = size;
+            }
+
+            auto received = socket_.tryRecv(std::span{input_}.subspan(inputEnd_));
+
+            if (!received) return;
+
+            if (*received == 0) return shutdown();
+
+            inputEnd_ += *received;
+            processFrames();
+        }
+    }
+
+    void Connection::writable() {
+        metrics::ScopedTimer timer(metrics::server().writeTime);
+
+        while (!closed_) {
+            if (batchIndex_ == batch_.size()) {
+                fillBatch();
+                if (batch_.empty()) break;
+            }
+
+            auto sent = socket_.trySend(std::span{batch_}.subspan(batchIndex_));
+            if (!sent) break;
+
+            // 跳过已发完的片段，部分发送的片段就地截短
+            for (auto n = *sent; n > 0;) {
+                auto& segment = batch_[batchIndex_];
+
+                if (n < segment.size()) {
+                    segment = segment.subspan(n);
+                    break;
+                }
+
+                n -= segment.size();
+                ++batchIndex_;
+            }
+        }
+
+        if (closed_) return;
+
+        auto want = batchIndex_ < batch_.size();
+
+        if (want != writing_) {
+            writing_    = want;
+            auto events = async::EventType::READ | async::EventType::HANGUP;
+
+            reactor_.modify(
+                socket_.nativeHandle(), want ? events | async::EventType::WRITE : events
+            );
+        }
+
+        if (want || !control_.empty()) return;
+
+        if ((goingAway_ && ready_.empty()) || (peerGoingAway_ && activeStreams() == 0))
+            shutdown();
+    }
+
+    void Connection::fillBatch() {
+        for (auto id : finished_) streams_.erase(id);
+        finished_.clear();
+
+        batch_.clear();
+        batchHeaders_.clear();
+        batchOwners_.clear();
+        batchIndex_ = 0;
+
+        batchControl_.swap(control_);
+        control_.clear();
+
+        if (!batchControl_.empty()) batch_.emplace_back(batchControl_);
+
+        auto bytes = batchControl_.size();
+
+        // 升级后收到客户端序言前只发送 101 与控制帧: 部分客户端在切换协议时
+        // 无法缓存紧跟 101 到达的大量数据
+        if (!prefaceReceived_) return;
+
+        // 轮转: 每个流每轮最多一帧，窗口仍有余量的流排回队尾
+        while (!ready_.empty() && sendWindow_ > 0 && bytes < options_.maxBatchBytes
+               && batchHeaders_.size() < MAX_BATCH_FRAMES) {
+            auto id = ready_.front();
+            ready_.pop_front();
+
+            auto* stream = find(id);
+            if (!stream || !stream->body) continue;
+
+            stream->scheduled = false;
+
+            // 等待 WINDOW_UPDATE 后由 schedule 重新排入
+            if (stream->sendWindow <= 0) continue;
+
+            const auto& body = *stream->body;
+            auto remaining   = body.size() - stream->bodyOffset;
+
+            auto size = std::min<std::int64_t>(
+                {static_cast<std::int64_t>(remaining), peerMaxFrameSize_, stream->sendWindow,
+                 sendWindow_}
+            );
+            auto last = static_cast<std::size_t>(size) == remaining;
+
+            auto& header = batchHeaders_.emplace_back();
+            encodeHeader(
+                header,
+                {static_cast<std::uint32_t>(size), FrameType::DATA,
+                 last ? flags::END_STREAM : std::uint8_t{0}, id}
+            );
+
+            batch_.emplace_back(header);
+            batch_.emplace_back(std::span{body}.subspan(stream->bodyOffset, size));
+            batchOwners_.push_back(stream->body);
+
+            stream->bodyOffset += size;
+            stream->sendWindow -= size;
+            sendWindow_ -= size;
+            bytes += FRAME_HEADER_SIZE + size;
+
+            if (last) {
+                stream->body.reset();
+                finish(id, *stream);
+            } else {
+                schedule(id, *stream);
+            }
+        }
+    }
+
+    void Connection::flush() {
+        if (processing_ || closed_ || writing_) return;
+
+        writable();
+    }
+
+    void Connection::processFrames() {
+        auto nested = processing_;
+        processing_ = true;
+
+        if (!prefaceReceived_) {
+            auto available = std::span{input_}.subspan(inputBegin_, inputEnd_ - inputBegin_);
+            auto preface   = detectPreface(available);
+
+            if (preface == false) {
+                processing_ = nested;
+                return shutdown();
+            }
+
+            if (preface == true) {
+                prefaceReceived_ = true;
+                inputBegin_ += PREFACE.size();
+            }
+        }
+
+        while (prefaceReceived_ && !closed_ && !goingAway_) {
+            auto available = std::span{input_}.subspan(inputBegin_, inputEnd_ - inputBegin_);
+
+            FrameHeader header;
+            if (!parseHeader(available, header)) break;
+
+            if (header.length > options_.maxFrameSize) {
+                fail(ErrorCode::FRAME_SIZE_ERROR);
+                break;
+            }
+
+            auto total = FRAME_HEADER_SIZE + header.length;
+
+            if (available.size() < total) {
+                // 缓冲区放不下整帧时扩容，压缩留给 readable
+                if (total > input_.size() - inputBegin_) {
+                    std::memmove(input_.data(), available.data(), available.size());
+                    inputEnd_   = available.size();
+                    inputBegin_ = 0;
+
+                    if (total > input_.size()) input_.resize(total);
+                }
+
+                break;
+            }
+
+            inputBegin_ += total;
+            dispatch(header, available.subspan(FRAME_HEADER_SIZE, header.length));
+        }
+
+        if (inputBegin_ == inputEnd_) inputBegin_ = inputEnd_ = 0;
+
+        processing_ = nested;
+
+        // 本轮所有帧产生的输出合并为一次发送
+        flush();
+    }
+
+    void
+    Connection::dispatch(const FrameHeader& header, std::span<const std::byte> payload) {
+        // 头部块未结束时只允许同一流的 CONTINUATION
+        if (continuationStream_ != 0
+            && (header.type != FrameType::CONTINUATION
+                || header.streamId != continuationStream_))
+            return fail(ErrorCode::PROTOCOL_ERROR);
+
+        switch (header.type) {
+            case FrameType::DATA: return onData(header, payload);
+
+            case FrameType::HEADERS: return onHeaders(header, payload);
+
+            case FrameType::PRIORITY: {
+                if (header.streamId == 0) return fail(ErrorCode::PROTOCOL_ERROR);
+                if (payload.size() != 5)
+                    sendReset(header.streamId, ErrorCode::FRAME_SIZE_ERROR);
+                return;
+            }
+
+            case FrameType::RST_STREAM: {
+                if (header.streamId == 0 || header.streamId > lastStreamId_)
+                    return fail(ErrorCode::PROTOCOL_ERROR);
+
+                if (payload.size() != 4) return fail(ErrorCode::FRAME_SIZE_ERROR);
+
+                if (auto* stream = find(header.streamId)) {
+                    release(*stream);
+                    stream->remoteClosed = stream->localClosed = true;
+                    stream->body.reset();
+                    finished_.push_back(header.streamId);
+                }
+                return;
+            }
+
+            case FrameType::SETTINGS: return onSettings(header, payload);
+
+            case FrameType::PUSH_PROMISE: return fail(ErrorCode::PROTOCOL_ERROR);
+
+            case FrameType::PING: {
+                if (header.streamId != 0) return fail(ErrorCode::PROTOCOL_ERROR);
+                if (payload.size() != 8) return fail(ErrorCode::FRAME_SIZE_ERROR);
+
+                if (!header.has(flags::ACK))
+                    appendFrame(control_, FrameType::PING, flags::ACK, 0, payload);
+                return;
+            }
+
+            case FrameType::GOAWAY: {
+                if (header.streamId != 0) return fail(ErrorCode::PROTOCOL_ERROR);
+
+                peerGoingAway_ = true;
+                return;
+            }
+
+            case FrameType::WINDOW_UPDATE: return onWindowUpdate(header, payload);
+
+            case FrameType::CONTINUATION: {
+                if (continuationStream_ == 0) return fail(ErrorCode::PROTOCOL_ERROR);
+
+                if (headerBlock_.size() + payload.size() > options_.maxHeaderListSize * 2
+                    || ++continuationFrames_ > MAX_CONTINUATION_FRAMES)
+                    return fail(ErrorCode::ENHANCE_YOUR_CALM);
+
+                headerBlock_.insert(headerBlock_.end(), payload.begin(), payload.end());
+
+                if (!header.has(flags::END_HEADERS)) return;
+
+                auto id             = continuationStream_;
+                continuationStream_ = 0;
+
+                return onHeaderBlock(id, continuationFlags_, headerBlock_);
+            }
+
+            // 未知类型的帧必须被忽略
+            default: return;
+        }
+    }
+
+    void
+    Connection::onHeaders(const FrameHeader& header, std::span<const std::byte> payload) {
+        if (header.streamId == 0 || !removePadding(header, payload))
+            return fail(ErrorCode::PROTOCOL_ERROR);
+
+        // 优先级信息被忽略
+        if (header.has(flags::PRIORITY)) {
+            if (payload.size() < 5) return fail(ErrorCode::PROTOCOL_ERROR);
+
+            payload = payload.subspan(5);
+        }
+
+        if (header.has(flags::END_HEADERS))
+            return onHeaderBlock(header.streamId, header.flags, payload);
+
+        continuationStream_ = header.streamId;
+        continuationFlags_  = header.flags;
+        continuationFrames_ = 0;
+        headerBlock_.assign(payload.begin(), payload.end());
+    }
+
+    void Connection::onHeaderBlock(
+        const std::uint32_t streamId, const std::uint8_t flags,
+        const std::span<const std::byte> block
+    ) {
+        // 即使随后拒绝该流也必须先解码，以保持动态表与对端同步;
+        // 超出预算的字段不会被展开，之后以 431 拒绝
+        std::vector<HeaderField> fields;
+        auto status = decoder_.decode(block, fields, options_.maxHeaderListSize);
+
+        if (status == HpackDecoder::Status::ERROR) return fail(ErrorCode::COMPRESSION_ERROR);
+
+        auto tooLarge = status == HpackDecoder::Status::TOO_LARGE;
+
+        auto endStream = (flags & flags::END_STREAM) != 0;
+
+        // 已存在的流上只能是结束请求的尾部字段，内容被丢弃
+        if (auto it = streams_.find(streamId); it != streams_.end()) {
+            auto& stream = it->second;
+
+            if (stream.remoteClosed) return sendReset(streamId, ErrorCode::STREAM_CLOSED);
+            if (!endStream) return fail(ErrorCode::PROTOCOL_ERROR);
+
+            stream.remoteClosed = true;
+
+            if (stream.localClosed) return finish(streamId, stream);
+
+            return deliver(streamId);
+        }
+
+        if (streamId % 2 == 0 || streamId <= lastStreamId_)
+            return fail(ErrorCode::PROTOCOL_ERROR);
+
+        lastStreamId_ = streamId;
+
+        if (peerGoingAway_ || activeStreams() >= options_.maxConcurrentStreams)
+            return sendReset(streamId, ErrorCode::REFUSED_STREAM);
+
+        Stream stream;
+        stream.sendWindow    = peerInitialWindow_;
+        stream.receiveWindow = options_.initialWindowSize;
+        stream.remoteClosed  = endStream;
+
+        auto& request  = stream.request;
+        auto malformed = false;
+        auto regular   = false;
+
+        for (auto& field : fields) {
+            if (field.name.starts_with(':')) {
+                // 伪头部必须位于所有普通字段之前
+                if (regular) malformed = true;
+
+                if (field.name == ":method")
+                    request.method = std::move(field.value);
+                else if (field.name == ":scheme")
+                    request.scheme = std::move(field.value);
+                else if (field.name == ":authority")
+                    request.authority = std::move(field.value);
+                else if (field.name == ":path")
+                    request.path = std::move(field.value);
+                else
+                    malformed = true;
+
+                continue;
+            }
+
+            regular = true;
+
+            auto uppercase = std::ranges::any_of(field.name, [](char c) {
+                return c >= 'A' && c <= 'Z';
+            });
+
+            if (uppercase || isConnectionSpecific(field.name)
+                || (field.name == "te" && field.value != "trailers"))
+                malformed = true;
+
+            request.headers.push_back(std::move(field));
+        }
+
+        if (request.method.empty() || (request.method != "CONNECT" && request.path.empty()))
+            malformed = true;
+
+        // 超出预算时字段未被展开，缺少伪头部不算格式错误
+        if (malformed && !tooLarge) return sendReset(streamId, ErrorCode::PROTOCOL_ERROR);
+
+        streams_.emplace(streamId, std::move(stream));
+        streamCounter().add();
+
+        if (tooLarge) return respond(streamId, statusOnly(431));
+
+        if (endStream) deliver(streamId);
+    }
+
+    void Connection::onData(const FrameHeader& header, std::span<const std::byte> payload) {
+        if (header.streamId == 0) return fail(ErrorCode::PROTOCOL_ERROR);
+
+        // 流控按包括填充在内的整个负载计算
+        if (header.length > receiveWindow_) return fail(ErrorCode::FLOW_CONTROL_ERROR);
+
+        receiveWindow_ -= header.length;
+
+        // 连接级窗口用掉一半时补满，缓冲的请求体总量另由 maxBufferedBodySize 限制
+        if (receiveWindow_ < options_.connectionWindowSize / 2) {
+            sendWindowUpdate(0, options_.connectionWindowSize - receiveWindow_);
+            receiveWindow_ = options_.connectionWindowSize;
+        }
+
+        if (!removePadding(header, payload)) return fail(ErrorCode::PROTOCOL_ERROR);
+
+        auto* stream = find(header.streamId);
+
+        // 已重置或已提前响应的流上迟到的数据直接丢弃
+        if (!stream) {
+            if (header.streamId > lastStreamId_) return fail(ErrorCode::PROTOCOL_ERROR);
+            return;
+        }
+
+        if (stream->remoteClosed)
+            return sendReset(header.streamId, ErrorCode::STREAM_CLOSED);
+
+        if (header.length > stream->receiveWindow)
+            return reset(header.streamId, ErrorCode::FLOW_CONTROL_ERROR);
+
+        stream->receiveWindow -= header.length;
+
+        auto& body = stream->request.body;
+
+        if (body.size() + payload.size() > options_.maxRequestBodySize)
+            return respond(header.streamId, statusOnly(413));
+
+        if (bufferedBody_ + payload.size() > options_.maxBufferedBodySize)
+            return respond(header.streamId, statusOnly(503));
+
+        body.insert(body.end(), payload.begin(), payload.end());
+        stream->buffered += payload.size();
+        bufferedBody_ += payload.size();
+
+        if (header.has(flags::END_STREAM)) {
+            stream->remoteClosed = true;
+            return deliver(header.streamId);
+        }
+
+        if (stream->receiveWindow < options_.initialWindowSize / 2) {
+            auto increment = options_.initialWindowSize - stream->receiveWindow;
+
+            sendWindowUpdate(header.streamId, increment);
+            stream->receiveWindow = options_.initialWindowSize;
+        }
+    }
+
+    void
+    Connection::onSettings(const FrameHeader& header, std::span<const std::byte> payload) {
+        if (header.streamId != 0) return fail(ErrorCode::PROTOCOL_ERROR);
+
+        if (header.has(flags::ACK)) {
+            if (!payload.empty()) fail(ErrorCode::FRAME_SIZE_ERROR);
+            return;
+        }
+
+        std::vector<Setting> settings;
+        if (!parseSettings(payload, settings)) return fail(ErrorCode::FRAME_SIZE_ERROR);
+
+        if (auto error = applySettings(settings); error != ErrorCode::NONE)
+            return fail(error);
+
+        appendFrame(control_, FrameType::SETTINGS, flags::ACK, 0);
+    }
+
+    void Connection::onWindowUpdate(
+        const FrameHeader& header, const std::span<const std::byte> payload
+    ) {
+        if (payload.size() != 4) return fail(ErrorCode::FRAME_SIZE_ERROR);
+
+        auto increment = readInteger(payload.data(), 4) & MAX_WINDOW_SIZE;
+
+        if (header.streamId == 0) {
+            if (increment == 0) return fail(ErrorCode::PROTOCOL_ERROR);
+
+            sendWindow_ += increment;
+            if (sendWindow_ > MAX_WINDOW_SIZE) return fail(ErrorCode::FLOW_CONTROL_ERROR);
+
+            return;
+        }
+
+        auto* stream = find(header.streamId);
+        if (!stream) return;
+
+        if (increment == 0) return reset(header.streamId, ErrorCode::PROTOCOL_ERROR);
+
+        stream->sendWindow += increment;
+
+        if (stream->sendWindow > MAX_WINDOW_SIZE)
+            return reset(header.streamId, ErrorCode::FLOW_CONTROL_ERROR);
+
+        schedule(header.streamId, *stream);
+    }
+
+    ErrorCode Connection::applySettings(const std::span<const Setting> settings) {
+        for (const auto& [id, value] : settings) {
+            switch (id) {
+                case SettingsId::HEADER_TABLE_SIZE: encoder_.setMaxTableSize(value); break;
+
+                case SettingsId::ENABLE_PUSH:
+                    if (value > 1) return ErrorCode::PROTOCOL_ERROR;
+                    break;
+
+                case SettingsId::INITIAL_WINDOW_SIZE: {
+                    if (value > MAX_WINDOW_SIZE) return ErrorCode::FLOW_CONTROL_ERROR;
+
+                    // 差值作用于所有已打开的流，窗口重新变为正数的流恢复调度
+                    auto delta = static_cast<std::int64_t>(value) - peerInitialWindow_;
+                    peerInitialWindow_ = value;
+
+                    for (auto& [streamId, stream] : streams_) {
+                        stream.sendWindow += delta;
+
+                        if (stream.sendWindow > MAX_WINDOW_SIZE)
+                            return ErrorCode::FLOW_CONTROL_ERROR;
+
+                        schedule(streamId, stream);
+                    }
+                    break;
+                }
+
+                case SettingsId::MAX_FRAME_SIZE:
+                    if (value < DEFAULT_MAX_FRAME_SIZE || value > 0xFFFFFF)
+                        return ErrorCode::PROTOCOL_ERROR;
+
+                    peerMaxFrameSize_ = value;
+                    break;
+
+                // 服务端不推送，也不限制自己发出的头部列表
+                default: break;
+            }
+        }
+
+        return ErrorCode::NONE;
+    }
+
+    void Connection::deliver(const std::uint32_t streamId) {
+        auto* stream = find(streamId);
+        if (!stream) return;
+
+        release(*stream);
+
+        if (!onRequest_) return respond(streamId, statusOnly(404));
+
+        // 回调中同步调用 respond 产生的输出留到回调结束后发送
+        auto nested = processing_;
+        processing_ = true;
+
+        {
+            metrics::ScopedTimer timer(metrics::server().handlerTime);
+            onRequest_(*this, streamId, stream->request);
+        }
+
+        processing_ = nested;
+    }
+
+    Connection::Stream* Connection::find(const std::uint32_t streamId) noexcept {
+        auto it = streams_.find(streamId);
+        if (it == streams_.end()) return nullptr;
+
+        auto& stream = it->second;
+
+        return stream.localClosed && stream.remoteClosed ? nullptr : &stream;
+    }
+
+    void Connection::schedule(const std::uint32_t streamId, Stream& stream) {
+        if (stream.scheduled || !stream.body || stream.sendWindow <= 0) return;
+
+        stream.scheduled = true;
+        ready_.push_back(streamId);
+    }
+
+    void Connection::finish(const std::uint32_t streamId, Stream& stream) {
+        if (stream.localClosed && stream.remoteClosed) return;
+
+        release(stream);
+
+        // 请求尚未接收完就已响应完毕: 以 NO_ERROR 重置，让对端停止发送请求体
+        if (!stream.remoteClosed) sendReset(streamId, ErrorCode::NONE);
+
+        stream.localClosed = stream.remoteClosed = true;
+        finished_.push_back(streamId);
+    }
+
+    void Connection::release(Stream& stream) noexcept {
+        bufferedBody_ -= stream.buffered;
+        stream.buffered = 0;
+    }
+
+    void Connection::sendWindowUpdate(
+        const std::uint32_t streamId, const std::uint32_t increment
+    ) {
+        std::byte payload[4];
+        writeInteger(payload, increment, 4);
+
+        appendFrame(control_, FrameType::WINDOW_UPDATE, 0, streamId, payload);
+    }
+
+    void Connection::sendReset(const std::uint32_t streamId, const ErrorCode code) {
+        std::byte payload[4];
+        writeInteger(payload, static_cast<std::uint32_t>(code), 4);
+
+        appendFrame(control_, FrameType::RST_STREAM, 0, streamId, payload);
+    }
+
+    void Connection::fail(const ErrorCode code) {
+        if (goingAway_) return;
+
+        // 连接错误: 丢弃未发送的响应体，只把 GOAWAY 发出去
+        ready_.clear();
+        close(code);
+    }
+
+    void Connection::shutdown() {
+        if (closed_) return;
+
+        auto self = shared_from_this();
+
+        closed_ = true;
+        reactor_.remove(socket_.nativeHandle());
+        socket_.close();
+
+        streams_.clear();
+        finished_.clear();
+        bufferedBody_ = 0;
+        ready_.clear();
+        control_.clear();
+        batch_.clear();
+        batchOwners_.clear();
+
+        if (onClose_) onClose_(*this);
+    }
+
+    bool isUpgradeRequest(const http::Request& request) noexcept {
+        auto length = request.header("Content-Length");
+
+        return request.versionMinor >= 1 && request.hasToken("Upgrade", "h2c")
+            && request.hasToken("Connection", "HTTP2-Settings")
+            && (length.empty() || length == "0")
+            && request.header("Transfer-Encoding").empty();
+    }
+
+}  // namespace tiny_web_server::http2
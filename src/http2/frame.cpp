@@ -0,0 +1,120 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file frame.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 22:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http2/frame.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace tiny_web_server::http2 {
+
+    bool FrameHeader::has(const std::uint8_t flag) const noexcept {
+        return (flags & flag) != 0;
+    }
+
+    std::optional<bool> detectPreface(const std::span<const std::byte> data) noexcept {
+        auto size = std::min(data.size(), PREFACE.size());
+        if (size == 0) return std::nullopt;
+
+        if (std::memcmp(data.data(), PREFACE.data(), size) != 0) return false;
+
+        if (size < PREFACE.size()) return std::nullopt;
+
+        return true;
+    }
+
+    bool parseHeader(const std::span<const std::byte> data, FrameHeader& header) noexcept {
+        if (data.size() < FRAME_HEADER_SIZE) return false;
+
+        header.length   = readInteger(data.data(), 3);
+        header.type     = static_cast<FrameType>(data[3]);
+        header.flags    = std::to_integer<std::uint8_t>(data[4]);
+        header.streamId = readInteger(data.data() + 5, 4) & MAX_WINDOW_SIZE;
+
+        return true;
+    }
+
+    void encodeHeader(
+        const std::span<std::byte, FRAME_HEADER_SIZE> out, const FrameHeader& header
+    ) noexcept {
+        writeInteger(out.data(), header.length, 3);
+        out[3] = static_cast<std::byte>(header.type);
+        out[4] = static_cast<std::byte>(header.flags);
+        writeInteger(out.data() + 5, header.streamId & MAX_WINDOW_SIZE, 4);
+    }
+
+    void appendFrame(
+        std::vector<std::byte>& out, const FrameType type, const std::uint8_t flags,
+        const std::uint32_t streamId, const std::span<const std::byte> payload
+    ) {
+        auto offset = out.size();
+        out.resize(offset + FRAME_HEADER_SIZE);
+
+        encodeHeader(
+            std::span{out}.subspan(offset).first<FRAME_HEADER_SIZE>(),
+            {static_cast<std::uint32_t>(payload.size()), type, flags, streamId}
+        );
+
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    void
+    appendSettings(std::vector<std::byte>& out, const std::span<const Setting> settings) {
+        std::vector<std::byte> payload(settings.size() * 6);
+
+        for (std::size_t i = 0; i < settings.size(); ++i) {
+            auto* entry = payload.data() + i * 6;
+
+            writeInteger(entry, static_cast<std::uint16_t>(settings[i].id), 2);
+            writeInteger(entry + 2, settings[i].value, 4);
+        }
+
+        appendFrame(out, FrameType::SETTINGS, 0, 0, payload);
+    }
+
+    bool parseSettings(
+        const std::span<const std::byte> payload, std::vector<Setting>& settings
+    ) {
+        if (payload.size() % 6 != 0) return false;
+
+        for (std::size_t i = 0; i < payload.size(); i += 6) {
+            auto id = readInteger(payload.data() + i, 2);
+
+            if (id < 1 || id > 6) continue;
+
+            settings.push_back(
+                {static_cast<SettingsId>(id), readInteger(payload.data() + i + 2, 4)}
+            );
+        }
+
+        return true;
+    }
+
+    std::uint32_t readInteger(const std::byte* data, const std::size_t size) noexcept {
+        std::uint32_t value = 0;
+
+        for (std::size_t i = 0; i < size; ++i)
+            value = value << 8 | std::to_integer<std::uint32_t>(data[i]);
+
+        return value;
+    }
+
+    void writeInteger(
+        std::byte* data, const std::uint32_t value, const std::size_t size
+    ) noexcept {
+        for (std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<std::byte>(value >> (8 * (size - 1 - i)) & 0xFF);
+    }
+
+}  // namespace tiny_web_server::http2
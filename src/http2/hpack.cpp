@@ -0,0 +1,633 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file hpack.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 22:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http2/hpack.hpp"
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace tiny_web_server::http2 {
+
+    namespace {
+
+        // RFC 7541 附录 B，下标 256 为 EOS
+        constexpr std::uint32_t HUFFMAN_CODES[257]{
+            0x00001ff8, 0x007fffd8, 0x0fffffe2, 0x0fffffe3, 0x0fffffe4, 0x0fffffe5,
+            0x0fffffe6, 0x0fffffe7, 0x0fffffe8, 0x00ffffea, 0x3ffffffc, 0x0fffffe9,
+            0x0fffffea, 0x3ffffffd, 0x0fffffeb, 0x0fffffec, 0x0fffffed, 0x0fffffee,
+            0x0fffffef, 0x0ffffff0, 0x0ffffff1, 0x0ffffff2, 0x3ffffffe, 0x0ffffff3,
+            0x0ffffff4, 0x0ffffff5, 0x0ffffff6, 0x0ffffff7, 0x0ffffff8, 0x0ffffff9,
+            0x0ffffffa, 0x0ffffffb, 0x00000014, 0x000003f8, 0x000003f9, 0x00000ffa,
+            0x00001ff9, 0x00000015, 0x000000f8, 0x000007fa, 0x000003fa, 0x000003fb,
+            0x000000f9, 0x000007fb, 0x000000fa, 0x00000016, 0x00000017, 0x00000018,
+            0x00000000, 0x00000001, 0x00000002, 0x00000019, 0x0000001a, 0x0000001b,
+            0x0000001c, 0x0000001d, 0x0000001e, 0x0000001f, 0x0000005c, 0x000000fb,
+            0x00007ffc, 0x00000020, 0x00000ffb, 0x000003fc, 0x00001ffa, 0x00000021,
+            0x0000005d, 0x0000005e, 0x0000005f, 0x00000060, 0x00000061, 0x00000062,
+            0x00000063, 0x00000064, 0x00000065, 0x00000066, 0x00000067, 0x00000068,
+            0x00000069, 0x0000006a, 0x0000006b, 0x0000006c, 0x0000006d, 0x0000006e,
+            0x0000006f, 0x00000070, 0x00000071, 0x00000072, 0x000000fc, 0x00000073,
+            0x000000fd, 0x00001ffb, 0x0007fff0, 0x00001ffc, 0x00003ffc, 0x00000022,
+            0x00007ffd, 0x00000003, 0x00000023, 0x00000004, 0x00000024, 0x00000005,
+            0x00000025, 0x00000026, 0x00000027, 0x00000006, 0x00000074, 0x00000075,
+            0x00000028, 0x00000029, 0x0000002a, 0x00000007, 0x0000002b, 0x00000076,
+            0x0000002c, 0x00000008, 0x00000009, 0x0000002d, 0x00000077, 0x00000078,
+            0x00000079, 0x0000007a, 0x0000007b, 0x00007ffe, 0x000007fc, 0x00003ffd,
+            0x00001ffd, 0x0ffffffc, 0x000fffe6, 0x003fffd2, 0x000fffe7, 0x000fffe8,
+            0x003fffd3, 0x003fffd4, 0x003fffd5, 0x007fffd9, 0x003fffd6, 0x007fffda,
+            0x007fffdb, 0x007fffdc, 0x007fffdd, 0x007fffde, 0x00ffffeb, 0x007fffdf,
+            0x00ffffec, 0x00ffffed, 0x003fffd7, 0x007fffe0, 0x00ffffee, 0x007fffe1,
+            0x007fffe2, 0x007fffe3, 0x007fffe4, 0x001fffdc, 0x003fffd8, 0x007fffe5,
+            0x003fffd9, 0x007fffe6, 0x007fffe7, 0x00ffffef, 0x003fffda, 0x001fffdd,
+            0x000fffe9, 0x003fffdb, 0x003fffdc, 0x007fffe8, 0x007fffe9, 0x001fffde,
+            0x007fffea, 0x003fffdd, 0x003fffde, 0x00fffff0, 0x001fffdf, 0x003fffdf,
+            0x007fffeb, 0x007fffec, 0x001fffe0, 0x001fffe1, 0x003fffe0, 0x001fffe2,
+            0x007fffed, 0x003fffe1, 0x007fffee, 0x007fffef, 0x000fffea, 0x003fffe2,
+            0x003fffe3, 0x003fffe4, 0x007ffff0, 0x003fffe5, 0x003fffe6, 0x007ffff1,
+            0x03ffffe0, 0x03ffffe1, 0x000fffeb, 0x0007fff1, 0x003fffe7, 0x007ffff2,
+            0x003fffe8, 0x01ffffec, 0x03ffffe2, 0x03ffffe3, 0x03ffffe4, 0x07ffffde,
+            0x07ffffdf, 0x03ffffe5, 0x00fffff1, 0x01ffffed, 0x0007fff2, 0x001fffe3,
+            0x03ffffe6, 0x07ffffe0, 0x07ffffe1, 0x03ffffe7, 0x07ffffe2, 0x00fffff2,
+            0x001fffe4, 0x001fffe5, 0x03ffffe8, 0x03ffffe9, 0x0ffffffd, 0x07ffffe3,
+            0x07ffffe4, 0x07ffffe5, 0x000fffec, 0x00fffff3, 0x000fffed, 0x001fffe6,
+            0x003fffe9, 0x001fffe7, 0x001fffe8, 0x007ffff3, 0x003fffea, 0x003fffeb,
+            0x01ffffee, 0x01ffffef, 0x00fffff4, 0x00fffff5, 0x03ffffea, 0x007ffff4,
+            0x03ffffeb, 0x07ffffe6, 0x03ffffec, 0x03ffffed, 0x07ffffe7, 0x07ffffe8,
+            0x07ffffe9, 0x07ffffea, 0x07ffffeb, 0x0ffffffe, 0x07ffffec, 0x07ffffed,
+            0x07ffffee, 0x07ffffef, 0x07fffff0, 0x03ffffee, 0x3fffffff,
+        };
+
+        constexpr std::uint8_t HUFFMAN_LENGTHS[257]{
+            13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+            28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+            6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+            5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+            13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+            7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+            15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+            6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+            20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+            24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+            22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+            21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+            26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+            19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+            20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+            26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+            30,
+        };
+
+        // RFC 7541 附录 A，下标从1开始
+        constexpr std::pair<std::string_view, std::string_view> STATIC_TABLE[]{
+            {},
+            {":authority", ""},
+            {":method", "GET"},
+            {":method", "POST"},
+            {":path", "/"},
+            {":path", "/index.html"},
+            {":scheme", "http"},
+            {":scheme", "https"},
+            {":status", "200"},
+            {":status", "204"},
+            {":status", "206"},
+            {":status", "304"},
+            {":status", "400"},
+            {":status", "404"},
+            {":status", "500"},
+            {"accept-charset", ""},
+            {"accept-encoding", "gzip, deflate"},
+            {"accept-language", ""},
+            {"accept-ranges", ""},
+            {"accept", ""},
+            {"access-control-allow-origin", ""},
+            {"age", ""},
+            {"allow", ""},
+            {"authorization", ""},
+            {"cache-control", ""},
+            {"content-disposition", ""},
+            {"content-encoding", ""},
+            {"content-language", ""},
+            {"content-length", ""},
+            {"content-location", ""},
+            {"content-range", ""},
+            {"content-type", ""},
+            {"cookie", ""},
+            {"date", ""},
+            {"etag", ""},
+            {"expect", ""},
+            {"expires", ""},
+            {"from", ""},
+            {"host", ""},
+            {"if-match", ""},
+            {"if-modified-since", ""},
+            {"if-none-match", ""},
+            {"if-range", ""},
+            {"if-unmodified-since", ""},
+            {"last-modified", ""},
+            {"link", ""},
+            {"location", ""},
+            {"max-forwards", ""},
+            {"proxy-authenticate", ""},
+            {"proxy-authorization", ""},
+            {"range", ""},
+            {"referer", ""},
+            {"refresh", ""},
+            {"retry-after", ""},
+            {"server", ""},
+            {"set-cookie", ""},
+            {"strict-transport-security", ""},
+            {"transfer-encoding", ""},
+            {"user-agent", ""},
+            {"vary", ""},
+            {"via", ""},
+            {"www-authenticate", ""},
+        };
+
+        constexpr std::size_t STATIC_TABLE_SIZE = std::size(STATIC_TABLE) - 1;
+
+        constexpr std::uint8_t HUFFMAN_EMIT = 0x1;
+
+        constexpr std::uint8_t HUFFMAN_FAIL = 0x2;
+
+        struct HuffmanTransition {
+            std::uint8_t next;
+
+            std::uint8_t symbol;
+
+            std::uint8_t flags;
+        };
+
+        /**
+         * @brief 半字节状态机
+         * @details 状态即 Huffman 树的内部节点(恰好256个)。由于最短的码长为5位，
+         * 读入4位最多走到一个叶子，因此每次转移至多输出一个符号
+         */
+        struct HuffmanMachine {
+            HuffmanTransition transitions[256][16];
+
+            /// 停在该状态时，已读入的位是否构成合法填充(不超过7位且全为1)
+            bool accepting[256];
+        };
+
+        const HuffmanMachine& huffmanMachine() {
+            static const auto machine = [] {
+                struct Node {
+                    int children[2]{-1, -1};
+
+                    int symbol = -1;
+
+                    int depth = 0;
+
+                    bool ones = true;
+                };
+
+                std::vector<Node> nodes(1);
+
+                for (auto symbol = 0; symbol < 257; ++symbol) {
+                    auto node = 0;
+
+                    for (auto i = HUFFMAN_LENGTHS[symbol]; i-- > 0;) {
+                        auto bit = HUFFMAN_CODES[symbol] >> i & 1;
+
+                        if (nodes[node].children[bit] < 0) {
+                            Node child;
+                            child.depth = nodes[node].depth + 1;
+                            child.ones  = nodes[node].ones && bit == 1;
+
+                            nodes[node].children[bit] = static_cast<int>(nodes.size());
+                            nodes.push_back(child);
+                        }
+
+                        node = nodes[node].children[bit];
+                    }
+
+                    nodes[node].symbol = symbol;
+                }
+
+                std::vector<int> states(nodes.size(), -1);
+                auto count = 0;
+
+                for (std::size_t i = 0; i < nodes.size(); ++i)
+                    if (nodes[i].symbol < 0) states[i] = count++;
+
+                auto result = std::make_unique<HuffmanMachine>();
+
+                for (std::size_t i = 0; i < nodes.size(); ++i) {
+                    if (states[i] < 0) continue;
+
+                    auto state = states[i];
+                    result->accepting[state] = nodes[i].ones && nodes[i].depth <= 7;
+
+                    for (auto nibble = 0; nibble < 16; ++nibble) {
+                        HuffmanTransition transition{};
+                        auto node = static_cast<int>(i);
+
+                        for (auto bit = 4; bit-- > 0;) {
+                            node = nodes[node].children[nibble >> bit & 1];
+
+                            auto symbol = nodes[node].symbol;
+                            if (symbol < 0) continue;
+
+                            if (symbol == 256) {
+                                transition.flags |= HUFFMAN_FAIL;
+                                break;
+                            }
+
+                            transition.symbol = static_cast<std::uint8_t>(symbol);
+                            transition.flags |= HUFFMAN_EMIT;
+                            node = 0;
+                        }
+
+                        transition.next = static_cast<std::uint8_t>(states[node]);
+                        result->transitions[state][nibble] = transition;
+                    }
+                }
+
+                return result;
+            }();
+
+            return *machine;
+        }
+
+        /**
+         * @brief 静态表中名称到首个表项下标的映射，同名表项在静态表中相邻
+         */
+        std::size_t staticNameIndex(const std::string_view name) {
+            static const auto indices = [] {
+                std::unordered_map<std::string_view, std::size_t> map;
+
+                for (auto i = STATIC_TABLE_SIZE; i > 0; --i) map[STATIC_TABLE[i].first] = i;
+
+                return map;
+            }();
+
+            auto it = indices.find(name);
+
+            return it == indices.end() ? 0 : it->second;
+        }
+
+        void encodeInteger(
+            std::size_t value, const int prefix, const std::uint8_t pattern,
+            std::vector<std::byte>& out
+        ) {
+            const std::size_t limit = (1u << prefix) - 1;
+
+            if (value < limit) {
+                out.push_back(static_cast<std::byte>(pattern | value));
+                return;
+            }
+
+            out.push_back(static_cast<std::byte>(pattern | limit));
+            value -= limit;
+
+            for (; value >= 0x80; value >>= 7)
+                out.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+
+            out.push_back(static_cast<std::byte>(value));
+        }
+
+        void encodeString(const std::string_view text, std::vector<std::byte>& out) {
+            auto huffman = huffmanEncodedSize(text);
+
+            if (huffman < text.size()) {
+                encodeInteger(huffman, 7, 0x80, out);
+                huffmanEncode(text, out);
+                return;
+            }
+
+            encodeInteger(text.size(), 7, 0, out);
+
+            auto bytes = std::as_bytes(std::span{text});
+            out.insert(out.end(), bytes.begin(), bytes.end());
+        }
+
+        /**
+         * @brief 从头部块中逐个读取表示的游标
+         */
+        struct Reader {
+            std::span<const std::byte> data;
+
+            std::size_t offset = 0;
+
+            [[nodiscard]] bool done() const noexcept { return offset == data.size(); }
+
+            [[nodiscard]] std::uint8_t peek() const noexcept {
+                return std::to_integer<std::uint8_t>(data[offset]);
+            }
+
+            bool integer(const int prefix, std::size_t& value) noexcept {
+                if (done()) return false;
+
+                const std::size_t limit = (1u << prefix) - 1;
+
+                value = peek() & limit;
+                ++offset;
+
+                if (value < limit) return true;
+
+                for (auto shift = 0; shift <= 28; shift += 7) {
+                    if (done()) return false;
+
+                    auto byte = peek();
+                    ++offset;
+
+                    value += static_cast<std::size_t>(byte & 0x7F) << shift;
+
+                    if ((byte & 0x80) == 0) return true;
+                }
+
+                // 超过32位的整数视为攻击
+                return false;
+            }
+
+            bool string(std::string& out) {
+                if (done()) return false;
+
+                auto huffman = (peek() & 0x80) != 0;
+
+                std::size_t length;
+                if (!integer(7, length) || length > data.size() - offset) return false;
+
+                auto bytes = data.subspan(offset, length);
+                offset += length;
+
+                out.clear();
+
+                if (huffman) return huffmanDecode(bytes, out);
+
+                out.assign(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+
+                return true;
+            }
+        };
+
+    }  // namespace
+
+    std::size_t huffmanEncodedSize(const std::string_view text) noexcept {
+        std::size_t bits = 0;
+
+        for (auto c : text) bits += HUFFMAN_LENGTHS[static_cast<std::uint8_t>(c)];
+
+        return (bits + 7) / 8;
+    }
+
+    void huffmanEncode(const std::string_view text, std::vector<std::byte>& out) {
+        std::uint64_t bits = 0;
+        auto count         = 0;
+
+        for (auto c : text) {
+            auto symbol = static_cast<std::uint8_t>(c);
+
+            bits = bits << HUFFMAN_LENGTHS[symbol] | HUFFMAN_CODES[symbol];
+            count += HUFFMAN_LENGTHS[symbol];
+
+            while (count >= 8) {
+                count -= 8;
+                out.push_back(static_cast<std::byte>(bits >> count & 0xFF));
+            }
+        }
+
+        // 以 EOS 的高位(全1)填充最后一个字节
+        if (count > 0) {
+            auto last = (bits << (8 - count) & 0xFF) | (0xFF >> count);
+            out.push_back(static_cast<std::byte>(last));
+        }
+    }
+
+    bool huffmanDecode(const std::span<const std::byte> data, std::string& out) {
+        const auto& machine = huffmanMachine();
+
+        std::uint8_t state = 0;
+
+        auto step = [&](const std::uint8_t nibble) {
+            const auto& transition = machine.transitions[state][nibble];
+
+            if (transition.flags & HUFFMAN_FAIL) return false;
+
+            if (transition.flags & HUFFMAN_EMIT)
+                out.push_back(static_cast<char>(transition.symbol));
+
+            state = transition.next;
+            return true;
+        };
+
+        out.reserve(out.size() + data.size() * 8 / 5);
+
+        for (auto byte : data) {
+            auto value = std::to_integer<std::uint8_t>(byte);
+
+            if (!step(value >> 4) || !step(value & 0xF)) return false;
+        }
+
+        return machine.accepting[state];
+    }
+
+    DynamicTable::DynamicTable(const std::size_t maxSize)
+        : maxSize_(maxSize) {}
+
+    void DynamicTable::insert(const std::string_view name, const std::string_view value) {
+        auto size = name.size() + value.size() + ENTRY_OVERHEAD;
+
+        if (size > maxSize_) {
+            evict(0);
+            return;
+        }
+
+        evict(maxSize_ - size);
+
+        entries_.push_front({std::string{name}, std::string{value}});
+        size_ += size;
+    }
+
+    void DynamicTable::setMaxSize(const std::size_t maxSize) {
+        maxSize_ = maxSize;
+        evict(maxSize);
+    }
+
+    const HeaderField* DynamicTable::get(const std::size_t index) const noexcept {
+        return index < entries_.size() ? &entries_[index] : nullptr;
+    }
+
+    std::size_t DynamicTable::count() const noexcept { return entries_.size(); }
+
+    std::size_t DynamicTable::size() const noexcept { return size_; }
+
+    std::size_t DynamicTable::maxSize() const noexcept { return maxSize_; }
+
+    void DynamicTable::evict(const std::size_t limit) {
+        while (size_ > limit) {
+            const auto& oldest = entries_.back();
+
+            size_ -= oldest.name.size() + oldest.value.size() + ENTRY_OVERHEAD;
+            entries_.pop_back();
+        }
+    }
+
+    HpackDecoder::HpackDecoder(const std::size_t maxTableSize)
+        : table_(maxTableSize)
+        , maxTableSize_(maxTableSize) {}
+
+    HpackDecoder::Status HpackDecoder::decode(
+        const std::span<const std::byte> block, std::vector<HeaderField>& fields,
+        const std::size_t maxListSize
+    ) {
+        Reader reader{block};
+
+        // 动态表大小更新只能出现在头部块的开头
+        auto started = false;
+
+        const auto initial   = fields.size();
+        std::size_t listSize = 0;
+        auto tooLarge        = false;
+
+        // 先按大小计入预算，未超出时才复制字段
+        auto admit = [&](const std::string_view name, const std::string_view value) {
+            if (tooLarge) return false;
+
+            listSize += name.size() + value.size() + ENTRY_OVERHEAD;
+
+            if (listSize > maxListSize) {
+                tooLarge = true;
+                fields.resize(initial);
+            }
+
+            return !tooLarge;
+        };
+
+        using Entry = std::pair<std::string_view, std::string_view>;
+
+        auto lookup = [&](const std::size_t index) -> std::optional<Entry> {
+            if (index == 0) return std::nullopt;
+
+            if (index <= STATIC_TABLE_SIZE) return STATIC_TABLE[index];
+
+            const auto* entry = table_.get(index - STATIC_TABLE_SIZE - 1);
+            if (!entry) return std::nullopt;
+
+            return Entry{entry->name, entry->value};
+        };
+
+        while (!reader.done()) {
+            auto first = reader.peek();
+            std::size_t index;
+
+            // 索引表示
+            if (first & 0x80) {
+                if (!reader.integer(7, index)) return Status::ERROR;
+
+                auto entry = lookup(index);
+                if (!entry) return Status::ERROR;
+
+                if (const auto [name, value] = *entry; admit(name, value))
+                    fields.push_back({std::string{name}, std::string{value}});
+
+                started = true;
+                continue;
+            }
+
+            // 动态表大小更新
+            if ((first & 0xE0) == 0x20) {
+                std::size_t size;
+                if (started || !reader.integer(5, size)) return Status::ERROR;
+
+                if (size > maxTableSize_) return Status::ERROR;
+
+                table_.setMaxSize(size);
+                continue;
+            }
+
+            // 字面量: 01 增量索引，0001 永不索引，0000 不索引
+            auto indexing = (first & 0xC0) == 0x40;
+
+            if (!reader.integer(indexing ? 6 : 4, index)) return Status::ERROR;
+
+            HeaderField field;
+
+            if (index > 0) {
+                auto named = lookup(index);
+                if (!named) return Status::ERROR;
+
+                field.name = named->first;
+            } else if (!reader.string(field.name)) {
+                return Status::ERROR;
+            }
+
+            if (!reader.string(field.value)) return Status::ERROR;
+
+            if (indexing) table_.insert(field.name, field.value);
+
+            if (admit(field.name, field.value)) fields.push_back(std::move(field));
+
+            started = true;
+        }
+
+        return tooLarge ? Status::TOO_LARGE : Status::OK;
+    }
+
+    HpackEncoder::HpackEncoder(const std::size_t maxTableSize)
+        : table_(maxTableSize) {}
+
+    void HpackEncoder::setMaxTableSize(const std::size_t size) {
+        auto limit = std::min(size, DEFAULT_HEADER_TABLE_SIZE);
+        if (limit == table_.maxSize() && !pendingSize_) return;
+
+        pendingMinimum_ = pendingSize_ ? std::min(pendingMinimum_, limit) : limit;
+
+        table_.setMaxSize(limit);
+        pendingSize_ = limit;
+    }
+
+    void HpackEncoder::encode(
+        const std::string_view name, const std::string_view value,
+        std::vector<std::byte>& out, const bool index
+    ) {
+        if (pendingSize_) {
+            // 期间曾缩小过: 先告知最小值，对端据此逐出后再放大(RFC 7541 4.2)
+            if (pendingMinimum_ < *pendingSize_)
+                encodeInteger(pendingMinimum_, 5, 0x20, out);
+
+            encodeInteger(*pendingSize_, 5, 0x20, out);
+            pendingSize_.reset();
+        }
+
+        auto nameIndex = staticNameIndex(name);
+
+        // 静态表完全匹配
+        for (auto i = nameIndex; i > 0 && i <= STATIC_TABLE_SIZE; ++i) {
+            if (STATIC_TABLE[i].first != name) break;
+
+            if (STATIC_TABLE[i].second == value) return encodeInteger(i, 7, 0x80, out);
+        }
+
+        // 动态表，新表项在前
+        for (std::size_t i = 0; i < table_.count(); ++i) {
+            const auto* entry = table_.get(i);
+            if (entry->name != name) continue;
+
+            if (entry->value == value)
+                return encodeInteger(STATIC_TABLE_SIZE + 1 + i, 7, 0x80, out);
+
+            if (nameIndex == 0) nameIndex = STATIC_TABLE_SIZE + 1 + i;
+        }
+
+        encodeInteger(nameIndex, index ? 6 : 4, index ? 0x40 : 0, out);
+
+        if (nameIndex == 0) encodeString(name, out);
+        encodeString(value, out);
+
+        if (index) table_.insert(name, value);
+    }
+
+}  // namespace tiny_web_server::http2
@@ -0,0 +1,384 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file access_log.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/logging/access_log.hpp"
+#include "tws/exception.hpp"
+#include "tws/metrics/metrics.hpp"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+
+namespace tiny_web_server::logging {
+
+    namespace {
+
+        /// 缓冲区超过此大小时立即写出
+        constexpr std::size_t FLUSH_THRESHOLD = 64 << 10;
+
+        /// 每个环每轮最多取出的记录数，避免单个繁忙线程饿死其他线程
+        constexpr std::size_t DRAIN_BATCH = 1024;
+
+        std::atomic<std::uint64_t> nextId = 1;
+
+        struct ThreadProducer {
+            std::uint64_t owner;
+
+            void* producer;
+        };
+
+        /// 本线程在各个日志实例中的环，实例数很少，线性查找即可
+        thread_local std::vector<ThreadProducer> threadProducers;
+
+        metrics::Counter& droppedCounter() {
+            static auto& counter = metrics::Registry::global().counter(
+                "tws_access_log_records_total", "Access log records by outcome",
+                "result=\"dropped\""
+            );
+            return counter;
+        }
+
+        metrics::Counter& writtenCounter() {
+            static auto& counter = metrics::Registry::global().counter(
+                "tws_access_log_records_total", "Access log records by outcome",
+                "result=\"written\""
+            );
+            return counter;
+        }
+
+        template<typename T>
+        void appendNumber(std::string& out, const T value) {
+            char buffer[24];
+            auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, end);
+        }
+
+        /**
+         * @brief 方法与目标来自客户端，可见 ASCII 之外的字节及引号、反斜杠写作 \xHH，
+         * 防止伪造日志行或向终端注入控制序列
+         */
+        void appendEscaped(std::string& out, const std::string_view text) {
+            static constexpr std::string_view HEX = "0123456789abcdef";
+
+            for (auto c : text) {
+                auto byte = static_cast<unsigned char>(c);
+
+                if (byte > 0x20 && byte < 0x7F && c != '"' && c != '\\') {
+                    out.push_back(c);
+                    continue;
+                }
+
+                out.append("\\x");
+                out.push_back(HEX[byte >> 4]);
+                out.push_back(HEX[byte & 0xF]);
+            }
+        }
+
+    }  // namespace
+
+    AccessRecord AccessRecord::make(
+        const net::Endpoint& peer, const http::Request& request, const int status,
+        const std::uint64_t bytesIn, const std::uint64_t bytesOut,
+        const std::chrono::nanoseconds duration
+    ) noexcept {
+        AccessRecord record;
+
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+
+        record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        record.duration = static_cast<std::uint64_t>(duration.count());
+        record.bytesIn  = bytesIn;
+        record.bytesOut = bytesOut;
+        record.status   = static_cast<std::uint16_t>(status);
+
+        // Unix 域套接字的对端没有地址，端口保持为0
+        if (!peer.isUnix()) {
+            auto bytes = peer.address().bytes();
+
+            std::memcpy(record.address.data(), bytes.data(), bytes.size());
+            record.ipv6 = peer.address().isIPv6();
+            record.port = peer.port();
+        }
+
+        record.methodLength =
+            static_cast<std::uint8_t>(std::min(request.method.size(), record.method.size()));
+        std::memcpy(record.method.data(), request.method.data(), record.methodLength);
+
+        record.targetLength =
+            static_cast<std::uint8_t>(std::min(request.target.size(), TARGET_SIZE));
+        std::memcpy(record.target.data(), request.target.data(), record.targetLength);
+
+        return record;
+    }
+
+    AccessLog::AccessLog(AccessLogOptions options)
+        : options_(std::move(options))
+        , id_(nextId.fetch_add(1, std::memory_order_relaxed)) {
+        open();
+
+        buffer_.reserve(FLUSH_THRESHOLD * 2);
+
+        writer_ = std::jthread([this](const std::stop_token& token) { run(token); });
+    }
+
+    AccessLog::~AccessLog() {
+        writer_.request_stop();
+        writer_.join();
+
+        if (file_ >= 0) ::close(file_);
+    }
+
+    bool AccessLog::log(const AccessRecord& record) noexcept {
+        auto* producer = this->producer();
+
+        if (producer && producer->ring.tryPush(record)) return true;
+
+        // 只有本线程写入，读-改-写无需原子
+        if (producer)
+            producer->dropped.store(
+                producer->dropped.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed
+            );
+
+        droppedCounter().add();
+
+        return false;
+    }
+
+    void AccessLog::rotate() noexcept {
+        rotateRequested_.store(true, std::memory_order_relaxed);
+    }
+
+    std::uint64_t AccessLog::written() const noexcept {
+        return written_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t AccessLog::dropped() const noexcept {
+        std::lock_guard lock(mutex_);
+
+        std::uint64_t total = 0;
+
+        for (const auto& producer : producers_)
+            total += producer->dropped.load(std::memory_order_relaxed);
+
+        return total;
+    }
+
+    AccessLog::Producer* AccessLog::producer() noexcept {
+        for (const auto& entry : threadProducers)
+            if (entry.owner == id_) return static_cast<Producer*>(entry.producer);
+
+        // 每个线程只在首次调用时注册一次
+        try {
+            auto producer = std::make_unique<Producer>();
+            auto* raw     = producer.get();
+
+            threadProducers.push_back({id_, raw});
+
+            std::lock_guard lock(mutex_);
+            producers_.push_back(std::move(producer));
+
+            return raw;
+        } catch (const std::bad_alloc&) { return nullptr; }
+    }
+
+    void AccessLog::run(const std::stop_token& token) {
+        std::mutex mutex;
+        std::condition_variable_any sleeper;
+
+        while (!token.stop_requested()) {
+            auto collected = collect();
+
+            if (buffer_.size() >= FLUSH_THRESHOLD || (collected == 0 && !buffer_.empty()))
+                flush();
+
+            if (rotateRequested_.exchange(false, std::memory_order_relaxed)
+                || (options_.maxFileSize > 0 && fileSize_ >= options_.maxFileSize))
+                rotateFiles();
+
+            if (collected > 0) continue;
+
+            // 生产者从不唤醒写线程，空闲时按固定间隔轮询
+            std::unique_lock lock(mutex);
+            sleeper.wait_for(lock, token, options_.flushInterval, [] { return false; });
+        }
+
+        // 退出前写出所有已提交的记录
+        while (collect() > 0)
+            if (buffer_.size() >= FLUSH_THRESHOLD) flush();
+
+        flush();
+    }
+
+    std::size_t AccessLog::collect() {
+        std::vector<Producer*> producers;
+
+        {
+            std::lock_guard lock(mutex_);
+
+            producers.reserve(producers_.size());
+            for (const auto& producer : producers_) producers.push_back(producer.get());
+        }
+
+        std::size_t total = 0;
+
+        for (auto* producer : producers)
+            total += producer->ring.drain(
+                [this](const AccessRecord& record) { format(record); }, DRAIN_BATCH
+            );
+
+        return total;
+    }
+
+    void AccessLog::format(const AccessRecord& record) {
+        // 时间: 2026-10-19T12:34:56.789Z，同一秒内复用已格式化的前缀
+        auto second = record.timestamp / 1'000'000'000;
+
+        if (second != cachedSecond_) {
+            auto time = static_cast<std::time_t>(second);
+            std::tm tm{};
+#if WEB_SERVER_WINDOWS
+            gmtime_s(&tm, &time);
+#else
+            gmtime_r(&time, &tm);
+#endif
+
+            std::strftime(cachedTime_.data(), cachedTime_.size(), "%Y-%m-%dT%H:%M:%S", &tm);
+            cachedSecond_ = second;
+        }
+
+        buffer_.append(cachedTime_.data());
+
+        char millis[8];
+        auto value = record.timestamp / 1'000'000 % 1000;
+        std::snprintf(millis, sizeof(millis), ".%03dZ ", static_cast<int>(value));
+        buffer_.append(millis);
+
+        // 对端
+        if (record.port == 0) {
+            buffer_.append("-");
+        } else {
+            auto address = std::as_bytes(std::span{record.address});
+
+            if (record.ipv6) buffer_.push_back('[');
+            buffer_.append(net::IpAddress{address, record.ipv6}.toString());
+            if (record.ipv6) buffer_.push_back(']');
+
+            buffer_.push_back(':');
+            appendNumber(buffer_, record.port);
+        }
+
+        // 请求行
+        buffer_.append(" \"");
+        appendEscaped(buffer_, {record.method.data(), record.methodLength});
+        buffer_.push_back(' ');
+        appendEscaped(buffer_, {record.target.data(), record.targetLength});
+        buffer_.append("\" ");
+
+        appendNumber(buffer_, record.status);
+        buffer_.push_back(' ');
+        appendNumber(buffer_, record.bytesIn);
+        buffer_.push_back(' ');
+        appendNumber(buffer_, record.bytesOut);
+        buffer_.push_back(' ');
+        appendNumber(buffer_, record.duration / 1000);
+        buffer_.append("us\n");
+
+        written_.fetch_add(1, std::memory_order_relaxed);
+        writtenCounter().add();
+    }
+
+    void AccessLog::flush() {
+        if (buffer_.empty()) return;
+
+        // 上次轮转后重新打开失败时在此重试，仍失败则丢弃本批
+        if (file_ < 0) {
+            try {
+                open();
+            } catch (const std::system_error&) {
+                buffer_.clear();
+                return;
+            }
+        }
+
+        std::string_view data = buffer_;
+
+        while (!data.empty()) {
+            auto written = ::write(file_, data.data(), data.size());
+
+            if (written < 0) {
+                if (errno == EINTR) continue;
+
+                // 写入失败(如磁盘已满)时丢弃本批，不影响后续批次
+                break;
+            }
+
+            data.remove_prefix(static_cast<std::size_t>(written));
+            fileSize_ += static_cast<std::uint64_t>(written);
+        }
+
+        buffer_.clear();
+    }
+
+    void AccessLog::open() {
+#if WEB_SERVER_WINDOWS
+        file_ = _wopen(
+            options_.path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY,
+            _S_IREAD | _S_IWRITE
+        );
+#else
+        file_ = ::open(
+            options_.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644
+        );
+#endif
+
+        if (file_ < 0)
+            throw LogError<>(errno, std::format("open '{}'", options_.path.string()));
+
+        struct stat status{};
+        fileSize_ = ::fstat(file_, &status) == 0 ? static_cast<std::uint64_t>(status.st_size)
+                                                 : 0;
+    }
+
+    void AccessLog::rotateFiles() {
+        flush();
+
+        if (file_ >= 0) ::close(file_);
+
+        file_     = -1;
+        fileSize_ = 0;
+
+        // path.N-1 -> path.N, ..., path -> path.1; 最旧的被覆盖
+        auto rotated = [&](const int index) {
+            auto path = options_.path;
+            path += "." + std::to_string(index);
+            return path;
+        };
+
+        // 新文件在下一次 flush 时打开
+        std::error_code ec;
+
+        if (options_.maxFiles > 0) {
+            for (auto i = options_.maxFiles - 1; i > 0; --i)
+                std::filesystem::rename(rotated(i), rotated(i + 1), ec);
+
+            std::filesystem::rename(options_.path, rotated(1), ec);
+        } else {
+            std::filesystem::remove(options_.path, ec);
+        }
+    }
+
+}  // namespace tiny_web_server::logging
@@ -0,0 +1,43 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file admin.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/metrics/admin.hpp"
+
+namespace tiny_web_server::metrics {
+
+    bool serveMetrics(
+        const http::Request& request, http::ResponseBuilder& response,
+        const Registry& registry
+    ) {
+        auto path = request.target.substr(0, request.target.find('?'));
+
+        if (path != "/metrics" || (request.method != "GET" && request.method != "HEAD"))
+            return false;
+
+        std::string body;
+        registry.render(body);
+
+        response.status(200)
+            .header("Content-Type", "text/plain; version=0.0.4; charset=utf-8")
+            .header("Content-Length", body.size())
+            .header("Cache-Control", "no-store")
+            .end();
+
+        if (request.method == "GET") response.append(body);
+
+        return true;
+    }
+
+}  // namespace tiny_web_server::metrics
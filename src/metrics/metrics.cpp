@@ -0,0 +1,278 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file metrics.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/metrics/metrics.hpp"
+#include <charconv>
+#include <cmath>
+
+namespace tiny_web_server::metrics {
+
+    namespace {
+
+        /// 导出的直方图桶边界: 含 2^10 ns(约1微秒) 到 2^35 ns(约34秒)的桶的上界
+        constexpr int MIN_EXPORT_EXPONENT = 10;
+
+        constexpr int MAX_EXPORT_EXPONENT = 35;
+
+        template<typename T>
+        void appendNumber(std::string& out, const T value) {
+            char buffer[32];
+            auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+            out.append(buffer, end);
+        }
+
+        /**
+         * @brief 输出 name{labels,extra}
+         */
+        void appendSeries(
+            std::string& out, std::string_view name, std::string_view suffix,
+            std::string_view labels, std::string_view extra = {}
+        ) {
+            out.append(name).append(suffix);
+
+            if (labels.empty() && extra.empty()) return;
+
+            out.push_back('{');
+            out.append(labels);
+            if (!labels.empty() && !extra.empty()) out.push_back(',');
+            out.append(extra);
+            out.push_back('}');
+        }
+
+        void renderHistogram(
+            std::string& out, std::string_view name, std::string_view labels,
+            const Histogram::Snapshot& snapshot
+        ) {
+            std::uint64_t cumulative = 0;
+            std::size_t index        = 0;
+
+            for (auto exponent = MIN_EXPORT_EXPONENT; exponent <= MAX_EXPORT_EXPONENT;
+                 ++exponent) {
+                // 2的幂所在的桶还含略大于它(不超过 1/16)的值，le 取该桶的实际上界，
+                // 计数才严格等于 <= le 的观测数
+                auto last = Histogram::bucketIndex(std::uint64_t{1} << exponent);
+
+                for (; index <= last; ++index) cumulative += snapshot.counts[index];
+
+                auto upper = Histogram::bucketUpperBound(last);
+
+                std::string le = "le=\"";
+                appendNumber(le, static_cast<double>(upper) / 1e9);
+                le.push_back('"');
+
+                appendSeries(out, name, "_bucket", labels, le);
+                out.push_back(' ');
+                appendNumber(out, cumulative);
+                out.push_back('\n');
+            }
+
+            appendSeries(out, name, "_bucket", labels, "le=\"+Inf\"");
+            out.push_back(' ');
+            appendNumber(out, snapshot.count);
+            out.push_back('\n');
+
+            appendSeries(out, name, "_sum", labels);
+            out.push_back(' ');
+            appendNumber(out, static_cast<double>(snapshot.sum) / 1e9);
+            out.push_back('\n');
+
+            appendSeries(out, name, "_count", labels);
+            out.push_back(' ');
+            appendNumber(out, snapshot.count);
+            out.push_back('\n');
+        }
+
+    }  // namespace
+
+    std::size_t shardIndex() noexcept {
+        static std::atomic<std::size_t> next = 0;
+
+        thread_local const std::size_t index =
+            next.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+
+        return index;
+    }
+
+    std::uint64_t Counter::value() const noexcept {
+        std::uint64_t total = 0;
+
+        for (const auto& shard : shards_)
+            total += shard.value.load(std::memory_order_relaxed);
+
+        return total;
+    }
+
+    std::int64_t Gauge::value() const noexcept {
+        std::int64_t total = 0;
+
+        for (const auto& shard : shards_)
+            total += shard.value.load(std::memory_order_relaxed);
+
+        return total;
+    }
+
+    std::uint64_t Histogram::Snapshot::quantile(const double quantile) const noexcept {
+        if (count == 0) return 0;
+
+        auto target = static_cast<std::uint64_t>(std::ceil(quantile * count));
+        auto rank   = std::clamp<std::uint64_t>(target, 1, count);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) return bucketUpperBound(i);
+        }
+
+        return bucketUpperBound(BUCKET_COUNT - 1);
+    }
+
+    Histogram::Histogram()
+        : shards_(std::make_unique<Shard[]>(SHARD_COUNT)) {}
+
+    Histogram::Snapshot Histogram::snapshot() const {
+        Snapshot snapshot;
+
+        for (std::size_t s = 0; s < SHARD_COUNT; ++s) {
+            const auto& shard = shards_[s];
+
+            for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+                auto count = shard.counts[i].load(std::memory_order_relaxed);
+
+                snapshot.counts[i] += count;
+                snapshot.count += count;
+            }
+
+            snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+        }
+
+        return snapshot;
+    }
+
+    template<typename T>
+    T& Registry::find(
+        std::string_view name, std::string_view help, std::string_view labels
+    ) {
+        std::lock_guard lock(mutex_);
+
+        for (auto& entry : entries_) {
+            if (entry.name != name || entry.labels != labels) continue;
+
+            if (auto* metric = std::get_if<std::unique_ptr<T>>(&entry.metric))
+                return **metric;
+        }
+
+        auto metric = std::make_unique<T>();
+        auto& ref   = *metric;
+
+        entries_.push_back(
+            {std::string{name}, std::string{labels}, std::string{help}, std::move(metric)}
+        );
+
+        return ref;
+    }
+
+    Counter& Registry::counter(
+        std::string_view name, std::string_view help, std::string_view labels
+    ) {
+        return find<Counter>(name, help, labels);
+    }
+
+    Gauge& Registry::gauge(
+        std::string_view name, std::string_view help, std::string_view labels
+    ) {
+        return find<Gauge>(name, help, labels);
+    }
+
+    Histogram& Registry::histogram(
+        std::string_view name, std::string_view help, std::string_view labels
+    ) {
+        return find<Histogram>(name, help, labels);
+    }
+
+    void Registry::render(std::string& out) const {
+        std::lock_guard lock(mutex_);
+
+        // 同名指标(仅标签不同)需连续输出，且只输出一次 HELP 与 TYPE
+        std::vector<bool> done(entries_.size());
+
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            if (done[i]) continue;
+
+            const auto& family = entries_[i];
+
+            static constexpr std::string_view types[]{"counter", "gauge", "histogram"};
+
+            out.append("# HELP ").append(family.name).push_back(' ');
+            out.append(family.help).push_back('\n');
+            out.append("# TYPE ").append(family.name).push_back(' ');
+            out.append(types[family.metric.index()]).push_back('\n');
+
+            for (auto j = i; j < entries_.size(); ++j) {
+                const auto& entry = entries_[j];
+                if (done[j] || entry.name != family.name) continue;
+
+                done[j] = true;
+
+                std::visit(
+                    [&]<typename T>(const std::unique_ptr<T>& metric) {
+                        if constexpr (std::is_same_v<T, Histogram>) {
+                            auto snapshot = metric->snapshot();
+                            renderHistogram(out, entry.name, entry.labels, snapshot);
+                        } else {
+                            appendSeries(out, entry.name, "", entry.labels);
+                            out.push_back(' ');
+                            appendNumber(out, metric->value());
+                            out.push_back('\n');
+                        }
+                    },
+                    entry.metric
+                );
+            }
+        }
+    }
+
+    Registry& Registry::global() {
+        static Registry registry;
+        return registry;
+    }
+
+    ServerMetrics& server() {
+        static ServerMetrics metrics = [] {
+            constexpr std::string_view BYTES_HELP = "Bytes transferred by sockets";
+
+            auto& registry = Registry::global();
+
+            return ServerMetrics{
+                registry.counter("tws_accepts_total", "Accepted connections"),
+                registry.gauge("tws_active_connections", "Currently open connections"),
+                registry.counter("tws_socket_bytes_total", BYTES_HELP, "direction=\"in\""),
+                registry.counter("tws_socket_bytes_total", BYTES_HELP, "direction=\"out\""),
+                registry.histogram(
+                    "tws_parse_duration_seconds", "Time spent parsing request headers"
+                ),
+                registry.histogram(
+                    "tws_handler_duration_seconds", "Time spent in request handlers"
+                ),
+                registry.histogram(
+                    "tws_write_duration_seconds", "Time spent writing responses"
+                ),
+            };
+        }();
+
+        return metrics;
+    }
+
+}  // namespace tiny_web_server::metrics
@@ -0,0 +1,261 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file trace.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 19:50
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/metrics/trace.hpp"
+#include <charconv>
+#include <thread>
+
+namespace tiny_web_server::metrics {
+
+    namespace {
+
+        /// 以结束阶段命名的区间，如 parse 为 FIRST_READ 到 HEADERS_PARSED
+        constexpr std::array<std::string_view, STAGE_COUNT> INTERVAL_NAMES{
+            "", "wait", "parse", "queue", "handler", "serialize", "write"
+        };
+
+        struct Calibration {
+            std::uint64_t base;
+
+            double nanosPerTick;
+        };
+
+        const Calibration& calibration() noexcept {
+            static const Calibration value = [] {
+                using Clock = std::chrono::steady_clock;
+
+                auto startTime  = Clock::now();
+                auto startTicks = traceTicks();
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                auto elapsed = std::chrono::duration<double, std::nano>(
+                    Clock::now() - startTime
+                );
+                auto ticks = traceTicks() - startTicks;
+
+                return Calibration{startTicks, ticks > 0 ? elapsed.count() / ticks : 1.0};
+            }();
+
+            return value;
+        }
+
+        /**
+         * @brief 相对校准起点的微秒数
+         */
+        double micros(const std::uint64_t ticks) noexcept {
+            const auto& [base, scale] = calibration();
+
+            return (static_cast<double>(ticks) - static_cast<double>(base)) * scale / 1000;
+        }
+
+        void appendNumber(std::string& out, const double value) {
+            char buffer[32];
+            auto [end, _] = std::to_chars(
+                buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 3
+            );
+
+            out.append(buffer, end);
+        }
+
+        void appendNumber(std::string& out, const std::size_t value) {
+            char buffer[24];
+            auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+            out.append(buffer, end);
+        }
+
+        void appendSpan(
+            std::string& out, bool& first, const std::string_view name,
+            const std::size_t tid, const std::uint64_t begin, const std::uint64_t end
+        ) {
+            out.append(first ? "\n" : ",\n");
+            first = false;
+
+            out.append(R"({"name":")").append(name).append(R"(","ph":"X","pid":1,"tid":)");
+            appendNumber(out, tid);
+            out.append(R"(,"ts":)");
+            appendNumber(out, micros(begin));
+            out.append(R"(,"dur":)");
+            appendNumber(out, micros(end) - micros(begin));
+            out.push_back('}');
+        }
+
+        /**
+         * @brief 按阶段顺序遍历已记录的相邻时间点，缺失的阶段并入下一个区间
+         */
+        template<typename F>
+        void forEachInterval(const RequestTrace& trace, F&& consume) {
+            std::uint64_t previous = 0;
+
+            for (std::size_t i = 0; i < STAGE_COUNT; ++i) {
+                auto tick = trace.ticks[i];
+                if (tick == 0) continue;
+
+                if (previous != 0 && tick >= previous) consume(i, previous, tick);
+
+                previous = tick;
+            }
+        }
+
+        struct ThreadProducer {
+            const Tracer* owner;
+
+            void* producer;
+        };
+
+        thread_local ThreadProducer threadProducer{};
+
+    }  // namespace
+
+    struct Tracer::Producer {
+        async::SpscRing<RequestTrace, RING_CAPACITY> ring;
+
+        /// 提交线程的序号，作为 Chrome 追踪中的 tid
+        std::size_t index;
+    };
+
+    double nanosPerTick() noexcept { return calibration().nanosPerTick; }
+
+    Tracer::Tracer() = default;
+
+    Tracer::~Tracer() = default;
+
+    void Tracer::enable(const bool enabled) noexcept {
+        if (enabled) (void)calibration();
+
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    std::uint64_t Tracer::dropped() const noexcept { return dropped_.value(); }
+
+    Tracer& Tracer::global() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    Tracer::Producer* Tracer::producer() noexcept {
+        if (threadProducer.owner == this)
+            return static_cast<Producer*>(threadProducer.producer);
+
+        // 每个线程只在首次提交时注册一次
+        try {
+            std::lock_guard lock(mutex_);
+
+            auto producer = std::make_unique<Producer>();
+            producer->index = producers_.size() + 1;
+
+            threadProducer = {this, producer.get()};
+            producers_.push_back(std::move(producer));
+
+            return static_cast<Producer*>(threadProducer.producer);
+        } catch (const std::bad_alloc&) { return nullptr; }
+    }
+
+    template<typename F>
+    std::size_t Tracer::drain(F&& consume) {
+        std::lock_guard lock(mutex_);
+
+        std::size_t total = 0;
+
+        for (const auto& producer : producers_)
+            total += producer->ring.drain([&](const RequestTrace& trace) {
+                consume(trace, producer->index);
+            });
+
+        return total;
+    }
+
+    std::size_t Tracer::exportChromeTrace(std::string& out) {
+        auto first = true;
+
+        out.append(R"({"displayTimeUnit":"ns","traceEvents":[)");
+
+        auto count = drain([&](const RequestTrace& trace, const std::size_t tid) {
+            std::uint64_t begin = 0;
+            std::uint64_t end   = 0;
+
+            for (auto tick : trace.ticks) {
+                if (tick == 0) continue;
+
+                if (begin == 0) begin = tick;
+                end = tick;
+            }
+
+            appendSpan(out, first, "request", tid, begin, end);
+
+            forEachInterval(trace, [&](auto stage, auto from, auto to) {
+                appendSpan(out, first, INTERVAL_NAMES[stage], tid, from, to);
+            });
+        });
+
+        out.append("\n]}\n");
+
+        return count;
+    }
+
+    std::size_t Tracer::recordHistograms(Registry& registry) {
+        constexpr std::string_view name = "tws_stage_duration_seconds";
+        constexpr std::string_view help = "Time spent in each request stage";
+
+        // 注册表查找带锁，先把各阶段的直方图取出来
+        std::array<Histogram*, STAGE_COUNT> histograms{};
+
+        for (std::size_t i = 1; i < STAGE_COUNT; ++i) {
+            auto labels   = std::string(R"(stage=")").append(INTERVAL_NAMES[i]).append("\"");
+            histograms[i] = &registry.histogram(name, help, labels);
+        }
+
+        auto& total = registry.histogram(name, help, R"(stage="total")");
+        auto scale  = nanosPerTick();
+
+        auto nanos = [scale](auto from, auto to) {
+            return static_cast<std::uint64_t>(static_cast<double>(to - from) * scale);
+        };
+
+        return drain([&](const RequestTrace& trace, std::size_t) {
+            std::uint64_t begin = 0;
+            std::uint64_t end   = 0;
+
+            forEachInterval(trace, [&](auto stage, auto from, auto to) {
+                histograms[stage]->record(nanos(from, to));
+
+                if (begin == 0) begin = from;
+                end = to;
+            });
+
+            if (end > begin) total.record(nanos(begin, end));
+        });
+    }
+
+    void RequestTrace::commit() noexcept {
+        if (empty()) return;
+
+        auto& tracer   = Tracer::global();
+        auto* producer = tracer.producer();
+
+        if (!producer || !producer->ring.tryPush(*this)) tracer.dropped_.add();
+
+        reset();
+    }
+
+    bool RequestTrace::empty() const noexcept {
+        for (auto tick : ticks)
+            if (tick != 0) return false;
+
+        return true;
+    }
+
+}  // namespace tiny_web_server::metrics
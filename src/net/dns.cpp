@@ -0,0 +1,502 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file dns.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 23:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/net/dns.hpp"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace tiny_web_server::net {
+
+    namespace {
+
+        constexpr std::size_t HEADER_SIZE = 12;
+
+        constexpr std::uint16_t CLASS_IN = 1;
+
+        /// 压缩指针链的最大跳数，防止循环引用
+        constexpr int MAX_POINTERS = 16;
+
+        /// 跟随的 CNAME 链的最大长度，防止循环的别名
+        constexpr int MAX_CNAME_CHAIN = 8;
+
+        struct DnsCategory : std::error_category {
+            [[nodiscard]] const char* name() const noexcept override { return "dns"; }
+
+            [[nodiscard]] std::string message(const int value) const override {
+                switch (static_cast<DnsError>(value)) {
+                    case DnsError::NOT_FOUND: return "Host not found";
+                    case DnsError::TIMEOUT: return "Name server timed out";
+                    case DnsError::SERVER_FAILURE: return "Name server failure";
+                    case DnsError::INVALID_NAME: return "Invalid host name";
+                    default: return "Unknown DNS error";
+                }
+            }
+        };
+
+        std::string lowercase(const std::string_view text) {
+            std::string out{text};
+
+            for (auto& c : out)
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+
+            return out;
+        }
+
+        /// 去掉完全限定名结尾的点
+        std::string_view trimRoot(std::string_view name) noexcept {
+            if (name.ends_with('.')) name.remove_suffix(1);
+            return name;
+        }
+
+        /**
+         * @brief 应答报文的读取游标，所有读取都做边界检查
+         */
+        struct Reader {
+            std::span<const std::byte> data;
+
+            std::size_t offset = 0;
+
+            bool u16(std::uint16_t& value) noexcept {
+                if (offset + 2 > data.size()) return false;
+
+                value = static_cast<std::uint16_t>(
+                    std::to_integer<unsigned>(data[offset]) << 8
+                    | std::to_integer<unsigned>(data[offset + 1])
+                );
+                offset += 2;
+
+                return true;
+            }
+
+            bool u32(std::uint32_t& value) noexcept {
+                std::uint16_t high, low;
+                if (!u16(high) || !u16(low)) return false;
+
+                value = static_cast<std::uint32_t>(high) << 16 | low;
+                return true;
+            }
+
+            /**
+             * @brief 读取可能被压缩的域名，游标停在名称之后
+             * @param name 非空时写入小写、以点分隔的名称
+             */
+            bool readName(std::string* name) {
+                auto position = offset;
+                auto jumped   = false;
+                auto pointers = 0;
+
+                if (name) name->clear();
+
+                while (true) {
+                    if (position >= data.size()) return false;
+
+                    auto length = std::to_integer<std::size_t>(data[position]);
+
+                    // 压缩指针
+                    if ((length & 0xC0) == 0xC0) {
+                        if (position + 2 > data.size() || ++pointers > MAX_POINTERS)
+                            return false;
+
+                        auto target = (length & 0x3F) << 8
+                                    | std::to_integer<std::size_t>(data[position + 1]);
+
+                        if (!jumped) offset = position + 2;
+
+                        jumped   = true;
+                        position = target;
+                        continue;
+                    }
+
+                    if (length & 0xC0) return false;
+
+                    if (length == 0) {
+                        if (!jumped) offset = position + 1;
+                        return true;
+                    }
+
+                    if (position + 1 + length > data.size()) return false;
+
+                    if (name) {
+                        if (!name->empty()) name->push_back('.');
+
+                        auto label = data.subspan(position + 1, length);
+
+                        for (auto byte : label) {
+                            auto c = std::to_integer<char>(byte);
+                            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+
+                            name->push_back(c);
+                        }
+                    }
+
+                    position += 1 + length;
+                }
+            }
+        };
+
+    }  // namespace
+
+    const std::error_category& dnsCategory() noexcept {
+        static const DnsCategory category;
+        return category;
+    }
+
+    std::error_code make_error_code(const DnsError error) noexcept {
+        return {static_cast<int>(error), dnsCategory()};
+    }
+
+    std::optional<std::vector<std::byte>>
+    buildDnsQuery(const std::uint16_t id, std::string_view name, const DnsType type) {
+        name = trimRoot(name);
+
+        if (name.empty() || name.size() > 253) return std::nullopt;
+
+        std::vector<std::byte> query;
+        query.reserve(HEADER_SIZE + name.size() + 6);
+
+        auto push16 = [&](const std::uint16_t value) {
+            query.push_back(static_cast<std::byte>(value >> 8));
+            query.push_back(static_cast<std::byte>(value & 0xFF));
+        };
+
+        // 头部: ID、RD=1、一个问题
+        push16(id);
+        push16(0x0100);
+        push16(1);
+        push16(0);
+        push16(0);
+        push16(0);
+
+        while (!name.empty()) {
+            auto dot   = name.find('.');
+            auto label = name.substr(0, dot);
+
+            if (label.empty() || label.size() > 63) return std::nullopt;
+
+            query.push_back(static_cast<std::byte>(label.size()));
+
+            auto bytes = std::as_bytes(std::span{label});
+            query.insert(query.end(), bytes.begin(), bytes.end());
+
+            name = dot == std::string_view::npos ? std::string_view{} : name.substr(dot + 1);
+        }
+
+        query.push_back(std::byte{0});
+
+        push16(static_cast<std::uint16_t>(type));
+        push16(CLASS_IN);
+
+        return query;
+    }
+
+    std::optional<DnsAnswer> parseDnsResponse(
+        const std::span<const std::byte> message, const std::uint16_t id,
+        const std::string_view name, const DnsType type
+    ) {
+        Reader reader{message};
+
+        std::uint16_t responseId, flags, questions, answers, authorities, additional;
+
+        if (!reader.u16(responseId) || !reader.u16(flags) || !reader.u16(questions)
+            || !reader.u16(answers) || !reader.u16(authorities) || !reader.u16(additional))
+            return std::nullopt;
+
+        // 必须是对本查询的标准应答
+        if (responseId != id || (flags & 0x8000) == 0 || (flags & 0x7800) != 0
+            || questions != 1)
+            return std::nullopt;
+
+        std::string questionName;
+        std::uint16_t questionType, questionClass;
+
+        if (!reader.readName(&questionName) || !reader.u16(questionType)
+            || !reader.u16(questionClass))
+            return std::nullopt;
+
+        if (questionName != lowercase(trimRoot(name))
+            || questionType != static_cast<std::uint16_t>(type) || questionClass != CLASS_IN)
+            return std::nullopt;
+
+        DnsAnswer answer;
+
+        if (flags & 0x0200) {
+            answer.status = DnsAnswer::Status::TRUNCATED;
+            return answer;
+        }
+
+        switch (flags & 0x000F) {
+            case 0: break;
+            case 3: answer.status = DnsAnswer::Status::NOT_FOUND; break;
+            default: answer.status = DnsAnswer::Status::SERVER_FAILURE; return answer;
+        }
+
+        auto minimize = [&](const std::uint32_t ttl) {
+            answer.ttl = std::min(answer.ttl.value_or(ttl), ttl);
+        };
+
+        struct Record {
+            std::string owner;
+
+            std::uint16_t type;
+
+            std::uint32_t ttl;
+
+            std::span<const std::byte> data;
+        };
+
+        // 应答区中的地址与 CNAME，权威区中的 SOA 用于否定缓存
+        std::vector<Record> records;
+        std::optional<std::uint32_t> negativeTtl;
+
+        for (auto i = 0; i < answers + authorities; ++i) {
+            std::string owner;
+            std::uint16_t recordType, recordClass, length;
+            std::uint32_t ttl;
+
+            if (!reader.readName(&owner) || !reader.u16(recordType)
+                || !reader.u16(recordClass) || !reader.u32(ttl) || !reader.u16(length))
+                return std::nullopt;
+
+            if (reader.offset + length > message.size()) return std::nullopt;
+
+            auto data = message.subspan(reader.offset, length);
+            reader.offset += length;
+
+            if (recordClass != CLASS_IN) continue;
+
+            if (i >= answers) {
+                if (recordType != static_cast<std::uint16_t>(DnsType::SOA)) continue;
+
+                // SOA 的 RDATA: MNAME、RNAME，之后是5个32位整数，MINIMUM 在最后
+                if (length < 20) return std::nullopt;
+
+                Reader soa{message, reader.offset - 4};
+                std::uint32_t minimum;
+                if (!soa.u32(minimum)) return std::nullopt;
+
+                negativeTtl = std::min(ttl, minimum);
+                continue;
+            }
+
+            records.push_back({std::move(owner), recordType, ttl, data});
+        }
+
+        // 从问题名称出发跟随 CNAME 链，只采信属于链上名称的记录; 其余记录
+        // (如指向无关名称的地址)可能是缓存投毒，直接忽略
+        auto current = lowercase(trimRoot(name));
+
+        for (auto step = 0; step < MAX_CNAME_CHAIN; ++step) {
+            auto alias = std::ranges::find_if(records, [&](const Record& record) {
+                return record.type == static_cast<std::uint16_t>(DnsType::CNAME)
+                    && record.owner == current;
+            });
+
+            if (alias == records.end()) break;
+
+            // CNAME 的目标可能以压缩指针引用报文的其他部分，需在整个报文中读取
+            auto offset = static_cast<std::size_t>(alias->data.data() - message.data());
+            Reader target{message, offset};
+            if (!target.readName(&current)) return std::nullopt;
+
+            minimize(alias->ttl);
+        }
+
+        for (const auto& record : records) {
+            if (record.type != static_cast<std::uint16_t>(type) || record.owner != current)
+                continue;
+
+            auto ipv6 = type == DnsType::AAAA;
+            if (record.data.size() != (ipv6 ? 16u : 4u)) return std::nullopt;
+
+            answer.addresses.emplace_back(record.data, ipv6);
+            minimize(record.ttl);
+        }
+
+        if (answer.addresses.empty()) answer.ttl = negativeTtl;
+
+        return answer;
+    }
+
+    HostsFile HostsFile::parse(const std::string_view text) {
+        HostsFile hosts;
+        std::istringstream stream{std::string{text}};
+
+        for (std::string line; std::getline(stream, line);) {
+            if (auto comment = line.find('#'); comment != std::string::npos)
+                line.resize(comment);
+
+            std::istringstream fields{line};
+            std::string field;
+
+            if (!(fields >> field)) continue;
+
+            auto address = IpAddress::tryParse(field);
+            if (!address) continue;
+
+            while (fields >> field) {
+                auto& addresses = hosts.entries_[lowercase(trimRoot(field))];
+
+                if (std::ranges::find(addresses, *address) == addresses.end())
+                    addresses.push_back(*address);
+            }
+        }
+
+        return hosts;
+    }
+
+    HostsFile HostsFile::load(const std::filesystem::path& path) {
+        std::ifstream file{path};
+        if (!file) return {};
+
+        std::ostringstream text;
+        text << file.rdbuf();
+
+        return parse(text.str());
+    }
+
+    const std::vector<IpAddress>* HostsFile::find(const std::string_view name) const {
+        auto it = entries_.find(lowercase(trimRoot(name)));
+
+        return it == entries_.end() ? nullptr : &it->second;
+    }
+
+    std::size_t HostsFile::size() const noexcept { return entries_.size(); }
+
+    ResolvConf ResolvConf::parse(const std::string_view text) {
+        ResolvConf conf;
+        std::istringstream stream{std::string{text}};
+
+        auto option = [](std::string_view field, const std::string_view key, int& value) {
+            if (!field.starts_with(key)) return;
+
+            auto digits = field.substr(key.size());
+            std::from_chars(digits.data(), digits.data() + digits.size(), value);
+        };
+
+        for (std::string line; std::getline(stream, line);) {
+            std::istringstream fields{line};
+            std::string keyword, field;
+
+            if (!(fields >> keyword) || keyword.starts_with('#') || keyword.starts_with(';'))
+                continue;
+
+            if (keyword == "nameserver" && fields >> field) {
+                // 带作用域的链路本地地址(fe80::1%eth0)不受支持
+                if (auto address = IpAddress::tryParse(field))
+                    conf.nameservers.emplace_back(*address, 53);
+
+                continue;
+            }
+
+            if (keyword != "options") continue;
+
+            while (fields >> field) {
+                auto seconds = static_cast<int>(conf.timeout.count() / 1000);
+
+                option(field, "timeout:", seconds);
+                option(field, "attempts:", conf.attempts);
+
+                conf.timeout = std::chrono::seconds(std::clamp(seconds, 1, 30));
+            }
+        }
+
+        conf.attempts = std::clamp(conf.attempts, 1, 5);
+
+        if (conf.nameservers.empty())
+            conf.nameservers.emplace_back(IpAddress::loopback(), 53);
+
+        return conf;
+    }
+
+    ResolvConf ResolvConf::load(const std::filesystem::path& path) {
+        std::ifstream file{path};
+        if (!file) return parse({});
+
+        std::ostringstream text;
+        text << file.rdbuf();
+
+        return parse(text.str());
+    }
+
+    void happyEyeballsOrder(std::vector<IpAddress>& addresses) {
+        std::vector<IpAddress> ipv6, ipv4;
+
+        for (const auto& address : addresses)
+            (address.isIPv6() ? ipv6 : ipv4).push_back(address);
+
+        addresses.clear();
+
+        for (std::size_t i = 0; i < std::max(ipv6.size(), ipv4.size()); ++i) {
+            if (i < ipv6.size()) addresses.push_back(ipv6[i]);
+            if (i < ipv4.size()) addresses.push_back(ipv4[i]);
+        }
+    }
+
+    DnsCache::DnsCache(const std::size_t maxEntries)
+        : maxEntries_(maxEntries) {}
+
+    DnsCache& DnsCache::global() {
+        static DnsCache cache;
+        return cache;
+    }
+
+    std::optional<std::vector<IpAddress>>
+    DnsCache::find(const std::string_view name, const Clock::time_point now) {
+        std::lock_guard lock(mutex_);
+
+        auto it = entries_.find(lowercase(trimRoot(name)));
+        if (it == entries_.end()) return std::nullopt;
+
+        if (it->second.expires <= now) {
+            entries_.erase(it);
+            return std::nullopt;
+        }
+
+        return it->second.addresses;
+    }
+
+    void DnsCache::store(
+        const std::string_view name, std::vector<IpAddress> addresses,
+        const std::chrono::seconds ttl, const Clock::time_point now
+    ) {
+        if (ttl <= std::chrono::seconds::zero() || maxEntries_ == 0) return;
+
+        std::lock_guard lock(mutex_);
+
+        // 满时先清理过期项，仍然满则随意逐出一项
+        if (entries_.size() >= maxEntries_) {
+            std::erase_if(entries_, [&](const auto& entry) {
+                return entry.second.expires <= now;
+            });
+
+            if (entries_.size() >= maxEntries_) entries_.erase(entries_.begin());
+        }
+
+        entries_[lowercase(trimRoot(name))] = {std::move(addresses), now + ttl};
+    }
+
+    void DnsCache::clear() {
+        std::lock_guard lock(mutex_);
+        entries_.clear();
+    }
+
+    std::size_t DnsCache::size() const {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+}  // namespace tiny_web_server::net
@@ -15,31 +15,198 @@
  * */
 #include "../../include/tws/net/endpoint.hpp"
 #include "tws/exception.hpp"
+#include <charconv>
+#include <cstddef>
+#include <cstring>
 
 namespace tiny_web_server::net {
 
+    namespace {
+
+        constexpr std::size_t MAX_PATH_LENGTH = sizeof(sockaddr_un::sun_path);
+
+    }  // namespace
+
     Endpoint::Endpoint(const IpAddress& address, const std::uint16_t port)
         : address_(address)
         , port_(port) {}
 
     Endpoint::Endpoint(const std::string_view str) {
-        auto pos = str.find_last_of(':');
-        if (pos == std::string::npos)
-            throw SocketError<"Invalid endpoint format, expected 'ip:port'"_s>();
+        if (str.starts_with("unix:")) {
+            auto path = str.substr(5);
+
+            if (path.starts_with('@'))
+                *this = abstractSocket(path.substr(1));
+            else
+                *this = unixSocket(path);
+
+            return;
+        }
+
+        auto [host, port] = splitHostPort(str);
+
+        address_ = IpAddress{host};
+        port_    = port;
+    }
+
+    Endpoint Endpoint::unixSocket(const std::string_view path) {
+        if (path.empty() || path.size() >= MAX_PATH_LENGTH)
+            throw SocketError<>(std::format("Invalid unix socket path: '{}'", path));
+
+        Endpoint endpoint;
+        endpoint.path_ = path;
+
+        return endpoint;
+    }
+
+    Endpoint Endpoint::abstractSocket(const std::string_view name) {
+        if (name.size() >= MAX_PATH_LENGTH)
+            throw SocketError<>(std::format("Abstract socket name too long: '{}'", name));
+
+        Endpoint endpoint;
+        endpoint.path_.reserve(name.size() + 1);
+        endpoint.path_.push_back('\0');
+        endpoint.path_.append(name);
 
-        address_ = IpAddress{str.substr(0, pos)};
-        port_    = std::stoi(std::string(str.substr(pos + 1)));
+        return endpoint;
+    }
+
+    Endpoint Endpoint::fromNative(const sockaddr_storage& storage, const socklen_t length) {
+        switch (storage.ss_family) {
+            // IPv6
+            case AF_INET6: {
+                const auto& addr = reinterpret_cast<const sockaddr_in6&>(storage);
+                auto bytes       = std::as_bytes(std::span{&addr.sin6_addr, 1});
+
+                return {IpAddress{bytes, true}, ntohs(addr.sin6_port)};
+            }
+
+            // IPv4
+            case AF_INET: {
+                const auto& addr = reinterpret_cast<const sockaddr_in&>(storage);
+                auto bytes       = std::as_bytes(std::span{&addr.sin_addr, 1});
+
+                return {IpAddress{bytes}, ntohs(addr.sin_port)};
+            }
+
+            // Unix
+            case AF_UNIX: {
+                const auto& addr = reinterpret_cast<const sockaddr_un&>(storage);
+                auto offset      = offsetof(sockaddr_un, sun_path);
+
+                Endpoint endpoint;
 
-        if (port_ < 0 || port_ > 65535)
-            throw SocketError<>(std::format("Invalid port number: {}", port_));
+                // 未绑定的客户端套接字没有路径
+                if (static_cast<std::size_t>(length) <= offset) return endpoint;
+
+                auto size = static_cast<std::size_t>(length) - offset;
+
+                // 文件系统路径以 '\0' 结尾，抽象名称则完全由长度决定
+                if (addr.sun_path[0] != '\0') size = strnlen(addr.sun_path, size);
+
+                endpoint.path_.assign(addr.sun_path, size);
+
+                return endpoint;
+            }
+
+            default: throw SocketError<"Unsupported address family"_s>();
+        }
     }
 
     const IpAddress& Endpoint::address() const noexcept { return address_; }
 
     std::uint16_t Endpoint::port() const noexcept { return port_; }
 
+    const std::string& Endpoint::path() const noexcept { return path_; }
+
+    bool Endpoint::isUnix() const noexcept { return !path_.empty(); }
+
+    bool Endpoint::isAbstract() const noexcept { return !path_.empty() && path_[0] == '\0'; }
+
+    AddressFamily Endpoint::family() const noexcept {
+        if (isUnix()) return AddressFamily::UNIX;
+
+        return address_.isIPv6() ? AddressFamily::IPv6 : AddressFamily::IPv4;
+    }
+
+    socklen_t Endpoint::toNative(sockaddr_storage& storage) const {
+        storage = {};
+
+        // Unix
+        if (isUnix()) {
+            auto& addr      = reinterpret_cast<sockaddr_un&>(storage);
+            addr.sun_family = AF_UNIX;
+
+            std::memcpy(addr.sun_path, path_.data(), path_.size());
+
+            // 抽象名称的长度不含结尾的 '\0'
+            return static_cast<socklen_t>(
+                offsetof(sockaddr_un, sun_path) + path_.size() + (isAbstract() ? 0 : 1)
+            );
+        }
+
+        const auto address = address_.getAddress();
+
+        // IPv6
+        if (const auto* ipv6 = std::get_if<in6_addr>(&address)) {
+            auto& addr       = reinterpret_cast<sockaddr_in6&>(storage);
+            addr.sin6_family = AF_INET6;
+            addr.sin6_port   = htons(port_);
+            addr.sin6_addr   = *ipv6;
+
+            return sizeof(sockaddr_in6);
+        }
+
+        // IPv4
+        auto& addr      = reinterpret_cast<sockaddr_in&>(storage);
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(port_);
+        addr.sin_addr   = std::get<in_addr>(address);
+
+        return sizeof(sockaddr_in);
+    }
+
     std::string Endpoint::toString() const {
+        if (isAbstract()) return std::format("unix:@{}", std::string_view{path_}.substr(1));
+
+        if (isUnix()) return std::format("unix:{}", path_);
+
+        if (address_.isIPv6()) return std::format("[{}]:{}", address_.toString(), port_);
+
         return std::format("{}:{}", address_.toString(), port_);
     }
 
+    std::pair<std::string_view, std::uint16_t> splitHostPort(const std::string_view str) {
+        std::string_view host;
+        std::size_t pos;
+
+        // [ipv6]:port
+        if (str.starts_with('[')) {
+            auto close = str.find(']');
+
+            if (close == std::string_view::npos || str.substr(close + 1, 1) != ":")
+                throw SocketError<"Invalid endpoint format, expected '[ipv6]:port'"_s>();
+
+            host = str.substr(1, close - 1);
+            pos  = close + 1;
+        } else {
+            pos = str.find_last_of(':');
+            if (pos == std::string_view::npos)
+                throw SocketError<"Invalid endpoint format, expected 'ip:port'"_s>();
+
+            host = str.substr(0, pos);
+        }
+
+        auto digits   = str.substr(pos + 1);
+        unsigned port = 0;
+
+        auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), port);
+
+        if (ec != std::errc{} || end != digits.data() + digits.size() || digits.empty()
+            || port > 65535)
+            throw SocketError<>(std::format("Invalid port number: '{}'", digits));
+
+        return {host, static_cast<std::uint16_t>(port)};
+    }
+
 }  // namespace tiny_web_server::net
@@ -0,0 +1,387 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file handoff.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 17:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/net/handoff.hpp"
+#include "tws/exception.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+namespace tiny_web_server::net {
+
+    namespace {
+
+        /// 单条消息可携带的最大句柄数(内核 SCM_MAX_FD)
+        constexpr std::size_t MAX_HANDOFF_SOCKETS = 253;
+
+        /// systemd 传入的第一个句柄(SD_LISTEN_FDS_START)
+        constexpr int LISTEN_FDS_START = 3;
+
+        /// 新实例确认就绪的消息
+        constexpr std::byte READY{'R'};
+
+        std::string defaultName(const Socket& socket) {
+            try {
+                return socket.localEndpoint().toString();
+            } catch (const std::system_error&) { return {}; }
+        }
+
+        template<typename T>
+        bool parseNumber(const std::string_view str, T& value) noexcept {
+            auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+
+            return ec == std::errc{} && ptr == str.data() + str.size();
+        }
+
+    }  // namespace
+
+    void sendListeners(const Socket& channel, std::span<const ListenSocket> listeners) {
+#if WEB_SERVER_WINDOWS
+        throw SocketError<"SCM_RIGHTS is not supported on this platform"_s>();
+#else
+        if (listeners.empty() || listeners.size() > MAX_HANDOFF_SOCKETS)
+            throw SocketError<>(
+                std::format("Cannot hand off {} listening sockets", listeners.size())
+            );
+
+        // 名称以 '\n' 结尾依次排列，与句柄一一对应
+        std::string names;
+        for (const auto& [name, socket] : listeners) {
+            if (name.contains('\n'))
+                throw SocketError<"Listening socket name must not contain newlines"_s>();
+
+            names.append(name).push_back('\n');
+        }
+
+        const auto size = listeners.size() * sizeof(int);
+        std::vector<cmsghdr> control(
+            (CMSG_SPACE(size) + sizeof(cmsghdr) - 1) / sizeof(cmsghdr)
+        );
+
+        iovec io{names.data(), names.size()};
+
+        msghdr message{};
+        message.msg_iov        = &io;
+        message.msg_iovlen     = 1;
+        message.msg_control    = control.data();
+        message.msg_controllen = CMSG_SPACE(size);
+
+        auto* header       = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type  = SCM_RIGHTS;
+        header->cmsg_len   = CMSG_LEN(size);
+
+        auto* handles = reinterpret_cast<int*>(CMSG_DATA(header));
+        for (std::size_t i = 0; i < listeners.size(); ++i) {
+            auto handle = listeners[i].socket.nativeHandle();
+            std::memcpy(handles + i, &handle, sizeof(int));
+        }
+
+        if (::sendmsg(channel.nativeHandle(), &message, NET_NOSIGNAL) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to send listening sockets");
+#endif
+    }
+
+    ListenSockets receiveListeners(const Socket& channel) {
+#if WEB_SERVER_WINDOWS
+        throw SocketError<"SCM_RIGHTS is not supported on this platform"_s>();
+#else
+        std::string names(MAX_HANDOFF_SOCKETS * (sizeof(sockaddr_un::sun_path) + 8), '\0');
+
+        constexpr auto size = CMSG_SPACE(MAX_HANDOFF_SOCKETS * sizeof(int));
+        std::vector<cmsghdr> control((size + sizeof(cmsghdr) - 1) / sizeof(cmsghdr));
+
+        iovec io{names.data(), names.size()};
+
+        msghdr message{};
+        message.msg_iov        = &io;
+        message.msg_iovlen     = 1;
+        message.msg_control    = control.data();
+        message.msg_controllen = size;
+
+        auto received = ::recvmsg(channel.nativeHandle(), &message, MSG_CMSG_CLOEXEC);
+        if (received < 0)
+            throw SocketError<>(NET_ERROR, "Failed to receive listening sockets");
+
+        // 先接管所有句柄，出错时随之关闭
+        std::vector<Socket> sockets;
+
+        for (auto* header = CMSG_FIRSTHDR(&message); header;
+             header       = CMSG_NXTHDR(&message, header)) {
+            if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS)
+                continue;
+
+            auto count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (std::size_t i = 0; i < count; ++i) {
+                int handle;
+                std::memcpy(&handle, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+                sockets.push_back(Socket::adopt(handle));
+            }
+        }
+
+        if (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+            throw SocketError<"Listening socket handoff message truncated"_s>();
+
+        names.resize(static_cast<std::size_t>(received));
+
+        ListenSockets listeners;
+        listeners.reserve(sockets.size());
+
+        std::string_view rest{names};
+        for (auto& socket : sockets) {
+            auto end = rest.find('\n');
+            if (end == std::string_view::npos)
+                throw SocketError<"Listening socket handoff names mismatch"_s>();
+
+            listeners.push_back({std::string{rest.substr(0, end)}, std::move(socket)});
+            rest.remove_prefix(end + 1);
+        }
+
+        return listeners;
+#endif
+    }
+
+    ListenSockets inheritedListeners() {
+        ListenSockets listeners;
+
+#if WEB_SERVER_LINUX
+        const char* pid   = std::getenv("LISTEN_PID");
+        const char* fds   = std::getenv("LISTEN_FDS");
+        const char* names = std::getenv("LISTEN_FDNAMES");
+
+        int count = 0;
+
+        // 环境变量可能是为其他进程设置的，只认领 LISTEN_PID 指向自身的句柄
+        if (pid_t owner = 0; pid && fds && parseNumber(pid, owner) && owner == getpid())
+            parseNumber(fds, count);
+
+        std::string_view rest = names ? names : "";
+
+        for (auto i = 0; i < count; ++i) {
+            auto handle = LISTEN_FDS_START + i;
+            fcntl(handle, F_SETFD, FD_CLOEXEC);
+
+            auto end  = rest.find(':');
+            auto name = rest.substr(0, end);
+            rest      = end == std::string_view::npos ? "" : rest.substr(end + 1);
+
+            auto socket = Socket::adopt(handle);
+
+            // systemd 未指定 FileDescriptorName 时名称为 "unknown"
+            auto label = name.empty() || name == "unknown" ? defaultName(socket)
+                                                           : std::string{name};
+
+            listeners.push_back({std::move(label), std::move(socket)});
+        }
+
+        unsetenv("LISTEN_PID");
+        unsetenv("LISTEN_FDS");
+        unsetenv("LISTEN_FDNAMES");
+#endif
+
+        return listeners;
+    }
+
+    Socket takeListener(ListenSockets& inherited, const Endpoint& endpoint) {
+        const auto key = endpoint.toString();
+
+        for (auto it = inherited.begin(); it != inherited.end(); ++it) {
+            if (it->name != key && defaultName(it->socket) != key) continue;
+
+            auto socket = std::move(it->socket);
+            inherited.erase(it);
+
+            return socket;
+        }
+
+        Socket socket(endpoint.family(), SocketType::STREAM);
+
+        if (!endpoint.isUnix()) socket.setOptions({.reuse_address = true});
+
+        socket.bind(endpoint);
+        socket.listen();
+
+        return socket;
+    }
+
+    Drainer::Guard::Guard(Drainer& drainer)
+        : drainer_(&drainer) {
+        std::lock_guard lock(drainer_->mutex_);
+        ++drainer_->active_;
+    }
+
+    Drainer::Guard::~Guard() {
+        if (!drainer_) return;
+
+        std::lock_guard lock(drainer_->mutex_);
+        if (--drainer_->active_ == 0) drainer_->idle_.notify_all();
+    }
+
+    Drainer::Guard::Guard(Guard&& other) noexcept
+        : drainer_(std::exchange(other.drainer_, nullptr)) {}
+
+    Drainer::Guard Drainer::track() { return Guard{*this}; }
+
+    void Drainer::start() {
+        std::lock_guard lock(mutex_);
+        draining_ = true;
+    }
+
+    bool Drainer::draining() const {
+        std::lock_guard lock(mutex_);
+        return draining_;
+    }
+
+    std::size_t Drainer::active() const {
+        std::lock_guard lock(mutex_);
+        return active_;
+    }
+
+    bool Drainer::wait(const std::chrono::milliseconds timeout) {
+        std::unique_lock lock(mutex_);
+        return idle_.wait_for(lock, timeout, [this] { return active_ == 0; });
+    }
+
+    HotRestart::HotRestart(Endpoint control)
+        : control_(std::move(control)) {}
+
+    HotRestart::~HotRestart() {
+        if (!reactor_) return;
+
+        if (listener_.isValid()) reactor_->remove(listener_.nativeHandle());
+
+        if (peer_.isValid()) reactor_->remove(peer_.nativeHandle());
+    }
+
+    ListenSockets HotRestart::acquire() {
+        if (auto listeners = inheritedListeners(); !listeners.empty()) return listeners;
+
+        Socket channel(AddressFamily::UNIX, SocketType::SEQPACKET);
+
+        // 没有正在运行的旧实例，冷启动
+        try {
+            channel.connect(control_);
+        } catch (const std::system_error&) { return {}; }
+
+        channel.setOptions({.receive_timeout_ms = 5000});
+
+        auto listeners = receiveListeners(channel);
+        channel_       = std::move(channel);
+
+        return listeners;
+    }
+
+    void HotRestart::ready() {
+        if (!channel_.isValid()) return;
+
+        // 旧实例收到后停止接受连接; 旧实例已退出时忽略
+        [[maybe_unused]] auto sent = channel_.trySend(std::span{&READY, 1});
+
+        channel_.close();
+    }
+
+    void HotRestart::serve(
+        async::Reactor& reactor, const std::span<const ListenSocket> listeners,
+        HandoffCallback onHandoff
+    ) {
+        reactor_   = &reactor;
+        listeners_ = listeners;
+        onHandoff_ = std::move(onHandoff);
+
+        listen();
+    }
+
+    pid_t HotRestart::spawn(char* const argv[]) {
+        auto pid = fork();
+        if (pid < 0) throw SocketError<>(NET_ERROR, "Failed to fork new instance");
+
+        if (pid == 0) {
+            execvp(argv[0], argv);
+            _exit(127);
+        }
+
+        return pid;
+    }
+
+    void HotRestart::listen() {
+        listener_ = Socket(AddressFamily::UNIX, SocketType::SEQPACKET);
+        listener_.bind(control_);
+        listener_.listen(1);
+        listener_.setNonBlocking();
+
+        reactor_->add(listener_.nativeHandle(), async::EventType::READ, [this](auto) {
+            onAccept();
+        });
+    }
+
+    void HotRestart::onAccept() {
+        auto handle = ::accept4(listener_.nativeHandle(), nullptr, nullptr, SOCK_CLOEXEC);
+        if (handle == NET_INVALID_SOCKET) return;
+
+        auto peer = Socket::adopt(handle);
+
+        // 抽象命名空间没有文件权限，只把监听套接字交给同一用户的进程;
+        // 其他连接直接关闭，控制端点继续监听
+        try {
+            if (peer.peerCredentials().uid != geteuid()) return;
+        } catch (const std::system_error&) { return; }
+
+        // 一次只交接给一个新实例; 同时释放控制端点，让新实例可以接着监听
+        reactor_->remove(listener_.nativeHandle());
+        listener_.close();
+
+        try {
+            sendListeners(peer, listeners_);
+        } catch (const std::system_error&) {
+            listen();
+            return;
+        }
+
+        peer_ = std::move(peer);
+        peer_.setNonBlocking();
+
+        reactor_->add(
+            peer_.nativeHandle(), async::EventType::READ | async::EventType::HANGUP,
+            [this](auto events) { onPeer(events); }
+        );
+    }
+
+    void HotRestart::onPeer(async::EventType) {
+        std::byte message{};
+
+        std::optional<std::size_t> received;
+        try {
+            received = peer_.tryRecv(std::span{&message, 1});
+        } catch (const std::system_error&) { received = 0; }
+
+        if (!received) return;
+
+        closePeer();
+
+        if (*received == 1 && message == READY) {
+            onHandoff_();
+            return;
+        }
+
+        // 新实例在就绪前退出，继续由本实例服务
+        listen();
+    }
+
+    void HotRestart::closePeer() {
+        reactor_->remove(peer_.nativeHandle());
+        peer_.close();
+    }
+
+}  // namespace tiny_web_server::net
@@ -15,21 +15,39 @@
  * */
 #include "tws/net/ip_address.hpp"
 #include "tws/exception.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
 
 namespace tiny_web_server::net {
 
     IpAddress::IpAddress(const std::string_view str) {
+        auto parsed = tryParse(str);
+        if (!parsed) throw SocketError<"Ip address parsing error"_s>();
+
+        *this = *parsed;
+    }
+
+    std::optional<IpAddress> IpAddress::tryParse(std::string_view str) {
+        // 允许 [::1] 形式的 IPv6 字面量
+        if (str.size() > 2 && str.front() == '[' && str.back() == ']')
+            str = str.substr(1, str.size() - 2);
+
+        // inet_pton 需要以 '\0' 结尾的字符串
+        const std::string text{str};
+
         // IPv6
-        if (str.contains(":")) {
-            if (in6_addr addr{}; inet_pton(AF_INET6, str.data(), &addr) == 1)
-                address_ = addr;
+        if (text.contains(':')) {
+            if (in6_addr addr{}; inet_pton(AF_INET6, text.c_str(), &addr) == 1)
+                return IpAddress{addr};
         }
 
         // IPv4
-        else if (in_addr addr{}; inet_pton(AF_INET, str.data(), &addr) == 1)
-            address_ = addr;
+        else if (in_addr addr{}; inet_pton(AF_INET, text.c_str(), &addr) == 1) {
+            return IpAddress{addr};
+        }
 
-        throw SocketError<"Ip address parsing error"_s>();
+        return std::nullopt;
     }
 
     IpAddress::IpAddress(const std::span<const std::byte> bytes, const bool ipv6) {
@@ -69,25 +87,39 @@ namespace tiny_web_server::net {
     }
 
     std::vector<std::byte> IpAddress::toBytes() const {
-        std::vector<std::byte> bytes;
+        auto data = bytes();
 
-        // IPv4
-        if (std::holds_alternative<in_addr>(address_)) {
-            const auto* data =
-                reinterpret_cast<const std::byte*>(&std::get<in_addr>(address_));
+        return {data.begin(), data.end()};
+    }
 
-            bytes.assign(data, data + 4);
-        }
+    std::span<const std::byte> IpAddress::bytes() const noexcept {
+        // IPv4
+        if (const auto* ipv4 = std::get_if<in_addr>(&address_))
+            return std::as_bytes(std::span{ipv4, 1});
 
         // IPv6
-        else if (std::holds_alternative<in6_addr>(address_)) {
-            const auto* data =
-                reinterpret_cast<const std::byte*>(&std::get<in6_addr>(address_));
+        return std::as_bytes(std::span{&std::get<in6_addr>(address_), 1});
+    }
+
+    IpAddress IpAddress::masked(const int prefixLength) const {
+        auto data = bytes();
+
+        // ::ffff:a.b.c.d
+        constexpr std::byte MAPPED[12]{
+            {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, std::byte{0xff}, std::byte{0xff}
+        };
+
+        if (data.size() == 16 && std::equal(data.begin(), data.begin() + 12, MAPPED))
+            data = data.subspan(12);
+
+        std::array<std::byte, 16> result{};
 
-            bytes.assign(data, data + 16);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            auto bits = std::clamp(prefixLength - static_cast<int>(i) * 8, 0, 8);
+            result[i] = data[i] & static_cast<std::byte>(0xff00 >> bits);
         }
 
-        return bytes;
+        return {std::span{result}.first(data.size()), data.size() == 16};
     }
 
     bool IpAddress::isIPv4() const noexcept {
@@ -104,7 +136,7 @@ namespace tiny_web_server::net {
 
         // IPv4
         in_addr addr{};
-        addr.s_addr = INADDR_ANY;
+        addr.s_addr = htonl(INADDR_ANY);
 
         return addr;
     }
@@ -115,7 +147,7 @@ namespace tiny_web_server::net {
 
         // IPv4
         in_addr addr{};
-        addr.s_addr = INADDR_LOOPBACK;
+        addr.s_addr = htonl(INADDR_LOOPBACK);
 
         return addr;
     }
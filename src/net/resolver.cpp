@@ -0,0 +1,359 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file resolver.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 23:55
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/net/resolver.hpp"
+#include <algorithm>
+
+namespace tiny_web_server::net {
+
+    namespace {
+
+        /// 常见的 UDP 应答都不超过 512 字节，开启 EDNS 的服务器也很少超过 4096
+        constexpr std::size_t MAX_MESSAGE_SIZE = 4096;
+
+        constexpr DnsType TYPES[2]{DnsType::A, DnsType::AAAA};
+
+        /// 随机源端口的范围，避开特权端口
+        constexpr std::uint16_t MIN_SOURCE_PORT = 1024;
+
+        /// 随机端口被占用时的重试次数，之后交给内核分配
+        constexpr int BIND_ATTEMPTS = 8;
+
+        std::string normalize(std::string_view name) {
+            if (name.ends_with('.')) name.remove_suffix(1);
+
+            std::string out{name};
+
+            for (auto& c : out)
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+
+            return out;
+        }
+
+        std::vector<Endpoint>
+        toEndpoints(const std::vector<IpAddress>& addresses, const std::uint16_t port) {
+            std::vector<Endpoint> endpoints;
+            endpoints.reserve(addresses.size());
+
+            for (const auto& address : addresses) endpoints.emplace_back(address, port);
+
+            return endpoints;
+        }
+
+    }  // namespace
+
+    ResolverOptions ResolverOptions::system() {
+        auto conf = ResolvConf::load();
+
+        ResolverOptions options;
+        options.nameservers = std::move(conf.nameservers);
+        options.timeout     = conf.timeout;
+        options.attempts    = conf.attempts;
+        options.hosts       = HostsFile::load();
+
+        return options;
+    }
+
+    Resolver::Resolver(async::Reactor& reactor, ResolverOptions options, DnsCache& cache)
+        : reactor_(reactor)
+        , options_(std::move(options))
+        , cache_(cache)
+        , random_(std::random_device{}()) {
+        if (options_.nameservers.empty())
+            options_.nameservers.emplace_back(IpAddress::loopback(), 53);
+    }
+
+    Resolver::~Resolver() {
+        for (auto& [name, lookup] : lookups_)
+            for (auto family = 0; family < 2; ++family) close(lookup, family);
+    }
+
+    void Resolver::resolve(
+        const std::string_view host, const std::uint16_t port, Callback callback
+    ) {
+        auto now = Clock::now();
+
+        auto deliver = [&](std::vector<IpAddress> addresses) {
+            if (addresses.empty()) return callback(DnsError::NOT_FOUND, {});
+
+            callback({}, toEndpoints(addresses, port));
+        };
+
+        if (auto literal = IpAddress::tryParse(host)) return deliver({*literal});
+
+        if (const auto* addresses = options_.hosts.find(host)) {
+            auto ordered = *addresses;
+            happyEyeballsOrder(ordered);
+
+            return deliver(std::move(ordered));
+        }
+
+        if (auto cached = cache_.find(host, now)) return deliver(std::move(*cached));
+
+        auto name = normalize(host);
+
+        // 同一名称已有进行中的查询
+        if (auto it = lookups_.find(name); it != lookups_.end()) {
+            it->second.waiters.emplace_back(port, std::move(callback));
+            return;
+        }
+
+        if (!buildDnsQuery(0, name, DnsType::A)) return callback(DnsError::INVALID_NAME, {});
+
+        Lookup lookup;
+        lookup.name    = name;
+        lookup.done[1] = !options_.ipv6;
+        lookup.waiters.emplace_back(port, std::move(callback));
+
+        send(lookups_.emplace(name, std::move(lookup)).first->second, now);
+    }
+
+    void Resolver::resolve(const std::string_view hostPort, Callback callback) {
+        auto [host, port] = splitHostPort(hostPort);
+
+        resolve(host, port, std::move(callback));
+    }
+
+    std::optional<Resolver::Clock::time_point>
+    Resolver::expire(const Clock::time_point now) {
+        std::vector<std::string> due, retry;
+
+        for (const auto& [name, lookup] : lookups_) {
+            if (lookup.delayUntil && *lookup.delayUntil <= now)
+                due.push_back(name);
+            else if (lookup.deadline <= now)
+                retry.push_back(name);
+        }
+
+        for (const auto& name : due) finish(name);
+
+        // 换到下一个名称服务器重发未应答的查询，次数用完时以已有结果结束
+        auto tries = static_cast<int>(options_.nameservers.size()) * options_.attempts;
+
+        for (const auto& name : retry) {
+            auto it = lookups_.find(name);
+            if (it == lookups_.end()) continue;
+
+            auto& lookup = it->second;
+
+            if (++lookup.attempt >= tries) {
+                finish(name);
+                continue;
+            }
+
+            lookup.server = (lookup.server + 1) % options_.nameservers.size();
+            send(lookup, now);
+        }
+
+        std::optional<Clock::time_point> next;
+
+        for (const auto& [name, lookup] : lookups_) {
+            auto at = lookup.delayUntil ? std::min(*lookup.delayUntil, lookup.deadline)
+                                        : lookup.deadline;
+
+            next = next ? std::min(*next, at) : at;
+        }
+
+        return next;
+    }
+
+    std::size_t Resolver::pending() const noexcept { return lookups_.size(); }
+
+    void Resolver::send(Lookup& lookup, const Clock::time_point now) {
+        lookup.deadline = now + options_.timeout;
+
+        std::uniform_int_distribution<unsigned> ids(0, 0xFFFF);
+
+        for (auto family = 0; family < 2; ++family) {
+            if (lookup.done[family]) continue;
+
+            // 重传也换新的端口与 ID，上一次尝试迟到的应答随旧套接字一起丢弃
+            close(lookup, family);
+
+            lookup.ids[family] = static_cast<std::uint16_t>(ids(random_));
+
+            auto query = buildDnsQuery(lookup.ids[family], lookup.name, TYPES[family]);
+
+            // 创建或发送失败(如网络不可达)等同于丢包，由超时处理
+            try {
+                lookup.sockets[family] = open(lookup.name, family, lookup.server);
+                (void)lookup.sockets[family].trySend(*query);
+            } catch (const std::system_error&) {}
+        }
+    }
+
+    Socket
+    Resolver::open(const std::string& name, const int family, const std::size_t server) {
+        const auto& nameserver = options_.nameservers[server];
+        auto ipv6              = nameserver.address().isIPv6();
+
+        Socket socket{nameserver.family(), SocketType::DGRAM, Protocol::UDP};
+        socket.setNonBlocking();
+
+        // 源端口自行随机选取，不依赖内核的临时端口分配策略
+        std::uniform_int_distribution<unsigned> ports(MIN_SOURCE_PORT, 0xFFFF);
+        auto bound = false;
+
+        for (auto attempt = 0; attempt < BIND_ATTEMPTS && !bound; ++attempt) {
+            try {
+                auto port = static_cast<std::uint16_t>(ports(random_));
+
+                socket.bind({IpAddress::any(ipv6), port});
+                bound = true;
+            } catch (const std::system_error&) {}
+        }
+
+        if (!bound) socket.bind({IpAddress::any(ipv6), 0});
+
+        // 已连接的 UDP 套接字只接收来自该服务器的应答
+        socket.connect(nameserver);
+
+        reactor_.add(
+            socket.nativeHandle(), async::EventType::READ,
+            [this, name, family](auto) { readable(name, family); }
+        );
+
+        return socket;
+    }
+
+    void Resolver::close(Lookup& lookup, const int family) {
+        auto& socket = lookup.sockets[family];
+        if (!socket.isValid()) return;
+
+        reactor_.remove(socket.nativeHandle());
+        socket = Socket{};
+    }
+
+    void Resolver::readable(const std::string& name, const int family) {
+        std::byte buffer[MAX_MESSAGE_SIZE];
+
+        while (true) {
+            // 回调可能已结束该查询，每次都重新查找
+            auto it = lookups_.find(name);
+            if (it == lookups_.end()) return;
+
+            auto& lookup = it->second;
+            auto& socket = lookup.sockets[family];
+
+            if (lookup.done[family] || !socket.isValid()) return;
+
+            std::optional<std::size_t> received;
+
+            try {
+                received = socket.tryRecv(buffer);
+            } catch (const std::system_error& error) {
+                // ICMP 端口不可达以 ECONNREFUSED 的形式出现: 该服务器不可用，立即换下一个
+                if (error.code() == std::errc::connection_refused) {
+                    lookup.deadline = Clock::now();
+                    continue;
+                }
+
+                // 其他错误不会因为继续读取而消失，交给超时处理
+                return;
+            }
+
+            if (!received) return;
+
+            auto message = std::span{buffer}.first(*received);
+            auto id      = lookup.ids[family];
+            auto answer  = parseDnsResponse(message, id, name, TYPES[family]);
+
+            // 格式错误或与问题不匹配的报文视为伪造，继续等待
+            if (!answer) continue;
+
+            auto now = Clock::now();
+
+            switch (answer->status) {
+                case DnsAnswer::Status::NOT_FOUND: {
+                    lookup.notFound = lookup.done[0] = lookup.done[1] = true;
+                    lookup.ttl      = answer->ttl;
+                    break;
+                }
+
+                case DnsAnswer::Status::OK: {
+                    lookup.done[family]      = true;
+                    lookup.addresses[family] = std::move(answer->addresses);
+
+                    if (answer->ttl)
+                        lookup.ttl = std::min(lookup.ttl.value_or(UINT32_MAX), *answer->ttl);
+                    break;
+                }
+
+                // 另一地址族已有结果时放弃该地址族，否则立即换下一个服务器
+                default: {
+                    lookup.failed = true;
+
+                    if (!lookup.addresses[1 - family].empty()) {
+                        lookup.done[family] = true;
+                        break;
+                    }
+
+                    lookup.deadline = now;
+                    continue;
+                }
+            }
+
+            if (lookup.done[0] && lookup.done[1]) {
+                finish(name);
+                continue;
+            }
+
+            // 已有结论的地址族不再读取，重复的应答不能让水平触发的事件一直就绪
+            close(lookup, family);
+
+            // 只差 AAAA 时最多再等一个 Resolution Delay
+            if (family == 0 && !lookup.delayUntil)
+                lookup.delayUntil = now + options_.resolutionDelay;
+        }
+    }
+
+    void Resolver::finish(const std::string& name) {
+        auto it = lookups_.find(name);
+        if (it == lookups_.end()) return;
+
+        auto lookup = std::move(it->second);
+        lookups_.erase(it);
+
+        for (auto family = 0; family < 2; ++family) close(lookup, family);
+
+        auto addresses = std::move(lookup.addresses[1]);
+        auto& ipv4     = lookup.addresses[0];
+        addresses.insert(addresses.end(), ipv4.begin(), ipv4.end());
+        happyEyeballsOrder(addresses);
+
+        auto complete = lookup.done[0] && lookup.done[1];
+
+        std::error_code error;
+
+        if (addresses.empty()) {
+            if (lookup.notFound || (complete && !lookup.failed))
+                error = DnsError::NOT_FOUND;
+            else
+                error = lookup.failed ? DnsError::SERVER_FAILURE : DnsError::TIMEOUT;
+        }
+
+        // 只缓存完整的结论: 成功解析或确认不存在
+        if (complete && (!addresses.empty() || error == DnsError::NOT_FOUND)) {
+            auto fallback = addresses.empty() ? options_.negativeTtl : options_.maxTtl;
+            auto ttl      = lookup.ttl ? std::chrono::seconds(*lookup.ttl) : fallback;
+
+            cache_.store(lookup.name, addresses, std::min(ttl, options_.maxTtl));
+        }
+
+        for (auto& [port, callback] : lookup.waiters)
+            callback(error, toEndpoints(addresses, port));
+    }
+
+}  // namespace tiny_web_server::net
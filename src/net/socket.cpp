@@ -15,64 +15,117 @@
  * */
 #include "tws/net/socket.hpp"
 #include "tws/exception.hpp"
+#include "tws/metrics/metrics.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if WEB_SERVER_LINUX
+    #include <linux/filter.h>
+#endif
 
 
 namespace tiny_web_server::net {
 
+    namespace {
+
+        /// 向量化发送单次提交的缓冲区上限，远小于 IOV_MAX
+        constexpr std::size_t MAX_SEND_BUFFERS = 64;
+
+#if !WEB_SERVER_WINDOWS
+        /**
+         * @brief 路径上的套接字文件是否已无进程监听
+         * @details 以同类型的非阻塞套接字试连: 只有连接被拒绝(ECONNREFUSED)才说明是上次运行的残留;
+         * 连接成功或积压队列已满(EAGAIN)说明有实例在监听，其他错误也无法确认，都不删除。
+         * 非阻塞保证占用路径的进程卡住时 bind 不会随之阻塞
+         */
+        bool isStaleSocketFile(
+            const socket_t handle, const sockaddr_storage& addr, const socklen_t length
+        ) {
+            int type           = SOCK_STREAM;
+            socklen_t typeSize = sizeof(type);
+            getsockopt(handle, SOL_SOCKET, SO_TYPE, &type, &typeSize);
+
+            auto probe = ::socket(AF_UNIX, type | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+            if (probe < 0) return false;
+
+            const auto* native = reinterpret_cast<const sockaddr*>(&addr);
+
+            auto refused = ::connect(probe, native, length) < 0 && errno == ECONNREFUSED;
+
+            ::close(probe);
+
+            return refused;
+        }
+#endif
+
+        bool wouldBlock(const int error) noexcept {
+#if WEB_SERVER_WINDOWS
+            return error == WSAEWOULDBLOCK;
+#else
+            return error == EAGAIN || error == EWOULDBLOCK;
+#endif
+        }
+
+    }  // namespace
+
     int Socket::count = 0;
 
     Socket::Socket(AddressFamily family, SocketType type, Protocol protocol) {
         if (count == 0) initialize();
 
-        handle_ = socket(
-            static_cast<int>(family), static_cast<int>(type), static_cast<int>(protocol)
-        );
+        // Unix域套接字不使用 IP 层协议
+        if (family == AddressFamily::UNIX) protocol = Protocol::NONE;
 
-        if (handle_ == INVALID_SOCKET) throw SocketError<"Failed to create socket"_s>();
+        auto nativeType = static_cast<int>(type);
+
+#if WEB_SERVER_LINUX
+        // 句柄不随 exec 泄漏: 热重启的新实例只应持有显式交出的监听套接字
+        nativeType |= SOCK_CLOEXEC;
+#endif
+
+        handle_ = socket(static_cast<int>(family), nativeType, static_cast<int>(protocol));
+
+        if (handle_ == NET_INVALID_SOCKET) throw SocketError<"Failed to create socket"_s>();
     }
 
     Socket::~Socket() { close(); }
 
     Socket::Socket(Socket&& other) noexcept
         : handle_(other.handle_) {
-        other.handle_ = INVALID_SOCKET;
+        other.handle_ = NET_INVALID_SOCKET;
     }
 
     Socket& Socket::operator=(Socket&& other) noexcept {
         if (this != &other) {
-            if (isValid()) NET_CLOSE(handle_);
+            if (isValid()) ::NET_CLOSE(handle_);
 
             handle_       = other.handle_;
-            other.handle_ = INVALID_SOCKET;
+            other.handle_ = NET_INVALID_SOCKET;
         }
 
         return *this;
     }
 
     void Socket::bind(const Endpoint& endpoint) const {
-        // IPv6
-        if (endpoint.address().isIPv6()) {
-            sockaddr_in6 addr{};
-            addr.sin6_family = AF_INET6;
-            addr.sin6_port   = htons(endpoint.port());
+        sockaddr_storage addr{};
+        auto length = endpoint.toNative(addr);
 
-            std::memcpy(&addr.sin6_addr, endpoint.address().toBytes().data(), 16);
+#if !WEB_SERVER_WINDOWS
+        // 清理上次运行残留的套接字文件，但绝不删除其他类型的文件或仍在服务的套接字;
+        // 后者留给 bind 以 EADDRINUSE 报错
+        if (endpoint.isUnix() && !endpoint.isAbstract()) {
+            struct stat info{};
 
-            if (::bind(handle_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
-                throw SocketError<"Failed to bind socket to endpoint"_s>();
+            if (::stat(endpoint.path().c_str(), &info) == 0 && S_ISSOCK(info.st_mode)
+                && isStaleSocketFile(handle_, addr, length))
+                ::unlink(endpoint.path().c_str());
         }
+#endif
 
-        // IPv4
-        else {
-            sockaddr_in addr{};
-            addr.sin_family = AF_INET;
-            addr.sin_port   = htons(endpoint.port());
-
-            std::memcpy(&addr.sin_addr, endpoint.address().toBytes().data(), 4);
-
-            if (::bind(handle_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
-                throw SocketError<>(NET_ERROR, "Failed to bind socket to endpoint in IPv4");
-        }
+        if (::bind(handle_, reinterpret_cast<sockaddr*>(&addr), length) < 0)
+            throw SocketError<>(
+                NET_ERROR, std::format("Failed to bind socket to {}", endpoint.toString())
+            );
     }
 
     void Socket::listen(const int backlog) const {
@@ -84,41 +137,148 @@ namespace tiny_web_server::net {
         sockaddr_storage addr{};
         socklen_t addrlen = sizeof(addr);
 
+#if WEB_SERVER_LINUX
+        auto clientHandler = ::accept4(
+            handle_, reinterpret_cast<sockaddr*>(&addr), &addrlen, SOCK_CLOEXEC
+        );
+#else
         auto clientHandler = ::accept(handle_, reinterpret_cast<sockaddr*>(&addr), &addrlen);
+#endif
         if (static_cast<int>(clientHandler) < 0)
             throw SocketError<"Failed to accept connection from socket"_s>();
 
+        metrics::server().accepts.add();
+
         return std::move(clientHandler);
     }
 
     void Socket::connect(const Endpoint& endpoint) const {
-        // IPv6
-        if (endpoint.address().isIPv6()) {
-            sockaddr_in6 addr{};
-            addr.sin6_family = AF_INET6;
-            addr.sin6_port   = htons(endpoint.port());
-
-            std::memcpy(
-                &addr.sin6_addr, endpoint.address().toBytes().data(), sizeof(addr.sin6_addr)
+        sockaddr_storage addr{};
+        auto length = endpoint.toNative(addr);
+
+        if (::connect(handle_, reinterpret_cast<sockaddr*>(&addr), length) < 0)
+            throw SocketError<>(
+                NET_ERROR, std::format("Failed to connect to {}", endpoint.toString())
             );
+    }
 
-            if (::connect(handle_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
-                throw SocketError<"Failed to connect to endpoint"_s>();
-        }
+    bool Socket::tryConnect(const Endpoint& endpoint) const {
+        sockaddr_storage addr{};
+        auto length = endpoint.toNative(addr);
 
-        // IPv4
-        else {
-            sockaddr_in addr{};
-            addr.sin_family = AF_INET;
-            addr.sin_port   = htons(endpoint.port());
+        if (::connect(handle_, reinterpret_cast<sockaddr*>(&addr), length) == 0) return true;
 
-            std::memcpy(
-                &addr.sin_addr, endpoint.address().toBytes().data(), sizeof(addr.sin_addr)
-            );
+#if WEB_SERVER_WINDOWS
+        if (NET_ERROR == WSAEWOULDBLOCK) return false;
+#else
+        if (NET_ERROR == EINPROGRESS) return false;
+#endif
 
-            if (::connect(handle_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
-                throw SocketError<"Failed to connect to endpoint"_s>();
-        }
+        throw SocketError<>(
+            NET_ERROR, std::format("Failed to connect to {}", endpoint.toString())
+        );
+    }
+
+    std::error_code Socket::error() const {
+        int value        = 0;
+        socklen_t length = sizeof(value);
+
+        auto result = ::getsockopt(
+            handle_, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&value), &length
+        );
+
+        if (result < 0)
+            throw SocketError<>(NET_ERROR, "Failed to get socket error");
+
+        return {value, std::system_category()};
+    }
+
+    Endpoint Socket::localEndpoint() const {
+        sockaddr_storage addr{};
+        socklen_t length = sizeof(addr);
+
+        if (::getsockname(handle_, reinterpret_cast<sockaddr*>(&addr), &length) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to get local endpoint of socket");
+
+        return Endpoint::fromNative(addr, length);
+    }
+
+    Endpoint Socket::peerEndpoint() const {
+        sockaddr_storage addr{};
+        socklen_t length = sizeof(addr);
+
+        if (::getpeername(handle_, reinterpret_cast<sockaddr*>(&addr), &length) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to get peer endpoint of socket");
+
+        return Endpoint::fromNative(addr, length);
+    }
+
+    PeerCredentials Socket::peerCredentials() const {
+#if WEB_SERVER_LINUX
+        ucred credentials{};
+        socklen_t length = sizeof(credentials);
+
+        if (getsockopt(handle_, SOL_SOCKET, SO_PEERCRED, &credentials, &length) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to get SO_PEERCRED of socket");
+
+        return {credentials.pid, credentials.uid, credentials.gid};
+#else
+        throw SocketError<"SO_PEERCRED is not supported on this platform"_s>();
+#endif
+    }
+
+    std::optional<TcpInfo> Socket::tcpInfo() const {
+#if WEB_SERVER_LINUX
+        // glibc 的 tcp_info 止于 tcpi_total_retrans，其后的字段按内核布局补齐
+        struct {
+            tcp_info base;
+            std::uint64_t pacingRate;
+            std::uint64_t maxPacingRate;
+            std::uint64_t bytesAcked;
+            std::uint64_t bytesReceived;
+            std::uint32_t segmentsOut;
+            std::uint32_t segmentsIn;
+            std::uint32_t notSentBytes;
+            std::uint32_t minRtt;
+            std::uint32_t dataSegmentsIn;
+            std::uint32_t dataSegmentsOut;
+            std::uint64_t deliveryRate;
+        } info{};
+
+        socklen_t length = sizeof(info);
+
+        if (getsockopt(handle_, IPPROTO_TCP, TCP_INFO, &info, &length) < 0)
+            return std::nullopt;
+
+        // 旧内核返回的结构较短，缺少的字段保持为 0
+        if (length < sizeof(info)) info.deliveryRate = 0;
+
+        const auto& base = info.base;
+
+        return TcpInfo{
+            .rtt              = std::chrono::microseconds(base.tcpi_rtt),
+            .rttVariance      = std::chrono::microseconds(base.tcpi_rttvar),
+            .retransmits      = base.tcpi_total_retrans,
+            .congestionWindow = base.tcpi_snd_cwnd,
+            .deliveryRate     = info.deliveryRate,
+            .unackedBytes     = std::uint64_t{base.tcpi_unacked} * base.tcpi_snd_mss,
+        };
+#else
+        return std::nullopt;
+#endif
+    }
+
+    std::pair<Socket, Socket> Socket::pair(const SocketType type) {
+#if WEB_SERVER_WINDOWS
+        throw SocketError<"socketpair is not supported on this platform"_s>();
+#else
+        socket_t handles[2];
+
+        if (::socketpair(AF_UNIX, static_cast<int>(type) | SOCK_CLOEXEC, 0, handles) < 0)
+            throw SocketError<>(NET_ERROR, "Failed to create socket pair");
+
+        return {Socket{std::move(handles[0])}, Socket{std::move(handles[1])}};
+#endif
     }
 
     std::size_t Socket::recv(std::span<std::byte> buffer, int flags) const {
@@ -127,6 +287,8 @@ namespace tiny_web_server::net {
 
         if (received < 0) throw SocketError<"Failed to receive from socket"_s>();
 
+        metrics::server().bytesIn.add(static_cast<std::uint64_t>(received));
+
         return static_cast<std::size_t>(received);
     }
 
@@ -136,24 +298,146 @@ namespace tiny_web_server::net {
 
         if (sent < 0) throw SocketError<"Failed to send to socket"_s>();
 
+        metrics::server().bytesOut.add(static_cast<std::uint64_t>(sent));
+
+        return static_cast<std::size_t>(sent);
+    }
+
+    std::optional<std::size_t>
+    Socket::tryRecv(std::span<std::byte> buffer, const int flags) const {
+        auto received =
+            ::recv(handle_, reinterpret_cast<char*>(buffer.data()), buffer.size(), flags);
+
+        if (received < 0) {
+            if (wouldBlock(NET_ERROR)) return std::nullopt;
+
+            throw SocketError<>(NET_ERROR, "Failed to receive from socket");
+        }
+
+        metrics::server().bytesIn.add(static_cast<std::uint64_t>(received));
+
+        return static_cast<std::size_t>(received);
+    }
+
+    std::optional<std::size_t>
+    Socket::trySend(std::span<const std::byte> data, const int flags) const {
+        auto sent = ::send(
+            handle_, reinterpret_cast<const char*>(data.data()), data.size(),
+            flags | NET_NOSIGNAL
+        );
+
+        if (sent < 0) {
+            if (wouldBlock(NET_ERROR)) return std::nullopt;
+
+            throw SocketError<>(NET_ERROR, "Failed to send to socket");
+        }
+
+        metrics::server().bytesOut.add(static_cast<std::uint64_t>(sent));
+
+        return static_cast<std::size_t>(sent);
+    }
+
+    std::optional<std::size_t>
+    Socket::trySend(const std::span<const std::span<const std::byte>> buffers) const {
+        auto count = std::min(buffers.size(), MAX_SEND_BUFFERS);
+
+#if WEB_SERVER_WINDOWS
+        WSABUF vectors[MAX_SEND_BUFFERS];
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto* data = const_cast<std::byte*>(buffers[i].data());
+
+            vectors[i].buf = reinterpret_cast<CHAR*>(data);
+            vectors[i].len = static_cast<ULONG>(buffers[i].size());
+        }
+
+        DWORD sent = 0;
+
+        if (WSASend(handle_, vectors, static_cast<DWORD>(count), &sent, 0, nullptr, nullptr)
+            == SOCKET_ERROR) {
+            if (wouldBlock(NET_ERROR)) return std::nullopt;
+
+            throw SocketError<>(NET_ERROR, "Failed to send to socket");
+        }
+#else
+        iovec vectors[MAX_SEND_BUFFERS];
+
+        for (std::size_t i = 0; i < count; ++i) {
+            vectors[i].iov_base = const_cast<std::byte*>(buffers[i].data());
+            vectors[i].iov_len  = buffers[i].size();
+        }
+
+        // writev 不接受 MSG_NOSIGNAL，改用 sendmsg
+        msghdr message{};
+        message.msg_iov    = vectors;
+        message.msg_iovlen = count;
+
+        auto sent = ::sendmsg(handle_, &message, NET_NOSIGNAL);
+
+        if (sent < 0) {
+            if (wouldBlock(NET_ERROR)) return std::nullopt;
+
+            throw SocketError<>(NET_ERROR, "Failed to send to socket");
+        }
+#endif
+
+        metrics::server().bytesOut.add(static_cast<std::uint64_t>(sent));
+
+        return static_cast<std::size_t>(sent);
+    }
+
+    std::size_t Socket::sendFile(int file, std::uint64_t offset, std::size_t count) const {
+#if WEB_SERVER_WINDOWS
+        OVERLAPPED overlapped{};
+        overlapped.Offset     = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        if (!TransmitFile(
+                handle_, reinterpret_cast<HANDLE>(_get_osfhandle(file)),
+                static_cast<DWORD>(count), 0, &overlapped, nullptr, 0
+            ))
+            throw SocketError<>(NET_ERROR, "Failed to send file to socket");
+
+        metrics::server().bytesOut.add(count);
+
+        return count;
+#else
+        auto position = static_cast<off_t>(offset);
+        auto sent     = ::sendfile(handle_, file, &position, count);
+
+        if (sent < 0) throw SocketError<>(NET_ERROR, "Failed to send file to socket");
+
+        metrics::server().bytesOut.add(static_cast<std::uint64_t>(sent));
+
         return static_cast<std::size_t>(sent);
+#endif
     }
 
     void Socket::setOptions(const Options& opts) const {
         if (opts.reuse_address) {
-            if (char enable = 1;
+            if (int enable = 1;
                 setsockopt(handle_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int)))
                 throw SocketError<"Failed to set SO_REUSEADDR option on socket"_s>();
         }
 
+        if (opts.reuse_port) {
+#if WEB_SERVER_LINUX
+            if (int enable = 1;
+                setsockopt(handle_, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(int)))
+                throw SocketError<"Failed to set SO_REUSEPORT option on socket"_s>();
+#else
+            throw SocketError<"SO_REUSEPORT is not supported on this platform"_s>();
+#endif
+        }
+
         if (opts.keep_alive) {
-            if (char enable = 1;
+            if (int enable = 1;
                 setsockopt(handle_, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(int)))
                 throw SocketError<"Failed to set SO_KEEPALIVE option on socket"_s>();
         }
 
         if (opts.no_delay) {
-            if (char enable = 1;
+            if (int enable = 1;
                 setsockopt(handle_, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(int)))
                 throw SocketError<"Failed to set TCP_NODELAY option on socket"_s>();
         }
@@ -189,6 +473,85 @@ namespace tiny_web_server::net {
                 ))
                 throw SocketError<"Failed to set SO_SNDTIMEO option on socket"_s>();
         }
+
+        if (opts.busy_poll_us > 0 || opts.busy_poll_budget > 0 || opts.prefer_busy_poll) {
+#if WEB_SERVER_LINUX
+            if (opts.busy_poll_us > 0) {
+                if (setsockopt(
+                        handle_, SOL_SOCKET, SO_BUSY_POLL, &opts.busy_poll_us, sizeof(int)
+                    ))
+                    throw SocketError<"Failed to set SO_BUSY_POLL option on socket"_s>();
+            }
+
+            if (opts.busy_poll_budget > 0) {
+                if (setsockopt(
+                        handle_, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &opts.busy_poll_budget,
+                        sizeof(int)
+                    ))
+                    throw SocketError<"Failed to set SO_BUSY_POLL_BUDGET on socket"_s>();
+            }
+
+            if (opts.prefer_busy_poll) {
+                if (int enable = 1; setsockopt(
+                        handle_, SOL_SOCKET, SO_PREFER_BUSY_POLL, &enable, sizeof(int)
+                    ))
+                    throw SocketError<"Failed to set SO_PREFER_BUSY_POLL on socket"_s>();
+            }
+#else
+            throw SocketError<"Busy polling is not supported on this platform"_s>();
+#endif
+        }
+    }
+
+    std::optional<int> Socket::incomingCpu() const {
+#if WEB_SERVER_LINUX
+        int cpu          = -1;
+        socklen_t length = sizeof(cpu);
+
+        if (getsockopt(handle_, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &length) < 0 || cpu < 0)
+            return std::nullopt;
+
+        return cpu;
+#else
+        return std::nullopt;
+#endif
+    }
+
+    void Socket::steerByIncomingCpu(const std::span<const int> cpus) const {
+#if WEB_SERVER_LINUX
+        if (cpus.empty()) throw SocketError<"Empty SO_REUSEPORT group"_s>();
+
+        // 首尾各一条指令，每个监听套接字两条
+        if (cpus.size() > (BPF_MAXINSNS - 2) / 2)
+            throw SocketError<"Too many listeners for CPU steering"_s>();
+
+        constexpr auto CPU = static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU);
+
+        // A = 当前 CPU; 逐个比较，A == cpus[i] 时返回 i; 都不相等时返回组大小，
+        // 越界的下标令内核回退到按哈希选择
+        std::vector<sock_filter> code{{BPF_LD | BPF_W | BPF_ABS, 0, 0, CPU}};
+
+        for (std::size_t i = 0; i < cpus.size(); ++i) {
+            if (cpus[i] < 0 || std::ranges::find(cpus.first(i), cpus[i]) != cpus.begin() + i)
+                throw SocketError<"Listener CPUs must be distinct and non-negative"_s>();
+
+            auto cpu = static_cast<std::uint32_t>(cpus[i]);
+
+            code.push_back({BPF_JMP | BPF_JEQ | BPF_K, 0, 1, cpu});
+            code.push_back({BPF_RET | BPF_K, 0, 0, static_cast<std::uint32_t>(i)});
+        }
+
+        code.push_back({BPF_RET | BPF_K, 0, 0, static_cast<std::uint32_t>(cpus.size())});
+
+        sock_fprog program{static_cast<unsigned short>(code.size()), code.data()};
+
+        if (setsockopt(
+                handle_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)
+            ))
+            throw SocketError<>(NET_ERROR, "Failed to attach SO_REUSEPORT CPU steering");
+#else
+        throw SocketError<"SO_ATTACH_REUSEPORT_CBPF is not supported on this platform"_s>();
+#endif
     }
 
     void Socket::setNonBlocking(bool nonBlocking) const {
@@ -214,15 +577,21 @@ namespace tiny_web_server::net {
     void Socket::close() {
         count--;
 
-        if (isValid()) NET_CLOSE(handle_);
+        if (isValid()) ::NET_CLOSE(handle_);
 
-        handle_ = INVALID_SOCKET;
+        handle_ = NET_INVALID_SOCKET;
     }
 
-    bool Socket::isValid() const { return handle_ != INVALID_SOCKET; }
+    bool Socket::isValid() const { return handle_ != NET_INVALID_SOCKET; }
 
     socket_t Socket::nativeHandle() const noexcept { return handle_; }
 
+    Socket Socket::adopt(socket_t handle) noexcept { return Socket{std::move(handle)}; }
+
+    socket_t Socket::release() noexcept {
+        return std::exchange(handle_, NET_INVALID_SOCKET);
+    }
+
     void Socket::initialize() {
 #if WEB_SERVER_WINDOWS
         WSADATA wsaData;
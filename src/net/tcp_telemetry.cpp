@@ -0,0 +1,93 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file tcp_telemetry.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 03:05
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/net/tcp_telemetry.hpp"
+
+namespace tiny_web_server::net {
+
+    TcpTelemetry::Probe::Probe(const Series& series) noexcept
+        : series_(&series) {}
+
+    std::optional<TcpInfo> TcpTelemetry::Probe::sample(const Socket& socket) {
+        auto info = socket.tcpInfo();
+        if (!info) return std::nullopt;
+
+        series_->rtt.record(info->rtt);
+        series_->rttVariance.record(info->rttVariance);
+        series_->samples.add();
+
+        if (info->retransmits > retransmits_) {
+            series_->retransmits.add(info->retransmits - retransmits_);
+            retransmits_ = info->retransmits;
+        }
+
+        return info;
+    }
+
+    TcpTelemetry::TcpTelemetry(
+        const TcpTelemetryOptions& options, metrics::Registry& registry
+    )
+        : options_(options)
+        , registry_(registry) {}
+
+    std::optional<TcpTelemetry::Probe> TcpTelemetry::probe(const IpAddress& client) {
+        if (options_.sampleEvery == 0) return std::nullopt;
+
+        auto index = connections_.fetch_add(1, std::memory_order_relaxed);
+        if (index % options_.sampleEvery != 0) return std::nullopt;
+
+        return Probe{series(prefix(client))};
+    }
+
+    std::string TcpTelemetry::prefix(const IpAddress& client) const {
+        // 完整长度的掩码只用于把 IPv4 映射地址还原为 IPv4
+        auto address = client.masked(128);
+        auto length  = address.isIPv4() ? options_.ipv4PrefixLength
+                                         : options_.ipv6PrefixLength;
+
+        return address.masked(length).toString() + '/' + std::to_string(length);
+    }
+
+    const TcpTelemetry::Series& TcpTelemetry::series(const std::string& prefix) {
+        std::lock_guard lock(mutex_);
+
+        if (auto it = series_.find(prefix); it != series_.end()) return *it->second;
+
+        // 网段过多时不再细分，避免标签基数无限增长
+        auto key = series_.size() < options_.maxPrefixes ? prefix : std::string{"other"};
+
+        if (auto it = series_.find(key); it != series_.end()) return *it->second;
+
+        auto labels = "prefix=\"" + key + '"';
+
+        auto histogram = [&](std::string_view name, std::string_view help) -> auto& {
+            return registry_.histogram(name, help, labels);
+        };
+        auto counter = [&](std::string_view name, std::string_view help) -> auto& {
+            return registry_.counter(name, help, labels);
+        };
+
+        auto& series = series_[key];
+        series       = std::make_unique<Series>(Series{
+            histogram("tws_client_rtt_seconds", "Smoothed TCP round-trip time of clients"),
+            histogram("tws_client_rtt_variance_seconds", "TCP round-trip time variance"),
+            counter("tws_client_retransmits_total", "TCP segments retransmitted to clients"),
+            counter("tws_client_tcp_samples_total", "TCP_INFO samples taken"),
+        });
+
+        return *series;
+    }
+
+}  // namespace tiny_web_server::net
@@ -0,0 +1,381 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file upstream.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 03:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/net/upstream.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/utils/hash.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace tiny_web_server::net {
+
+    namespace {
+
+        enum class Ejection { CONSECUTIVE, ERRORS, LATENCY };
+
+        void recordEjection(const Ejection reason) {
+            constexpr std::string_view NAME = "tws_upstream_ejections_total";
+            constexpr std::string_view HELP = "Backends ejected by outlier detection";
+
+            auto& registry = metrics::Registry::global();
+
+            static metrics::Counter* counters[]{
+                &registry.counter(NAME, HELP, "reason=\"consecutive\""),
+                &registry.counter(NAME, HELP, "reason=\"errors\""),
+                &registry.counter(NAME, HELP, "reason=\"latency\""),
+            };
+
+            counters[static_cast<int>(reason)]->add();
+        }
+
+        std::uint64_t mix(const std::uint64_t key) noexcept {
+            return contentHash(std::as_bytes(std::span{&key, 1}));
+        }
+
+        /**
+         * @brief 只由一个线程写入的计数器，省去原子读改写
+         */
+        void bump(std::atomic<std::uint64_t>& counter, const std::uint64_t value) noexcept {
+            auto current = counter.load(std::memory_order_relaxed);
+            counter.store(current + value, std::memory_order_relaxed);
+        }
+
+    }  // namespace
+
+    Upstream::Upstream(const std::vector<Endpoint>& backends, const UpstreamOptions& options)
+        : options_(options)
+        , endpoints_(backends)
+        , size_(backends.size())
+        , backends_(std::make_unique<Backend[]>(backends.size())) {
+        if (options_.policy != BalancePolicy::CONSISTENT_HASH) return;
+
+        // 虚拟节点的位置只取决于后端地址，各进程构建出相同的环
+        ring_.reserve(size_ * options_.virtualNodes);
+
+        for (std::size_t i = 0; i < size_; ++i) {
+            const auto& endpoint = backends[i];
+
+            auto identity = endpoint.isUnix() ? std::as_bytes(std::span{endpoint.path()})
+                                              : endpoint.address().bytes();
+
+            for (std::size_t node = 0; node < options_.virtualNodes; ++node) {
+                auto seed = std::uint64_t{endpoint.port()} << 32 | node;
+                auto hash = contentHash(identity, seed);
+
+                ring_.emplace_back(hash, static_cast<std::uint32_t>(i));
+            }
+        }
+
+        std::ranges::sort(ring_);
+    }
+
+    void Upstream::aggregate(const Clock::time_point now) {
+        std::lock_guard lock(mutex_);
+
+        // 本周期内各后端的请求数、失败数与总延迟
+        std::vector<std::array<std::uint64_t, 3>> totals(size_);
+
+        for (auto& window : windows_) {
+            // 先确认已退役再读取，保证读到退役前的全部结果
+            auto retired = window->retired.load(std::memory_order_acquire);
+
+            for (std::size_t i = 0; i < size_; ++i) {
+                const auto& stats = window->stats[i];
+                auto& previous    = window->previous[i];
+
+                std::array current{
+                    stats.requests.load(std::memory_order_relaxed),
+                    stats.errors.load(std::memory_order_relaxed),
+                    stats.latency.load(std::memory_order_relaxed),
+                };
+
+                for (std::size_t k = 0; k < current.size(); ++k)
+                    totals[i][k] += current[k] - previous[k];
+
+                previous = current;
+            }
+
+            if (retired) window.reset();
+        }
+
+        std::erase(windows_, nullptr);
+
+        auto stamp = [&](Backend& backend) {
+            ++backend.ejections;
+
+            auto duration = options_.baseEjection * backend.ejections;
+            backend.ejectedUntil = now + std::min(duration, options_.maxEjection);
+        };
+
+        for (std::size_t i = 0; i < size_; ++i) {
+            auto& backend = backends_[i];
+            if (!backend.ejected.load(std::memory_order_relaxed)) continue;
+
+            // 选择器因连续失败摘除的后端
+            if (backend.ejectedUntil == Clock::time_point{}) {
+                stamp(backend);
+                continue;
+            }
+
+            if (now < backend.ejectedUntil) continue;
+
+            backend.ejectedUntil = {};
+            backend.ejected.store(false, std::memory_order_relaxed);
+            ejectedCount_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        auto eligible = [&](const std::size_t i) {
+            return !backends_[i].ejected.load(std::memory_order_relaxed)
+                   && totals[i][0] >= std::max<std::uint64_t>(options_.minRequests, 1);
+        };
+
+        // 每个请求的平均失败数(k = 1)或平均延迟(k = 2)
+        auto perRequest = [&](const std::size_t i, const std::size_t k) {
+            return static_cast<double>(totals[i][k]) / static_cast<double>(totals[i][0]);
+        };
+
+        // 至少三个后端有足够样本时，延迟中位数才有比较意义
+        std::vector<double> latencies;
+        for (std::size_t i = 0; i < size_; ++i)
+            if (eligible(i)) latencies.push_back(perRequest(i, 2));
+
+        auto median = 0.0;
+        if (latencies.size() >= 3) {
+            auto middle = latencies.begin() + latencies.size() / 2;
+            std::ranges::nth_element(latencies, middle);
+            median = *middle;
+        }
+
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (!eligible(i)) continue;
+
+            auto& backend = backends_[i];
+
+            auto errors = perRequest(i, 1);
+            auto slow   = options_.latencyFactor > 0 && median > 0
+                        && perRequest(i, 2) > options_.latencyFactor * median;
+
+            // 健康的周期逐步抵消摘除时长的倍数
+            if (errors <= options_.maxErrorRate && !slow) {
+                if (backend.ejections > 0) --backend.ejections;
+                continue;
+            }
+
+            if (!eject(i)) continue;
+
+            stamp(backend);
+            recordEjection(
+                errors > options_.maxErrorRate ? Ejection::ERRORS : Ejection::LATENCY
+            );
+        }
+    }
+
+    std::size_t Upstream::size() const noexcept { return size_; }
+
+    const Endpoint& Upstream::endpoint(const std::size_t index) const noexcept {
+        return endpoints_[index];
+    }
+
+    bool Upstream::isEjected(const std::size_t index) const noexcept {
+        return backends_[index].ejected.load(std::memory_order_relaxed);
+    }
+
+    const UpstreamOptions& Upstream::options() const noexcept { return options_; }
+
+    bool Upstream::eject(const std::size_t index) noexcept {
+        auto limit = static_cast<std::size_t>(options_.maxEjectedRatio * size_);
+        auto count = ejectedCount_.load(std::memory_order_relaxed);
+
+        do {
+            if (count >= limit) return false;
+        } while (!ejectedCount_.compare_exchange_weak(count, count + 1));
+
+        auto expected = false;
+        if (backends_[index].ejected.compare_exchange_strong(expected, true)) return true;
+
+        // 已被其他线程摘除
+        ejectedCount_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::shared_ptr<Upstream::Window> Upstream::registerWindow() {
+        auto window   = std::make_shared<Window>();
+        window->stats = std::make_unique<Stats[]>(size_);
+        window->previous.resize(size_);
+
+        std::lock_guard lock(mutex_);
+        windows_.push_back(window);
+
+        return window;
+    }
+
+    UpstreamSelector::UpstreamSelector(Upstream& upstream)
+        : upstream_(upstream)
+        , window_(upstream.registerWindow())
+        , outstanding_(upstream.size())
+        , consecutiveErrors_(upstream.size())
+        , random_(std::random_device{}()) {}
+
+    UpstreamSelector::~UpstreamSelector() {
+        window_->retired.store(true, std::memory_order_release);
+    }
+
+    std::optional<std::size_t> UpstreamSelector::select(const std::uint64_t key) {
+        auto size = upstream_.size();
+        if (size == 0) return std::nullopt;
+
+        // 全部后端都被摘除时忽略摘除状态
+        auto all = upstream_.ejectedCount_.load(std::memory_order_relaxed) >= size;
+
+        std::optional<std::size_t> backend;
+
+        switch (upstream_.options_.policy) {
+            case BalancePolicy::ROUND_ROBIN:
+                for (std::size_t i = 0; i < size && !backend; ++i) {
+                    auto candidate = next_++ % size;
+                    if (usable(candidate, all)) backend = acquire(candidate);
+                }
+                break;
+
+            case BalancePolicy::LEAST_OUTSTANDING: backend = leastOutstanding(all); break;
+
+            case BalancePolicy::POWER_OF_TWO: backend = powerOfTwo(all); break;
+
+            case BalancePolicy::CONSISTENT_HASH: backend = consistentHash(key, all); break;
+        }
+
+        // 选择期间摘除状态发生了变化
+        return backend ? backend : leastOutstanding(true);
+    }
+
+    std::optional<std::size_t> UpstreamSelector::select(const IpAddress& client) {
+        return select(std::uint64_t{client.hash()});
+    }
+
+    std::optional<std::size_t> UpstreamSelector::select(const std::string_view key) {
+        return select(contentHash(std::as_bytes(std::span{key})));
+    }
+
+    void UpstreamSelector::complete(
+        const std::size_t backend, const bool success, const std::chrono::nanoseconds latency
+    ) {
+        if (outstanding_[backend] > 0) {
+            --outstanding_[backend];
+            --totalOutstanding_;
+        }
+
+        auto& stats      = window_->stats[backend];
+        auto nanoseconds = std::max<std::int64_t>(latency.count(), 0);
+
+        bump(stats.requests, 1);
+        bump(stats.errors, success ? 0 : 1);
+        bump(stats.latency, static_cast<std::uint64_t>(nanoseconds));
+
+        if (success) {
+            consecutiveErrors_[backend] = 0;
+            return;
+        }
+
+        auto threshold = upstream_.options_.consecutiveErrors;
+        if (threshold == 0 || ++consecutiveErrors_[backend] < threshold) return;
+
+        consecutiveErrors_[backend] = 0;
+
+        if (upstream_.eject(backend)) recordEjection(Ejection::CONSECUTIVE);
+    }
+
+    std::uint32_t UpstreamSelector::outstanding(const std::size_t backend) const noexcept {
+        return outstanding_[backend];
+    }
+
+    bool UpstreamSelector::usable(const std::size_t backend, const bool all) const noexcept {
+        return all || !upstream_.isEjected(backend);
+    }
+
+    std::optional<std::size_t> UpstreamSelector::leastOutstanding(const bool all) {
+        auto size = upstream_.size();
+
+        // 从轮转的起点开始扫描，进行中请求数相同时不总是选中同一个后端
+        auto start = next_++;
+        std::optional<std::size_t> best;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            auto candidate = (start + i) % size;
+            if (!usable(candidate, all)) continue;
+
+            if (!best || outstanding_[candidate] < outstanding_[*best]) best = candidate;
+        }
+
+        if (!best) return std::nullopt;
+
+        return acquire(*best);
+    }
+
+    std::optional<std::size_t> UpstreamSelector::powerOfTwo(const bool all) {
+        auto size = upstream_.size();
+        if (size == 1) return leastOutstanding(all);
+
+        std::size_t first  = random_() % size;
+        std::size_t second = random_() % (size - 1);
+        if (second >= first) ++second;
+
+        auto firstUsable  = usable(first, all);
+        auto secondUsable = usable(second, all);
+
+        if (firstUsable && secondUsable)
+            return acquire(outstanding_[second] < outstanding_[first] ? second : first);
+
+        if (firstUsable) return acquire(first);
+        if (secondUsable) return acquire(second);
+
+        // 两个都被摘除
+        return leastOutstanding(all);
+    }
+
+    std::optional<std::size_t>
+    UpstreamSelector::consistentHash(const std::uint64_t key, const bool all) {
+        const auto& ring = upstream_.ring_;
+        if (ring.empty()) return std::nullopt;
+
+        auto size    = upstream_.size();
+        auto ejected = upstream_.ejectedCount_.load(std::memory_order_relaxed);
+        auto healthy = all ? size : std::max<std::size_t>(size - std::min(ejected, size), 1);
+
+        // 有界负载: 加上本次请求后不超过平均负载的 loadFactor 倍
+        auto average = (totalOutstanding_ + 1.0) / static_cast<double>(healthy);
+        auto bound   = std::ceil(upstream_.options_.loadFactor * average);
+
+        auto hash  = mix(key);
+        auto start = std::ranges::lower_bound(ring, std::pair{hash, std::uint32_t{0}});
+        auto index = static_cast<std::size_t>(start - ring.begin());
+
+        for (std::size_t i = 0; i < ring.size(); ++i) {
+            auto candidate = ring[(index + i) % ring.size()].second;
+            if (!usable(candidate, all)) continue;
+
+            if (outstanding_[candidate] + 1 <= bound) return acquire(candidate);
+        }
+
+        return std::nullopt;
+    }
+
+    std::size_t UpstreamSelector::acquire(const std::size_t backend) noexcept {
+        ++outstanding_[backend];
+        ++totalOutstanding_;
+
+        return backend;
+    }
+
+}  // namespace tiny_web_server::net
@@ -0,0 +1,161 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file arena.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/utils/arena.hpp"
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace tiny_web_server {
+
+    namespace {
+
+        constexpr std::align_val_t BLOCK_ALIGNMENT{alignof(std::max_align_t)};
+
+        /// 块头之后的数据按 max_align_t 对齐
+        constexpr std::size_t HEADER_SIZE =
+            (sizeof(void*) * 2 + alignof(std::max_align_t) - 1)
+            & ~(alignof(std::max_align_t) - 1);
+
+        /**
+         * @brief 线程局部的定长块缓存
+         */
+        struct BlockPool {
+            static constexpr std::size_t MAX_CACHED = 64;
+
+            void* head = nullptr;
+
+            std::size_t count = 0;
+
+            ~BlockPool() {
+                while (head) {
+                    auto* next = *static_cast<void**>(head);
+                    ::operator delete(head, BLOCK_ALIGNMENT);
+                    head = next;
+                }
+            }
+
+            void* acquire() {
+                if (!head) return ::operator new(Arena::BLOCK_SIZE, BLOCK_ALIGNMENT);
+
+                auto* block = head;
+                head        = *static_cast<void**>(block);
+                --count;
+
+                return block;
+            }
+        };
+
+        thread_local BlockPool blockPool;
+
+    }  // namespace
+
+    Arena::Arena() noexcept
+        : Arena(std::span<std::byte>{}) {}
+
+    Arena::Arena(const std::span<std::byte> initial) noexcept
+        : initial_(initial)
+        , cursor_(initial.data())
+        , end_(initial.data() + initial.size()) {}
+
+    Arena::~Arena() { reset(); }
+
+    void Arena::reset() noexcept {
+        while (large_) {
+            auto* next = large_->next;
+            ::operator delete(large_, BLOCK_ALIGNMENT);
+            large_ = next;
+        }
+
+        // 定长块的链表末尾接上块池即可整串归还; 块池已满时逐个释放
+        if (blocks_) {
+            if (blockPool.count + blockCount_ <= BlockPool::MAX_CACHED) {
+                static_assert(offsetof(Block, next) == 0);
+
+                lastBlock_->next = static_cast<Block*>(blockPool.head);
+                blockPool.head   = blocks_;
+                blockPool.count += blockCount_;
+            } else {
+                while (blocks_) {
+                    auto* next = blocks_->next;
+                    ::operator delete(blocks_, BLOCK_ALIGNMENT);
+                    blocks_ = next;
+                }
+            }
+
+            blocks_     = nullptr;
+            lastBlock_  = nullptr;
+            blockCount_ = 0;
+        }
+
+        cursor_    = initial_.data();
+        end_       = initial_.data() + initial_.size();
+        allocated_ = 0;
+    }
+
+    std::size_t Arena::allocated() const noexcept { return allocated_; }
+
+    void* Arena::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+        allocated_ += bytes;
+
+        void* pointer = cursor_;
+        auto space    = static_cast<std::size_t>(end_ - cursor_);
+
+        if (cursor_ && std::align(alignment, bytes, pointer, space)) {
+            cursor_ = static_cast<std::byte*>(pointer) + bytes;
+            return pointer;
+        }
+
+        if (bytes > BLOCK_SIZE / 4 || alignment > alignof(std::max_align_t))
+            return allocateLarge(bytes, alignment);
+
+        auto* block = static_cast<Block*>(blockPool.acquire());
+        block->next = blocks_;
+        block->size = BLOCK_SIZE;
+
+        if (!blocks_) lastBlock_ = block;
+        blocks_ = block;
+        ++blockCount_;
+
+        cursor_ = reinterpret_cast<std::byte*>(block) + HEADER_SIZE;
+        end_    = reinterpret_cast<std::byte*>(block) + BLOCK_SIZE;
+
+        // 新块中数据区按 max_align_t 对齐，且 bytes 不超过块大小的四分之一
+        pointer = cursor_;
+        cursor_ += bytes;
+
+        return pointer;
+    }
+
+    void* Arena::allocateLarge(const std::size_t bytes, const std::size_t alignment) {
+        auto padding = std::max(alignment, alignof(std::max_align_t));
+        auto size    = HEADER_SIZE + padding + bytes;
+
+        auto* block = static_cast<Block*>(::operator new(size, BLOCK_ALIGNMENT));
+        block->next = large_;
+        block->size = size;
+        large_      = block;
+
+        void* pointer = reinterpret_cast<std::byte*>(block) + HEADER_SIZE;
+        auto space    = size - HEADER_SIZE;
+
+        return std::align(alignment, bytes, pointer, space);
+    }
+
+    bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+}  // namespace tiny_web_server
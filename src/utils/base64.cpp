@@ -0,0 +1,91 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file base64.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 14:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/utils/base64.hpp"
+
+namespace tiny_web_server {
+
+    std::string base64Encode(const std::span<const std::byte> data) {
+        constexpr char table[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string out;
+        out.reserve((data.size() + 2) / 3 * 4);
+
+        std::size_t i = 0;
+
+        for (; i + 3 <= data.size(); i += 3) {
+            auto n = std::to_integer<std::uint32_t>(data[i]) << 16
+                   | std::to_integer<std::uint32_t>(data[i + 1]) << 8
+                   | std::to_integer<std::uint32_t>(data[i + 2]);
+
+            out += table[n >> 18 & 63];
+            out += table[n >> 12 & 63];
+            out += table[n >> 6 & 63];
+            out += table[n & 63];
+        }
+
+        if (auto remain = data.size() - i; remain > 0) {
+            auto n = std::to_integer<std::uint32_t>(data[i]) << 16;
+            if (remain == 2) n |= std::to_integer<std::uint32_t>(data[i + 1]) << 8;
+
+            out += table[n >> 18 & 63];
+            out += table[n >> 12 & 63];
+            out += remain == 2 ? table[n >> 6 & 63] : '=';
+            out += '=';
+        }
+
+        return out;
+    }
+
+    std::optional<std::vector<std::byte>> base64Decode(std::string_view text) {
+        auto value = [](const char c) -> int {
+            if (c >= 'A' && c <= 'Z') return c - 'A';
+            if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+            if (c >= '0' && c <= '9') return c - '0' + 52;
+            if (c == '+' || c == '-') return 62;
+            if (c == '/' || c == '_') return 63;
+
+            return -1;
+        };
+
+        while (text.ends_with('=')) text.remove_suffix(1);
+
+        // 余1个字符时不足一个字节
+        if (text.size() % 4 == 1) return std::nullopt;
+
+        std::vector<std::byte> out;
+        out.reserve(text.size() * 3 / 4);
+
+        std::uint32_t bits = 0;
+        int count          = 0;
+
+        for (auto c : text) {
+            auto v = value(c);
+            if (v < 0) return std::nullopt;
+
+            bits = bits << 6 | static_cast<std::uint32_t>(v);
+            count += 6;
+
+            if (count >= 8) {
+                count -= 8;
+                out.push_back(static_cast<std::byte>(bits >> count & 0xFF));
+            }
+        }
+
+        return out;
+    }
+
+}  // namespace tiny_web_server
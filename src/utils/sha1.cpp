@@ -0,0 +1,110 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file sha1.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 14:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/utils/sha1.hpp"
+#include <bit>
+#include <cstring>
+
+namespace tiny_web_server {
+
+    namespace {
+
+        void transform(std::array<std::uint32_t, 5>& state, const std::byte* block) noexcept {
+            std::uint32_t w[80];
+
+            for (auto i = 0; i < 16; ++i)
+                w[i] = std::to_integer<std::uint32_t>(block[i * 4]) << 24
+                     | std::to_integer<std::uint32_t>(block[i * 4 + 1]) << 16
+                     | std::to_integer<std::uint32_t>(block[i * 4 + 2]) << 8
+                     | std::to_integer<std::uint32_t>(block[i * 4 + 3]);
+
+            for (auto i = 16; i < 80; ++i)
+                w[i] = std::rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+            auto [a, b, c, d, e] = state;
+
+            for (auto i = 0; i < 80; ++i) {
+                std::uint32_t f, k;
+
+                if (i < 20) {
+                    f = (b & c) | (~b & d);
+                    k = 0x5A827999;
+                }
+                else if (i < 40) {
+                    f = b ^ c ^ d;
+                    k = 0x6ED9EBA1;
+                }
+                else if (i < 60) {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8F1BBCDC;
+                }
+                else {
+                    f = b ^ c ^ d;
+                    k = 0xCA62C1D6;
+                }
+
+                auto temp = std::rotl(a, 5) + f + e + k + w[i];
+                e         = d;
+                d         = c;
+                c         = std::rotl(b, 30);
+                b         = a;
+                a         = temp;
+            }
+
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+        }
+
+    }  // namespace
+
+    std::array<std::byte, 20> sha1(const std::span<const std::byte> data) {
+        std::array<std::uint32_t, 5> state{
+            0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+        };
+
+        auto full = data.size() / 64 * 64;
+
+        for (std::size_t offset = 0; offset < full; offset += 64)
+            transform(state, data.data() + offset);
+
+        // 填充: 0x80，若干0，64位大端比特长度
+        std::byte tail[128]{};
+        auto remain = data.size() - full;
+
+        if (remain > 0) std::memcpy(tail, data.data() + full, remain);
+        tail[remain] = std::byte{0x80};
+
+        auto tailSize = remain < 56 ? 64 : 128;
+        auto bits     = static_cast<std::uint64_t>(data.size()) * 8;
+
+        for (auto i = 0; i < 8; ++i)
+            tail[tailSize - 1 - i] = static_cast<std::byte>(bits >> (i * 8));
+
+        transform(state, tail);
+        if (tailSize == 128) transform(state, tail + 64);
+
+        std::array<std::byte, 20> digest{};
+
+        for (auto i = 0; i < 5; ++i)
+            for (auto j = 0; j < 4; ++j)
+                digest[i * 4 + j] = static_cast<std::byte>(state[i] >> (24 - j * 8));
+
+        return digest;
+    }
+
+}  // namespace tiny_web_server
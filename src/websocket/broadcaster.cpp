@@ -0,0 +1,93 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file broadcaster.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 16:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/websocket/broadcaster.hpp"
+
+namespace tiny_web_server::websocket {
+
+    void Broadcaster::subscribe(const std::shared_ptr<Connection>& connection) {
+        run(connection->reactor(), [group = group(connection->reactor()), connection] {
+            group->members.push_back(connection);
+        });
+    }
+
+    void Broadcaster::unsubscribe(const std::shared_ptr<Connection>& connection) {
+        run(connection->reactor(), [group = group(connection->reactor()), connection] {
+            // 扇出中(如关闭回调里退订)不能移动元素，否则会跳过或重复发送
+            if (group->sending > 0) {
+                for (auto& member : group->members)
+                    if (member.lock() == connection) member.reset();
+
+                return;
+            }
+
+            std::erase_if(group->members, [&](const auto& member) {
+                return member.lock() == connection;
+            });
+        });
+    }
+
+    void Broadcaster::broadcast(const Opcode opcode, std::span<const std::byte> payload) {
+        broadcast(makeFrame(opcode, payload));
+    }
+
+    void Broadcaster::broadcast(Frame frame) {
+        std::vector<std::shared_ptr<Group>> groups;
+
+        {
+            std::lock_guard lock(mutex_);
+            groups = groups_;
+        }
+
+        for (auto& group : groups) {
+            run(*group->reactor, [group, frame] {
+                auto& members = group->members;
+
+                // send 可能关闭连接并经回调重入 subscribe/unsubscribe/broadcast:
+                // 循环中只按下标访问，不移动元素，失效成员在最外层扇出结束后移除
+                ++group->sending;
+
+                for (std::size_t i = 0; i < members.size(); ++i) {
+                    auto connection = members[i].lock();
+                    if (connection && connection->isOpen()) connection->send(frame);
+                }
+
+                if (--group->sending > 0) return;
+
+                std::erase_if(members, [](const auto& member) {
+                    auto connection = member.lock();
+                    return !connection || !connection->isOpen();
+                });
+            });
+        }
+    }
+
+    std::shared_ptr<Broadcaster::Group> Broadcaster::group(async::Reactor& reactor) {
+        std::lock_guard lock(mutex_);
+
+        for (auto& group : groups_)
+            if (group->reactor == &reactor) return group;
+
+        return groups_.emplace_back(std::make_shared<Group>(&reactor));
+    }
+
+    void Broadcaster::run(async::Reactor& reactor, std::function<void()> task) {
+        if (reactor.isInLoopThread())
+            task();
+        else
+            reactor.post(std::move(task));
+    }
+
+}  // namespace tiny_web_server::websocket
@@ -0,0 +1,326 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file connection.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 15:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/websocket/connection.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/websocket/handshake.hpp"
+#include <cstring>
+
+namespace tiny_web_server::websocket {
+
+    namespace {
+
+        // 每次可读事件最多连续读取的次数，避免单个连接长期占用反应器
+        constexpr int MAX_READS_PER_EVENT = 4;
+
+        std::uint16_t closeCode(const std::span<const std::byte> payload) noexcept {
+            if (payload.size() < 2) return 1005;
+
+            return static_cast<std::uint16_t>(
+                std::to_integer<std::uint16_t>(payload[0]) << 8
+                | std::to_integer<std::uint16_t>(payload[1])
+            );
+        }
+
+        /**
+         * @brief 关闭帧中允许出现的状态码(RFC 6455 7.4)
+         * @details 1004/1005/1006/1015 为保留值，不得出现在帧中
+         */
+        bool isValidCloseCode(const std::uint16_t code) noexcept {
+            if (code >= 3000 && code <= 4999) return true;
+
+            if (code == 1004 || code == 1005 || code == 1006) return false;
+
+            return code >= 1000 && code <= 1014;
+        }
+
+    }  // namespace
+
+    Connection::Connection(
+        Private, net::Socket socket, async::Reactor& reactor, MessageHandler onMessage,
+        const ConnectionOptions& options
+    )
+        : socket_(std::move(socket))
+        , reactor_(reactor)
+        , options_(options)
+        , onMessage_(std::move(onMessage))
+        , input_(options.receiveBufferSize) {}
+
+    std::shared_ptr<Connection> Connection::upgrade(
+        net::Socket socket, const http::Request& request, std::span<const std::byte> rest,
+        async::Reactor& reactor, MessageHandler onMessage, const ConnectionOptions& options
+    ) {
+        auto response = handshakeResponse(request);
+
+        socket.setNonBlocking();
+
+        auto connection = std::make_shared<Connection>(
+            Private{}, std::move(socket), reactor, std::move(onMessage), options
+        );
+
+        auto& input = connection->input_;
+        if (rest.size() > input.size()) input.resize(rest.size());
+
+        std::memcpy(input.data(), rest.data(), rest.size());
+        connection->inputEnd_ = rest.size();
+
+        reactor.add(
+            connection->socket_.nativeHandle(),
+            async::EventType::READ | async::EventType::HANGUP,
+            [self = connection](async::EventType events) { self->handleEvents(events); }
+        );
+
+        auto bytes = std::as_bytes(std::span{response});
+        connection->send(std::make_shared<Frame::element_type>(bytes.begin(), bytes.end()));
+
+        // 客户端可能在握手响应前就发送了帧
+        if (connection->inputEnd_ > 0) connection->processFrames();
+
+        return connection;
+    }
+
+    void Connection::send(const Opcode opcode, const std::span<const std::byte> payload) {
+        send(makeFrame(opcode, payload));
+    }
+
+    void Connection::send(Frame frame) {
+        if (closed_ || closeSent_) return;
+
+        pendingBytes_ += frame->size();
+
+        if (pendingBytes_ > options_.maxPendingBytes) return shutdown(1008);
+
+        output_.push_back(std::move(frame));
+
+        if (writing_) return;
+
+        // 广播器在扇出循环中调用，发送错误在此关闭连接而不是抛给调用者
+        try {
+            writable();
+        } catch (const std::exception&) { shutdown(1006); }
+    }
+
+    void Connection::close(const std::uint16_t code, const std::string_view reason) {
+        if (closed_ || closeSent_) return;
+
+        send(Opcode::CLOSE, closePayload(code, reason));
+        closeSent_ = true;
+    }
+
+    void Connection::onClose(CloseHandler handler) { onClose_ = std::move(handler); }
+
+    bool Connection::isOpen() const noexcept { return !closed_ && !closeSent_; }
+
+    async::Reactor& Connection::reactor() const noexcept { return reactor_; }
+
+    const net::Socket& Connection::socket() const noexcept { return socket_; }
+
+    void Connection::handleEvents(const async::EventType events) {
+        auto self = shared_from_this();
+
+        try {
+            if (events & async::EventType::ERROR) return shutdown(1006);
+
+            if (events & async::EventType::WRITE) writable();
+
+            if (!closed_ && (events & (async::EventType::READ | async::EventType::HANGUP)))
+                readable();
+        } catch (const std::exception&) { shutdown(1006); }
+    }
+
+    void Connection::readable() {
+        for (auto i = 0; i < MAX_READS_PER_EVENT && !closed_; ++i) {
+            // 缓冲区尾部已满: 先把未处理的数据移到头部
+            if (inputEnd_ == input_.size() && inputBegin_ > 0) {
+                auto size = inputEnd_ - inputBegin_;
+
+                std::memmove(input_.data(), input_.data() + inputBegin_, size);
+                inputBegin_ = 0;
+                inputEnd_   = size;
+            }
+
+            auto received = socket_.tryRecv(std::span{input_}.subspan(inputEnd_));
+
+            if (!received) return;
+
+            if (*received == 0) return shutdown(1006);
+
+            inputEnd_ += *received;
+            processFrames();
+        }
+    }
+
+    void Connection::writable() {
+        metrics::ScopedTimer timer(metrics::server().writeTime);
+
+        while (!output_.empty()) {
+            const auto& front = *output_.front();
+
+            auto sent = socket_.trySend(std::span{front}.subspan(outputOffset_));
+            if (!sent) break;
+
+            outputOffset_ += *sent;
+
+            if (outputOffset_ == front.size()) {
+                pendingBytes_ -= front.size();
+                outputOffset_ = 0;
+                output_.pop_front();
+            }
+        }
+
+        auto want = !output_.empty();
+
+        if (want != writing_) {
+            writing_    = want;
+            auto events = async::EventType::READ | async::EventType::HANGUP;
+
+            reactor_.modify(
+                socket_.nativeHandle(), want ? events | async::EventType::WRITE : events
+            );
+        }
+
+        // 双方的关闭帧都已收发完毕
+        if (!want && closeSent_ && closeReceived_) shutdown(closeCode_);
+    }
+
+    void Connection::processFrames() {
+        while (!closed_ && !closeReceived_) {
+            auto available =
+                std::span{input_}.subspan(inputBegin_, inputEnd_ - inputBegin_);
+
+            FrameHeader header;
+            auto status = parseHeader(available, header);
+
+            if (status == ParseStatus::INCOMPLETE) break;
+
+            // 客户端发来的帧必须加掩码
+            if (status == ParseStatus::ERROR || !header.masked) return fail(1002);
+
+            if (header.payloadLength > options_.maxMessageSize) return fail(1009);
+
+            auto total = header.headerLength + header.payloadLength;
+
+            if (available.size() < total) {
+                // 缓冲区放不下整帧时扩容，压缩留给 readable
+                if (total > input_.size() - inputBegin_) {
+                    std::memmove(input_.data(), available.data(), available.size());
+                    inputEnd_   = available.size();
+                    inputBegin_ = 0;
+
+                    if (total > input_.size()) input_.resize(total);
+                }
+
+                break;
+            }
+
+            auto payload = available.subspan(header.headerLength, header.payloadLength);
+            if (header.masked) unmask(payload, header.maskKey);
+
+            inputBegin_ += total;
+            dispatch(header, payload);
+        }
+
+        if (inputBegin_ == inputEnd_) inputBegin_ = inputEnd_ = 0;
+
+        // 为大帧扩容的缓冲区在帧消费完后归还，空闲连接不长期占用消息上限级别的内存
+        if (inputEnd_ == 0 && input_.size() > options_.receiveBufferSize)
+            std::vector<std::byte>(options_.receiveBufferSize).swap(input_);
+    }
+
+    void Connection::dispatch(const FrameHeader& header, std::span<std::byte> payload) {
+        switch (header.opcode) {
+            case Opcode::PING: return send(Opcode::PONG, payload);
+
+            case Opcode::PONG: return;
+
+            case Opcode::CLOSE: {
+                closeReceived_ = true;
+                closeCode_     = closeCode(payload);
+
+                // 不允许的状态码是协议错误; 只有1字节的载荷解析为 1005，同样不允许
+                if (!payload.empty() && !isValidCloseCode(closeCode_)) closeCode_ = 1002;
+
+                // 对端发起的关闭需回送关闭帧(空载荷回 1000，否则回送其状态码);
+                // 待发送队列清空后由 writable 关闭连接
+                if (!closeSent_) close(closeCode_ == 1005 ? 1000 : closeCode_);
+
+                if (output_.empty()) shutdown(closeCode_);
+                return;
+            }
+
+            case Opcode::CONTINUATION: {
+                if (!fragmented_) return fail(1002);
+
+                if (message_.size() + payload.size() > options_.maxMessageSize)
+                    return fail(1009);
+
+                message_.insert(message_.end(), payload.begin(), payload.end());
+
+                if (!header.fin) return;
+
+                fragmented_ = false;
+                deliver(messageOpcode_, message_);
+
+                if (message_.capacity() > options_.receiveBufferSize)
+                    std::vector<std::byte>{}.swap(message_);
+                else
+                    message_.clear();
+                return;
+            }
+
+            default: {
+                if (fragmented_) return fail(1002);
+
+                if (!header.fin) {
+                    fragmented_    = true;
+                    messageOpcode_ = header.opcode;
+                    message_.assign(payload.begin(), payload.end());
+                    return;
+                }
+
+                // 未分片消息直接以接收缓冲区中的视图交付
+                deliver(header.opcode, payload);
+            }
+        }
+    }
+
+    void Connection::deliver(const Opcode opcode, const std::span<const std::byte> payload) {
+        if (!onMessage_ || closeSent_) return;
+
+        metrics::ScopedTimer timer(metrics::server().handlerTime);
+        onMessage_(*this, opcode, payload);
+    }
+
+    void Connection::fail(const std::uint16_t code) {
+        close(code);
+        shutdown(code);
+    }
+
+    void Connection::shutdown(const std::uint16_t code) {
+        if (closed_) return;
+
+        auto self = shared_from_this();
+
+        closed_ = true;
+        reactor_.remove(socket_.nativeHandle());
+        socket_.close();
+
+        output_.clear();
+        pendingBytes_ = 0;
+
+        if (onClose_) onClose_(*this, code);
+    }
+
+}  // namespace tiny_web_server::websocket
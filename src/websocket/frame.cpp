@@ -0,0 +1,217 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file frame.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 14:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/websocket/frame.hpp"
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <immintrin.h>
+    #define WEB_SERVER_X86_64 1
+#else
+    #define WEB_SERVER_X86_64 0
+#endif
+
+namespace tiny_web_server::websocket {
+
+    namespace {
+
+        void unmaskScalar(std::byte* data, std::size_t size, std::uint32_t key) noexcept {
+            const auto wide = static_cast<std::uint64_t>(key) << 32 | key;
+
+            for (; size >= 8; data += 8, size -= 8) {
+                std::uint64_t word;
+                std::memcpy(&word, data, 8);
+                word ^= wide;
+                std::memcpy(data, &word, 8);
+            }
+
+            constexpr bool little = std::endian::native == std::endian::little;
+
+            for (std::size_t i = 0; i < size; ++i)
+                data[i] ^= static_cast<std::byte>(key >> (little ? i * 8 : 24 - i * 8));
+        }
+
+#if WEB_SERVER_X86_64
+        void unmaskSse2(std::byte* data, std::size_t size, std::uint32_t key) noexcept {
+            const auto mask = _mm_set1_epi32(static_cast<int>(key));
+
+            for (; size >= 16; data += 16, size -= 16) {
+                auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                block      = _mm_xor_si128(block, mask);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data), block);
+            }
+
+            unmaskScalar(data, size, key);
+        }
+
+    #if defined(__GNUC__)
+        __attribute__((target("avx2"))) void
+        unmaskAvx2(std::byte* data, std::size_t size, std::uint32_t key) noexcept {
+            const auto mask = _mm256_set1_epi32(static_cast<int>(key));
+
+            for (; size >= 32; data += 32, size -= 32) {
+                auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+                block      = _mm256_xor_si256(block, mask);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), block);
+            }
+
+            unmaskSse2(data, size, key);
+        }
+
+        const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    #endif
+#endif
+
+        void writeBigEndian(std::byte* out, std::uint64_t value, const int bytes) noexcept {
+            for (auto i = bytes - 1; i >= 0; --i, value >>= 8)
+                out[i] = static_cast<std::byte>(value & 0xFF);
+        }
+
+        std::uint64_t readBigEndian(const std::byte* in, const int bytes) noexcept {
+            std::uint64_t value = 0;
+
+            for (auto i = 0; i < bytes; ++i)
+                value = value << 8 | std::to_integer<std::uint64_t>(in[i]);
+
+            return value;
+        }
+
+    }  // namespace
+
+    ParseStatus parseHeader(const std::span<const std::byte> data, FrameHeader& header) {
+        if (data.size() < 2) return ParseStatus::INCOMPLETE;
+
+        auto b0 = std::to_integer<std::uint8_t>(data[0]);
+        auto b1 = std::to_integer<std::uint8_t>(data[1]);
+
+        // 未协商扩展，保留位必须为0
+        if (b0 & 0x70) return ParseStatus::ERROR;
+
+        header.fin    = (b0 & 0x80) != 0;
+        header.opcode = static_cast<Opcode>(b0 & 0x0F);
+        header.masked = (b1 & 0x80) != 0;
+
+        switch (header.opcode) {
+            case Opcode::CONTINUATION:
+            case Opcode::TEXT:
+            case Opcode::BINARY:
+            case Opcode::CLOSE:
+            case Opcode::PING:
+            case Opcode::PONG: break;
+            default: return ParseStatus::ERROR;
+        }
+
+        std::size_t length = b1 & 0x7F, offset = 2;
+
+        if (length == 126) {
+            if (data.size() < 4) return ParseStatus::INCOMPLETE;
+
+            length = readBigEndian(data.data() + 2, 2);
+            offset = 4;
+        }
+        else if (length == 127) {
+            if (data.size() < 10) return ParseStatus::INCOMPLETE;
+
+            length = readBigEndian(data.data() + 2, 8);
+            offset = 10;
+
+            if (length >> 63) return ParseStatus::ERROR;
+        }
+
+        if (isControl(header.opcode) && (!header.fin || length > 125))
+            return ParseStatus::ERROR;
+
+        if (header.masked) {
+            if (data.size() < offset + 4) return ParseStatus::INCOMPLETE;
+
+            std::memcpy(&header.maskKey, data.data() + offset, 4);
+            offset += 4;
+        }
+        else
+            header.maskKey = 0;
+
+        header.payloadLength = length;
+        header.headerLength  = offset;
+
+        return ParseStatus::COMPLETE;
+    }
+
+    void unmask(
+        std::span<std::byte> payload, std::uint32_t maskKey, const std::size_t offset
+    ) noexcept {
+        // 掩码按负载偏移循环，分段处理时先把密钥旋转到当前相位
+        if (auto phase = static_cast<int>(offset & 3) * 8; phase != 0)
+            maskKey = std::endian::native == std::endian::little ? std::rotr(maskKey, phase)
+                                                                 : std::rotl(maskKey, phase);
+
+        auto* data = payload.data();
+        auto size  = payload.size();
+
+#if WEB_SERVER_X86_64
+    #if defined(__GNUC__)
+        if (hasAvx2 && size >= 64) return unmaskAvx2(data, size, maskKey);
+    #endif
+
+        unmaskSse2(data, size, maskKey);
+#else
+        unmaskScalar(data, size, maskKey);
+#endif
+    }
+
+    std::size_t encodeHeader(
+        std::span<std::byte> out, const Opcode opcode, const std::uint64_t payloadLength,
+        const bool fin
+    ) noexcept {
+        out[0] = static_cast<std::byte>(opcode) | (fin ? std::byte{0x80} : std::byte{0});
+
+        if (payloadLength < 126) {
+            out[1] = static_cast<std::byte>(payloadLength);
+            return 2;
+        }
+
+        if (payloadLength <= 0xFFFF) {
+            out[1] = std::byte{126};
+            writeBigEndian(out.data() + 2, payloadLength, 2);
+            return 4;
+        }
+
+        out[1] = std::byte{127};
+        writeBigEndian(out.data() + 2, payloadLength, 8);
+        return 10;
+    }
+
+    Frame makeFrame(Opcode opcode, std::span<const std::byte> payload, const bool fin) {
+        std::byte header[10];
+        auto headerLength = encodeHeader(header, opcode, payload.size(), fin);
+
+        auto frame = std::make_shared<std::vector<std::byte>>();
+        frame->reserve(headerLength + payload.size());
+        frame->insert(frame->end(), header, header + headerLength);
+        frame->insert(frame->end(), payload.begin(), payload.end());
+
+        return frame;
+    }
+
+    std::vector<std::byte> closePayload(const std::uint16_t code, std::string_view reason) {
+        std::vector<std::byte> payload(2 + std::min<std::size_t>(reason.size(), 123));
+
+        writeBigEndian(payload.data(), code, 2);
+        std::memcpy(payload.data() + 2, reason.data(), payload.size() - 2);
+
+        return payload;
+    }
+
+}  // namespace tiny_web_server::websocket
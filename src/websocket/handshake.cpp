@@ -0,0 +1,52 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file handshake.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 15:05
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/websocket/handshake.hpp"
+#include "tws/exception.hpp"
+#include "tws/utils/base64.hpp"
+#include "tws/utils/sha1.hpp"
+
+namespace tiny_web_server::websocket {
+
+    bool isUpgradeRequest(const http::Request& request) noexcept {
+        return request.method == "GET" && request.versionMinor >= 1
+            && request.hasToken("Upgrade", "websocket")
+            && request.hasToken("Connection", "upgrade")
+            && request.header("Sec-WebSocket-Version") == "13"
+            && request.header("Sec-WebSocket-Key").size() == 24;
+    }
+
+    std::string acceptKey(const std::string_view key) {
+        constexpr std::string_view guid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+        std::string input;
+        input.reserve(key.size() + guid.size());
+        input.append(key).append(guid);
+
+        return base64Encode(sha1(std::as_bytes(std::span{input})));
+    }
+
+    std::string handshakeResponse(const http::Request& request) {
+        if (!isUpgradeRequest(request))
+            throw HttpError<"Invalid WebSocket upgrade request"_s>();
+
+        return std::format(
+            "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+            "Connection: Upgrade\r\nSec-WebSocket-Accept: {}\r\n\r\n",
+            acceptKey(request.header("Sec-WebSocket-Key"))
+        );
+    }
+
+}  // namespace tiny_web_server::websocket
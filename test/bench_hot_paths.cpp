@@ -0,0 +1,320 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file bench_hot_paths.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 17:40
+ * @brief 热路径微基准
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/exception.hpp"
+#include "tws/http/request.hpp"
+#include "tws/http/response.hpp"
+#include "tws/net/socket.hpp"
+#include "tws/net/upstream.hpp"
+#include "tws/utils/fstr.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+
+using namespace tiny_web_server;
+
+// bench 目标以固定参数运行并输出 JSON(只保留聚合值)，便于跨提交比对:
+//   TestBenchmarks --benchmark_out=bench.json --benchmark_out_format=json
+//                  --benchmark_repetitions=5 --benchmark_report_aggregates_only=true
+
+namespace {
+
+    const std::array<std::string_view, 4> ADDRESSES{
+        "127.0.0.1", "192.168.100.254", "::1", "2001:db8:85a3::8a2e:370:7334"
+    };
+
+    constexpr std::string_view REQUEST = "GET /static/app.js?v=42 HTTP/1.1\r\n"
+                                         "Host: localhost:8080\r\n"
+                                         "User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n"
+                                         "Accept: */*\r\n"
+                                         "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+                                         "Accept-Language: en-US,en;q=0.9\r\n"
+                                         "Connection: keep-alive\r\n"
+                                         "\r\n";
+
+    /**
+     * @brief 阻塞地收满 @p buffer
+     */
+    void recvAll(const net::Socket& socket, std::span<std::byte> buffer) {
+        while (!buffer.empty()) buffer = buffer.subspan(socket.recv(buffer));
+    }
+
+    /**
+     * @brief 以 SO_LINGER(0) 关闭，跳过 TIME_WAIT 以免长时间运行耗尽临时端口
+     */
+    void closeAbortive(net::Socket& socket) {
+        linger option{1, 0};
+        setsockopt(
+            socket.nativeHandle(), SOL_SOCKET, SO_LINGER,
+            reinterpret_cast<const char*>(&option), sizeof(option)
+        );
+        socket.close();
+    }
+
+    std::pair<net::Socket, net::Socket> loopbackPair(net::Socket& listener) {
+        net::Socket client(net::AddressFamily::IPv4, net::SocketType::STREAM);
+        client.connect(listener.localEndpoint());
+        client.setOptions({.no_delay = true});
+
+        auto server = listener.accept();
+
+        return {std::move(client), std::move(server)};
+    }
+
+    net::Socket loopbackListener() {
+        net::Socket listener(net::AddressFamily::IPv4, net::SocketType::STREAM);
+        listener.setOptions({.reuse_address = true});
+        listener.bind({net::IpAddress::loopback(), 0});
+        listener.listen();
+
+        return listener;
+    }
+
+    void transfer(benchmark::State& state, const net::Socket& from, const net::Socket& to) {
+        std::vector<std::byte> out(static_cast<std::size_t>(state.range(0)), std::byte{'x'});
+        std::vector<std::byte> in(out.size());
+
+        for (auto _ : state) {
+            (void)from.send(out);
+            recvAll(to, in);
+            benchmark::DoNotOptimize(in.data());
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+
+}  // namespace
+
+// IpAddress
+
+void BM_IpAddressParse(benchmark::State& state) {
+    auto text = ADDRESSES[static_cast<std::size_t>(state.range(0))];
+
+    for (auto _ : state) {
+        net::IpAddress address{text};
+        benchmark::DoNotOptimize(address);
+    }
+
+    state.SetLabel(std::string(text));
+}
+BENCHMARK(BM_IpAddressParse)->DenseRange(0, ADDRESSES.size() - 1);
+
+void BM_IpAddressFormat(benchmark::State& state) {
+    net::IpAddress address{ADDRESSES[static_cast<std::size_t>(state.range(0))]};
+
+    for (auto _ : state) benchmark::DoNotOptimize(address.toString());
+}
+BENCHMARK(BM_IpAddressFormat)->DenseRange(0, ADDRESSES.size() - 1);
+
+void BM_IpAddressHash(benchmark::State& state) {
+    net::IpAddress address{ADDRESSES[static_cast<std::size_t>(state.range(0))]};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(address);
+        benchmark::DoNotOptimize(address.hash());
+    }
+}
+BENCHMARK(BM_IpAddressHash)->DenseRange(0, ADDRESSES.size() - 1);
+
+// Endpoint
+
+void BM_EndpointFromParts(benchmark::State& state) {
+    auto address = net::IpAddress::loopback();
+
+    for (auto _ : state) {
+        net::Endpoint endpoint{address, 8080};
+        benchmark::DoNotOptimize(endpoint);
+    }
+}
+BENCHMARK(BM_EndpointFromParts);
+
+void BM_EndpointParse(benchmark::State& state) {
+    for (auto _ : state) {
+        net::Endpoint endpoint{std::string_view{"192.168.1.20:8080"}};
+        benchmark::DoNotOptimize(endpoint);
+    }
+}
+BENCHMARK(BM_EndpointParse);
+
+void BM_EndpointToNative(benchmark::State& state) {
+    net::Endpoint endpoint{net::IpAddress::loopback(true), 8080};
+    sockaddr_storage storage;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(endpoint.toNative(storage));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_EndpointToNative);
+
+// Socket
+
+void BM_SocketPairTransfer(benchmark::State& state) {
+    auto [a, b] = net::Socket::pair();
+
+    transfer(state, a, b);
+}
+BENCHMARK(BM_SocketPairTransfer)->Arg(64)->Arg(1024)->Arg(16384);
+
+void BM_LoopbackTransfer(benchmark::State& state) {
+    auto listener         = loopbackListener();
+    auto [client, server] = loopbackPair(listener);
+
+    transfer(state, client, server);
+}
+BENCHMARK(BM_LoopbackTransfer)->Arg(64)->Arg(1024)->Arg(16384);
+
+void BM_LoopbackPingPong(benchmark::State& state) {
+    auto listener         = loopbackListener();
+    auto [client, server] = loopbackPair(listener);
+
+    std::array<std::byte, 64> message{};
+
+    for (auto _ : state) {
+        (void)client.send(message);
+        recvAll(server, message);
+        (void)server.send(message);
+        recvAll(client, message);
+    }
+}
+BENCHMARK(BM_LoopbackPingPong);
+
+void BM_LoopbackAccept(benchmark::State& state) {
+    auto listener = loopbackListener();
+    auto endpoint = listener.localEndpoint();
+
+    for (auto _ : state) {
+        net::Socket client(net::AddressFamily::IPv4, net::SocketType::STREAM);
+        client.connect(endpoint);
+
+        auto server = listener.accept();
+
+        closeAbortive(client);
+        closeAbortive(server);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoopbackAccept);
+
+// FStr
+
+void BM_FStrEqualsLiteral(benchmark::State& state) {
+    constexpr auto name = "Content-Length"_s;
+    std::string candidate{"Content-Length"};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(candidate);
+        benchmark::DoNotOptimize(name.equals(candidate.data(), candidate.size()));
+    }
+}
+BENCHMARK(BM_FStrEqualsLiteral);
+
+void BM_FStrMismatchedLength(benchmark::State& state) {
+    constexpr auto name = "Content-Length"_s;
+    std::string candidate{"Content-Type"};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(candidate);
+        benchmark::DoNotOptimize(name.equals(candidate.data(), candidate.size()));
+    }
+}
+BENCHMARK(BM_FStrMismatchedLength);
+
+void BM_FStrCompare(benchmark::State& state) {
+    constexpr auto a = "Transfer-Encoding"_s;
+    constexpr auto b = "Transfer-Encoding"_s;
+
+    for (auto _ : state) {
+        auto lhs = a;
+        benchmark::DoNotOptimize(lhs);
+        benchmark::DoNotOptimize(lhs == b);
+    }
+}
+BENCHMARK(BM_FStrCompare);
+
+// 请求解析
+
+void BM_RequestParse(benchmark::State& state) {
+    http::RequestParser parser;
+    http::Request request;
+
+    for (auto _ : state) {
+        parser.reset();
+        request.clear();
+
+        benchmark::DoNotOptimize(parser.parse(REQUEST, request));
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(REQUEST.size()));
+}
+BENCHMARK(BM_RequestParse);
+
+// 响应头
+
+void BM_ResponseBuilder(benchmark::State& state) {
+    http::ResponseBuilder response;
+
+    for (auto _ : state) {
+        response.clear();
+        response.status(200)
+            .header("Content-Type", "text/plain")
+            .header("Content-Length", std::uint64_t{12345})
+            .date()
+            .header("Connection", "keep-alive")
+            .end();
+
+        benchmark::DoNotOptimize(response.view().data());
+    }
+}
+BENCHMARK(BM_ResponseBuilder);
+
+void BM_ResponseTemplate(benchmark::State& state) {
+    const http::ResponseTemplate response{200, {{"Content-Type", "text/plain"}}};
+    std::string head;
+
+    for (auto _ : state) {
+        response.render(head, 12345);
+        benchmark::DoNotOptimize(head.data());
+    }
+}
+BENCHMARK(BM_ResponseTemplate);
+
+// 后端选择
+
+void BM_UpstreamSelect(benchmark::State& state) {
+    std::vector<net::Endpoint> backends;
+    for (auto i = 1; i <= 16; ++i)
+        backends.emplace_back(net::IpAddress{"10.0.0." + std::to_string(i)}, 8080);
+
+    auto policy = static_cast<net::BalancePolicy>(state.range(0));
+
+    net::Upstream upstream{backends, {.policy = policy}};
+    net::UpstreamSelector selector{upstream};
+
+    std::uint64_t key = 0;
+
+    for (auto _ : state) {
+        auto backend = *selector.select(key++);
+        selector.complete(backend, true, std::chrono::microseconds(100));
+
+        benchmark::DoNotOptimize(backend);
+    }
+}
+BENCHMARK(BM_UpstreamSelect)->DenseRange(0, 3);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,49 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file check.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 10:20
+ * @brief 测试用的检查宏与结果汇报
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TINY_WEB_SERVER_TEST_CHECK_HPP
+#define TINY_WEB_SERVER_TEST_CHECK_HPP
+#pragma once
+
+#include <iostream>
+#include <string_view>
+
+namespace tiny_web_server::test {
+
+    /// 本测试程序中失败的检查数
+    inline int failures = 0;
+
+    /**
+     * @brief 汇报结果，全部通过时输出 @c All <name> tests passed
+     * @return 进程退出码
+     */
+    inline int report(const std::string_view name) {
+        if (failures == 0) std::cout << "All " << name << " tests passed" << std::endl;
+
+        return failures == 0 ? 0 : 1;
+    }
+
+}  // namespace tiny_web_server::test
+
+/// 检查失败时打印位置与表达式并计数，不中断当前用例
+#define CHECK(expr)                                                                        \
+    do {                                                                                   \
+        if (!(expr)) {                                                                     \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": check failed: " #expr << '\n'; \
+            ++tiny_web_server::test::failures;                                             \
+        }                                                                                  \
+    } while (0)
+
+#endif  // TINY_WEB_SERVER_TEST_CHECK_HPP
@@ -0,0 +1,654 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file loadgen.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:40
+ * @brief HTTP 负载生成器
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/async/reactor.hpp"
+#include "tws/metrics/metrics.hpp"
+#include "tws/net/socket.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+
+
+using namespace tiny_web_server;
+
+// 闭环(-R 0): 每个连接收到响应后立即发下一个请求，延迟从实际发送算起。
+// 开环(-R N): 全部连接合计每秒 N 个请求，按固定间隔排定每个请求的预定发送时间，
+// 延迟从预定时间算起; 服务端变慢时排队时间计入延迟，避免协调遗漏(coordinated omission)。
+// 调度精度受反应器毫秒级超时限制，迟发的部分同样计入延迟。
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string target = "127.0.0.1:8080";
+
+        std::string path = "/";
+
+        int threads = 1;
+
+        int connections = 10;
+
+        double duration = 10;
+
+        /// 每秒请求数，0 表示闭环
+        double rate = 0;
+
+        bool keepAlive = true;
+
+        std::string hgrm;
+
+        bool json = false;
+
+        /// 非空时启动该回环服务并运行场景矩阵
+        std::string server;
+
+        std::uint16_t port = 18080;
+    };
+
+    struct Result {
+        std::uint64_t requests = 0;
+
+        std::uint64_t errors = 0;
+
+        std::uint64_t bytes = 0;
+
+        double elapsed = 0;
+
+        metrics::Histogram::Snapshot latency;
+    };
+
+    /**
+     * @brief 单个客户端连接的状态
+     */
+    struct Client {
+        net::Socket socket;
+
+        bool connected = false;
+
+        bool busy = false;
+
+        bool writing = false;
+
+        /// 本次请求的计时起点: 开环为预定发送时间，闭环为实际发送时间
+        Clock::time_point start;
+
+        /// 开环下一个请求的预定发送时间
+        Clock::time_point due;
+
+        std::size_t sent = 0;
+
+        std::size_t received = 0;
+
+        /// 已解析完响应头后剩余的响应体字节数
+        std::optional<std::size_t> bodyRemaining;
+
+        std::array<std::byte, 16384> buffer;
+    };
+
+    std::optional<std::size_t> contentLength(std::string_view head) {
+        constexpr std::string_view name = "content-length:";
+
+        for (std::size_t pos = head.find("\r\n"); pos != std::string_view::npos;
+             pos             = head.find("\r\n", pos + 2)) {
+            auto line = head.substr(pos + 2, head.find("\r\n", pos + 2) - pos - 2);
+
+            if (line.size() < name.size()) continue;
+
+            auto matches = std::equal(
+                name.begin(), name.end(), line.begin(),
+                [](char a, char b) {
+                    return a == std::tolower(static_cast<unsigned char>(b));
+                }
+            );
+            if (!matches) continue;
+
+            auto value = line.substr(name.size());
+            while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+
+            std::size_t length = 0;
+            auto [_, ec] =
+                std::from_chars(value.data(), value.data() + value.size(), length);
+
+            if (ec != std::errc{}) return std::nullopt;
+
+            return length;
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief 单个线程上的一组连接，使用自己的反应器
+     */
+    struct Worker {
+    private:
+        const Options& options_;
+
+        net::Endpoint endpoint_;
+
+        std::string request_;
+
+        async::Reactor reactor_;
+
+        std::vector<std::unique_ptr<Client>> clients_;
+
+        metrics::Histogram& latency_;
+
+        /// 开环时每个连接的请求间隔
+        Clock::duration interval_{};
+
+    public:
+        std::uint64_t requests = 0;
+
+        std::uint64_t errors = 0;
+
+        std::uint64_t bytes = 0;
+
+        Worker(
+            const Options& options, const int connections, const double rate,
+            metrics::Histogram& latency
+        )
+            : options_(options)
+            , endpoint_(std::string_view{options.target})
+            , latency_(latency) {
+            request_ = "GET " + options.path + " HTTP/1.1\r\nHost: " + options.target
+                       + "\r\nUser-Agent: tws-loadgen\r\n"
+                       + (options.keepAlive ? "" : "Connection: close\r\n") + "\r\n";
+
+            if (rate > 0)
+                interval_ = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(connections / rate)
+                );
+
+            for (auto i = 0; i < connections; ++i)
+                clients_.push_back(std::make_unique<Client>());
+        }
+
+        void run(const Clock::time_point begin, const Clock::time_point end) {
+            // 开环时把各连接的首个请求均匀错开，避免同时突发
+            for (std::size_t i = 0; i < clients_.size(); ++i)
+                clients_[i]->due = begin + interval_ * i / clients_.size();
+
+            while (true) {
+                auto now = Clock::now();
+                if (now >= end) break;
+
+                auto wake = end;
+
+                for (auto& client : clients_) {
+                    if (client->busy) continue;
+
+                    if (interval_ == Clock::duration{} || client->due <= now)
+                        start(*client, now);
+                    else
+                        wake = std::min(wake, client->due);
+                }
+
+                auto timeout = std::chrono::ceil<std::chrono::milliseconds>(wake - now);
+                auto ms      = std::clamp<long>(timeout.count(), 0, 100);
+
+                reactor_.runOnce(static_cast<int>(ms));
+            }
+
+            for (auto& client : clients_) disconnect(*client);
+        }
+
+    private:
+        void start(Client& client, const Clock::time_point now) {
+            client.busy  = true;
+            client.start = interval_ == Clock::duration{} ? now : client.due;
+            client.due += interval_;
+
+            client.sent          = 0;
+            client.received      = 0;
+            client.bodyRemaining = std::nullopt;
+
+            try {
+                if (!client.connected) return connect(client);
+
+                send(client);
+            } catch (const std::system_error&) { fail(client); }
+        }
+
+        void connect(Client& client) {
+            client.socket = net::Socket(net::AddressFamily::IPv4, net::SocketType::STREAM);
+            client.socket.setNonBlocking();
+            client.socket.setOptions({.no_delay = true});
+
+            auto connected = client.socket.tryConnect(endpoint_);
+
+            reactor_.add(
+                client.socket.nativeHandle(),
+                async::EventType::READ | async::EventType::WRITE | async::EventType::HANGUP,
+                [this, &client](async::EventType events) { onEvents(client, events); }
+            );
+
+            client.writing   = true;
+            client.connected = true;
+
+            if (connected) send(client);
+        }
+
+        void disconnect(Client& client) {
+            if (!client.connected) return;
+
+            reactor_.remove(client.socket.nativeHandle());
+            client.socket.close();
+
+            client.connected = false;
+            client.writing   = false;
+        }
+
+        void onEvents(Client& client, const async::EventType events) {
+            try {
+                if (events & async::EventType::ERROR) return fail(client);
+
+                if (events & async::EventType::WRITE) {
+                    if (client.sent == 0 && client.socket.error()) return fail(client);
+
+                    send(client);
+                }
+
+                if (events & (async::EventType::READ | async::EventType::HANGUP))
+                    receive(client);
+            } catch (const std::system_error&) { fail(client); }
+        }
+
+        void send(Client& client) {
+            while (client.sent < request_.size()) {
+                auto pending = std::string_view{request_}.substr(client.sent);
+                auto sent    = client.socket.trySend(std::as_bytes(std::span{pending}));
+
+                if (!sent) return setWriting(client, true);
+
+                client.sent += *sent;
+            }
+
+            setWriting(client, false);
+        }
+
+        void receive(Client& client) {
+            while (client.busy) {
+                auto space    = std::span{client.buffer}.subspan(client.received);
+                auto received = client.socket.tryRecv(space);
+
+                if (!received) return;
+                if (*received == 0) return fail(client);
+
+                bytes += *received;
+
+                // 响应体只计数不保存
+                if (client.bodyRemaining) {
+                    *client.bodyRemaining -= std::min(*client.bodyRemaining, *received);
+                } else {
+                    client.received += *received;
+
+                    std::string_view data{
+                        reinterpret_cast<const char*>(client.buffer.data()), client.received
+                    };
+
+                    auto end = data.find("\r\n\r\n");
+
+                    if (end == std::string_view::npos) {
+                        if (client.received == client.buffer.size()) return fail(client);
+                        continue;
+                    }
+
+                    auto head   = data.substr(0, end + 2);
+                    auto length = contentLength(head);
+
+                    if (!head.starts_with("HTTP/1.1 2") || !length) return fail(client);
+
+                    auto body            = client.received - end - 4;
+                    client.bodyRemaining = *length - std::min(*length, body);
+                    client.received      = 0;
+                }
+
+                if (*client.bodyRemaining == 0) complete(client);
+            }
+        }
+
+        void complete(Client& client) {
+            latency_.record(Clock::now() - client.start);
+            ++requests;
+
+            client.busy = false;
+
+            if (!options_.keepAlive) disconnect(client);
+        }
+
+        void fail(Client& client) {
+            ++errors;
+
+            client.busy = false;
+            disconnect(client);
+        }
+
+        void setWriting(Client& client, const bool writing) {
+            if (client.writing == writing) return;
+
+            client.writing = writing;
+            auto events    = async::EventType::READ | async::EventType::HANGUP;
+
+            reactor_.modify(
+                client.socket.nativeHandle(),
+                writing ? events | async::EventType::WRITE : events
+            );
+        }
+    };
+
+    Result runLoad(const Options& options) {
+        metrics::Histogram latency;
+
+        std::vector<std::unique_ptr<Worker>> workers(options.threads);
+
+        auto begin = Clock::now();
+        auto end   = begin + std::chrono::duration_cast<Clock::duration>(
+                           std::chrono::duration<double>(options.duration)
+                       );
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (auto i = 0; i < options.threads; ++i) {
+                // 连接数与速率按线程均分，余数给前几个线程
+                auto connections = options.connections / options.threads
+                                   + (i < options.connections % options.threads ? 1 : 0);
+                auto rate = options.rate * connections / options.connections;
+
+                threads.emplace_back([&, i, connections, rate] {
+                    workers[i] =
+                        std::make_unique<Worker>(options, connections, rate, latency);
+                    workers[i]->run(begin, end);
+                });
+            }
+        }
+
+        Result result;
+        result.elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+        result.latency = latency.snapshot();
+
+        for (const auto& worker : workers) {
+            result.requests += worker->requests;
+            result.errors += worker->errors;
+            result.bytes += worker->bytes;
+        }
+
+        return result;
+    }
+
+    std::uint64_t maxLatency(const metrics::Histogram::Snapshot& snapshot) {
+        for (auto i = snapshot.counts.size(); i-- > 0;)
+            if (snapshot.counts[i] > 0) return metrics::Histogram::bucketUpperBound(i);
+
+        return 0;
+    }
+
+    /**
+     * @brief 以 HdrHistogram 的百分位分布格式(.hgrm)输出，单位毫秒
+     */
+    void writeHgrm(std::ostream& out, const metrics::Histogram::Snapshot& snapshot) {
+        char line[128];
+
+        out << "       Value     Percentile TotalCount 1/(1-Percentile)\n\n";
+
+        std::uint64_t total = 0;
+        double mean         = 0;
+        double variance     = 0;
+
+        if (snapshot.count > 0) mean = static_cast<double>(snapshot.sum) / snapshot.count;
+
+        for (std::size_t i = 0; i < snapshot.counts.size(); ++i) {
+            if (snapshot.counts[i] == 0) continue;
+
+            total += snapshot.counts[i];
+
+            auto value      = static_cast<double>(metrics::Histogram::bucketUpperBound(i));
+            auto percentile = static_cast<double>(total) / snapshot.count;
+            auto deviation  = value - mean;
+            variance += deviation * deviation * snapshot.counts[i];
+
+            if (percentile < 1)
+                std::snprintf(
+                    line, sizeof(line), "%12.3f %14.12f %10llu %14.2f\n", value / 1e6,
+                    percentile, static_cast<unsigned long long>(total), 1 / (1 - percentile)
+                );
+            else
+                std::snprintf(
+                    line, sizeof(line), "%12.3f %14.12f %10llu\n", value / 1e6, percentile,
+                    static_cast<unsigned long long>(total)
+                );
+
+            out << line;
+        }
+
+        auto stddev = snapshot.count > 0 ? std::sqrt(variance / snapshot.count) : 0;
+
+        std::snprintf(
+            line, sizeof(line), "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean / 1e6,
+            stddev / 1e6
+        );
+        out << line;
+
+        std::snprintf(
+            line, sizeof(line), "#[Max     = %12.3f, Total count    = %12llu]\n",
+            maxLatency(snapshot) / 1e6, static_cast<unsigned long long>(snapshot.count)
+        );
+        out << line;
+    }
+
+    void report(const std::string& name, const Options& options, const Result& result) {
+        const auto& latency = result.latency;
+
+        auto micros = [&](double quantile) { return latency.quantile(quantile) / 1000; };
+
+        if (options.json) {
+            std::cout << "{\"scenario\":\"" << name << "\",\"connections\":"
+                      << options.connections << ",\"threads\":" << options.threads
+                      << ",\"keep_alive\":" << (options.keepAlive ? "true" : "false")
+                      << ",\"path\":\"" << options.path << "\",\"rate\":" << options.rate
+                      << ",\"requests\":" << result.requests
+                      << ",\"errors\":" << result.errors
+                      << ",\"bytes\":" << result.bytes
+                      << ",\"rps\":" << std::llround(result.requests / result.elapsed)
+                      << ",\"latency_us\":{\"p50\":" << micros(0.5)
+                      << ",\"p90\":" << micros(0.9) << ",\"p99\":" << micros(0.99)
+                      << ",\"p999\":" << micros(0.999) << ",\"p9999\":" << micros(0.9999)
+                      << ",\"max\":" << maxLatency(latency) / 1000 << "}}" << std::endl;
+            return;
+        }
+
+        std::cout << name << ": " << result.requests << " requests, " << result.errors
+                  << " errors in " << result.elapsed << "s, "
+                  << std::llround(result.requests / result.elapsed) << " req/s\n"
+                  << "  latency(us) p50 " << micros(0.5) << "  p90 " << micros(0.9)
+                  << "  p99 " << micros(0.99) << "  p99.9 " << micros(0.999) << "  max "
+                  << maxLatency(latency) / 1000 << std::endl;
+    }
+
+    /**
+     * @brief 启动回环服务，等到端口可连接为止
+     */
+    pid_t spawnServer(const Options& options) {
+        auto port    = std::to_string(options.port);
+        auto threads = std::to_string(options.threads);
+
+        auto pid = fork();
+
+        if (pid == 0) {
+            execl(
+                options.server.c_str(), options.server.c_str(), port.c_str(),
+                threads.c_str(), nullptr
+            );
+            _exit(127);
+        }
+
+        net::Endpoint endpoint{net::IpAddress::loopback(), options.port};
+
+        for (auto i = 0; i < 500; ++i) {
+            try {
+                net::Socket probe(net::AddressFamily::IPv4, net::SocketType::STREAM);
+                probe.connect(endpoint);
+
+                return pid;
+            } catch (const std::system_error&) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+
+        throw std::runtime_error("Loopback server did not start");
+    }
+
+    /**
+     * @brief 标准场景矩阵: 长连接与短连接、小与大响应体、少与多连接，外加一组开环
+     */
+    int runMatrix(Options options) {
+        auto pid = spawnServer(options);
+
+        options.target = "127.0.0.1:" + std::to_string(options.port);
+
+        auto failed = false;
+
+        auto scenario = [&](const std::string& name, Options variant) {
+            auto result = runLoad(variant);
+            report(name, variant, result);
+
+            if (result.requests == 0 || result.errors > 0) failed = true;
+        };
+
+        for (auto keepAlive : {true, false}) {
+            for (const char* body : {"64", "65536"}) {
+                for (auto connections : {1, 64}) {
+                    auto variant        = options;
+                    variant.keepAlive   = keepAlive;
+                    variant.path        = "/bytes/" + std::string(body);
+                    variant.connections = std::max(connections, options.threads);
+                    variant.rate        = 0;
+
+                    auto name = std::string(keepAlive ? "keepalive" : "close") + "/body"
+                                + body + "/c" + std::to_string(variant.connections);
+
+                    scenario(name, variant);
+                }
+            }
+        }
+
+        // 开环: 固定速率下的延迟才不受协调遗漏影响
+        auto variant        = options;
+        variant.path        = "/bytes/64";
+        variant.connections = std::max(64, options.threads);
+        variant.rate        = options.rate > 0 ? options.rate : 10000;
+        scenario("keepalive/body64/c64/open", variant);
+
+        kill(pid, SIGTERM);
+        waitpid(pid, nullptr, 0);
+
+        return failed ? 1 : 0;
+    }
+
+    void usage(const char* program) {
+        std::cerr
+            << "usage: " << program << " [options] [host:port]\n"
+            << "  -t <n>         threads (1)\n"
+            << "  -c <n>         connections (10)\n"
+            << "  -d <seconds>   duration (10)\n"
+            << "  -R <rate>      total requests per second, 0 for closed loop (0)\n"
+            << "  -p <path>      request path (/)\n"
+            << "  --close        new connection per request\n"
+            << "  --hgrm <file>  write the latency percentile distribution\n"
+            << "  --json         one JSON line per run\n"
+            << "  --server <exe> start a loopback server and run the scenario matrix\n"
+            << "  --port <port>  port for --server (18080)\n";
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    for (auto i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                std::exit(2);
+            }
+
+            return argv[++i];
+        };
+
+        if (arg == "-t")
+            options.threads = std::stoi(value());
+        else if (arg == "-c")
+            options.connections = std::stoi(value());
+        else if (arg == "-d")
+            options.duration = std::stod(value());
+        else if (arg == "-R")
+            options.rate = std::stod(value());
+        else if (arg == "-p")
+            options.path = value();
+        else if (arg == "--close")
+            options.keepAlive = false;
+        else if (arg == "--hgrm")
+            options.hgrm = value();
+        else if (arg == "--json")
+            options.json = true;
+        else if (arg == "--server")
+            options.server = value();
+        else if (arg == "--port")
+            options.port = static_cast<std::uint16_t>(std::stoi(value()));
+        else if (arg.starts_with('-')) {
+            usage(argv[0]);
+            return 2;
+        } else
+            options.target = arg;
+    }
+
+    options.threads     = std::max(options.threads, 1);
+    options.connections = std::max(options.connections, options.threads);
+
+    try {
+        if (!options.server.empty()) return runMatrix(options);
+
+        auto result = runLoad(options);
+        report(options.target + options.path, options, result);
+
+        if (!options.hgrm.empty()) {
+            std::ofstream out(options.hgrm);
+            writeHgrm(out, result.latency);
+        }
+
+        return result.errors > 0 ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,834 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file loopback_server.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 18:10
+ * @brief 压测用的回环 HTTP 服务
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/async/affinity.hpp"
+#include "tws/async/reactor.hpp"
+#include "tws/http/admission.hpp"
+#include "tws/http/body.hpp"
+#include "tws/http/connection_pool.hpp"
+#include "tws/http/response.hpp"
+#include "tws/http/static_bundle.hpp"
+#include "tws/http2/connection.hpp"
+#include "tws/logging/access_log.hpp"
+#include "tws/net/tcp_telemetry.hpp"
+#include <charconv>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace tiny_web_server;
+
+// 由 TestLoadGen 启动: TestLoopbackServer <port> [threads] [trace.json]
+// GET /bytes/<n> 返回 n 字节的响应体，其余路径返回 "ok"。
+// 带请求体的请求流式接收后以请求体字节数响应; POST /upload 的请求体写入临时文件(经 splice)，
+// 设置 TWS_UPLOAD_DIR 时写入并保留在该目录中，否则响应后删除。
+// 每个线程一个反应器与连接池，各自以 SO_REUSEPORT 监听同一端口。
+// 给出 trace.json 时开启请求追踪，退出时写出 Chrome 追踪格式的各阶段耗时。
+// 以连接序言开头或携带 Upgrade: h2c 的连接移交给 HTTP/2 连接处理。
+// 设置 TWS_CPUS(如 0-7)时第 i 个线程绑定到其中第 i 个 CPU，在绑定后创建自己的反应器与连接池，
+// 线程数不超过 CPU 数时让内核把在某个 CPU 上到达的新连接交给绑定在该 CPU 上的线程;
+// 接收 CPU 与线程的对应关系以指标导出。
+// 设置 TWS_BUSY_POLL(微秒)时开启混合忙轮询: 反应器阻塞前先自旋，监听套接字(及其接受的连接)
+// 与 epoll 实例同时开启内核忙轮询，后者需要 CAP_NET_ADMIN。
+// 设置 TWS_TCP_SAMPLE=<n> 时每 n 个连接采样一个，每次响应发出后按客户端网段记录其 TCP_INFO。
+// 设置 TWS_BUNDLE 为 PackBundle 生成的资源包时，其中的路径由资源包响应(GET，支持 If-None-Match)。
+// 设置 TWS_ACCESS_LOG 为文件路径时为不带请求体的请求写访问日志，收到 SIGHUP 时轮转。
+
+namespace {
+
+    constexpr std::size_t MAX_BODY_SIZE = 16 << 20;
+
+    constexpr std::uint64_t MAX_UPLOAD_SIZE = std::uint64_t{64} << 30;
+
+    /// 每个线程的连接上限，满时淘汰最久未活动的空闲连接
+    constexpr std::size_t MAX_CONNECTIONS = 10000;
+
+    std::atomic<bool> stopping = false;
+
+    const std::string& bodyStorage() {
+        static const std::string storage(MAX_BODY_SIZE, 'x');
+        return storage;
+    }
+
+    /**
+     * @brief 连接池之外的写状态: 响应头复制一份，响应体直接引用静态存储
+     */
+    struct Session {
+        http::ConnectionPool::Handle handle;
+
+        std::string head;
+
+        std::string_view body;
+
+        std::size_t offset = 0;
+
+        /// 正在接收请求体时非空
+        std::optional<http::BodyReader> reader;
+
+        std::optional<http::UploadFile> upload;
+
+        /// 被采样的连接非空
+        std::optional<net::TcpTelemetry::Probe> probe;
+
+        /// 开启访问日志时在接受连接时记录
+        std::optional<net::Endpoint> peer;
+
+        /// 带请求体的请求的响应体
+        std::string result;
+
+        bool closeAfterWrite = false;
+
+        bool writing = false;
+    };
+
+    const http::ResponseTemplate& okTemplate() {
+        static const http::ResponseTemplate response{200, {{"Content-Type", "text/plain"}}};
+        return response;
+    }
+
+    const std::filesystem::path& uploadDirectory() {
+        static const std::filesystem::path directory = [] {
+            const auto* configured = std::getenv("TWS_UPLOAD_DIR");
+            return configured ? configured : std::filesystem::temp_directory_path();
+        }();
+
+        return directory;
+    }
+
+    /// TWS_BUSY_POLL 给出的忙轮询时长，未设置时为 0
+    int busyPollUs() {
+        static const int us = [] {
+            const auto* configured = std::getenv("TWS_BUSY_POLL");
+            return configured ? std::stoi(configured) : 0;
+        }();
+
+        return us;
+    }
+
+    /// TWS_TCP_SAMPLE 未设置时为空
+    net::TcpTelemetry* tcpTelemetry() {
+        static const auto telemetry = []() -> std::unique_ptr<net::TcpTelemetry> {
+            const auto* configured = std::getenv("TWS_TCP_SAMPLE");
+            if (!configured) return nullptr;
+
+            auto every = static_cast<std::uint32_t>(std::stoul(configured));
+            return std::make_unique<net::TcpTelemetry>(net::TcpTelemetryOptions{every});
+        }();
+
+        return telemetry.get();
+    }
+
+    /// TWS_BUNDLE 未设置时为空
+    const http::StaticBundle* staticBundle() {
+        static const auto bundle = []() -> std::unique_ptr<http::StaticBundle> {
+            const auto* configured = std::getenv("TWS_BUNDLE");
+            if (!configured) return nullptr;
+
+            auto bundle = http::StaticBundle::open(configured);
+            return std::make_unique<http::StaticBundle>(std::move(bundle));
+        }();
+
+        return bundle.get();
+    }
+
+    /// TWS_ACCESS_LOG 未设置时为空
+    logging::AccessLog* accessLog() {
+        static const auto log = []() -> std::unique_ptr<logging::AccessLog> {
+            const auto* configured = std::getenv("TWS_ACCESS_LOG");
+            if (!configured) return nullptr;
+
+            // 日志析构时仍会更新指标，注册表须先于日志构造、后于日志析构
+            (void)metrics::Registry::global();
+
+            logging::AccessLogOptions options{.path = configured};
+            return std::make_unique<logging::AccessLog>(std::move(options));
+        }();
+
+        return log.get();
+    }
+
+    /**
+     * @brief 请求的路径在资源包中时，以预先序列化的响应头与映射中的内容作为响应
+     * @return 未命中时返回 false
+     */
+    bool bundleResponse(
+        const http::Request& request, std::string& head, std::string_view& body,
+        const bool keepAlive
+    ) {
+        const auto* bundle = staticBundle();
+        if (!bundle || request.method != "GET") return false;
+
+        auto entry = bundle->find(request.target.substr(0, request.target.find('?')));
+        if (!entry) return false;
+
+        auto variant =
+            bundle->select(*entry, http::AcceptEncoding{request.header("Accept-Encoding")});
+
+        if (http::matchesETag(request.header("If-None-Match"), variant.etag)) {
+            http::ResponseBuilder response;
+            response.status(304).header("ETag", variant.etag);
+
+            if (variant.varies) response.header("Vary", "Accept-Encoding");
+
+            response.date().header("Connection", keepAlive ? "keep-alive" : "close").end();
+
+            head.assign(response.view());
+            body = {};
+
+            return true;
+        }
+
+        variant.render(head, keepAlive);
+        body = {reinterpret_cast<const char*>(variant.body.data()), variant.body.size()};
+
+        return true;
+    }
+
+    std::string_view route(std::string_view target) {
+        constexpr std::string_view prefix = "/bytes/";
+
+        if (!target.starts_with(prefix)) return "ok";
+
+        target.remove_prefix(prefix.size());
+
+        std::size_t size = 0;
+        std::from_chars(target.data(), target.data() + target.size(), size);
+
+        return std::string_view{bodyStorage()}.substr(0, size);
+    }
+
+    struct Worker {
+    private:
+        async::Reactor reactor_;
+
+        http::ConnectionPool pool_{MAX_CONNECTIONS};
+
+        net::Socket listener_;
+
+        http::AdmissionController admission_;
+
+        bool acceptPaused_ = false;
+
+        std::size_t index_;
+
+        /// 绑定的 CPU，未绑定时为 -1
+        int cpu_;
+
+        /// HTTP/2 响应体按长度缓存，由各流共享; "ok" 以 SIZE_MAX 为键
+        std::unordered_map<std::size_t, std::shared_ptr<const std::vector<std::byte>>>
+            bodies_;
+
+    public:
+        /**
+         * @param steerCpus 非空时在监听套接字上附加按接收 CPU 分发的程序，组内设置一次即可;
+         * 第 i 项为第 i 个线程绑定的 CPU
+         */
+        Worker(
+            const std::uint16_t port, const std::size_t index, const int cpu,
+            const std::span<const int> steerCpus
+        )
+            : listener_(net::AddressFamily::IPv4, net::SocketType::STREAM)
+            , index_(index)
+            , cpu_(cpu) {
+            listener_.setOptions({.reuse_address = true, .reuse_port = true});
+
+            // 忙轮询设置由接受的连接继承
+            if (auto us = busyPollUs(); us > 0)
+                listener_.setOptions({.busy_poll_us = us, .prefer_busy_poll = true});
+            listener_.bind({net::IpAddress::loopback(), port});
+            listener_.listen();
+            listener_.setNonBlocking();
+
+            if (!steerCpus.empty()) listener_.steerByIncomingCpu(steerCpus);
+        }
+
+        void run() {
+            reactor_.add(listener_.nativeHandle(), async::EventType::READ, [this](auto) {
+                acceptAll();
+            });
+
+            if (auto us = busyPollUs(); us > 0) {
+                auto kernel = reactor_.setBusyPoll({
+                    .spin           = std::chrono::microseconds(us),
+                    .kernelPollUs   = static_cast<std::uint32_t>(us),
+                    .preferBusyPoll = true,
+                });
+
+                if (!kernel) std::cerr << "epoll busy polling is not supported" << std::endl;
+            }
+
+            auto nextSweep = http::Clock::now() + std::chrono::seconds(1);
+
+            while (!stopping.load(std::memory_order_relaxed)) {
+                reactor_.runOnce(100);
+
+                if (acceptPaused_ && !admission_.overloaded()) pauseAccept(false);
+
+                // 慢速与空闲连接由每秒一次的扫描清理
+                auto now = http::Clock::now();
+                if (now < nextSweep) continue;
+
+                pool_.sweep(now, [this](http::Connection& connection) {
+                    forget(connection);
+                });
+                nextSweep = now + std::chrono::seconds(1);
+            }
+        }
+
+    private:
+        void acceptAll() {
+            // 过载时让新连接留在内核积压队列中
+            if (admission_.overloaded()) return pauseAccept(true);
+
+            while (true) {
+                net::Socket socket;
+
+                try {
+                    socket = listener_.accept();
+                } catch (const std::system_error&) { return; }
+
+                socket.setNonBlocking();
+                socket.setOptions({.no_delay = true});
+
+                if (cpu_ >= 0) async::recordIncomingCpu(index_, cpu_, socket.incomingCpu());
+
+                auto handle = pool_.open(
+                    std::move(socket), http::Clock::now(),
+                    [this](http::Connection& connection) { forget(connection); }
+                );
+                if (!handle) continue;
+
+                auto session    = std::make_shared<Session>();
+                session->handle = handle;
+
+                if (auto* telemetry = tcpTelemetry()) {
+                    const auto& socket = pool_.get(handle)->socket;
+                    session->probe     = telemetry->probe(socket.peerEndpoint().address());
+                }
+
+                if (accessLog()) session->peer = pool_.get(handle)->socket.peerEndpoint();
+
+                auto native = pool_.get(handle)->socket.nativeHandle();
+
+                reactor_.add(
+                    native, async::EventType::READ | async::EventType::HANGUP,
+                    [this, session](async::EventType events) { onEvents(*session, events); }
+                );
+            }
+        }
+
+        void onEvents(Session& session, const async::EventType events) {
+            if (!pool_.get(session.handle)) return;
+
+            try {
+                if (events & async::EventType::ERROR) return close(session);
+
+                // 写完后先处理缓冲区中已到达的流水线请求
+                if (events & async::EventType::WRITE) {
+                    if (!flush(session)) return;
+                    process(session);
+                }
+
+                if (!session.writing && pool_.get(session.handle)) readable(session);
+            } catch (const std::system_error&) { close(session); }
+        }
+
+        void readable(Session& session) {
+            // 请求体由 receiveBody 自行读取，以便绕过接收缓冲区
+            if (session.reader) return process(session);
+
+            auto& connection = *pool_.get(session.handle);
+
+            auto space    = std::span{connection.buffer}.subspan(connection.received);
+            auto received = connection.socket.tryRecv(space);
+
+            if (!received) return;
+            if (*received == 0) return close(session);
+
+            connection.trace.markOnce(metrics::Stage::FIRST_READ);
+            // 以本轮事件到达的时刻为活动时刻: 准入控制据此计算排队延迟，
+            // 由空闲转为活跃时也从此刻起计算接收速率
+            pool_.touch(connection, false, reactor_.pollTime());
+
+            connection.received += *received;
+            connection.readBytes += *received;
+
+            process(session);
+        }
+
+        /**
+         * @brief 逐个处理缓冲区中的请求，写阻塞时留到可写后继续
+         */
+        void process(Session& session) {
+            auto& connection = *pool_.get(session.handle);
+
+            while (!session.writing && pool_.get(session.handle)) {
+                // 上一个请求的请求体尚未接收完
+                if (session.reader) {
+                    if (!receiveBody(session, connection)) return;
+
+                    connection.endRead();
+                    respondBody(session, connection);
+
+                    if (!next(session, connection)) return;
+                    continue;
+                }
+
+                auto& context = connection.context;
+                auto received = std::as_bytes(std::span{connection.data()});
+
+                // 先验知识的连接序言不是合法的 HTTP/1.1 请求行
+                if (http2::detectPreface(received) == true)
+                    return startHttp2(session, nullptr);
+
+                auto status = connection.parser.parse(connection.data(), context.request);
+
+                if (status == http::RequestParser::Status::INCOMPLETE) {
+                    if (connection.received == connection.buffer.size()) close(session);
+                    return;
+                }
+
+                if (status == http::RequestParser::Status::ERROR) return close(session);
+
+                connection.trace.mark(metrics::Stage::HEADERS_PARSED);
+
+                if (http2::isUpgradeRequest(context.request)) {
+                    connection.endRead();
+                    return startHttp2(session, &context.request);
+                }
+
+                // 过载时尽力发送预先构造的 503 后立即关闭
+                if (!admission_.admit(connection)) {
+                    auto rejected = http::AdmissionController::overloadResponse();
+                    (void)connection.socket.trySend(rejected);
+
+                    return close(session);
+                }
+
+                auto framing = http::BodyFraming::of(context.request);
+
+                if (framing.type == http::BodyFraming::Type::INVALID)
+                    return reject(session, 400);
+
+                if (framing.type != http::BodyFraming::Type::NONE) {
+                    startBody(session, connection, framing);
+                    continue;
+                }
+
+                auto started = connection.readStart;
+
+                connection.endRead();
+                respond(session, connection, started);
+
+                // 移除已处理的请求头
+                consume(connection, connection.parser.headerLength());
+
+                connection.parser.reset();
+                context.reset();
+
+                if (!next(session, connection)) return;
+            }
+        }
+
+        /**
+         * @brief 发送响应，并为缓冲区中的下一个请求做准备
+         * @return 可以继续处理下一个请求时返回 true
+         */
+        bool next(Session& session, http::Connection& connection) {
+            if (!flush(session)) return false;
+
+            if (session.probe) (void)session.probe->sample(connection.socket);
+
+            if (connection.received == 0) {
+                pool_.touch(connection, true);
+                return false;
+            }
+
+            // 缓冲区中还有下一个请求的数据
+            connection.beginRead(http::Clock::now());
+            return true;
+        }
+
+        static void consume(http::Connection& connection, const std::size_t size) {
+            std::memmove(
+                connection.buffer.data(), connection.buffer.data() + size,
+                connection.received - size
+            );
+            connection.received -= size;
+        }
+
+        /**
+         * @brief 开始接收请求体; 请求头在此之后失效
+         * @details 解析器保持完成状态直到请求体结束，连接仍受接收速率下限约束
+         */
+        void startBody(
+            Session& session, http::Connection& connection, const http::BodyFraming framing
+        ) {
+            const auto& request = connection.context.request;
+
+            session.closeAfterWrite = !request.keepAlive();
+            session.reader.emplace(framing, MAX_UPLOAD_SIZE);
+
+            if (session.reader->status() == http::BodyReader::Status::TOO_LARGE)
+                return reject(session, 413);
+
+            if (request.target == "/upload")
+                session.upload = http::UploadFile::create(uploadDirectory());
+
+            if (request.hasToken("Expect", "100-continue")) {
+                constexpr std::string_view CONTINUE = "HTTP/1.1 100 Continue\r\n\r\n";
+                (void)connection.socket.trySend(std::as_bytes(std::span{CONTINUE}));
+            }
+
+            consume(connection, connection.parser.headerLength());
+        }
+
+        /**
+         * @brief 接收请求体: 先消费缓冲区中的数据，缓冲区为空时上传数据直接 splice 到文件
+         * @return 请求体接收完整时返回 true; 需等待数据或连接已关闭时返回 false
+         */
+        bool receiveBody(Session& session, http::Connection& connection) {
+            using Status = http::BodyReader::Status;
+
+            auto& reader = *session.reader;
+
+            while (!reader.complete()) {
+                if (connection.received > 0) {
+                    auto input  = std::span{connection.buffer}.first(connection.received);
+                    auto result = reader.read(input);
+
+                    if (result.status == Status::ERROR) {
+                        reject(session, 400);
+                        return false;
+                    }
+                    if (result.status == Status::TOO_LARGE) {
+                        reject(session, 413);
+                        return false;
+                    }
+
+                    if (session.upload && !result.data.empty())
+                        session.upload->write(result.data);
+
+                    consume(connection, result.consumed);
+                    continue;
+                }
+
+                if (session.upload && reader.directBytes() > 0) {
+                    auto& upload = *session.upload;
+                    auto moved   = upload.splice(connection.socket, reader.directBytes());
+
+                    if (!moved) return false;
+                    if (*moved == 0) {
+                        close(session);
+                        return false;
+                    }
+
+                    reader.advance(*moved);
+                    connection.readBytes += *moved;
+                    continue;
+                }
+
+                auto received = connection.socket.tryRecv(connection.buffer);
+
+                if (!received) return false;
+                if (*received == 0) {
+                    close(session);
+                    return false;
+                }
+
+                connection.received = *received;
+                connection.readBytes += *received;
+            }
+
+            return true;
+        }
+
+        void respondBody(Session& session, http::Connection& connection) {
+            if (session.upload && std::getenv("TWS_UPLOAD_DIR")) session.upload->keep();
+
+            session.result = std::to_string(session.reader->received());
+            session.body   = session.result;
+            session.offset = 0;
+
+            okTemplate().render(session.head, session.body.size(), !session.closeAfterWrite);
+
+            session.reader.reset();
+            session.upload.reset();
+
+            connection.parser.reset();
+            connection.context.reset();
+        }
+
+        /**
+         * @brief 尽力发送只有状态行的响应后关闭连接
+         */
+        void reject(Session& session, const int status) {
+            auto& connection = *pool_.get(session.handle);
+
+            http::ResponseBuilder response;
+            response.status(status)
+                .header("Content-Length", "0")
+                .header("Connection", "close")
+                .end();
+            (void)connection.socket.trySend(response.bytes());
+
+            close(session);
+        }
+
+        /**
+         * @param started 开始接收本请求的时刻，用于访问日志中的耗时
+         */
+        void respond(
+            Session& session, http::Connection& connection,
+            const http::Clock::time_point started
+        ) {
+            const auto& request = connection.context.request;
+            auto keepAlive      = request.keepAlive();
+
+            connection.trace.mark(metrics::Stage::HANDLER_START);
+
+            auto bundled = bundleResponse(request, session.head, session.body, keepAlive);
+            if (!bundled) session.body = route(request.target);
+
+            connection.trace.mark(metrics::Stage::HANDLER_END);
+
+            if (!bundled) okTemplate().render(session.head, session.body.size(), keepAlive);
+            session.offset          = 0;
+            session.closeAfterWrite = !keepAlive;
+
+            if (auto* log = accessLog(); log && session.peer) {
+                // 状态码取自已生成的状态行 "HTTP/1.1 NNN"
+                auto status = 0;
+                std::from_chars(session.head.data() + 9, session.head.data() + 12, status);
+
+                auto bytesOut = session.head.size() + session.body.size();
+                auto duration = http::Clock::now() - started;
+
+                log->log(logging::AccessRecord::make(
+                    *session.peer, request, status, connection.readBytes, bytesOut, duration
+                ));
+            }
+        }
+
+        /**
+         * @return 连接仍可继续读取时返回 true
+         */
+        bool flush(Session& session) {
+            auto& connection = *pool_.get(session.handle);
+
+            if (session.head.empty()) return true;
+
+            while (true) {
+                auto total = session.head.size() + session.body.size();
+                if (session.offset == total) break;
+
+                std::string_view pending;
+
+                if (session.offset < session.head.size())
+                    pending = std::string_view{session.head}.substr(session.offset);
+                else
+                    pending = session.body.substr(session.offset - session.head.size());
+
+                auto sent = connection.socket.trySend(std::as_bytes(std::span{pending}));
+
+                if (!sent) {
+                    setWriting(session, connection, true);
+                    return false;
+                }
+
+                connection.trace.markOnce(metrics::Stage::FIRST_WRITE);
+                session.offset += *sent;
+            }
+
+            connection.trace.mark(metrics::Stage::LAST_WRITE);
+            connection.trace.commit();
+
+            session.head.clear();
+            session.body   = {};
+            session.offset = 0;
+
+            setWriting(session, connection, false);
+
+            if (session.closeAfterWrite) {
+                close(session);
+                return false;
+            }
+
+            return true;
+        }
+
+        void setWriting(Session& session, http::Connection& connection, const bool writing) {
+            if (session.writing == writing) return;
+
+            session.writing = writing;
+            auto events     = async::EventType::READ | async::EventType::HANGUP;
+
+            reactor_.modify(
+                connection.socket.nativeHandle(),
+                writing ? events | async::EventType::WRITE : events
+            );
+        }
+
+        /**
+         * @brief 把连接从连接池移交给 HTTP/2 连接，之后由反应器持有
+         * @param request 升级请求，为空表示先验知识
+         */
+        void startHttp2(Session& session, const http::Request* request) {
+            auto& connection = *pool_.get(session.handle);
+            auto received    = std::as_bytes(std::span{connection.data()});
+
+            forget(connection);
+
+            auto handler = [this](auto& h2, std::uint32_t id, http2::Request& incoming) {
+                http2::Response response;
+                response.headers.push_back({"content-type", "text/plain"});
+                response.body = body(incoming.path);
+
+                h2.respond(id, std::move(response));
+            };
+
+            if (request)
+                http2::Connection::upgrade(
+                    std::move(connection.socket), *request,
+                    received.subspan(connection.parser.headerLength()), reactor_, handler
+                );
+            else
+                http2::Connection::start(
+                    std::move(connection.socket), received, reactor_, handler
+                );
+
+            pool_.close(session.handle);
+        }
+
+        std::shared_ptr<const std::vector<std::byte>> body(const std::string_view target) {
+            auto content = std::as_bytes(std::span{route(target)});
+            auto key     = target.starts_with("/bytes/") ? content.size() : SIZE_MAX;
+            auto& cached = bodies_[key];
+
+            if (!cached)
+                cached = std::make_shared<const std::vector<std::byte>>(
+                    content.begin(), content.end()
+                );
+
+            return cached;
+        }
+
+        void pauseAccept(const bool pause) {
+            acceptPaused_ = pause;
+
+            reactor_.modify(
+                listener_.nativeHandle(),
+                pause ? async::EventType::NONE : async::EventType::READ
+            );
+        }
+
+        void close(Session& session) {
+            auto* connection = pool_.get(session.handle);
+            if (!connection) return;
+
+            session.reader.reset();
+            session.upload.reset();
+
+            forget(*connection);
+            pool_.close(session.handle);
+        }
+
+        /**
+         * @brief 连接池关闭连接前从反应器中移除
+         */
+        void forget(const http::Connection& connection) {
+            reactor_.remove(connection.socket.nativeHandle());
+        }
+    };
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <port> [threads] [trace.json]" << std::endl;
+        return 2;
+    }
+
+    auto port    = static_cast<std::uint16_t>(std::stoi(argv[1]));
+    auto threads = argc > 2 ? std::stoi(argv[2]) : 1;
+
+    if (argc > 3) metrics::Tracer::enable();
+
+    std::signal(SIGTERM, [](int) { stopping = true; });
+    std::signal(SIGINT, [](int) { stopping = true; });
+
+    // 资源包与访问日志在接受连接前打开，文件无效时直接退出
+    try {
+        staticBundle();
+
+        if (accessLog()) std::signal(SIGHUP, [](int) { accessLog()->rotate(); });
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::optional<async::ThreadPlacement> placement;
+    if (const auto* cpus = std::getenv("TWS_CPUS"))
+        placement = async::ThreadPlacement::parse(cpus);
+
+    // 监听套接字按线程序号加入组，第 i 个对应线程 i 绑定的 CPU。线程多于 CPU 时多个线程共用
+    // 一个 CPU，无法一一对应，不做分发
+    std::vector<int> steerCpus;
+    if (placement && static_cast<std::size_t>(threads) <= placement->cpus.size())
+        for (auto i = 0; i < threads; ++i)
+            steerCpus.push_back(placement->cpu(static_cast<std::size_t>(i)));
+
+    {
+        std::vector<std::jthread> pool;
+
+        // 逐个在线程内创建，监听套接字按线程序号加入 SO_REUSEPORT 组
+        std::binary_semaphore created{0};
+
+        for (auto i = 0; i < threads; ++i) {
+            pool.emplace_back([&, i] {
+                auto index  = static_cast<std::size_t>(i);
+                auto pinned = placement && placement->apply(index);
+                auto cpu    = pinned ? placement->cpu(index) : -1;
+
+                auto steer  = cpu >= 0 && i == 0 ? std::span<const int>{steerCpus}
+                                                 : std::span<const int>{};
+                auto worker = std::make_unique<Worker>(port, index, cpu, steer);
+
+                created.release();
+                worker->run();
+            });
+
+            created.acquire();
+        }
+    }
+
+    if (argc > 3) {
+        std::string trace;
+        metrics::Tracer::global().exportChromeTrace(trace);
+
+        std::ofstream(argv[3]) << trace;
+    }
+
+    return 0;
+}
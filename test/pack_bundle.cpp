@@ -0,0 +1,101 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file pack_bundle.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 05:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "tws/http/static_bundle.hpp"
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+
+using namespace tiny_web_server;
+
+// 构建期把文档根目录打包为单个资源包，并重新打开校验每个文件都能通过索引找到
+
+namespace {
+
+    void usage(const char* program) {
+        std::cerr
+            << "usage: " << program << " [options] <root> <output>\n"
+            << "  --level <n>          compression level, -1 for the default (-1)\n"
+            << "  --min-size <bytes>   smallest file worth compressing (256)\n"
+            << "  --min-savings <f>    fraction a variant must save to be kept (0.1)\n";
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    http::BundleOptions options;
+    std::vector<std::string> positional;
+
+    for (auto i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                std::exit(2);
+            }
+
+            return argv[++i];
+        };
+
+        if (arg == "--level")
+            options.level = std::stoi(value());
+        else if (arg == "--min-size")
+            options.minCompressSize = std::stoul(value());
+        else if (arg == "--min-savings")
+            options.minSavings = std::stod(value());
+        else if (arg.starts_with('-')) {
+            usage(argv[0]);
+            return 2;
+        } else
+            positional.emplace_back(arg);
+    }
+
+    if (positional.size() != 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    try {
+        auto files = http::packBundle(positional[0], positional[1], options);
+
+        auto bundle = http::StaticBundle::open(positional[1]);
+
+        std::size_t found = 0;
+        std::filesystem::path root{positional[0]};
+
+        for (const auto& item : std::filesystem::recursive_directory_iterator(root)) {
+            if (!item.is_regular_file()) continue;
+
+            auto path = "/" + item.path().lexically_relative(root).generic_string();
+            if (bundle.find(path)) ++found;
+        }
+
+        if (found != files || bundle.files() != files) {
+            std::cerr << "Index verification failed: " << found << " of " << files
+                      << " files found" << std::endl;
+            return 1;
+        }
+
+        std::cout << "packed " << files << " files, "
+                  << std::filesystem::file_size(positional[1]) << " bytes" << std::endl;
+
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_access_log.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 07:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/async/spsc_ring.hpp"
+#include "tws/logging/access_log.hpp"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace tiny_web_server;
+
+void test_ring_order() {
+    async::SpscRing<int, 8> ring;
+
+    for (auto i = 0; i < 8; ++i) CHECK(ring.tryPush(i));
+
+    // 已满时拒绝而不覆盖
+    CHECK(!ring.tryPush(8));
+    CHECK(ring.size() == 8);
+
+    std::vector<int> out;
+    auto collect = [&](const int value) { out.push_back(value); };
+
+    CHECK(ring.drain(collect, 3) == 3);
+    CHECK((out == std::vector{0, 1, 2}));
+
+    // 跨越数组末尾回绕
+    for (auto i = 8; i < 11; ++i) CHECK(ring.tryPush(i));
+    CHECK(!ring.tryPush(11));
+
+    // 消费者只在缓存的生产者位置耗尽后才重新读取，可能分多次取完
+    out.clear();
+    while (ring.drain(collect) > 0) {}
+
+    CHECK((out == std::vector{3, 4, 5, 6, 7, 8, 9, 10}));
+    CHECK(ring.size() == 0);
+}
+
+void test_ring_threads() {
+    constexpr std::uint64_t COUNT = 1'000'000;
+
+    auto ring = std::make_unique<async::SpscRing<std::uint64_t, 1024>>();
+
+    std::jthread producer([&] {
+        for (std::uint64_t i = 0; i < COUNT; ++i)
+            while (!ring->tryPush(i)) std::this_thread::yield();
+    });
+
+    std::uint64_t next = 0;
+    bool ordered       = true;
+
+    while (next < COUNT) {
+        auto taken = ring->drain([&](const std::uint64_t value) {
+            ordered = ordered && value == next;
+            ++next;
+        });
+
+        if (taken == 0) std::this_thread::yield();
+    }
+
+    CHECK(ordered);
+    CHECK(next == COUNT);
+}
+
+std::filesystem::path temporaryLog(const std::string_view name) {
+    auto path = std::filesystem::temp_directory_path();
+    path /= std::string{name} + "-" + std::to_string(::getpid()) + ".log";
+
+    std::filesystem::remove(path);
+    return path;
+}
+
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+
+    std::stringstream content;
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+logging::AccessRecord record(
+    const std::string_view method, const std::string_view target, const std::uint16_t port
+) {
+    logging::AccessRecord record;
+
+    // 2026-10-19T12:34:56.789Z
+    record.timestamp = 1792413296'789'000'000;
+    record.duration  = 1'500'000;
+    record.bytesIn   = 78;
+    record.bytesOut  = 1024;
+    record.status    = 200;
+    record.port      = port;
+
+    record.methodLength = static_cast<std::uint8_t>(method.size());
+    std::memcpy(record.method.data(), method.data(), method.size());
+
+    record.targetLength = static_cast<std::uint8_t>(target.size());
+    std::memcpy(record.target.data(), target.data(), target.size());
+
+    return record;
+}
+
+void test_format() {
+    auto path = temporaryLog("tws-access-log");
+
+    {
+        logging::AccessLog log({.path = path});
+
+        auto ipv4 = record("GET", "/index.html?q=1", 51234);
+        ipv4.address[0] = std::byte{203};
+        ipv4.address[2] = std::byte{113};
+        ipv4.address[3] = std::byte{7};
+        CHECK(log.log(ipv4));
+
+        auto ipv6        = record("POST", "/upload", 443);
+        ipv6.ipv6        = true;
+        ipv6.address[15] = std::byte{1};
+        CHECK(log.log(ipv6));
+
+        // 引号、反斜杠、控制字符与非 ASCII 字节都被转义，不能伪造出新的日志行
+        CHECK(log.log(record("GET", "/a\"b\\c\x1b[31m\r\n\xff", 0)));
+    }
+
+    CHECK(readFile(path)
+          == "2026-10-19T12:34:56.789Z 203.0.113.7:51234 \"GET /index.html?q=1\" "
+             "200 78 1024 1500us\n"
+             "2026-10-19T12:34:56.789Z [::1]:443 \"POST /upload\" 200 78 1024 1500us\n"
+             "2026-10-19T12:34:56.789Z - \"GET /a\\x22b\\x5cc\\x1b[31m\\x0d\\x0a\\xff\" "
+             "200 78 1024 1500us\n");
+
+    std::filesystem::remove(path);
+}
+
+void test_rotate() {
+    auto path    = temporaryLog("tws-access-log-rotate");
+    auto rotated = path;
+    rotated += ".1";
+
+    std::filesystem::remove(rotated);
+
+    {
+        using std::chrono::milliseconds;
+
+        logging::AccessLog log({.path = path, .flushInterval = milliseconds(1)});
+
+        CHECK(log.log(record("GET", "/before", 80)));
+
+        // 等待第一条记录写出后再请求轮转
+        for (auto i = 0; i < 5000 && log.written() < 1; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        log.rotate();
+
+        for (auto i = 0; i < 5000 && std::filesystem::exists(path); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        CHECK(log.log(record("GET", "/after", 80)));
+
+        CHECK(log.written() <= 2);
+        CHECK(log.dropped() == 0);
+    }
+
+    // 轮转前的记录在 path.1 中，之后的写入新文件
+    CHECK(readFile(rotated).find("/before") != std::string::npos);
+    CHECK(readFile(path).find("/after") != std::string::npos);
+    CHECK(readFile(path).find("/before") == std::string::npos);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(rotated);
+}
+
+int main() {
+    test_ring_order();
+    test_ring_threads();
+    test_format();
+    test_rotate();
+
+    return test::report("access log");
+}
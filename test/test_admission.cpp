@@ -0,0 +1,136 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_admission.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 07:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/async/reactor.hpp"
+#include "tws/http/admission.hpp"
+#include <unistd.h>
+
+using namespace tiny_web_server;
+using namespace std::chrono_literals;
+
+using http::Clock;
+
+/// 默认选项: target 5ms，interval 100ms
+const auto START = Clock::time_point{} + 1h;
+
+void test_no_queue() {
+    http::AdmissionController admission;
+
+    // 排队延迟低于 target 时从不拒绝，也不进入过载
+    for (auto t = 0ms; t < 500ms; t += 1ms) {
+        auto now = START + t;
+        CHECK(admission.admit(now - 2ms, now));
+    }
+
+    CHECK(!admission.overloaded(START + 500ms));
+    CHECK(admission.shed() == 0);
+}
+
+void test_burst() {
+    http::AdmissionController admission;
+
+    // 偶发突发: 窗口内有延迟低的样本，最小延迟未超过 target
+    for (auto t = 0ms; t < 200ms; t += 1ms) {
+        auto now = START + t;
+        CHECK(admission.admit(now - (t % 10ms == 0ms ? 1ms : 50ms), now));
+    }
+
+    CHECK(!admission.overloaded(START + 200ms));
+
+    // 非过载时只拒绝排队超过 interval 的请求
+    CHECK(!admission.admit(START + 200ms - 150ms, START + 200ms));
+    CHECK(admission.shed() == 1);
+}
+
+void test_standing_queue() {
+    http::AdmissionController admission;
+
+    // 整个窗口内每个请求都排队 20ms: 持续积压
+    for (auto t = 0ms; t < 100ms; t += 1ms) {
+        auto now = START + t;
+        CHECK(admission.admit(now - 20ms, now));
+    }
+
+    CHECK(admission.shed() == 0);
+
+    // 窗口结束后进入过载: 暂停 accept，排队超过 target 的请求被拒绝
+    auto now = START + 100ms;
+    CHECK(admission.overloaded(now));
+
+    CHECK(!admission.admit(now - 20ms, now));
+    CHECK(!admission.admit(now - 6ms, now));
+    CHECK(admission.admit(now - 1ms, now));
+    CHECK(admission.shed() == 2);
+
+    // 本窗口出现了低于 target 的样本，下一个窗口恢复
+    CHECK(admission.overloaded(now + 99ms));
+    CHECK(!admission.overloaded(now + 100ms));
+    CHECK(admission.admit(now + 101ms - 20ms, now + 101ms));
+}
+
+void test_idle_recovery() {
+    http::AdmissionController admission;
+
+    for (auto t = 0ms; t < 100ms; t += 10ms)
+        CHECK(admission.admit(START + t - 30ms, START + t));
+
+    CHECK(admission.overloaded(START + 100ms));
+
+    // 没有样本的窗口视为已恢复，暂停的 accept 得以重新开启
+    CHECK(admission.overloaded(START + 150ms));
+    CHECK(!admission.overloaded(START + 200ms));
+}
+
+void test_poll_time() {
+    async::Reactor reactor;
+
+    int fds[2];
+    CHECK(::pipe(fds) == 0);
+
+    Clock::time_point seen{};
+    Clock::time_point handled{};
+
+    reactor.add(fds[0], async::EventType::READ, [&](async::EventType) {
+        char byte;
+        (void)::read(fds[0], &byte, 1);
+
+        seen    = reactor.pollTime();
+        handled = Clock::now();
+    });
+
+    auto before = Clock::now();
+    CHECK(::write(fds[1], "x", 1) == 1);
+
+    CHECK(reactor.runOnce(1000) == 1);
+
+    // 到达时刻取自 epoll_wait 返回时，不晚于处理器运行的时刻
+    CHECK(seen >= before);
+    CHECK(seen <= handled);
+
+    reactor.remove(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+int main() {
+    test_no_queue();
+    test_burst();
+    test_standing_queue();
+    test_idle_recovery();
+    test_poll_time();
+
+    return test::report("admission");
+}
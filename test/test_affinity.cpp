@@ -0,0 +1,146 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_affinity.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 08:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/async/affinity.hpp"
+#include "tws/net/socket.hpp"
+#include <iostream>
+
+using namespace tiny_web_server;
+
+void test_cpu_list() {
+    auto cpus = async::CpuSet::parse(" 0-3, 8,10-11 ");
+    CHECK(cpus && cpus->size() == 7);
+    CHECK(cpus && cpus->toString() == "0-3,8,10-11");
+
+    // 重叠与重复的区间合并
+    cpus = async::CpuSet::parse("4-6,5,0-1,4-6");
+    CHECK(cpus && cpus->toString() == "0-1,4-6");
+
+    cpus = async::CpuSet::parse("");
+    CHECK(cpus && cpus->empty());
+
+    CHECK(!async::CpuSet::parse("3-1"));
+    CHECK(!async::CpuSet::parse("-1"));
+    CHECK(!async::CpuSet::parse("1-"));
+    CHECK(!async::CpuSet::parse("a"));
+    CHECK(!async::CpuSet::parse("0,,1"));
+
+    // 巨大的区间被拒绝，不会分配与之成比例的内存
+    CHECK(!async::CpuSet::parse("0-2000000000"));
+    CHECK(!async::CpuSet::parse("8192"));
+    CHECK(async::CpuSet::parse("8191"));
+
+    std::string repeated;
+    for (auto i = 0; i < 10000; ++i) repeated += "0-8191,";
+    repeated += "0";
+
+    cpus = async::CpuSet::parse(repeated);
+    CHECK(cpus && cpus->size() == 8192);
+}
+
+void test_placement() {
+    auto placement = async::ThreadPlacement::parse("2,4,6");
+    CHECK(placement);
+
+    // 线程多于 CPU 时循环使用
+    CHECK(placement && placement->cpu(0) == 2 && placement->cpu(2) == 6);
+    CHECK(placement && placement->cpu(3) == 2);
+
+    CHECK(!async::ThreadPlacement::parse(""));
+    CHECK(!async::ThreadPlacement::parse("7-3"));
+}
+
+/**
+ * @brief 两个监听套接字组成 SO_REUSEPORT 组，按 @p cpus 分发后返回接受了连接的监听套接字序号
+ */
+int steeredListener(const std::array<int, 2>& cpus) {
+    net::Socket listeners[2]{
+        {net::AddressFamily::IPv4, net::SocketType::STREAM},
+        {net::AddressFamily::IPv4, net::SocketType::STREAM},
+    };
+
+    std::uint16_t port = 0;
+
+    for (auto& listener : listeners) {
+        listener.setOptions({.reuse_address = true, .reuse_port = true});
+        listener.bind({net::IpAddress::loopback(), port});
+        listener.listen();
+        listener.setNonBlocking();
+
+        port = listener.localEndpoint().port();
+    }
+
+    listeners[0].steerByIncomingCpu(cpus);
+
+    // 回环上 SYN 在发起连接的 CPU 上处理
+    net::Socket client{net::AddressFamily::IPv4, net::SocketType::STREAM};
+    client.connect({net::IpAddress::loopback(), port});
+
+    for (auto i = 0; i < 2; ++i) {
+        try {
+            (void)listeners[i].accept();
+            return i;
+        } catch (const std::system_error&) {}
+    }
+
+    return -1;
+}
+
+void test_steering() {
+#if WEB_SERVER_LINUX
+    auto available = async::CpuSet::available();
+
+    async::CpuSet single;
+    single.add(available[0]);
+
+    if (!async::pinThread(single)) {
+        std::cout << "skipping steering test: cannot pin thread\n";
+        return;
+    }
+
+    auto cpu = available[0];
+
+    // 按显式的 CPU 表分发，不按 CPU 编号取模: 表中第 1 项是当前 CPU，连接交给第 1 个套接字
+    CHECK(steeredListener({cpu + 1, cpu}) == 1);
+    CHECK(steeredListener({cpu, cpu + 1}) == 0);
+
+    net::Socket listener{net::AddressFamily::IPv4, net::SocketType::STREAM};
+    listener.setOptions({.reuse_port = true});
+
+    auto rejects = [&](std::span<const int> cpus) {
+        try {
+            listener.steerByIncomingCpu(cpus);
+        } catch (const std::system_error&) { return true; }
+
+        return false;
+    };
+
+    const int duplicate[]{cpu, cpu};
+    const int negative[]{-1};
+
+    CHECK(rejects({}));
+    CHECK(rejects(duplicate));
+    CHECK(rejects(negative));
+#endif
+}
+
+int main() {
+    test_cpu_list();
+    test_placement();
+    test_steering();
+
+    return test::report("affinity");
+}
@@ -0,0 +1,332 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_body.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 08:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/http/body.hpp"
+
+using namespace tiny_web_server;
+
+using Type   = http::BodyFraming::Type;
+using Status = http::ChunkedDecoder::Status;
+
+http::BodyFraming framing(
+    const std::initializer_list<http::Header> headers, const int versionMinor = 1
+) {
+    http::Request request;
+    request.versionMinor = versionMinor;
+
+    for (const auto& header : headers) request.headers.push_back(header);
+
+    return http::BodyFraming::of(request);
+}
+
+std::span<const std::byte> bytes(const std::string_view text) {
+    return std::as_bytes(std::span{text});
+}
+
+/**
+ * @brief 把 @p input 交给解码器直到用完或出现结论，解出的数据追加到 @p body
+ */
+Status decode(http::ChunkedDecoder& decoder, std::string_view input, std::string& body) {
+    while (!input.empty()) {
+        auto result = decoder.decode(bytes(input));
+
+        body.append(reinterpret_cast<const char*>(result.data.data()), result.data.size());
+        input.remove_prefix(result.consumed);
+
+        if (result.status != Status::INCOMPLETE) return result.status;
+    }
+
+    return Status::INCOMPLETE;
+}
+
+Status decodeAll(const std::string_view input, std::string* body = nullptr) {
+    http::ChunkedDecoder decoder;
+    std::string out;
+
+    auto status = decode(decoder, input, out);
+    if (body) *body = out;
+
+    return status;
+}
+
+void test_framing() {
+    CHECK(framing({}).type == Type::NONE);
+
+    auto length = framing({{"Content-Length", "42"}});
+    CHECK(length.type == Type::LENGTH && length.length == 42);
+
+    CHECK(framing({{"content-length", " 0 "}}).type == Type::LENGTH);
+    CHECK(framing({{"Transfer-Encoding", "chunked"}}).type == Type::CHUNKED);
+    CHECK(framing({{"transfer-encoding", "Chunked"}}).type == Type::CHUNKED);
+
+    // 同时出现 Transfer-Encoding 与 Content-Length，无论先后
+    CHECK(
+        framing({{"Transfer-Encoding", "chunked"}, {"Content-Length", "5"}}).type
+        == Type::INVALID
+    );
+    CHECK(
+        framing({{"Content-Length", "5"}, {"Transfer-Encoding", "chunked"}}).type
+        == Type::INVALID
+    );
+
+    // chunked 必须是唯一的传输编码
+    CHECK(framing({{"Transfer-Encoding", "gzip, chunked"}}).type == Type::INVALID);
+    CHECK(framing({{"Transfer-Encoding", "chunked, gzip"}}).type == Type::INVALID);
+    CHECK(framing({{"Transfer-Encoding", "chunked, chunked"}}).type == Type::INVALID);
+    CHECK(
+        framing({{"Transfer-Encoding", "chunked"}, {"Transfer-Encoding", "chunked"}}).type
+        == Type::INVALID
+    );
+    CHECK(framing({{"Transfer-Encoding", "identity"}}).type == Type::INVALID);
+    CHECK(framing({{"Transfer-Encoding", ""}}).type == Type::INVALID);
+
+    // HTTP/1.0 没有分块传输编码
+    CHECK(framing({{"Transfer-Encoding", "chunked"}}, 0).type == Type::INVALID);
+}
+
+void test_duplicate_length() {
+    // 值完全相同的重复 Content-Length 被接受
+    auto same = framing({{"Content-Length", "5"}, {"Content-Length", "5"}});
+    CHECK(same.type == Type::LENGTH && same.length == 5);
+
+    auto list = framing({{"Content-Length", "5, 5"}});
+    CHECK(list.type == Type::LENGTH && list.length == 5);
+
+    CHECK(framing({{"Content-Length", "5"}, {"Content-Length", "6"}}).type == Type::INVALID);
+    CHECK(framing({{"Content-Length", "5, 6"}}).type == Type::INVALID);
+    CHECK(framing({{"Content-Length", "5"}, {"Content-Length", ""}}).type == Type::INVALID);
+
+    CHECK(framing({{"Content-Length", ""}}).type == Type::INVALID);
+    CHECK(framing({{"Content-Length", "abc"}}).type == Type::INVALID);
+    CHECK(framing({{"Content-Length", "-1"}}).type == Type::INVALID);
+    CHECK(framing({{"Content-Length", "+5"}}).type == Type::INVALID);
+    CHECK(framing({{"Content-Length", "5 5"}}).type == Type::INVALID);
+    CHECK(framing({{"Content-Length", "0x10"}}).type == Type::INVALID);
+
+    // 超过 64 位
+    CHECK(framing({{"Content-Length", "18446744073709551616"}}).type == Type::INVALID);
+
+    auto largest = framing({{"Content-Length", "18446744073709551615"}});
+    CHECK(largest.type == Type::LENGTH && largest.length == UINT64_MAX);
+}
+
+void test_chunked() {
+    std::string body;
+
+    CHECK(decodeAll("5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n", &body) == Status::COMPLETE);
+    CHECK(body == "hello world");
+
+    CHECK(
+        decodeAll("A\r\n0123456789\r\na\r\n0123456789\r\n0\r\n\r\n", &body)
+        == Status::COMPLETE
+    );
+    CHECK(body.size() == 20);
+
+    CHECK(decodeAll("0\r\n\r\n", &body) == Status::COMPLETE);
+    CHECK(body.empty());
+
+    // 结尾之后的字节不被消耗，属于下一个请求
+    http::ChunkedDecoder decoder;
+    auto input  = std::string_view{"0\r\n\r\nGET / HTTP/1.1\r\n"};
+    auto result = decoder.decode(bytes(input));
+    CHECK(result.status == Status::COMPLETE && result.consumed == 5);
+    CHECK(decoder.done());
+
+    // 行尾必须是 CRLF
+    CHECK(decodeAll("5\nhello\r\n0\r\n\r\n") == Status::ERROR);
+    CHECK(decodeAll("5\r\nhello\n0\r\n\r\n") == Status::ERROR);
+    CHECK(decodeAll("5\r\nhelloX\r\n0\r\n\r\n") == Status::ERROR);
+    CHECK(decodeAll("0\r\n\n") == Status::ERROR);
+
+    // 缺少或非法的分块大小
+    CHECK(decodeAll("\r\nhello\r\n") == Status::ERROR);
+    CHECK(decodeAll("g\r\n") == Status::ERROR);
+    CHECK(decodeAll("-5\r\n") == Status::ERROR);
+    CHECK(decodeAll("0x5\r\n") == Status::ERROR);
+
+    CHECK(decodeAll("5\r\nhel") == Status::INCOMPLETE);
+}
+
+void test_chunk_size_overflow() {
+    // 16 位十六进制恰好占满 64 位
+    http::ChunkedDecoder decoder;
+    auto result = decoder.decode(bytes("FFFFFFFFFFFFFFFF\r\n"));
+
+    CHECK(result.status == Status::INCOMPLETE);
+    CHECK(decoder.pendingData() == UINT64_MAX);
+
+    // 第 17 位会溢出，即使前导是零
+    CHECK(decodeAll("10000000000000000\r\n") == Status::ERROR);
+    CHECK(decodeAll("00000000000000005\r\n") == Status::ERROR);
+
+    // 声明的大小一经解析就按上限检查，已收到的数据加上声明的大小不能回绕
+    http::BodyReader reader{{Type::CHUNKED}, 1024};
+
+    auto first = reader.read(bytes("1\r\nx\r\n"));
+    CHECK(first.status == http::BodyReader::Status::INCOMPLETE);
+
+    auto rest   = std::string_view{"1\r\nx\r\n"}.substr(first.consumed);
+    auto second = reader.read(bytes(rest));
+    CHECK(second.status == http::BodyReader::Status::INCOMPLETE);
+    CHECK(reader.received() == 1);
+
+    CHECK(
+        reader.read(bytes("FFFFFFFFFFFFFFFF\r\n")).status
+        == http::BodyReader::Status::TOO_LARGE
+    );
+
+    http::BodyReader small{{Type::CHUNKED}, 10};
+    CHECK(small.read(bytes("b\r\n")).status == http::BodyReader::Status::TOO_LARGE);
+
+    http::BodyReader length{{Type::LENGTH, 11}, 10};
+    CHECK(length.status() == http::BodyReader::Status::TOO_LARGE);
+}
+
+void test_extensions() {
+    std::string body;
+
+    CHECK(decodeAll("5;name=value\r\nhello\r\n0;last\r\n\r\n", &body) == Status::COMPLETE);
+    CHECK(body == "hello");
+
+    CHECK(decodeAll("5 ; quoted=\"a;b\"\r\nhello\r\n0\r\n\r\n", &body) == Status::COMPLETE);
+    CHECK(body == "hello");
+
+    // 扩展中的裸 LF 与超长的扩展
+    CHECK(decodeAll("5;a\nhello\r\n") == Status::ERROR);
+
+    auto limit = http::ChunkedDecoder::MAX_LINE_SIZE;
+
+    CHECK(
+        decodeAll("1;" + std::string(limit - 1, 'x') + "\r\nx\r\n0\r\n\r\n")
+        == Status::COMPLETE
+    );
+    CHECK(decodeAll("1;" + std::string(limit + 1, 'x') + "\r\n") == Status::ERROR);
+}
+
+void test_trailers() {
+    std::string body;
+
+    CHECK(
+        decodeAll("5\r\nhello\r\n0\r\nX-Checksum: abc\r\nX-Other: 1\r\n\r\n", &body)
+        == Status::COMPLETE
+    );
+    CHECK(body == "hello");
+
+    // 尾部字段中的裸 LF
+    CHECK(decodeAll("0\r\nX-Checksum: abc\n\r\n") == Status::ERROR);
+
+    // 单个字段与总长度的上限
+    auto line = std::string(http::ChunkedDecoder::MAX_LINE_SIZE + 1, 'x');
+    CHECK(decodeAll("0\r\n" + line + "\r\n\r\n") == Status::ERROR);
+
+    std::string trailers = "0\r\n";
+    auto field           = "X: " + std::string(1000, 'y') + "\r\n";
+
+    for (std::size_t size = 0; size <= http::ChunkedDecoder::MAX_TRAILER_SIZE;
+         size += field.size() - 2)
+        trailers += field;
+
+    CHECK(decodeAll(trailers + "\r\n") == Status::ERROR);
+
+    CHECK(decodeAll("0\r\nX: 1\r\n") == Status::INCOMPLETE);
+}
+
+void test_split_input() {
+    const std::string_view message =
+        "5;ext=1\r\nhello\r\n"
+        "1a\r\nabcdefghijklmnopqrstuvwxyz\r\n"
+        "0\r\nTrailer: value\r\n\r\n";
+
+    // 在每个字节边界把输入拆成两段
+    for (std::size_t split = 0; split <= message.size(); ++split) {
+        http::ChunkedDecoder decoder;
+        std::string body;
+
+        auto status = decode(decoder, message.substr(0, split), body);
+        if (status == Status::INCOMPLETE)
+            status = decode(decoder, message.substr(split), body);
+
+        CHECK(status == Status::COMPLETE);
+        CHECK(body == "helloabcdefghijklmnopqrstuvwxyz");
+    }
+
+    // 逐字节输入
+    http::ChunkedDecoder decoder;
+    std::string body;
+    auto status = Status::INCOMPLETE;
+
+    for (std::size_t i = 0; i < message.size() && status == Status::INCOMPLETE; ++i)
+        status = decode(decoder, message.substr(i, 1), body);
+
+    CHECK(status == Status::COMPLETE);
+    CHECK(body == "helloabcdefghijklmnopqrstuvwxyz");
+
+    // 经 BodyReader 拆分时，received 只计数据字节
+    for (std::size_t split = 0; split <= message.size(); ++split) {
+        http::BodyReader reader{{Type::CHUNKED}};
+
+        for (auto part : {message.substr(0, split), message.substr(split)}) {
+            while (!part.empty() && !reader.complete()) {
+                auto result = reader.read(bytes(part));
+                part.remove_prefix(result.consumed);
+            }
+        }
+
+        CHECK(reader.complete());
+        CHECK(reader.received() == 31);
+    }
+}
+
+void test_direct_bytes() {
+    // 数据部分可以绕过 read 直接搬运，之后以 advance 记账
+    http::BodyReader reader{{Type::CHUNKED}};
+
+    auto result = reader.read(bytes("10\r\n"));
+    CHECK(result.consumed == 4 && result.data.empty());
+    CHECK(reader.directBytes() == 16);
+
+    reader.advance(10);
+    CHECK(reader.directBytes() == 6);
+
+    reader.advance(6);
+    CHECK(reader.directBytes() == 0);
+
+    auto rest = std::string_view{"\r\n0\r\n\r\n"};
+    while (!rest.empty() && !reader.complete())
+        rest.remove_prefix(reader.read(bytes(rest)).consumed);
+
+    CHECK(reader.complete());
+    CHECK(reader.received() == 16);
+
+    http::BodyReader length{{Type::LENGTH, 8}};
+    CHECK(length.directBytes() == 8);
+
+    length.advance(8);
+    CHECK(length.complete());
+}
+
+int main() {
+    test_framing();
+    test_duplicate_length();
+    test_chunked();
+    test_chunk_size_overflow();
+    test_extensions();
+    test_trailers();
+    test_split_input();
+    test_direct_bytes();
+
+    return test::report("body");
+}
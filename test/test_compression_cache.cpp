@@ -0,0 +1,133 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_compression_cache.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 06:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 碰撞用例需要直接构造缓存条目
+#define private public
+#include "check.hpp"
+#include "tws/http/compression_cache.hpp"
+#undef private
+
+#include "tws/utils/hash.hpp"
+
+
+using namespace tiny_web_server;
+
+std::vector<std::byte> text(char fill, std::size_t size = 4096) {
+    std::vector<std::byte> data(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+        data[i] = static_cast<std::byte>(i % 64 == 0 ? '\n' : fill);
+
+    return data;
+}
+
+/// 后台压缩完成前一直未命中
+http::CompressionCache::Buffer
+waitFor(http::CompressionCache& cache, const std::vector<std::byte>& content) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (auto buffer = cache.find(content, http::ContentEncoding::GZIP)) return buffer;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return nullptr;
+}
+
+void test_hit_and_miss() {
+    http::CompressionCache cache;
+
+    auto content = text('a');
+
+    // 第一次未命中并安排压缩
+    CHECK(cache.find(content, http::ContentEncoding::GZIP) == nullptr);
+
+    auto buffer = waitFor(cache, content);
+    CHECK(buffer != nullptr);
+    CHECK(buffer && buffer->size() < content.size());
+
+    // 相同内容命中同一份结果，不同内容未命中
+    CHECK(cache.find(content, http::ContentEncoding::GZIP) == buffer);
+    CHECK(cache.find(text('b'), http::ContentEncoding::GZIP) == nullptr);
+
+    // 过短的内容与 identity 从不压缩
+    CHECK(cache.find(text('a', 100), http::ContentEncoding::GZIP) == nullptr);
+    CHECK(cache.find(content, http::ContentEncoding::IDENTITY) == nullptr);
+}
+
+void test_collision() {
+    http::CompressionCache cache;
+
+    auto original = text('a');
+    auto other    = text('b');
+
+    // 以另一份内容的键插入条目，模拟哈希碰撞
+    http::CompressionCache::Key key{
+        contentHash(other, cache.seed_), other.size(), http::ContentEncoding::GZIP
+    };
+
+    auto stored     = std::make_shared<const std::vector<std::byte>>(original);
+    auto compressed = std::make_shared<const std::vector<std::byte>>(text('z', 16));
+
+    {
+        std::lock_guard lock(cache.mutex_);
+        cache.insert(key, stored, compressed);
+    }
+
+    CHECK(cache.find(other, http::ContentEncoding::GZIP) == nullptr);
+}
+
+void test_eviction() {
+    // 容量只够一份原文及其压缩结果
+    http::CompressionCache cache(6000);
+
+    auto first  = text('a');
+    auto second = text('b');
+
+    (void) cache.find(first, http::ContentEncoding::GZIP);
+    CHECK(waitFor(cache, first) != nullptr);
+
+    (void) cache.find(second, http::ContentEncoding::GZIP);
+    CHECK(waitFor(cache, second) != nullptr);
+
+    CHECK(cache.size() <= 6000);
+
+    // 最久未用的条目已被淘汰
+    std::lock_guard lock(cache.mutex_);
+    CHECK(cache.lru_.size() == 1);
+    CHECK(cache.lru_.front().original->front() == std::byte{'\n'});
+    CHECK(cache.lru_.front().original->back() == std::byte{'b'});
+}
+
+int main() {
+    test_hit_and_miss();
+    test_collision();
+    test_eviction();
+
+    return test::report("compression cache");
+}
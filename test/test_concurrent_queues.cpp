@@ -0,0 +1,155 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_concurrent_queues.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 06:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/async/mpsc_queue.hpp"
+#include "tws/async/work_stealing_deque.hpp"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace tiny_web_server;
+
+// 多线程用例以 -DTWS_SANITIZER=thread 构建时同时由 ThreadSanitizer 检查
+
+void test_mpsc_fifo() {
+    async::MpscQueue<std::unique_ptr<std::string>> queue;
+
+    CHECK(!queue.pop());
+
+    for (auto i = 0; i < 1000; ++i)
+        queue.push(std::make_unique<std::string>(std::to_string(i)));
+
+    for (auto i = 0; i < 1000; ++i) {
+        auto value = queue.pop();
+        CHECK(value && **value == std::to_string(i));
+    }
+
+    CHECK(!queue.pop());
+
+    // 析构时释放未取出的元素
+    queue.push(std::make_unique<std::string>("left"));
+}
+
+void test_mpsc_stress() {
+    constexpr std::uint64_t PRODUCERS = 4;
+    constexpr std::uint64_t COUNT     = 100000;
+
+    async::MpscQueue<std::uint64_t> queue;
+
+    std::vector<std::jthread> producers;
+
+    for (std::uint64_t p = 0; p < PRODUCERS; ++p)
+        producers.emplace_back([&, p] {
+            for (std::uint64_t i = 0; i < COUNT; ++i) queue.push(p << 32 | i);
+        });
+
+    // 同一生产者的元素按入队顺序出队
+    std::vector<std::uint64_t> next(PRODUCERS, 0);
+    std::uint64_t received = 0;
+    auto ordered           = true;
+
+    while (received < PRODUCERS * COUNT) {
+        auto value = queue.pop();
+
+        if (!value) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        auto producer = *value >> 32;
+
+        if (producer >= PRODUCERS || (*value & 0xFFFFFFFF) != next[producer]++)
+            ordered = false;
+
+        ++received;
+    }
+
+    CHECK(ordered);
+    CHECK(!queue.pop());
+}
+
+void test_deque_order() {
+    // 初始容量很小，覆盖扩容
+    async::WorkStealingDeque<int> deque(4);
+
+    CHECK(!deque.pop());
+    CHECK(!deque.steal());
+
+    for (auto i = 0; i < 100; ++i) deque.push(i);
+
+    CHECK(deque.size() == 100);
+
+    // 所有者后进先出，窃取者先进先出
+    CHECK(deque.pop() == 99);
+    CHECK(deque.steal() == 0);
+    CHECK(deque.pop() == 98);
+    CHECK(deque.steal() == 1);
+
+    auto count = 0;
+    while (deque.pop()) ++count;
+
+    CHECK(count == 96);
+    CHECK(deque.size() == 0);
+    CHECK(!deque.steal());
+}
+
+void test_deque_stress() {
+    constexpr int COUNT   = 200000;
+    constexpr int THIEVES = 3;
+
+    async::WorkStealingDeque<int> deque(8);
+
+    std::vector<std::atomic<int>> seen(COUNT);
+    std::atomic<bool> done = false;
+
+    std::vector<std::jthread> thieves;
+
+    for (auto t = 0; t < THIEVES; ++t)
+        thieves.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire) || deque.size() > 0)
+                if (auto value = deque.steal()) seen[*value].fetch_add(1);
+        });
+
+    // 所有者边推边取，与窃取者争抢最后一个元素
+    for (auto i = 0; i < COUNT; ++i) {
+        deque.push(i);
+
+        if (i % 3 == 0)
+            if (auto value = deque.pop()) seen[*value].fetch_add(1);
+    }
+
+    while (auto value = deque.pop()) seen[*value].fetch_add(1);
+
+    done.store(true, std::memory_order_release);
+    thieves.clear();
+
+    // 每个元素恰好被取出一次
+    auto exactlyOnce = true;
+    for (const auto& count : seen) exactlyOnce = exactlyOnce && count.load() == 1;
+
+    CHECK(exactlyOnce);
+}
+
+int main() {
+    test_mpsc_fifo();
+    test_mpsc_stress();
+    test_deque_order();
+    test_deque_stress();
+
+    return test::report("concurrent queue");
+}
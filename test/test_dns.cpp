@@ -0,0 +1,639 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_dns.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 08:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/net/dns.hpp"
+#include "tws/net/resolver.hpp"
+#include <set>
+#include <sys/socket.h>
+
+using namespace tiny_web_server;
+using namespace std::chrono_literals;
+
+using net::DnsType;
+using net::parseDnsResponse;
+
+using Bytes = std::vector<std::byte>;
+
+/**
+ * @brief 逐段拼装应答报文
+ */
+struct Message {
+    Bytes bytes;
+
+    Message& u8(const unsigned value) {
+        bytes.push_back(static_cast<std::byte>(value));
+        return *this;
+    }
+
+    Message& u16(const unsigned value) { return u8(value >> 8 & 0xFF).u8(value & 0xFF); }
+
+    Message& u32(const std::uint32_t value) { return u16(value >> 16).u16(value & 0xFFFF); }
+
+    Message& name(std::string_view text) {
+        while (!text.empty()) {
+            auto dot   = text.find('.');
+            auto label = text.substr(0, dot);
+
+            u8(static_cast<unsigned>(label.size()));
+            for (auto c : label) u8(static_cast<unsigned char>(c));
+
+            text = dot == std::string_view::npos ? std::string_view{} : text.substr(dot + 1);
+        }
+
+        return u8(0);
+    }
+
+    Message& pointer(const unsigned offset) { return u16(0xC000 | offset); }
+
+    Message& header(
+        const unsigned id, const unsigned flags, const unsigned answers,
+        const unsigned authorities = 0
+    ) {
+        return u16(id).u16(flags).u16(1).u16(answers).u16(authorities).u16(0);
+    }
+
+    Message& question(const std::string_view text, const DnsType type) {
+        return name(text).u16(static_cast<unsigned>(type)).u16(1);
+    }
+
+    /// 记录的类型、类、TTL 与 RDATA，名称须事先写入
+    Message& record(const DnsType type, const std::uint32_t ttl, const Bytes& data) {
+        u16(static_cast<unsigned>(type)).u16(1).u32(ttl).u16(data.size());
+        bytes.insert(bytes.end(), data.begin(), data.end());
+
+        return *this;
+    }
+
+    /// 写入一条 RDATA 为名称的记录，RDLENGTH 事后回填
+    Message& alias(const std::uint32_t ttl, const std::string_view target) {
+        u16(static_cast<unsigned>(DnsType::CNAME)).u16(1).u32(ttl).u16(0);
+
+        auto start = bytes.size();
+        name(target);
+
+        auto length      = bytes.size() - start;
+        bytes[start - 2] = static_cast<std::byte>(length >> 8);
+        bytes[start - 1] = static_cast<std::byte>(length & 0xFF);
+
+        return *this;
+    }
+};
+
+/// 问题名称在报文中的偏移
+constexpr unsigned QUESTION = 12;
+
+constexpr unsigned RESPONSE = 0x8180;
+
+Bytes ipv4(const unsigned a, const unsigned b, const unsigned c, const unsigned d) {
+    return {std::byte(a), std::byte(b), std::byte(c), std::byte(d)};
+}
+
+net::IpAddress address(const std::string_view text) { return net::IpAddress{text}; }
+
+void test_answer() {
+    Message message;
+    message.header(0x1234, RESPONSE, 2)
+        .question("www.example.com", DnsType::A)
+        .pointer(QUESTION)
+        .record(DnsType::A, 300, ipv4(192, 0, 2, 1))
+        .pointer(QUESTION)
+        .record(DnsType::A, 60, ipv4(192, 0, 2, 2));
+
+    auto answer = parseDnsResponse(message.bytes, 0x1234, "www.example.com.", DnsType::A);
+
+    CHECK(answer && answer->status == net::DnsAnswer::Status::OK);
+    CHECK(answer && answer->addresses.size() == 2);
+    CHECK(answer && answer->addresses[0] == address("192.0.2.1"));
+    CHECK(answer && answer->ttl == 60u);
+
+    // ID、问题名称或类型与查询不符的报文不被接受
+    CHECK(!parseDnsResponse(message.bytes, 0x1235, "www.example.com", DnsType::A));
+    CHECK(!parseDnsResponse(message.bytes, 0x1234, "example.com", DnsType::A));
+    CHECK(!parseDnsResponse(message.bytes, 0x1234, "www.example.com", DnsType::AAAA));
+}
+
+void test_owner_case() {
+    // 服务器回显问题时可能保留随机化的大小写(0x20 编码)
+    Message message;
+    message.header(1, RESPONSE, 1)
+        .question("WwW.ExAmple.COM", DnsType::A)
+        .name("www.EXAMPLE.com")
+        .record(DnsType::A, 300, ipv4(192, 0, 2, 1));
+
+    auto answer = parseDnsResponse(message.bytes, 1, "www.example.com", DnsType::A);
+
+    CHECK(answer && answer->addresses.size() == 1);
+}
+
+void test_cname_chain() {
+    Message message;
+    message.header(7, RESPONSE, 4).question("www.example.com", DnsType::A);
+
+    auto alias = static_cast<unsigned>(message.bytes.size());
+    message.pointer(QUESTION).alias(600, "cdn.example.net");
+
+    // 目标名称在 CNAME 的 RDATA 中，偏移为记录头之后
+    auto target = alias + 2 + 10;
+
+    message.pointer(target)
+        .record(DnsType::A, 120, ipv4(198, 51, 100, 7))
+        // 不在链上的地址即使出现在应答区也不采信
+        .name("attacker.example")
+        .record(DnsType::A, 86400, ipv4(203, 0, 113, 66))
+        .pointer(QUESTION)
+        .record(DnsType::A, 86400, ipv4(203, 0, 113, 67));
+
+    auto answer = parseDnsResponse(message.bytes, 7, "www.example.com", DnsType::A);
+
+    CHECK(answer && answer->addresses.size() == 1);
+    CHECK(answer && answer->addresses[0] == address("198.51.100.7"));
+    CHECK(answer && answer->ttl == 120u);
+}
+
+void test_mismatched_owner() {
+    Message message;
+    message.header(9, RESPONSE, 1)
+        .question("www.example.com", DnsType::A)
+        .name("mail.example.com")
+        .record(DnsType::A, 300, ipv4(203, 0, 113, 1));
+
+    auto answer = parseDnsResponse(message.bytes, 9, "www.example.com", DnsType::A);
+
+    CHECK(answer && answer->status == net::DnsAnswer::Status::OK);
+    CHECK(answer && answer->addresses.empty());
+}
+
+void test_cname_loop() {
+    // a -> b -> a 的别名环在跟随上限内终止，不产生地址
+    Message message;
+    message.header(3, RESPONSE, 2).question("a.example", DnsType::A);
+    message.pointer(QUESTION).alias(60, "b.example");
+    message.name("b.example").alias(60, "a.example");
+
+    auto answer = parseDnsResponse(message.bytes, 3, "a.example", DnsType::A);
+
+    CHECK(answer && answer->addresses.empty());
+}
+
+void test_pointer_loop() {
+    // 记录名称是指向自身的压缩指针
+    Message self;
+    self.header(5, RESPONSE, 1).question("www.example.com", DnsType::A);
+    self.pointer(static_cast<unsigned>(self.bytes.size()))
+        .record(DnsType::A, 60, ipv4(192, 0, 2, 1));
+
+    CHECK(!parseDnsResponse(self.bytes, 5, "www.example.com", DnsType::A));
+
+    // 两个指针互相引用
+    Message pair;
+    pair.header(5, RESPONSE, 1).question("www.example.com", DnsType::A);
+
+    auto first = static_cast<unsigned>(pair.bytes.size());
+    pair.pointer(first + 2).pointer(first).record(DnsType::A, 60, ipv4(192, 0, 2, 1));
+
+    CHECK(!parseDnsResponse(pair.bytes, 5, "www.example.com", DnsType::A));
+
+    // 指针越过报文末尾
+    Message outside;
+    outside.header(5, RESPONSE, 1).question("www.example.com", DnsType::A);
+    outside.pointer(0x3FFF).record(DnsType::A, 60, ipv4(192, 0, 2, 1));
+
+    CHECK(!parseDnsResponse(outside.bytes, 5, "www.example.com", DnsType::A));
+}
+
+void test_truncated_packet() {
+    Message message;
+    message.header(11, RESPONSE, 2).question("www.example.com", DnsType::A);
+    message.pointer(QUESTION).alias(600, "cdn.example.net");
+    message.name("cdn.example.net").record(DnsType::A, 120, ipv4(198, 51, 100, 7));
+
+    CHECK(parseDnsResponse(message.bytes, 11, "www.example.com", DnsType::A));
+
+    // 任何位置截断都被拒绝，且不会越界读取
+    for (std::size_t size = 0; size < message.bytes.size(); ++size) {
+        auto prefix = std::span{message.bytes}.first(size);
+        CHECK(!parseDnsResponse(prefix, 11, "www.example.com", DnsType::A));
+    }
+
+    // 地址记录的 RDATA 长度与类型不符
+    Message wrong;
+    wrong.header(11, RESPONSE, 1)
+        .question("www.example.com", DnsType::AAAA)
+        .pointer(QUESTION)
+        .record(DnsType::AAAA, 60, ipv4(192, 0, 2, 1));
+
+    CHECK(!parseDnsResponse(wrong.bytes, 11, "www.example.com", DnsType::AAAA));
+}
+
+void test_tc_bit() {
+    Message message;
+    message.header(13, RESPONSE | 0x0200, 0).question("www.example.com", DnsType::A);
+
+    auto answer = parseDnsResponse(message.bytes, 13, "www.example.com", DnsType::A);
+
+    CHECK(answer && answer->status == net::DnsAnswer::Status::TRUNCATED);
+}
+
+void test_nxdomain() {
+    auto soa = [](const std::uint32_t ttl, const std::uint32_t minimum) {
+        Message message;
+        message.header(17, RESPONSE | 3, 0, 1).question("missing.example", DnsType::A);
+        message.name("example").u16(static_cast<unsigned>(DnsType::SOA)).u16(1).u32(ttl);
+
+        Message data;
+        data.name("ns.example").name("admin.example");
+        data.u32(2026102001).u32(7200).u32(900).u32(1209600).u32(minimum);
+
+        message.u16(data.bytes.size());
+        message.bytes.insert(message.bytes.end(), data.bytes.begin(), data.bytes.end());
+
+        return parseDnsResponse(message.bytes, 17, "missing.example", DnsType::A);
+    };
+
+    // 否定缓存时长取 SOA 记录的 TTL 与 MINIMUM 中较小者(RFC 2308)
+    auto answer = soa(3600, 300);
+    CHECK(answer && answer->status == net::DnsAnswer::Status::NOT_FOUND);
+    CHECK(answer && answer->ttl == 300u);
+
+    answer = soa(120, 300);
+    CHECK(answer && answer->ttl == 120u);
+
+    // 没有 SOA 时不带 TTL，由解析器使用默认的否定缓存时长
+    Message bare;
+    bare.header(17, RESPONSE | 3, 0).question("missing.example", DnsType::A);
+
+    answer = parseDnsResponse(bare.bytes, 17, "missing.example", DnsType::A);
+    CHECK(answer && answer->status == net::DnsAnswer::Status::NOT_FOUND);
+    CHECK(answer && !answer->ttl);
+
+    // SERVFAIL
+    Message failure;
+    failure.header(17, RESPONSE | 2, 0).question("missing.example", DnsType::A);
+
+    answer = parseDnsResponse(failure.bytes, 17, "missing.example", DnsType::A);
+    CHECK(answer && answer->status == net::DnsAnswer::Status::SERVER_FAILURE);
+}
+
+void test_hosts_file() {
+    auto hosts = net::HostsFile::parse(
+        "# comment line\n"
+        "127.0.0.1\tlocalhost Localhost.Localdomain\n"
+        "::1 localhost ip6-localhost # trailing comment\n"
+        "192.0.2.10 Web.Example. web\n"
+        "192.0.2.10 web\n"
+        "not-an-address ignored.example\n"
+        "\n"
+        "   \n"
+    );
+
+    const auto* localhost = hosts.find("LOCALHOST");
+    CHECK(localhost && localhost->size() == 2);
+    CHECK(localhost && (*localhost)[0] == address("127.0.0.1"));
+    CHECK(localhost && (*localhost)[1] == address("::1"));
+
+    CHECK(hosts.find("localhost.localdomain."));
+    CHECK(hosts.find("ip6-localhost"));
+
+    // 同一名称的重复地址只保留一次
+    const auto* web = hosts.find("web");
+    CHECK(web && web->size() == 1);
+    CHECK(hosts.find("web.example"));
+
+    CHECK(!hosts.find("ignored.example"));
+    CHECK(!hosts.find("comment"));
+    CHECK(hosts.size() == 5);
+}
+
+void test_resolv_conf() {
+    auto conf = net::ResolvConf::parse(
+        "; comment\n"
+        "# nameserver 192.0.2.99\n"
+        "search example.com\n"
+        "nameserver 192.0.2.53\n"
+        "nameserver 2001:db8::53\n"
+        "nameserver fe80::1%eth0\n"
+        "nameserver\n"
+        "options ndots:2 timeout:3 attempts:4\n"
+    );
+
+    CHECK(conf.nameservers.size() == 2);
+    CHECK(conf.nameservers.front().address() == address("192.0.2.53"));
+    CHECK(conf.nameservers.back().port() == 53);
+    CHECK(conf.timeout == 3s);
+    CHECK(conf.attempts == 4);
+
+    // 超出范围的选项被截断
+    conf = net::ResolvConf::parse("options timeout:0 attempts:100\n");
+    CHECK(conf.timeout == 1s);
+    CHECK(conf.attempts == 5);
+
+    conf = net::ResolvConf::parse("options timeout:120 attempts:0\n");
+    CHECK(conf.timeout == 30s);
+    CHECK(conf.attempts == 1);
+
+    // 没有可用的名称服务器时使用本机
+    conf = net::ResolvConf::parse("");
+    CHECK(conf.nameservers.size() == 1);
+    CHECK(conf.nameservers.front().address() == address("127.0.0.1"));
+    CHECK(conf.timeout == 5s);
+    CHECK(conf.attempts == 2);
+}
+
+bool throws(const std::string_view text) {
+    try {
+        (void)net::splitHostPort(text);
+    } catch (const std::system_error&) { return true; }
+
+    return false;
+}
+
+void test_split_host_port() {
+    auto [host, port] = net::splitHostPort("example.com:8080");
+    CHECK(host == "example.com" && port == 8080);
+
+    std::tie(host, port) = net::splitHostPort("[2001:db8::1]:443");
+    CHECK(host == "2001:db8::1" && port == 443);
+
+    std::tie(host, port) = net::splitHostPort("192.0.2.1:0");
+    CHECK(host == "192.0.2.1" && port == 0);
+
+    std::tie(host, port) = net::splitHostPort("[::1]:65535");
+    CHECK(host == "::1" && port == 65535);
+
+    CHECK(throws("example.com"));
+    CHECK(throws("example.com:"));
+    CHECK(throws("example.com:http"));
+    CHECK(throws("example.com:65536"));
+    CHECK(throws("example.com:-1"));
+    CHECK(throws("example.com:80 "));
+    CHECK(throws("[2001:db8::1"));
+    CHECK(throws("[2001:db8::1]"));
+    CHECK(throws("[2001:db8::1]8080"));
+}
+
+/**
+ * @brief 运行在测试线程反应器中的桩名称服务器
+ * @details 按问题类型应答固定地址，并记录每个查询的源端口与 ID
+ */
+struct StubServer {
+    struct Query {
+        std::uint16_t port;
+
+        std::uint16_t id;
+
+        DnsType type;
+    };
+
+    net::Socket socket{net::AddressFamily::IPv4, net::SocketType::DGRAM, net::Protocol::UDP};
+
+    std::vector<Query> queries;
+
+    /// 不应答的查询数，用于触发重传
+    int drop = 0;
+
+    async::Reactor& reactor;
+
+    explicit StubServer(async::Reactor& reactor) : reactor(reactor) {
+        socket.bind({net::IpAddress::loopback(), 0});
+        socket.setNonBlocking();
+
+        reactor.add(socket.nativeHandle(), async::EventType::READ, [this](auto) {
+            serve();
+        });
+    }
+
+    ~StubServer() { reactor.remove(socket.nativeHandle()); }
+
+    [[nodiscard]] net::Endpoint endpoint() const { return socket.localEndpoint(); }
+
+    void serve() {
+        std::byte buffer[512];
+        sockaddr_storage peer{};
+        socklen_t peerLength = sizeof(peer);
+
+        while (true) {
+            auto received = ::recvfrom(
+                socket.nativeHandle(), buffer, sizeof(buffer), 0,
+                reinterpret_cast<sockaddr*>(&peer), &peerLength
+            );
+
+            if (received < 12 + 5) return;
+
+            auto query = std::span{buffer}.first(static_cast<std::size_t>(received));
+            auto read  = [&](std::size_t at) {
+                return std::to_integer<unsigned>(query[at]) << 8
+                     | std::to_integer<unsigned>(query[at + 1]);
+            };
+
+            auto id   = read(0);
+            auto type = static_cast<DnsType>(read(query.size() - 4));
+            auto port = ntohs(reinterpret_cast<sockaddr_in&>(peer).sin_port);
+
+            queries.push_back({port, static_cast<std::uint16_t>(id), type});
+
+            if (drop > 0) {
+                --drop;
+                continue;
+            }
+
+            // 回显问题，应答名称以压缩指针引用它
+            Message response;
+            response.header(id, RESPONSE, 1);
+            response.bytes.insert(response.bytes.end(), query.begin() + 12, query.end());
+            response.pointer(QUESTION);
+
+            if (type == DnsType::A)
+                response.record(type, 300, ipv4(192, 0, 2, 80));
+            else
+                response.record(type, 300, address("2001:db8::80").toBytes());
+
+            (void)::sendto(
+                socket.nativeHandle(), response.bytes.data(), response.bytes.size(), 0,
+                reinterpret_cast<sockaddr*>(&peer), peerLength
+            );
+        }
+    }
+};
+
+/**
+ * @brief 驱动反应器与解析器的定时器，直到回调执行或超过 @p limit
+ */
+template<typename Done>
+void drive(
+    async::Reactor& reactor, net::Resolver& resolver, Done done,
+    const std::chrono::milliseconds limit = 2s
+) {
+    auto until = std::chrono::steady_clock::now() + limit;
+
+    while (!done() && std::chrono::steady_clock::now() < until) {
+        reactor.runOnce(5);
+        (void)resolver.expire();
+    }
+}
+
+struct Result {
+    bool done = false;
+
+    std::error_code error;
+
+    std::vector<net::Endpoint> endpoints;
+
+    net::Resolver::Callback callback() {
+        return [this](auto error, auto endpoints) {
+            done            = true;
+            this->error     = error;
+            this->endpoints = std::move(endpoints);
+        };
+    }
+};
+
+void test_resolver() {
+    async::Reactor reactor;
+    StubServer stub{reactor};
+    net::DnsCache cache;
+
+    net::ResolverOptions options;
+    options.nameservers = {stub.endpoint()};
+    net::Resolver resolver{reactor, options, cache};
+
+    Result result;
+    resolver.resolve("service.example", 8443, result.callback());
+
+    drive(reactor, resolver, [&] { return result.done; });
+
+    CHECK(result.done && !result.error);
+    CHECK(result.endpoints.size() == 2);
+
+    // IPv6 在前
+    CHECK(result.endpoints.size() == 2
+          && result.endpoints[0].address() == address("2001:db8::80"));
+    CHECK(result.endpoints.size() == 2 && result.endpoints[1].port() == 8443);
+
+    // A 与 AAAA 查询各自使用独立的套接字，源端口不同
+    CHECK(stub.queries.size() == 2);
+    CHECK(stub.queries.size() == 2 && stub.queries[0].port != stub.queries[1].port);
+    CHECK(resolver.pending() == 0);
+
+    // 第二次解析命中缓存，同步完成
+    Result cached;
+    resolver.resolve("SERVICE.example.", 80, cached.callback());
+
+    CHECK(cached.done && cached.endpoints.size() == 2);
+    CHECK(stub.queries.size() == 2);
+}
+
+void test_resolver_ipv4_only() {
+    async::Reactor reactor;
+    StubServer stub{reactor};
+    net::DnsCache cache;
+
+    net::ResolverOptions options;
+    options.nameservers = {stub.endpoint()};
+    options.ipv6        = false;
+    net::Resolver resolver{reactor, options, cache};
+
+    // 两个名称先后解析，各自结束时不影响另一个仍在进行的查询
+    Result first, second;
+    resolver.resolve("one.example", 80, first.callback());
+    resolver.resolve("two.example", 80, second.callback());
+
+    drive(reactor, resolver, [&] { return first.done && second.done; });
+
+    CHECK(first.done && first.endpoints.size() == 1);
+    CHECK(second.done && second.endpoints.size() == 1);
+    CHECK(stub.queries.size() == 2);
+
+    for (const auto& query : stub.queries) CHECK(query.type == DnsType::A);
+}
+
+void test_resolver_retransmit() {
+    async::Reactor reactor;
+    StubServer stub{reactor};
+    net::DnsCache cache;
+
+    net::ResolverOptions options;
+    options.nameservers = {stub.endpoint()};
+    options.ipv6        = false;
+    options.timeout     = 50ms;
+    net::Resolver resolver{reactor, options, cache};
+
+    stub.drop = 1;
+
+    Result result;
+    resolver.resolve("retry.example", 80, result.callback());
+
+    drive(reactor, resolver, [&] { return result.done; });
+
+    CHECK(result.done && result.endpoints.size() == 1);
+
+    // 重传换用新的源端口与 ID
+    CHECK(stub.queries.size() == 2);
+    CHECK(stub.queries.size() == 2 && stub.queries[0].port != stub.queries[1].port);
+    CHECK(stub.queries.size() == 2 && stub.queries[0].id != stub.queries[1].id);
+}
+
+void test_resolver_refused() {
+    async::Reactor reactor;
+    StubServer stub{reactor};
+    net::DnsCache cache;
+
+    // 取得一个随即关闭的端口: 发往它的查询会收到 ICMP 端口不可达
+    std::uint16_t closed;
+    {
+        net::Socket socket{
+            net::AddressFamily::IPv4, net::SocketType::DGRAM, net::Protocol::UDP
+        };
+        socket.bind({net::IpAddress::loopback(), 0});
+        closed = socket.localEndpoint().port();
+    }
+
+    net::ResolverOptions options;
+    options.nameservers = {{net::IpAddress::loopback(), closed}, stub.endpoint()};
+    options.timeout     = 5s;
+    net::Resolver resolver{reactor, options, cache};
+
+    auto started = std::chrono::steady_clock::now();
+
+    Result result;
+    resolver.resolve("refused.example", 80, result.callback());
+
+    drive(reactor, resolver, [&] { return result.done; });
+
+    // 不等待超时，立即换到下一个名称服务器
+    CHECK(result.done && result.endpoints.size() == 2);
+    CHECK(std::chrono::steady_clock::now() - started < 1s);
+}
+
+int main() {
+    test_answer();
+    test_owner_case();
+    test_cname_chain();
+    test_mismatched_owner();
+    test_cname_loop();
+    test_pointer_loop();
+    test_truncated_packet();
+    test_tc_bit();
+    test_nxdomain();
+    test_hosts_file();
+    test_resolv_conf();
+    test_split_host_port();
+    test_resolver();
+    test_resolver_ipv4_only();
+    test_resolver_retransmit();
+    test_resolver_refused();
+
+    return test::report("dns");
+}
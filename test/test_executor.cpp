@@ -0,0 +1,124 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_executor.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 11:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/async/executor.hpp"
+#include <latch>
+#include <stdexcept>
+
+using namespace tiny_web_server;
+
+/// 失败计数在任务抛出后才递增，可能晚于任务中的其他副作用被观察到
+bool waitForFailures(const async::Executor& executor, const std::uint64_t expected) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (executor.failures() < expected && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+
+    return executor.failures() == expected;
+}
+
+void test_runs_tasks() {
+    async::Executor executor(4);
+
+    constexpr int TASKS = 1000;
+
+    std::atomic<int> done = 0;
+    std::latch finished{TASKS};
+
+    for (int i = 0; i < TASKS; ++i)
+        executor.submit([&] {
+            done.fetch_add(1);
+            finished.count_down();
+        });
+
+    finished.wait();
+    CHECK(done.load() == TASKS);
+    CHECK(executor.failures() == 0);
+}
+
+void test_throwing_task() {
+    async::Executor executor(2);
+
+    constexpr int TASKS = 100;
+
+    std::latch finished{TASKS};
+    std::atomic<int> succeeded = 0;
+
+    // 交替提交会抛出与正常的任务，工作线程不应因此退出
+    for (int i = 0; i < TASKS; ++i)
+        executor.submit([&, i] {
+            finished.count_down();
+            if (i % 2 == 0) throw std::runtime_error("task failed");
+            succeeded.fetch_add(1);
+        });
+
+    finished.wait();
+
+    // 之后提交的任务照常执行
+    std::latch after{1};
+    executor.submit([&] { after.count_down(); });
+    after.wait();
+
+    CHECK(succeeded.load() == TASKS / 2);
+    CHECK(waitForFailures(executor, TASKS / 2));
+}
+
+void test_offload() {
+    async::Executor executor(2);
+    async::Reactor reactor;
+
+    int result = 0;
+    std::exception_ptr error;
+    bool completed = false, voidCompleted = false, voidFailed = false;
+
+    async::offload(executor, reactor, [] { return 42; }, [&](int value) { result = value; });
+
+    async::offload(
+        executor, reactor, []() -> int { throw std::runtime_error("offload failed"); },
+        [&](int) { completed = true; }, [&](std::exception_ptr e) { error = std::move(e); }
+    );
+
+    async::offload(
+        executor, reactor, [] {}, [&] { voidCompleted = true; },
+        [&](std::exception_ptr) { voidFailed = true; }
+    );
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((result == 0 || !error || !voidCompleted)
+           && std::chrono::steady_clock::now() < deadline)
+        reactor.runOnce(10);
+
+    CHECK(result == 42);
+    CHECK(!completed);
+    CHECK(voidCompleted && !voidFailed);
+    CHECK(error != nullptr);
+
+    try {
+        if (error) std::rethrow_exception(error);
+    } catch (const std::runtime_error& e) {
+        CHECK(std::string_view{e.what()} == "offload failed");
+    }
+
+    CHECK(waitForFailures(executor, 1));
+}
+
+int main() {
+    test_runs_tasks();
+    test_throwing_task();
+    test_offload();
+
+    return test::report("executor");
+}
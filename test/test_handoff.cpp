@@ -0,0 +1,260 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_handoff.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 10:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/net/handoff.hpp"
+#include <atomic>
+#include <format>
+#include <sys/wait.h>
+#include <thread>
+
+using namespace tiny_web_server;
+
+bool closeOnExec(const net::Socket& socket) {
+    return (fcntl(socket.nativeHandle(), F_GETFD) & FD_CLOEXEC) != 0;
+}
+
+net::Socket tcpListener() {
+    net::Socket socket(net::AddressFamily::IPv4, net::SocketType::STREAM);
+    socket.bind({net::IpAddress::loopback(), 0});
+    socket.listen();
+
+    return socket;
+}
+
+net::Endpoint controlEndpoint(const std::string_view tag) {
+    return net::Endpoint::abstractSocket(std::format("tws-test-{}-{}", tag, getpid()));
+}
+
+template<typename Done>
+void pump(async::Reactor& reactor, Done done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (!done() && std::chrono::steady_clock::now() < deadline) reactor.runOnce(10);
+}
+
+/// 新实例的 acquire 会阻塞到旧实例交出套接字，放到另一个线程中，本线程驱动旧实例的反应器
+net::ListenSockets acquire(async::Reactor& reactor, net::HotRestart& restart) {
+    net::ListenSockets listeners;
+    std::atomic<bool> done = false;
+
+    std::jthread thread([&] {
+        try {
+            listeners = restart.acquire();
+        } catch (const std::exception& e) { std::cerr << "acquire: " << e.what() << '\n'; }
+
+        done = true;
+    });
+
+    pump(reactor, [&] { return done.load(); });
+
+    return listeners;
+}
+
+void test_send_receive() {
+    using namespace net;
+
+    ListenSockets listeners;
+    listeners.push_back({"http", tcpListener()});
+    listeners.push_back({"", tcpListener()});
+
+    auto [sender, receiver] = Socket::pair(SocketType::SEQPACKET);
+
+    sendListeners(sender, listeners);
+    auto received = receiveListeners(receiver);
+
+    CHECK(received.size() == 2);
+    if (received.size() != 2) return;
+
+    for (std::size_t i = 0; i < received.size(); ++i) {
+        CHECK(received[i].name == listeners[i].name);
+        CHECK(
+            received[i].socket.localEndpoint().toString()
+            == listeners[i].socket.localEndpoint().toString()
+        );
+        CHECK(closeOnExec(received[i].socket));
+    }
+
+    // 收到的句柄与原句柄共享同一个监听队列
+    Socket client(AddressFamily::IPv4, SocketType::STREAM);
+    client.connect(listeners[0].socket.localEndpoint());
+
+    auto accepted = received[0].socket.accept();
+    CHECK(accepted.isValid());
+    CHECK(closeOnExec(accepted));
+
+    // 空列表与含换行的名称
+    bool threw = false;
+    try {
+        sendListeners(sender, {});
+    } catch (const std::system_error&) { threw = true; }
+    CHECK(threw);
+
+    ListenSockets badName;
+    badName.push_back({"a\nb", tcpListener()});
+
+    threw = false;
+    try {
+        sendListeners(sender, badName);
+    } catch (const std::system_error&) { threw = true; }
+    CHECK(threw);
+}
+
+void test_spawn_closes_sockets() {
+    using namespace net;
+
+    auto listener = tcpListener();
+
+    Socket client(AddressFamily::IPv4, SocketType::STREAM);
+    client.connect(listener.localEndpoint());
+    auto accepted = listener.accept();
+
+    CHECK(closeOnExec(listener));
+    CHECK(closeOnExec(client));
+    CHECK(closeOnExec(accepted));
+
+    // 子进程中这些句柄都不应存在
+    auto script = std::format(
+        "for fd in {} {} {}; do test -e /proc/self/fd/$fd && exit 1; done; exit 0",
+        listener.nativeHandle(), client.nativeHandle(), accepted.nativeHandle()
+    );
+
+    std::string shell = "sh", flag = "-c";
+    char* argv[]{shell.data(), flag.data(), script.data(), nullptr};
+
+    auto pid   = HotRestart::spawn(argv);
+    int status = 0;
+    CHECK(waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+void test_hot_restart() {
+    using namespace net;
+
+    auto control = controlEndpoint("restart");
+
+    ListenSockets listeners;
+    listeners.push_back({"http", tcpListener()});
+
+    async::Reactor reactor;
+    HotRestart old(control);
+
+    bool handedOff = false;
+    old.serve(reactor, listeners, [&] { handedOff = true; });
+
+    // 新实例在就绪前退出: 旧实例重新监听控制端点
+    {
+        HotRestart failed(control);
+
+        auto taken = acquire(reactor, failed);
+        CHECK(taken.size() == 1 && taken[0].name == "http");
+    }
+
+    for (int i = 0; i < 5; ++i) reactor.runOnce(10);
+    CHECK(!handedOff);
+
+    // 新实例确认就绪后旧实例收到回调
+    HotRestart next(control);
+
+    auto taken = acquire(reactor, next);
+    CHECK(taken.size() == 1);
+    if (taken.size() == 1)
+        CHECK(
+            taken[0].socket.localEndpoint().toString()
+            == listeners[0].socket.localEndpoint().toString()
+        );
+
+    next.ready();
+    pump(reactor, [&] { return handedOff; });
+    CHECK(handedOff);
+
+    // 交接后旧实例不再监听控制端点，之后的实例冷启动
+    HotRestart later(control);
+    CHECK(later.acquire().empty());
+}
+
+void test_rejects_other_users() {
+    using namespace net;
+
+    // 需要以 root 运行才能切换到其他用户
+    if (geteuid() != 0) return;
+
+    auto control = controlEndpoint("credentials");
+
+    ListenSockets listeners;
+    listeners.push_back({"http", tcpListener()});
+
+    async::Reactor reactor;
+    HotRestart old(control);
+    old.serve(reactor, listeners, [] {});
+
+    auto pid = fork();
+
+    if (pid == 0) {
+        if (setuid(65534) != 0) _exit(2);
+
+        try {
+            HotRestart intruder(control);
+            _exit(intruder.acquire().empty() ? 0 : 1);
+        } catch (...) { _exit(0); }
+    }
+
+    int status = 0;
+    pump(reactor, [&] { return waitpid(pid, &status, WNOHANG) == pid; });
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // 被拒绝的连接不影响同一用户的新实例
+    HotRestart next(control);
+    CHECK(acquire(reactor, next).size() == 1);
+}
+
+void test_drainer() {
+    net::Drainer drainer;
+
+    CHECK(!drainer.draining());
+    CHECK(drainer.wait(std::chrono::milliseconds(0)));
+
+    std::optional<net::Drainer::Guard> first{drainer.track()};
+    auto second = std::make_optional(drainer.track());
+    CHECK(drainer.active() == 2);
+
+    drainer.start();
+    CHECK(drainer.draining());
+    CHECK(!drainer.wait(std::chrono::milliseconds(10)));
+
+    // 守卫被移动后只计数一次
+    auto moved = std::move(*first);
+    first.reset();
+    CHECK(drainer.active() == 2);
+
+    std::jthread release([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        second.reset();
+        auto done = std::move(moved);
+    });
+
+    CHECK(drainer.wait(std::chrono::seconds(5)));
+    CHECK(drainer.active() == 0);
+}
+
+int main() {
+    test_send_receive();
+    test_spawn_closes_sockets();
+    test_hot_restart();
+    test_rejects_other_users();
+    test_drainer();
+
+    return test::report("handoff");
+}
@@ -0,0 +1,624 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_http2.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 07:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/async/reactor.hpp"
+#include "tws/http2/connection.hpp"
+#include "tws/http2/frame.hpp"
+#include "tws/http2/hpack.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace tiny_web_server;
+using namespace tiny_web_server::http2;
+
+/// 十六进制文本转为字节，忽略空白
+std::vector<std::byte> hex(const std::string_view text) {
+    std::vector<std::byte> out;
+    std::string digits;
+
+    for (auto c : text)
+        if (c != ' ' && c != '\n') digits.push_back(c);
+
+    for (std::size_t i = 0; i + 1 < digits.size(); i += 2)
+        out.push_back(static_cast<std::byte>(std::stoi(digits.substr(i, 2), nullptr, 16)));
+
+    return out;
+}
+
+using Fields = std::vector<std::pair<std::string, std::string>>;
+
+using Status = HpackDecoder::Status;
+
+bool decodes(HpackDecoder& decoder, const std::string_view block, const Fields& expected) {
+    std::vector<HeaderField> fields;
+
+    if (decoder.decode(hex(block), fields) != Status::OK || fields.size() != expected.size())
+        return false;
+
+    for (std::size_t i = 0; i < fields.size(); ++i)
+        if (fields[i].name != expected[i].first || fields[i].value != expected[i].second)
+            return false;
+
+    return true;
+}
+
+std::vector<std::byte> encodes(HpackEncoder& encoder, const Fields& fields) {
+    std::vector<std::byte> out;
+
+    for (const auto& [name, value] : fields) encoder.encode(name, value, out);
+
+    return out;
+}
+
+// RFC 7541 附录 C 中的请求与响应
+const Fields REQUEST_1{
+    {":method", "GET"},
+    {":scheme", "http"},
+    {":path", "/"},
+    {":authority", "www.example.com"}
+};
+
+const Fields REQUEST_2{
+    {":method", "GET"},
+    {":scheme", "http"},
+    {":path", "/"},
+    {":authority", "www.example.com"},
+    {"cache-control", "no-cache"}
+};
+
+const Fields REQUEST_3{
+    {":method", "GET"},
+    {":scheme", "https"},
+    {":path", "/index.html"},
+    {":authority", "www.example.com"},
+    {"custom-key", "custom-value"}
+};
+
+const Fields RESPONSE_1{
+    {":status", "302"},
+    {"cache-control", "private"},
+    {"date", "Mon, 21 Oct 2013 20:13:21 GMT"},
+    {"location", "https://www.example.com"}
+};
+
+const Fields RESPONSE_2{
+    {":status", "307"},
+    {"cache-control", "private"},
+    {"date", "Mon, 21 Oct 2013 20:13:21 GMT"},
+    {"location", "https://www.example.com"}
+};
+
+const Fields RESPONSE_3{
+    {":status", "200"},
+    {"cache-control", "private"},
+    {"date", "Mon, 21 Oct 2013 20:13:22 GMT"},
+    {"location", "https://www.example.com"},
+    {"content-encoding", "gzip"},
+    {"set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1"}
+};
+
+void test_rfc_requests() {
+    // C.3: 不使用 Huffman 编码，动态表跨请求累积
+    HpackDecoder plain;
+
+    CHECK(decodes(plain, "828684410f7777772e6578616d706c652e636f6d", REQUEST_1));
+    CHECK(decodes(plain, "828684be58086e6f2d6361636865", REQUEST_2));
+    CHECK(decodes(
+        plain,
+        "828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565",
+        REQUEST_3
+    ));
+
+    // C.4: 同样的请求使用 Huffman 编码; 编码器应输出完全相同的字节
+    HpackDecoder decoder;
+    HpackEncoder encoder;
+
+    const std::string_view blocks[]{
+        "828684418cf1e3c2e5f23a6ba0ab90f4ff",
+        "828684be5886a8eb10649cbf",
+        "828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf",
+    };
+    const Fields* requests[]{&REQUEST_1, &REQUEST_2, &REQUEST_3};
+
+    for (auto i = 0; i < 3; ++i) {
+        CHECK(decodes(decoder, blocks[i], *requests[i]));
+        CHECK(encodes(encoder, *requests[i]) == hex(blocks[i]));
+    }
+}
+
+void test_rfc_responses() {
+    // C.6: 动态表上限 256 字节，后续响应逐出最旧的表项
+    HpackDecoder decoder(256);
+    HpackEncoder encoder(256);
+
+    const std::string_view blocks[]{
+        "488264025885aec3771a4b6196d07abe941054d444a8200595040b8166e082a62d1bff6e919d29ad"
+        "171863c78f0b97c8e9ae82ae43d3",
+        "4883640effc1c0bf",
+        "88c16196d07abe941054d444a8200595040b8166e084a62d1bffc05a839bd9ab77ad94e7821dd7f2"
+        "e6c7b335dfdfcd5b3960d5af27087f3672c1ab270fb5291f9587316065c003ed4ee5b1063d5007",
+    };
+    const Fields* responses[]{&RESPONSE_1, &RESPONSE_2, &RESPONSE_3};
+
+    for (auto i = 0; i < 3; ++i) CHECK(decodes(decoder, blocks[i], *responses[i]));
+
+    // "307" 的 Huffman 编码与原文等长，编码器此时选择原文，其余字节与附录一致
+    CHECK(encodes(encoder, RESPONSE_1) == hex(blocks[0]));
+    CHECK(encodes(encoder, RESPONSE_2) == hex("4803333037c1c0bf"));
+    CHECK(encodes(encoder, RESPONSE_3) == hex(blocks[2]));
+}
+
+void test_dynamic_table() {
+    DynamicTable table(256);
+
+    table.insert("custom-key", "custom-value");
+    CHECK(table.count() == 1);
+    CHECK(table.size() == 54);
+
+    // 新表项在前，超出上限时逐出最旧的
+    for (auto i = 0; i < 5; ++i) table.insert("key", std::to_string(i));
+
+    CHECK(table.size() <= 256);
+    CHECK(table.get(0)->value == "4");
+    CHECK(table.get(table.count()) == nullptr);
+
+    // 比整个表还大的表项清空表
+    table.insert("big", std::string(300, 'x'));
+    CHECK(table.count() == 0);
+    CHECK(table.size() == 0);
+
+    table.insert("a", "b");
+    table.setMaxSize(0);
+    CHECK(table.count() == 0);
+}
+
+void test_table_size_update() {
+    // 头部块开头的大小更新可以连续出现，缩小时逐出表项
+    {
+        HpackDecoder decoder;
+        CHECK(decodes(decoder, "828684410f7777772e6578616d706c652e636f6d", REQUEST_1));
+        CHECK(decodes(decoder, "2020 3fe11f 82", {{":method", "GET"}}));
+
+        // 表已被清空，原先的 62 号表项不存在
+        std::vector<HeaderField> fields;
+        CHECK(decoder.decode(hex("be"), fields) == Status::ERROR);
+    }
+
+    // 不在开头或超过本端上限的大小更新是压缩错误
+    {
+        HpackDecoder decoder;
+        std::vector<HeaderField> fields;
+
+        CHECK(decoder.decode(hex("82 20"), fields) == Status::ERROR);
+        CHECK(HpackDecoder{}.decode(hex("3fe21f"), fields) == Status::ERROR);
+        CHECK(HpackDecoder{}.decode(hex("3fe11f"), fields) == Status::OK);
+    }
+
+    // 对端先缩小再放大: 编码器须先告知最小值
+    {
+        HpackEncoder encoder;
+        HpackDecoder decoder;
+
+        encoder.setMaxTableSize(0);
+        encoder.setMaxTableSize(1024);
+
+        auto block = encodes(encoder, {{":method", "GET"}});
+        CHECK(block == hex("20 3fe107 82"));
+
+        std::vector<HeaderField> fields;
+        CHECK(decoder.decode(block, fields) == Status::OK);
+
+        // 超过默认大小的设置按 4096 处理，未变化时不再发出更新
+        encoder.setMaxTableSize(4096);
+        encoder.setMaxTableSize(1 << 20);
+        CHECK(encodes(encoder, {{":method", "GET"}}) == hex("3fe11f 82"));
+        CHECK(encodes(encoder, {{":method", "GET"}}) == hex("82"));
+    }
+}
+
+void test_integer_overflow() {
+    std::vector<HeaderField> fields;
+
+    // 索引超出静态表与(空的)动态表
+    CHECK(HpackDecoder{}.decode(hex("ff00"), fields) == Status::ERROR);
+
+    // 整数的延续字节超过32位
+    CHECK(HpackDecoder{}.decode(hex("ff ffffffffff0f"), fields) == Status::ERROR);
+    CHECK(HpackDecoder{}.decode(hex("0f ffffffffffffffffff01 00"), fields) == Status::ERROR);
+
+    // 整数或字符串在头部块结尾被截断
+    CHECK(HpackDecoder{}.decode(hex("ff80"), fields) == Status::ERROR);
+    CHECK(HpackDecoder{}.decode(hex("400a 6375"), fields) == Status::ERROR);
+    CHECK(HpackDecoder{}.decode(hex("40 7f ffffffff0f"), fields) == Status::ERROR);
+}
+
+/// 字面量(增量索引、新名称)，名称与值都不用 Huffman 编码
+std::vector<std::byte> literal(const std::string_view name, const std::string_view value) {
+    std::vector<std::byte> out{std::byte{0x40}};
+
+    for (auto text : {name, value}) {
+        // 长度按7位前缀整数编码
+        auto length = text.size();
+        if (length < 127) {
+            out.push_back(static_cast<std::byte>(length));
+        } else {
+            out.push_back(std::byte{0x7f});
+            for (length -= 127; length >= 128; length >>= 7)
+                out.push_back(static_cast<std::byte>(length % 128 | 0x80));
+            out.push_back(static_cast<std::byte>(length));
+        }
+
+        auto bytes = std::as_bytes(std::span{text});
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+    return out;
+}
+
+void test_header_list_budget() {
+    HpackDecoder decoder;
+    std::vector<HeaderField> fields;
+
+    // 4000字节的表项，之后每个1字节的索引表示都展开为约4KB
+    auto entry = literal("x", std::string(4000, 'a'));
+    CHECK(decoder.decode(entry, fields, 16384) == Status::OK);
+    CHECK(fields.size() == 1);
+
+    std::vector<std::byte> bomb(1000, std::byte{0xbe});
+    auto tail = literal("y", "b");
+    bomb.insert(bomb.end(), tail.begin(), tail.end());
+
+    fields.clear();
+    fields.push_back({"kept", "1"});
+    CHECK(decoder.decode(bomb, fields, 16384) == Status::TOO_LARGE);
+    CHECK(fields.size() == 1 && fields[0].name == "kept");
+
+    // 超出预算后的字面量仍插入了动态表: 62 号表项是 y: b
+    fields.clear();
+    CHECK(decoder.decode(hex("be bf"), fields) == Status::OK);
+    CHECK(fields.size() == 2);
+    CHECK(fields[0].name == "y" && fields[0].value == "b");
+    CHECK(fields[1].name == "x" && fields[1].value.size() == 4000);
+
+    // 恰好等于预算: 名称、值与32字节
+    fields.clear();
+    CHECK(decoder.decode(hex("be"), fields, 1 + 1 + 32) == Status::OK);
+    CHECK(decoder.decode(hex("be"), fields, 1 + 1 + 31) == Status::TOO_LARGE);
+}
+
+void test_huffman() {
+    // 所有字节值往返
+    std::string all;
+    for (auto c = 0; c < 256; ++c) all.push_back(static_cast<char>(c));
+
+    std::vector<std::byte> encoded;
+    huffmanEncode(all, encoded);
+    CHECK(encoded.size() == huffmanEncodedSize(all));
+
+    std::string decoded;
+    CHECK(huffmanDecode(encoded, decoded));
+    CHECK(decoded == all);
+
+    // 'a' 的码为 00011: 以1填充合法
+    decoded.clear();
+    CHECK(huffmanDecode(hex("1f"), decoded) && decoded == "a");
+
+    // 填充不全为1
+    decoded.clear();
+    CHECK(!huffmanDecode(hex("18"), decoded));
+
+    // 填充超过7位
+    decoded.clear();
+    CHECK(!huffmanDecode(hex("1fff"), decoded));
+
+    // 显式编码的 EOS(30个1)
+    decoded.clear();
+    CHECK(!huffmanDecode(hex("ffffffff"), decoded));
+    CHECK(!huffmanDecode(hex("1fffffffff"), decoded));
+
+    decoded.clear();
+    CHECK(huffmanDecode({}, decoded) && decoded.empty());
+}
+
+/**
+ * @brief 以 Unix 域套接字对驱动一个 HTTP/2 连接
+ */
+struct Client {
+    async::Reactor reactor;
+
+    net::Socket peer;
+
+    std::shared_ptr<Connection> connection;
+
+    int requests = 0;
+
+    std::vector<std::byte> received;
+
+    explicit Client(const ConnectionOptions& options = {}) {
+        auto [server, client] = net::Socket::pair();
+
+        peer = std::move(client);
+        peer.setNonBlocking();
+
+        connection = Connection::start(
+            std::move(server), {}, reactor,
+            [this](Connection& h2, const std::uint32_t id, Request&) {
+                ++requests;
+                h2.respond(id, {});
+            },
+            options
+        );
+
+        auto preface = std::as_bytes(std::span{PREFACE});
+
+        std::vector<std::byte> out{preface.begin(), preface.end()};
+        appendSettings(out, {});
+
+        send(out);
+    }
+
+    void send(const std::span<const std::byte> data) {
+        for (auto offset = std::size_t{0}; offset < data.size();) {
+            // 连接出错关闭后不再发送
+            try {
+                if (auto sent = peer.trySend(data.subspan(offset))) offset += *sent;
+            } catch (const std::system_error&) { break; }
+
+            pump();
+        }
+
+        pump();
+    }
+
+    void pump() {
+        for (auto i = 0; i < 4; ++i) reactor.runOnce(0);
+
+        std::byte buffer[16384];
+
+        while (auto size = peer.tryRecv(buffer)) {
+            if (*size == 0) break;
+            received.insert(received.end(), buffer, buffer + *size);
+        }
+    }
+
+    /**
+     * @return 指定类型的帧(流标识匹配)的负载中偏移 @p offset 处的错误码
+     */
+    std::optional<ErrorCode>
+    error(const FrameType type, const std::uint32_t streamId, const std::size_t offset) {
+        std::span<const std::byte> data = received;
+
+        FrameHeader header;
+        while (parseHeader(data, header)) {
+            if (data.size() < FRAME_HEADER_SIZE + header.length) break;
+
+            auto payload = data.subspan(FRAME_HEADER_SIZE, header.length);
+            data         = data.subspan(FRAME_HEADER_SIZE + header.length);
+
+            if (header.type == type && header.streamId == streamId)
+                return static_cast<ErrorCode>(readInteger(payload.data() + offset, 4));
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<ErrorCode> goaway() { return error(FrameType::GOAWAY, 0, 4); }
+
+    std::optional<ErrorCode> rst(const std::uint32_t id) {
+        return error(FrameType::RST_STREAM, id, 0);
+    }
+};
+
+std::vector<std::byte> requestBlock() {
+    HpackEncoder encoder;
+
+    return encodes(encoder, REQUEST_1);
+}
+
+std::vector<std::byte>
+frame(const FrameType type, const std::uint8_t flags, const std::uint32_t id,
+      const std::span<const std::byte> payload = {}) {
+    std::vector<std::byte> out;
+    appendFrame(out, type, flags, id, payload);
+
+    return out;
+}
+
+std::vector<std::byte> windowUpdate(const std::uint32_t id, const std::uint32_t increment) {
+    std::byte payload[4];
+    writeInteger(payload, increment, 4);
+
+    return frame(FrameType::WINDOW_UPDATE, 0, id, payload);
+}
+
+void test_continuation() {
+    auto block = requestBlock();
+    auto first = std::span{block}.first(3);
+    auto rest  = std::span{block}.subspan(3);
+
+    // 拆成 HEADERS + CONTINUATION 的头部块
+    {
+        Client client;
+        client.send(frame(FrameType::HEADERS, flags::END_STREAM, 1, first));
+        CHECK(client.requests == 0);
+
+        client.send(frame(FrameType::CONTINUATION, flags::END_HEADERS, 1, rest));
+        CHECK(client.requests == 1);
+        CHECK(!client.goaway());
+    }
+
+    // 头部块未结束时出现其他帧、其他流的 CONTINUATION 或孤立的 CONTINUATION
+    {
+        Client client;
+        client.send(frame(FrameType::HEADERS, flags::END_STREAM, 1, first));
+        client.send(frame(FrameType::PING, 0, 0, hex("0000000000000000")));
+        CHECK(client.goaway() == ErrorCode::PROTOCOL_ERROR);
+    }
+    {
+        Client client;
+        client.send(frame(FrameType::HEADERS, flags::END_STREAM, 1, first));
+        client.send(frame(FrameType::CONTINUATION, flags::END_HEADERS, 3, rest));
+        CHECK(client.goaway() == ErrorCode::PROTOCOL_ERROR);
+    }
+    {
+        Client client;
+        client.send(frame(FrameType::CONTINUATION, flags::END_HEADERS, 1, block));
+        CHECK(client.goaway() == ErrorCode::PROTOCOL_ERROR);
+    }
+
+    // 头部块超过上限
+    {
+        Client client;
+        std::vector<std::byte> filler(16000);
+
+        client.send(frame(FrameType::HEADERS, flags::END_STREAM, 1, first));
+        for (auto i = 0; i < 3; ++i)
+            client.send(frame(FrameType::CONTINUATION, 0, 1, filler));
+
+        CHECK(client.goaway() == ErrorCode::ENHANCE_YOUR_CALM);
+        CHECK(client.requests == 0);
+    }
+
+    // 大量空的 CONTINUATION 帧
+    {
+        Client client;
+        client.send(frame(FrameType::HEADERS, flags::END_STREAM, 1, first));
+        for (auto i = 0; i < 40; ++i) client.send(frame(FrameType::CONTINUATION, 0, 1));
+
+        CHECK(client.goaway() == ErrorCode::ENHANCE_YOUR_CALM);
+    }
+}
+
+void test_window_update() {
+    // 连接级窗口恰好到达上限是允许的
+    {
+        Client client;
+        client.send(windowUpdate(0, MAX_WINDOW_SIZE - DEFAULT_WINDOW_SIZE));
+        CHECK(!client.goaway());
+
+        client.send(windowUpdate(0, 1));
+        CHECK(client.goaway() == ErrorCode::FLOW_CONTROL_ERROR);
+    }
+
+    // 增量为0
+    {
+        Client client;
+        client.send(windowUpdate(0, 0));
+        CHECK(client.goaway() == ErrorCode::PROTOCOL_ERROR);
+    }
+
+    // 流级窗口溢出只重置该流
+    {
+        Client client;
+        auto block = requestBlock();
+
+        client.send(frame(FrameType::HEADERS, flags::END_HEADERS, 1, block));
+        client.send(windowUpdate(1, MAX_WINDOW_SIZE));
+
+        CHECK(client.rst(1) == ErrorCode::FLOW_CONTROL_ERROR);
+        CHECK(!client.goaway());
+    }
+    {
+        Client client;
+        auto block = requestBlock();
+
+        client.send(frame(FrameType::HEADERS, flags::END_HEADERS, 1, block));
+        client.send(windowUpdate(1, 0));
+
+        CHECK(client.rst(1) == ErrorCode::PROTOCOL_ERROR);
+    }
+}
+
+void test_header_list_size() {
+    // 展开后超出 maxHeaderListSize 的头部块只以 431 拒绝该流，连接继续可用
+    Client client;
+    auto block = requestBlock();
+
+    auto bomb = literal("x", std::string(4000, 'a'));
+    bomb.insert(bomb.end(), 8, std::byte{0xbe});
+    bomb.insert(bomb.end(), block.begin(), block.end());
+
+    client.send(frame(FrameType::HEADERS, flags::END_HEADERS | flags::END_STREAM, 1, bomb));
+    CHECK(client.requests == 0);
+    CHECK(client.rst(1) == std::nullopt);
+    CHECK(!client.goaway());
+
+    // 431 的头部块为 HEADERS 帧: 流1，带 END_STREAM
+    std::span<const std::byte> data = client.received;
+    auto responded = false;
+
+    FrameHeader header;
+    while (parseHeader(data, header) && data.size() >= FRAME_HEADER_SIZE + header.length) {
+        if (header.type == FrameType::HEADERS && header.streamId == 1) responded = true;
+        data = data.subspan(FRAME_HEADER_SIZE + header.length);
+    }
+    CHECK(responded);
+
+    HpackEncoder encoder;
+    client.send(frame(
+        FrameType::HEADERS, flags::END_HEADERS | flags::END_STREAM, 3,
+        encodes(encoder, REQUEST_1)
+    ));
+    CHECK(client.requests == 1);
+}
+
+void test_buffered_body() {
+    ConnectionOptions options;
+    options.maxBufferedBodySize = 40000;
+
+    Client client{options};
+    std::vector<std::byte> chunk(16384);
+
+    for (std::uint32_t id : {1, 3, 5}) {
+        HpackEncoder encoder;
+        auto block = encodes(encoder, REQUEST_1);
+
+        client.send(frame(FrameType::HEADERS, flags::END_HEADERS, id, block));
+    }
+
+    // 两个流合计缓冲的请求体超出预算时，新到数据的流被拒绝
+    client.send(frame(FrameType::DATA, 0, 1, chunk));
+    client.send(frame(FrameType::DATA, 0, 3, chunk));
+    client.send(frame(FrameType::DATA, 0, 5, chunk));
+
+    CHECK(client.rst(5) == ErrorCode::NONE);
+    CHECK(!client.rst(1) && !client.rst(3));
+    CHECK(!client.goaway());
+
+    // 交给回调后释放预算
+    client.send(frame(FrameType::DATA, flags::END_STREAM, 1));
+    CHECK(client.requests == 1);
+
+    client.send(frame(FrameType::DATA, 0, 3, chunk));
+    CHECK(!client.rst(3));
+}
+
+int main() {
+    test_rfc_requests();
+    test_rfc_responses();
+    test_dynamic_table();
+    test_table_size_update();
+    test_integer_overflow();
+    test_header_list_budget();
+    test_huffman();
+    test_continuation();
+    test_window_update();
+    test_header_list_size();
+    test_buffered_body();
+
+    return test::report("HTTP/2");
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_metrics.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 06:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/metrics/metrics.hpp"
+#include <charconv>
+#include <limits>
+#include <string>
+
+using namespace tiny_web_server;
+
+using Histogram = metrics::Histogram;
+
+void test_bucket_index() {
+    // 小于子桶数的值各占一个桶
+    CHECK(Histogram::bucketIndex(0) == 0);
+    CHECK(Histogram::bucketIndex(1) == 1);
+    CHECK(Histogram::bucketIndex(Histogram::SUB_BUCKETS - 1) == Histogram::SUB_BUCKETS - 1);
+
+    // 每个2的幂都开启一个新区间的首个子桶
+    for (auto exponent = Histogram::SUB_BUCKET_BITS; exponent < 64; ++exponent) {
+        auto power = std::uint64_t{1} << exponent;
+        auto index = Histogram::bucketIndex(power);
+
+        CHECK(index == Histogram::SUB_BUCKETS * (exponent - Histogram::SUB_BUCKET_BITS + 1));
+        CHECK(Histogram::bucketIndex(power - 1) == index - 1);
+        CHECK(Histogram::bucketUpperBound(index - 1) == power - 1);
+        CHECK(Histogram::bucketUpperBound(index) >= power);
+    }
+
+    // 最大值落在最后一个桶，且其上界正好是最大值
+    constexpr auto MAX = std::numeric_limits<std::uint64_t>::max();
+
+    CHECK(Histogram::bucketIndex(MAX) == Histogram::BUCKET_COUNT - 1);
+    CHECK(Histogram::bucketUpperBound(Histogram::BUCKET_COUNT - 1) == MAX);
+
+    // 上界总落在同一个桶内，相对误差不超过 1/16
+    for (std::uint64_t value : {std::uint64_t{17}, std::uint64_t{1025}, MAX / 3}) {
+        auto upper = Histogram::bucketUpperBound(Histogram::bucketIndex(value));
+
+        CHECK(upper >= value);
+        CHECK(Histogram::bucketIndex(upper) == Histogram::bucketIndex(value));
+        CHECK(upper - value <= value / Histogram::SUB_BUCKETS);
+    }
+}
+
+/// 以与渲染相同的方式格式化秒数
+std::string seconds(const std::uint64_t nanoseconds) {
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), nanoseconds / 1e9);
+
+    return {buffer, end};
+}
+
+/// 取出 name{le="..."} 行的计数，缺失时返回 -1
+long long bucket(const std::string& out, const std::string& name, const std::string& le) {
+    auto prefix   = name + "_bucket{le=\"" + le + "\"} ";
+    auto position = out.find(prefix);
+
+    if (position == std::string::npos) return -1;
+
+    return std::stoll(out.substr(position + prefix.size()));
+}
+
+/// 导出的第 exponent 个边界: 含 2^exponent 的桶的上界
+std::string edge(const int exponent) {
+    using metrics::Histogram;
+
+    auto index = Histogram::bucketIndex(std::uint64_t{1} << exponent);
+
+    return seconds(Histogram::bucketUpperBound(index));
+}
+
+void test_render_histogram() {
+    metrics::Registry registry;
+
+    auto& histogram = registry.histogram("tws_test_seconds", "Test latency");
+
+    // 2^10 所在桶的上界为 2^10 + 2^6 - 1
+    constexpr std::uint64_t FIRST_EDGE = (1 << 10) + (1 << 6) - 1;
+
+    histogram.record(1 << 10);
+    histogram.record((1 << 10) - 1);
+    histogram.record(FIRST_EDGE);
+    histogram.record(FIRST_EDGE + 1);
+    histogram.record(std::uint64_t{1} << 20);
+    histogram.record(std::uint64_t{1} << 40);
+
+    std::string out;
+    registry.render(out);
+
+    CHECK(out.find("# HELP tws_test_seconds Test latency\n") != std::string::npos);
+    CHECK(out.find("# TYPE tws_test_seconds histogram\n") != std::string::npos);
+
+    // 每个 le 的计数恰为不超过 le 的观测数: 上界本身计入，再大1就不计入
+    CHECK(edge(10) == seconds(FIRST_EDGE));
+    CHECK(bucket(out, "tws_test_seconds", edge(10)) == 3);
+    CHECK(bucket(out, "tws_test_seconds", edge(11)) == 4);
+    CHECK(bucket(out, "tws_test_seconds", edge(19)) == 4);
+    CHECK(bucket(out, "tws_test_seconds", edge(20)) == 5);
+    CHECK(bucket(out, "tws_test_seconds", edge(35)) == 5);
+
+    // 不再以2的幂本身作为 le
+    CHECK(bucket(out, "tws_test_seconds", seconds(1 << 10)) == -1);
+
+    // 超出导出范围的观测只出现在 +Inf 与 _count 中
+    CHECK(bucket(out, "tws_test_seconds", "+Inf") == 6);
+    CHECK(out.find("tws_test_seconds_count 6\n") != std::string::npos);
+}
+
+void test_render_families() {
+    metrics::Registry registry;
+
+    registry.counter("tws_test_total", "Test counter", "direction=\"in\"").add(3);
+    registry.gauge("tws_test_active", "Test gauge").add(-2);
+    registry.counter("tws_test_total", "Test counter", "direction=\"out\"").add(4);
+
+    // 重复注册返回同一个指标
+    registry.counter("tws_test_total", "Test counter", "direction=\"in\"").add(1);
+
+    std::string out;
+    registry.render(out);
+
+    // 同名指标连续输出，HELP/TYPE 只出现一次
+    CHECK(out == "# HELP tws_test_total Test counter\n"
+                 "# TYPE tws_test_total counter\n"
+                 "tws_test_total{direction=\"in\"} 4\n"
+                 "tws_test_total{direction=\"out\"} 4\n"
+                 "# HELP tws_test_active Test gauge\n"
+                 "# TYPE tws_test_active gauge\n"
+                 "tws_test_active -2\n");
+}
+
+int main() {
+    test_bucket_index();
+    test_render_histogram();
+    test_render_families();
+
+    return test::report("metrics");
+}
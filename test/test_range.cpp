@@ -0,0 +1,254 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_range.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 10:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/http/range.hpp"
+#include "tws/http/response.hpp"
+#include "tws/http/static_file.hpp"
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace tiny_web_server;
+
+using Status = http::RangeSet::Status;
+
+void test_single_ranges() {
+    using namespace http;
+
+    auto result = parseRange("bytes=0-99", 1000);
+    CHECK(result.status == Status::SATISFIABLE);
+    CHECK((result.ranges == std::vector<ByteRange>{{0, 100}}));
+
+    // 开放区间
+    result = parseRange("bytes=900-", 1000);
+    CHECK((result.ranges == std::vector<ByteRange>{{900, 100}}));
+
+    // 末尾超出文件大小时截断
+    result = parseRange("bytes=990-5000", 1000);
+    CHECK((result.ranges == std::vector<ByteRange>{{990, 10}}));
+
+    // 后缀区间，以及超过文件大小的后缀
+    result = parseRange("bytes=-10", 1000);
+    CHECK((result.ranges == std::vector<ByteRange>{{990, 10}}));
+
+    result = parseRange("bytes=-5000", 1000);
+    CHECK((result.ranges == std::vector<ByteRange>{{0, 1000}}));
+
+    // 空白与大小写敏感的单位
+    result = parseRange("  bytes=0-0 ", 1000);
+    CHECK((result.ranges == std::vector<ByteRange>{{0, 1}}));
+    CHECK(parseRange("Bytes=0-0", 1000).status == Status::IGNORED);
+}
+
+void test_unsatisfiable() {
+    using namespace http;
+
+    // bytes=-0 不选择任何字节
+    CHECK(parseRange("bytes=-0", 1000).status == Status::UNSATISFIABLE);
+
+    // 起点在文件末尾或之后
+    CHECK(parseRange("bytes=1000-", 1000).status == Status::UNSATISFIABLE);
+    CHECK(parseRange("bytes=1000-2000", 1000).status == Status::UNSATISFIABLE);
+
+    // 空文件上的任何区间
+    CHECK(parseRange("bytes=0-", 0).status == Status::UNSATISFIABLE);
+    CHECK(parseRange("bytes=-1", 0).status == Status::UNSATISFIABLE);
+
+    // 只要有一个区间可满足即为 206
+    auto result = parseRange("bytes=2000-3000,0-0", 1000);
+    CHECK(result.status == Status::SATISFIABLE);
+    CHECK((result.ranges == std::vector<ByteRange>{{0, 1}}));
+}
+
+void test_invalid() {
+    using namespace http;
+
+    // 非法区间使整个头被忽略
+    for (auto header :
+         {"", "bytes=", "bytes=5-2", "bytes=abc", "bytes=1-x", "bytes=--1", "bytes=-",
+          "bytes=0-1,5-2", "items=0-1", "bytes=18446744073709551616-"})
+        CHECK(parseRange(header, 1000).status == Status::IGNORED);
+}
+
+void test_merging() {
+    using namespace http;
+
+    // 乱序、重叠与相邻的区间按偏移排序合并
+    auto result = parseRange("bytes=50-59,0-9,5-19,20-29,-10", 100);
+    CHECK(result.status == Status::SATISFIABLE);
+    CHECK((result.ranges == std::vector<ByteRange>{{0, 30}, {50, 10}, {90, 10}}));
+
+    // 合并后区间过多时忽略 Range
+    std::string many = "bytes=";
+    for (int i = 0; i < 17; ++i)
+        many += std::to_string(i * 10) + "-" + std::to_string(i * 10) + ",";
+    many.pop_back();
+
+    CHECK(parseRange(many, 1000).status == Status::IGNORED);
+    CHECK(parseRange(many, 1000, 17).ranges.size() == 17);
+
+    // 大量重叠碎片合并后不超限
+    std::string overlapping = "bytes=";
+    for (int i = 0; i < 100; ++i) overlapping += "0-" + std::to_string(i) + ",";
+    overlapping.pop_back();
+
+    result = parseRange(overlapping, 1000);
+    CHECK((result.ranges == std::vector<ByteRange>{{0, 100}}));
+}
+
+void test_content_range() {
+    using namespace http;
+
+    CHECK(contentRange({0, 100}, 1000) == "bytes 0-99/1000");
+    CHECK(contentRange({999, 1}, 1000) == "bytes 999-999/1000");
+    CHECK(
+        contentRange({0, UINT64_MAX}, UINT64_MAX)
+        == "bytes 0-18446744073709551614/18446744073709551615"
+    );
+}
+
+void test_if_range() {
+    using namespace http;
+
+    constexpr std::string_view date = "Sun, 06 Nov 1994 08:49:37 GMT";
+
+    CHECK(ifRangeMatches("", "\"a\"", date));
+    CHECK(ifRangeMatches("\"a\"", "\"a\"", date));
+    CHECK(!ifRangeMatches("\"b\"", "\"a\"", date));
+    CHECK(!ifRangeMatches("\"a\"", "", date));
+
+    // 弱标签不能用于 If-Range
+    CHECK(!ifRangeMatches("W/\"a\"", "W/\"a\"", date));
+    CHECK(!ifRangeMatches("\"a\"", "W/\"a\"", date));
+
+    CHECK(ifRangeMatches(date, "", date));
+    CHECK(!ifRangeMatches("Sun, 06 Nov 1994 08:49:38 GMT", "", date));
+    CHECK(!ifRangeMatches(date, "", ""));
+}
+
+struct Reply {
+    int status;
+    std::string text;
+
+    [[nodiscard]] std::string_view body() const {
+        auto end = text.find("\r\n\r\n");
+        if (end == std::string::npos) return {};
+
+        return std::string_view{text}.substr(end + 4);
+    }
+
+    [[nodiscard]] std::string header(const std::string_view name) const {
+        auto pos = text.find(std::string{"\r\n"}.append(name).append(": "));
+        if (pos == std::string::npos) return {};
+
+        pos += name.size() + 4;
+        return text.substr(pos, text.find("\r\n", pos) - pos);
+    }
+};
+
+Reply request(
+    const http::StaticFile& file, const std::string_view range,
+    const std::string_view ifRange = {}
+) {
+    auto [server, client] = net::Socket::pair();
+
+    Reply reply{http::sendStaticFile(server, file, "text/plain", range, ifRange), {}};
+    server = {};
+
+    std::array<std::byte, 4096> buffer;
+
+    while (auto received = client.recv(buffer))
+        reply.text.append(reinterpret_cast<const char*>(buffer.data()), received);
+
+    return reply;
+}
+
+void test_send_static_file() {
+    namespace fs = std::filesystem;
+
+    auto path = fs::temp_directory_path() / "tws_test_range.txt";
+
+    std::string content;
+    for (int i = 0; i < 100; ++i) content.push_back(static_cast<char>('A' + i % 26));
+
+    std::ofstream(path, std::ios::binary) << content;
+
+    auto file = http::resolveStaticFile(path, {});
+    CHECK(file.has_value());
+    if (!file) return;
+
+    auto full = request(*file, {});
+    CHECK(full.status == 200);
+    CHECK(full.body() == content);
+    CHECK(full.header("Accept-Ranges") == "bytes");
+
+    auto lastModified = full.header("Last-Modified");
+    CHECK(lastModified.size() == http::HttpDate::SIZE);
+
+    auto single = request(*file, "bytes=10-19");
+    CHECK(single.status == 206);
+    CHECK(single.header("Content-Range") == "bytes 10-19/100");
+    CHECK(single.header("Content-Length") == "10");
+    CHECK(single.body() == content.substr(10, 10));
+
+    auto suffix = request(*file, "bytes=-5");
+    CHECK(suffix.body() == content.substr(95));
+
+    auto unsatisfiable = request(*file, "bytes=100-");
+    CHECK(unsatisfiable.status == 416);
+    CHECK(unsatisfiable.header("Content-Range") == "bytes */100");
+    CHECK(unsatisfiable.body().empty());
+
+    // 非法 Range 按完整内容响应
+    CHECK(request(*file, "bytes=5-2").status == 200);
+
+    // 多区间
+    auto multi = request(*file, "bytes=0-1,50-52");
+    CHECK(multi.status == 206);
+
+    auto type     = multi.header("Content-Type");
+    auto boundary = type.substr(type.find("boundary=") + 9);
+    CHECK(type.starts_with("multipart/byteranges; boundary="));
+    CHECK(!boundary.empty());
+    CHECK(std::stoul(multi.header("Content-Length")) == multi.body().size());
+
+    auto expected = "\r\n--" + boundary + "\r\nContent-Type: text/plain\r\n"
+                  + "Content-Range: bytes 0-1/100\r\n\r\n" + content.substr(0, 2)
+                  + "\r\n--" + boundary + "\r\nContent-Type: text/plain\r\n"
+                  + "Content-Range: bytes 50-52/100\r\n\r\n" + content.substr(50, 3)
+                  + "\r\n--" + boundary + "--\r\n";
+    CHECK(multi.body() == expected);
+
+    // If-Range 与 Last-Modified 一致时 Range 生效，否则发送完整内容
+    CHECK(request(*file, "bytes=0-9", lastModified).status == 206);
+    CHECK(request(*file, "bytes=0-9", "Thu, 01 Jan 1970 00:00:00 GMT").status == 200);
+    CHECK(request(*file, "bytes=100-", "\"etag\"").status == 200);
+
+    fs::remove(path);
+}
+
+int main() {
+    test_single_ranges();
+    test_unsatisfiable();
+    test_invalid();
+    test_merging();
+    test_content_range();
+    test_if_range();
+    test_send_static_file();
+
+    return test::report("range");
+}
@@ -0,0 +1,272 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_single_flight.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 09:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/async/single_flight.hpp"
+#include <barrier>
+#include <stdexcept>
+#include <thread>
+
+using namespace tiny_web_server;
+using namespace std::chrono_literals;
+
+using Flight = async::SingleFlight<std::string, std::string>;
+
+/**
+ * @brief 跟随者回调收到的内容
+ */
+struct Outcome {
+    int calls = 0;
+
+    std::error_code error;
+
+    Flight::Result value;
+
+    std::exception_ptr exception;
+
+    Flight::Callback callback() {
+        return [this](auto error, auto value, auto exception) {
+            ++calls;
+            this->error     = error;
+            this->value     = std::move(value);
+            this->exception = std::move(exception);
+        };
+    }
+};
+
+/// 执行已投递给反应器的回调
+void drain(async::Reactor& reactor) { (void)reactor.runOnce(0); }
+
+void test_coalescing() {
+    async::Reactor reactor;
+    Flight flight;
+
+    std::vector<Outcome> followers(5);
+
+    auto ticket = flight.join("/hot", reactor, followers[0].callback());
+    CHECK(ticket);
+
+    // 执行期间到达的调用者都成为跟随者
+    for (std::size_t i = 1; i < followers.size(); ++i)
+        CHECK(!flight.join("/hot", reactor, followers[i].callback()));
+
+    // 不同的键各自执行
+    auto other = flight.join("/cold", reactor, [](auto...) {});
+    CHECK(other);
+    CHECK(flight.size() == 2);
+
+    CHECK(flight.complete(*ticket, std::string{"payload"}));
+    drain(reactor);
+
+    // 领导者的回调不被调用，跟随者共享同一个结果对象
+    CHECK(followers[0].calls == 0);
+
+    for (std::size_t i = 1; i < followers.size(); ++i) {
+        CHECK(followers[i].calls == 1);
+        CHECK(!followers[i].error && !followers[i].exception);
+        CHECK(followers[i].value && *followers[i].value == "payload");
+        CHECK(followers[i].value == followers[1].value);
+    }
+
+    CHECK(flight.complete(*other, std::string{}));
+}
+
+void test_concurrent_join() {
+    constexpr auto THREADS = 8;
+
+    async::Reactor reactor;
+    Flight flight;
+
+    std::atomic<int> leaders   = 0;
+    std::atomic<int> delivered = 0;
+    std::optional<Flight::Ticket> ticket;
+    std::barrier start{THREADS};
+
+    {
+        std::vector<std::jthread> threads;
+
+        for (auto i = 0; i < THREADS; ++i) {
+            threads.emplace_back([&] {
+                start.arrive_and_wait();
+
+                auto receive = [&](auto error, auto value, auto) {
+                    if (!error && value && *value == "shared") ++delivered;
+                };
+
+                auto joined = flight.join("/hot", reactor, receive);
+
+                if (!joined) return;
+
+                ++leaders;
+                ticket = std::move(joined);
+            });
+        }
+    }
+
+    // 同时到达的调用者中只有一个成为领导者
+    CHECK(leaders == 1);
+    CHECK(flight.size() == 1);
+
+    // 其余线程都收到领导者的结果
+    CHECK(ticket && flight.complete(*ticket, std::string{"shared"}));
+    drain(reactor);
+
+    CHECK(delivered == THREADS - 1);
+}
+
+void test_exception() {
+    async::Reactor reactor;
+    Flight flight;
+
+    std::vector<Outcome> followers(4);
+
+    auto ticket = flight.join("/broken", reactor, [](auto...) {});
+    CHECK(ticket);
+
+    for (auto& follower : followers)
+        CHECK(!flight.join("/broken", reactor, follower.callback()));
+
+    // 领导者自己也收到异常
+    auto rethrown = false;
+
+    try {
+        flight.execute(*ticket, []() -> std::string {
+            throw std::runtime_error("upstream exploded");
+        });
+    } catch (const std::runtime_error& error) {
+        rethrown = std::string_view{error.what()} == "upstream exploded";
+    }
+
+    CHECK(rethrown);
+    CHECK(flight.size() == 0);
+
+    drain(reactor);
+
+    // 每个跟随者都收到同一个异常
+    for (auto& follower : followers) {
+        CHECK(follower.calls == 1);
+        CHECK(follower.error == std::errc::operation_canceled);
+        CHECK(!follower.value);
+        CHECK(follower.exception == followers[0].exception);
+
+        auto message = std::string{};
+
+        try {
+            if (follower.exception) std::rethrow_exception(follower.exception);
+        } catch (const std::runtime_error& error) { message = error.what(); }
+
+        CHECK(message == "upstream exploded");
+    }
+
+    // 成功的 execute 把结果同时交给领导者与跟随者
+    Outcome follower;
+    ticket = flight.join("/ok", reactor, [](auto...) {});
+    CHECK(!flight.join("/ok", reactor, follower.callback()));
+
+    auto value = flight.execute(*ticket, [] { return std::string{"fine"}; });
+    drain(reactor);
+
+    CHECK(value && *value == "fine");
+    CHECK(follower.calls == 1 && follower.value == value);
+}
+
+void test_key_released() {
+    async::Reactor reactor;
+    Flight flight;
+
+    auto first = flight.join("/page", reactor, [](auto...) {});
+    CHECK(first);
+    CHECK(flight.complete(*first, std::string{"v1"}));
+    CHECK(flight.size() == 0);
+
+    // 完成后到达的调用者另起一次执行，不会拿到旧结果
+    Outcome late;
+    auto second = flight.join("/page", reactor, late.callback());
+    CHECK(second);
+    CHECK(second && second->id != first->id);
+
+    // 旧凭据不能提交到新的执行
+    CHECK(!flight.complete(*first, std::string{"stale"}));
+    CHECK(flight.size() == 1);
+
+    // 以错误码结束同样释放键
+    Outcome follower;
+    CHECK(!flight.join("/page", reactor, follower.callback()));
+    CHECK(flight.complete(*second, nullptr, std::make_error_code(std::errc::io_error)));
+    CHECK(flight.size() == 0);
+
+    drain(reactor);
+    CHECK(late.calls == 0);
+    CHECK(follower.calls == 1 && follower.error == std::errc::io_error);
+
+    // 失败后的执行也释放键
+    auto third = flight.join("/page", reactor, [](auto...) {});
+    CHECK(third);
+    CHECK(flight.fail(*third, std::make_exception_ptr(std::logic_error("x"))));
+    CHECK(!flight.fail(*third, nullptr));
+    CHECK(flight.join("/page", reactor, [](auto...) {}));
+}
+
+void test_timeouts() {
+    async::Reactor reactor;
+
+    async::SingleFlightOptions options;
+    options.waitTimeout   = 100ms;
+    options.flightTimeout = 1s;
+    options.maxWaiters    = 2;
+
+    Flight flight{options};
+
+    auto now    = Flight::Clock::now();
+    auto ticket = flight.join("/slow", reactor, [](auto...) {}, now);
+
+    Outcome waiting, rejected, extra;
+    CHECK(!flight.join("/slow", reactor, waiting.callback(), now));
+    CHECK(!flight.join("/slow", reactor, extra.callback(), now + 500ms));
+
+    // 跟随者数达到上限时拒绝
+    CHECK(!flight.join("/slow", reactor, rejected.callback(), now));
+    drain(reactor);
+    CHECK(rejected.calls == 1);
+    CHECK(rejected.error == std::errc::resource_unavailable_try_again);
+
+    // 跟随者按各自的等待时限超时，执行本身仍在进行
+    auto next = flight.expire(now + 100ms);
+    drain(reactor);
+
+    CHECK(waiting.calls == 1 && waiting.error == std::errc::timed_out);
+    CHECK(extra.calls == 0);
+    CHECK(next && *next == now + 600ms);
+    CHECK(flight.size() == 1);
+
+    // 失效的执行被新的领导者取代，旧的结果被丢弃
+    auto replacement = flight.join("/slow", reactor, [](auto...) {}, now + 1s);
+    CHECK(replacement);
+    CHECK(!flight.complete(*ticket, std::string{"late"}));
+    CHECK(flight.complete(*replacement, std::string{"fresh"}));
+
+    drain(reactor);
+    CHECK(extra.calls == 1 && extra.error == std::errc::timed_out);
+}
+
+int main() {
+    test_coalescing();
+    test_concurrent_join();
+    test_exception();
+    test_key_released();
+    test_timeouts();
+
+    return test::report("single flight");
+}
@@ -0,0 +1,278 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_static_bundle.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 09:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/http/static_bundle.hpp"
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <unistd.h>
+
+using namespace tiny_web_server;
+
+namespace fs = std::filesystem;
+
+constexpr auto FILES = 500;
+
+/// 资源包文件头与索引项的布局，用于构造损坏的资源包
+constexpr std::size_t HEADER_SIZE = 48;
+
+constexpr std::size_t ENTRIES_OFFSET = 32;
+
+constexpr std::size_t ENTRY_SIZE = 16 + 4 * 32;
+
+fs::path scratch(const std::string_view name) {
+    auto path = fs::temp_directory_path();
+    path /= std::string{name} + "-" + std::to_string(::getpid());
+
+    return path;
+}
+
+void write(const fs::path& path, const std::string_view content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << content;
+}
+
+std::string read(const fs::path& path) {
+    std::ifstream file{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, {}};
+}
+
+/// 第 i 个文件的内容: 文本可压缩，较大的文本会生成 gzip 变体
+std::string content(const int i) {
+    auto text = "file " + std::to_string(i) + "\n";
+    if (i % 3 == 0) text.append(static_cast<std::size_t>(i) * 4, 'a' + i % 26);
+
+    return text;
+}
+
+std::string assetPath(const int i) {
+    auto directory = "/dir" + std::to_string(i % 7) + "/sub" + std::to_string(i % 3);
+    auto extension = i % 5 == 0 ? ".png" : ".txt";
+
+    return directory + "/asset-" + std::to_string(i) + extension;
+}
+
+std::string text(std::span<const std::byte> bytes) {
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+bool opens(const fs::path& path) {
+    try {
+        auto bundle = http::StaticBundle::open(path);
+        return bundle.isOpen();
+    } catch (const std::exception&) { return false; }
+}
+
+/**
+ * @brief 打包一个有 FILES 个文件的目录，返回资源包路径
+ */
+fs::path packFixture(const fs::path& directory) {
+    fs::remove_all(directory);
+
+    for (auto i = 0; i < FILES; ++i)
+        write(directory / "root" / assetPath(i).substr(1), content(i));
+
+    auto output = directory / "site.bundle";
+    CHECK(http::packBundle(directory / "root", output) == FILES);
+
+    return output;
+}
+
+void test_lookup(const fs::path& output) {
+    auto bundle = http::StaticBundle::open(output);
+
+    CHECK(bundle.isOpen());
+    CHECK(bundle.files() == FILES);
+
+    http::AcceptEncoding identity{"identity"};
+    http::AcceptEncoding gzip{"gzip"};
+
+    // 每个文件都能找到，且各占一个槽位
+    std::set<std::size_t> slots;
+    auto compressed = 0;
+
+    for (auto i = 0; i < FILES; ++i) {
+        auto path  = assetPath(i);
+        auto entry = bundle.find(path);
+
+        CHECK(entry);
+        if (!entry) continue;
+
+        slots.insert(*entry);
+        CHECK(bundle.path(*entry) == path);
+
+        auto variant = bundle.select(*entry, identity);
+        CHECK(variant.encoding == http::ContentEncoding::IDENTITY);
+        CHECK(text(variant.body) == content(i));
+        CHECK(variant.head.starts_with("HTTP/1.1 200 OK\r\n"));
+        CHECK(variant.head.find(variant.etag) != std::string_view::npos);
+
+        auto preferred = bundle.select(*entry, gzip);
+        if (preferred.encoding == http::ContentEncoding::GZIP) ++compressed;
+    }
+
+    CHECK(slots.size() == FILES);
+    CHECK(compressed > 0);
+}
+
+void test_missing_path(const fs::path& output) {
+    auto bundle = http::StaticBundle::open(output);
+
+    // 不存在的路径，包括只差一个字符、大小写或结尾斜杠的路径
+    for (const auto* path : {
+             "", "/", "/missing", "/dir0", "/dir0/", "/dir1/sub1/asset-1.tx",
+             "/dir1/sub1/asset-1.txt/", "/DIR1/sub1/asset-1.txt", "dir1/sub1/asset-1.txt",
+             "/dir1/sub1/asset-1.txt?x=1", "/dir1/sub1/asset-10000.txt"
+         })
+        CHECK(!bundle.find(path));
+
+    CHECK(bundle.find("/dir1/sub1/asset-1.txt"));
+
+    // 大量随机的路径都不会误中
+    for (auto i = FILES; i < FILES * 20; ++i) CHECK(!bundle.find(assetPath(i)));
+
+    // 未打开的资源包
+    http::StaticBundle closed;
+    CHECK(!closed.isOpen());
+    CHECK(!closed.find("/dir1/sub1/asset-1.txt"));
+    CHECK(closed.files() == 0);
+
+    // 空目录也能打包与打开
+    auto empty = output.parent_path() / "empty";
+    fs::create_directories(empty);
+
+    auto emptyBundle = output.parent_path() / "empty.bundle";
+    CHECK(http::packBundle(empty, emptyBundle) == 0);
+    CHECK(opens(emptyBundle));
+    CHECK(!http::StaticBundle::open(emptyBundle).find("/"));
+}
+
+void test_corrupt(const fs::path& output) {
+    auto original = read(output);
+    auto damaged  = output.parent_path() / "damaged.bundle";
+
+    auto check = [&](const std::string& bytes) {
+        write(damaged, bytes);
+        return !opens(damaged);
+    };
+
+    auto u32 = [](std::string& bytes, const std::size_t at, const std::uint32_t value) {
+        std::memcpy(bytes.data() + at, &value, sizeof(value));
+    };
+
+    auto u64 = [](std::string& bytes, const std::size_t at, const std::uint64_t value) {
+        std::memcpy(bytes.data() + at, &value, sizeof(value));
+    };
+
+    CHECK(opens(output));
+    CHECK(!opens(output.parent_path() / "absent.bundle"));
+
+    // 截断到任何长度
+    std::size_t sizes[]{0, 1, HEADER_SIZE - 1, HEADER_SIZE, original.size() / 2,
+                        original.size() - 1};
+
+    for (auto size : sizes) CHECK(check(original.substr(0, size)));
+
+    // 截断后同时改写头部记录的大小，索引越界
+    auto truncated = original.substr(0, original.size() / 2);
+    u64(truncated, 40, truncated.size());
+    CHECK(check(truncated));
+
+    // 头部字段
+    auto bytes = original;
+    bytes[0]   = 'X';
+    CHECK(check(bytes));
+
+    bytes = original;
+    u32(bytes, 8, 2);
+    CHECK(check(bytes));
+
+    bytes = original;
+    u32(bytes, 12, FILES + 1);
+    CHECK(check(bytes));
+
+    bytes = original;
+    u32(bytes, 16, 0);
+    CHECK(check(bytes));
+
+    bytes = original;
+    u64(bytes, 24, original.size());
+    CHECK(check(bytes));
+
+    bytes = original;
+    u64(bytes, 24, HEADER_SIZE + 1);
+    CHECK(check(bytes));
+
+    bytes = original;
+    u64(bytes, ENTRIES_OFFSET, original.size() - 8);
+    CHECK(check(bytes));
+
+    // 第一个非空索引项的各个字段
+    std::uint64_t entries;
+    std::memcpy(&entries, original.data() + ENTRIES_OFFSET, sizeof(entries));
+
+    auto entry = static_cast<std::size_t>(entries);
+    while (original[entry + 12] == 0) entry += ENTRY_SIZE;
+
+    bytes = original;
+    u64(bytes, entry, original.size());
+    CHECK(check(bytes));
+
+    bytes = original;
+    u32(bytes, entry + 8, 0xFFFFFFFF);
+    CHECK(check(bytes));
+
+    // 缺少未压缩的变体
+    bytes = original;
+    u32(bytes, entry + 12, 2);
+    CHECK(check(bytes));
+
+    // 变体的响应头、响应体与 ETag 越界
+    auto variant = entry + 16;
+
+    bytes = original;
+    u64(bytes, variant, original.size());
+    CHECK(check(bytes));
+
+    bytes = original;
+    u64(bytes, variant + 16, UINT64_MAX);
+    CHECK(check(bytes));
+
+    bytes = original;
+    u32(bytes, variant + 24, 0);
+    CHECK(check(bytes));
+
+    bytes = original;
+    bytes[variant + 30] = static_cast<char>(0xFF);
+    bytes[variant + 31] = static_cast<char>(0xFF);
+    CHECK(check(bytes));
+
+    // 未改动的副本仍然有效
+    CHECK(!check(original));
+}
+
+int main() {
+    auto directory = scratch("tws-bundle");
+    auto output    = packFixture(directory);
+
+    test_lookup(output);
+    test_missing_path(output);
+    test_corrupt(output);
+
+    fs::remove_all(directory);
+
+    return test::report("static bundle");
+}
@@ -0,0 +1,282 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_upstream.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/20 09:00
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/net/upstream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <ranges>
+
+using namespace tiny_web_server;
+using namespace std::chrono_literals;
+
+using Clock = net::Upstream::Clock;
+
+constexpr int KEYS = 10000;
+
+std::vector<net::Endpoint> backends(const std::size_t count, const std::size_t first = 1) {
+    std::vector<net::Endpoint> endpoints;
+
+    for (auto i = first; i < first + count; ++i)
+        endpoints.emplace_back(net::IpAddress{"10.0.0." + std::to_string(i)}, 8080);
+
+    return endpoints;
+}
+
+net::UpstreamOptions hashing() {
+    net::UpstreamOptions options;
+    options.policy = net::BalancePolicy::CONSISTENT_HASH;
+
+    return options;
+}
+
+/**
+ * @brief 每个键落在的后端地址，逐个选择后立即结束，不受有界负载影响
+ */
+std::vector<std::string> placement(net::Upstream& upstream) {
+    net::UpstreamSelector selector{upstream};
+    std::vector<std::string> owners;
+
+    for (auto key = 0; key < KEYS; ++key) {
+        auto backend = selector.select("session-" + std::to_string(key));
+        owners.push_back(upstream.endpoint(*backend).address().toString());
+
+        selector.complete(*backend, true, 1ms);
+    }
+
+    return owners;
+}
+
+void test_ring_stability() {
+    net::Upstream upstream{backends(4), hashing()};
+
+    // 环只取决于后端地址: 同样的后端，无论构建几次、列出的顺序如何，键都落在同一后端
+    auto endpoints = backends(4);
+    std::ranges::reverse(endpoints);
+
+    net::Upstream rebuilt{backends(4), hashing()};
+    net::Upstream reversed{endpoints, hashing()};
+
+    auto owners = placement(upstream);
+
+    CHECK(placement(rebuilt) == owners);
+    CHECK(placement(reversed) == owners);
+
+    // 各后端分到的键大致均匀
+    std::map<std::string, int> counts;
+    for (const auto& owner : owners) ++counts[owner];
+
+    CHECK(counts.size() == 4);
+    for (const auto& [owner, count] : counts) CHECK(count > KEYS / 8 && count < KEYS / 2);
+
+    // 增加一个后端只移动约 1/5 的键，且只移到新后端上
+    net::Upstream grown{backends(5), hashing()};
+    auto after = placement(grown);
+    auto added = grown.endpoint(4).address().toString();
+
+    auto moved = 0;
+    for (auto key = 0; key < KEYS; ++key) {
+        if (after[key] == owners[key]) continue;
+
+        ++moved;
+        CHECK(after[key] == added);
+    }
+
+    CHECK(moved > KEYS / 10 && moved < KEYS * 3 / 10);
+
+    // 移除一个后端只移动原本在它上面的键
+    net::Upstream shrunk{backends(3), hashing()};
+    auto removed = upstream.endpoint(3).address().toString();
+    auto rest    = placement(shrunk);
+
+    for (auto key = 0; key < KEYS; ++key)
+        if (owners[key] != removed) CHECK(rest[key] == owners[key]);
+}
+
+void test_bounded_load() {
+    net::Upstream upstream{backends(4), hashing()};
+    net::UpstreamSelector selector{upstream};
+
+    auto factor = upstream.options().loadFactor;
+
+    // 同一个键的请求持续进行中: 首选后端达到上限后沿环顺延，任何后端都不超过上限
+    std::map<std::size_t, int> chosen;
+    std::optional<std::size_t> home;
+
+    for (auto total = 1; total <= 100; ++total) {
+        auto backend = selector.select("hot-key");
+        CHECK(backend);
+
+        if (!home) home = backend;
+        ++chosen[*backend];
+
+        auto bound = std::ceil(factor * total / 4.0);
+        for (std::size_t i = 0; i < upstream.size(); ++i)
+            CHECK(selector.outstanding(i) <= bound);
+    }
+
+    CHECK(chosen.size() == 4);
+    CHECK(chosen[*home] == std::ranges::max(chosen | std::views::values));
+
+    // 负载释放后回到首选后端
+    for (std::size_t i = 0; i < upstream.size(); ++i)
+        while (selector.outstanding(i) > 0) selector.complete(i, true, 1ms);
+
+    CHECK(selector.select("hot-key") == home);
+}
+
+void test_consecutive_errors() {
+    net::UpstreamOptions options;
+    options.policy = net::BalancePolicy::ROUND_ROBIN;
+
+    net::Upstream upstream{backends(4), options};
+    net::UpstreamSelector selector{upstream};
+
+    // 成功的请求清零连续失败计数
+    for (auto i = 0; i < 4; ++i) selector.complete(1, false, 1ms);
+    selector.complete(1, true, 1ms);
+    for (auto i = 0; i < 4; ++i) selector.complete(1, false, 1ms);
+    CHECK(!upstream.isEjected(1));
+
+    selector.complete(1, false, 1ms);
+    CHECK(upstream.isEjected(1));
+
+    // 被摘除的后端不再被选中
+    for (auto i = 0; i < 20; ++i) {
+        auto backend = selector.select();
+        CHECK(backend && *backend != 1);
+
+        selector.complete(*backend, true, 1ms);
+    }
+
+    // 下次汇总确定恢复时间，到期后的汇总恢复
+    auto now = Clock::now();
+    upstream.aggregate(now);
+    CHECK(upstream.isEjected(1));
+
+    upstream.aggregate(now + options.baseEjection - 1ms);
+    CHECK(upstream.isEjected(1));
+
+    upstream.aggregate(now + options.baseEjection);
+    CHECK(!upstream.isEjected(1));
+}
+
+void test_error_rate() {
+    net::UpstreamOptions options;
+    options.policy            = net::BalancePolicy::ROUND_ROBIN;
+    options.consecutiveErrors = 0;
+
+    net::Upstream upstream{backends(4), options};
+    net::UpstreamSelector selector{upstream};
+
+    auto period = [&](const Clock::time_point now, const std::size_t failing) {
+        for (std::size_t backend = 0; backend < 4; ++backend)
+            for (auto i = 0; i < 40; ++i)
+                selector.complete(backend, backend != failing || i % 4 == 0, 1ms);
+
+        upstream.aggregate(now);
+    };
+
+    auto now = Clock::now();
+
+    // 样本不足时不检测
+    for (auto i = 0; i < 10; ++i) selector.complete(2, false, 1ms);
+    upstream.aggregate(now);
+    CHECK(!upstream.isEjected(2));
+
+    // 错误率 75% 超过 50%
+    period(now, 2);
+    CHECK(upstream.isEjected(2));
+
+    // 到期后恢复
+    upstream.aggregate(now + 29s);
+    CHECK(upstream.isEjected(2));
+
+    upstream.aggregate(now + 30s);
+    CHECK(!upstream.isEjected(2));
+
+    // 再次被摘除时时长倍增
+    now += 30s;
+    period(now, 2);
+    CHECK(upstream.isEjected(2));
+
+    upstream.aggregate(now + 59s);
+    CHECK(upstream.isEjected(2));
+
+    upstream.aggregate(now + 60s);
+    CHECK(!upstream.isEjected(2));
+}
+
+void test_latency_outlier() {
+    net::UpstreamOptions options;
+    options.policy = net::BalancePolicy::ROUND_ROBIN;
+
+    net::Upstream upstream{backends(4), options};
+    net::UpstreamSelector selector{upstream};
+
+    for (std::size_t backend = 0; backend < 4; ++backend)
+        for (auto i = 0; i < 30; ++i)
+            selector.complete(backend, true, backend == 3 ? 50ms : 5ms);
+
+    // 负的延迟(时钟回拨)按0计
+    selector.complete(0, true, -1ms);
+
+    upstream.aggregate(Clock::now());
+
+    CHECK(upstream.isEjected(3));
+    CHECK(!upstream.isEjected(0) && !upstream.isEjected(1) && !upstream.isEjected(2));
+}
+
+void test_ejection_limit() {
+    net::UpstreamOptions options;
+    options.policy = net::BalancePolicy::ROUND_ROBIN;
+
+    net::Upstream upstream{backends(4), options};
+    net::UpstreamSelector selector{upstream};
+
+    // 最多摘除一半
+    for (std::size_t backend = 0; backend < 4; ++backend)
+        for (auto i = 0; i < 5; ++i) selector.complete(backend, false, 1ms);
+
+    auto ejected = 0;
+    for (std::size_t backend = 0; backend < 4; ++backend)
+        ejected += upstream.isEjected(backend) ? 1 : 0;
+
+    CHECK(ejected == 2);
+
+    // 比例上限为 1 时可以全部摘除，此时忽略摘除状态照常选择
+    options.maxEjectedRatio = 1.0;
+
+    net::Upstream all{backends(2), options};
+    net::UpstreamSelector allSelector{all};
+
+    for (std::size_t backend = 0; backend < 2; ++backend)
+        for (auto i = 0; i < 5; ++i) allSelector.complete(backend, false, 1ms);
+
+    CHECK(all.isEjected(0) && all.isEjected(1));
+    CHECK(allSelector.select());
+}
+
+int main() {
+    test_ring_stability();
+    test_bounded_load();
+    test_consecutive_errors();
+    test_error_rate();
+    test_latency_outlier();
+    test_ejection_limit();
+
+    return test::report("upstream");
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for
+// commercial purposes is prohibited without the author's permission. If you have any
+// questions or require permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file test_websocket.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 16:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#include "check.hpp"
+#include "tws/websocket/broadcaster.hpp"
+#include "tws/websocket/frame.hpp"
+#include "tws/websocket/handshake.hpp"
+#include <array>
+#include <cstring>
+#include <string>
+
+
+using namespace tiny_web_server;
+
+void test_accept_key() {
+    using namespace websocket;
+
+    // RFC 6455 1.3 中的示例
+    CHECK(acceptKey("dGhlIHNhbXBsZSBub25jZQ==") == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+void test_unmask() {
+    using namespace websocket;
+
+    const std::uint8_t key[4]{0x37, 0xfa, 0x21, 0x3d};
+    std::uint32_t maskKey;
+    std::memcpy(&maskKey, key, 4);
+
+    // 覆盖标量尾部、SSE2 与 AVX2 路径，以及非零相位
+    for (std::size_t size : {0, 1, 7, 15, 16, 31, 33, 64, 100, 1000}) {
+        for (std::size_t offset : {0, 1, 2, 3}) {
+            std::vector<std::byte> data(size), expected(size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                data[i]     = static_cast<std::byte>(i * 31 + 7);
+                expected[i] = data[i] ^ static_cast<std::byte>(key[(i + offset) % 4]);
+            }
+
+            unmask(data, maskKey, offset);
+            CHECK(data == expected);
+        }
+    }
+}
+
+void test_frame_round_trip() {
+    using namespace websocket;
+
+    for (std::size_t size : {0, 125, 126, 65535, 65536}) {
+        std::vector<std::byte> payload(size, std::byte{'x'});
+
+        auto frame = makeFrame(Opcode::BINARY, payload);
+
+        FrameHeader header;
+        CHECK(parseHeader(*frame, header) == ParseStatus::COMPLETE);
+        CHECK(header.fin && header.opcode == Opcode::BINARY && !header.masked);
+        CHECK(header.payloadLength == size);
+        CHECK(header.headerLength + size == frame->size());
+
+        // 帧头不完整
+        CHECK(parseHeader(std::span{*frame}.first(1), header) == ParseStatus::INCOMPLETE);
+    }
+}
+
+void test_frame_errors() {
+    using namespace websocket;
+
+    FrameHeader header;
+
+    // 保留位
+    const std::byte rsv[]{std::byte{0xC1}, std::byte{0x80}};
+    CHECK(parseHeader(rsv, header) == ParseStatus::ERROR);
+
+    // 分片的控制帧
+    const std::byte fragmentedPing[]{std::byte{0x09}, std::byte{0x80}};
+    CHECK(parseHeader(fragmentedPing, header) == ParseStatus::ERROR);
+
+    // 过长的控制帧
+    const std::byte longPing[]{
+        std::byte{0x89}, std::byte{0xFE}, std::byte{0}, std::byte{126}
+    };
+    CHECK(parseHeader(longPing, header) == ParseStatus::ERROR);
+
+    // 未知操作码
+    const std::byte unknown[]{std::byte{0x83}, std::byte{0x80}};
+    CHECK(parseHeader(unknown, header) == ParseStatus::ERROR);
+}
+
+std::size_t drain(const net::Socket& socket) {
+    std::array<std::byte, 4096> buffer;
+    std::size_t total = 0;
+
+    while (auto received = socket.tryRecv(buffer)) {
+        if (*received == 0) break;
+        total += *received;
+    }
+
+    return total;
+}
+
+void test_broadcast_reentrant_unsubscribe() {
+    using namespace websocket;
+
+    async::Reactor reactor;
+    Broadcaster broadcaster;
+
+    http::Request request;
+    request.method = "GET";
+    request.headers.push_back({"Upgrade", "websocket"});
+    request.headers.push_back({"Connection", "Upgrade"});
+    request.headers.push_back({"Sec-WebSocket-Version", "13"});
+    request.headers.push_back({"Sec-WebSocket-Key", "dGhlIHNhbXBsZSBub25jZQ=="});
+
+    auto handshake = handshakeResponse(request).size();
+
+    const std::vector<std::byte> payload(300, std::byte{'x'});
+    auto frame = makeFrame(Opcode::BINARY, payload);
+
+    std::vector<net::Socket> clients;
+    std::vector<std::shared_ptr<Connection>> connections;
+
+    for (int i = 0; i < 3; ++i) {
+        auto [server, client] = net::Socket::pair();
+        client.setNonBlocking();
+
+        // 第一个连接的发送上限小于广播帧，send 会在扇出中途关闭它
+        ConnectionOptions options;
+        if (i == 0) options.maxPendingBytes = payload.size() / 2;
+
+        auto connection =
+            Connection::upgrade(std::move(server), request, {}, reactor, {}, options);
+        connection->onClose([&](Connection& closed, std::uint16_t) {
+            broadcaster.unsubscribe(closed.shared_from_this());
+        });
+
+        broadcaster.subscribe(connection);
+        connections.push_back(std::move(connection));
+        clients.push_back(std::move(client));
+    }
+
+    reactor.post([&] { broadcaster.broadcast(frame); });
+    while (reactor.runOnce(0) > 0) {}
+
+    CHECK(!connections[0]->isOpen());
+
+    // 关闭回调中的退订不能让扇出跳过后续成员
+    for (std::size_t i = 1; i < clients.size(); ++i)
+        CHECK(drain(clients[i]) == handshake + frame->size());
+
+    // 再次广播时已退订的连接被移除，其余连接照常收到
+    reactor.post([&] { broadcaster.broadcast(frame); });
+    while (reactor.runOnce(0) > 0) {}
+
+    for (std::size_t i = 1; i < clients.size(); ++i)
+        CHECK(drain(clients[i]) == frame->size());
+
+    for (auto& connection : connections) connection->close();
+}
+
+int main() {
+    test_accept_key();
+    test_unmask();
+    test_frame_round_trip();
+    test_frame_errors();
+    test_broadcast_reentrant_unsubscribe();
+
+    return test::report("websocket");
+}